@@ -0,0 +1,95 @@
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef __ACHIEVED_FLUENTS__
+#define __ACHIEVED_FLUENTS__
+
+#include <action.hxx>
+#include <cond_eff.hxx>
+#include <types.hxx>
+#include <algorithm>
+#include <memory>
+
+namespace aptk
+{
+
+	namespace search
+	{
+
+		/**
+		 * Relevant fluents achieved on the path from the node whose relaxed
+		 * plan they belong to, sorted. A node shares the set of its parent
+		 * unless its action achieves a new one, and a null pointer stands for
+		 * the empty set, so r(n) is the size of the set of n.
+		 */
+		typedef std::shared_ptr<const Fluent_Vec> Achieved_Fluents_Ptr;
+
+		inline unsigned num_achieved(const Achieved_Fluents_Ptr &achieved)
+		{
+			return achieved ? achieved->size() : 0;
+		}
+
+		/**
+		 * The achieved set of a node reached with a from a node with the given
+		 * set. Effects of a are taken regardless of their conditions.
+		 */
+		inline Achieved_Fluents_Ptr achieve_fluents(const Achieved_Fluents_Ptr &achieved, const Action &a, const Fluent_Set &relevant)
+		{
+			Fluent_Vec new_fluents;
+			auto achieve = [&](unsigned p)
+			{
+				if (!relevant.isset(p))
+					return;
+				if (achieved && std::binary_search(achieved->begin(), achieved->end(), p))
+					return;
+				if (std::find(new_fluents.begin(), new_fluents.end(), p) == new_fluents.end())
+					new_fluents.push_back(p);
+			};
+
+			for (unsigned i = 0; i < a.ceff_vec().size(); i++)
+				for (auto p : a.ceff_vec()[i]->add_vec())
+					achieve(p);
+			for (auto p : a.add_vec())
+				achieve(p);
+
+			if (new_fluents.empty())
+				return achieved;
+
+			std::sort(new_fluents.begin(), new_fluents.end());
+			Fluent_Vec *merged = new Fluent_Vec(num_achieved(achieved) + new_fluents.size());
+			if (achieved)
+				std::merge(achieved->begin(), achieved->end(), new_fluents.begin(), new_fluents.end(), merged->begin());
+			else
+				std::copy(new_fluents.begin(), new_fluents.end(), merged->begin());
+			return Achieved_Fluents_Ptr(merged);
+		}
+
+	}
+
+}
+
+#endif // achieved_fluents.hxx
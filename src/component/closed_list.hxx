@@ -42,6 +42,36 @@ namespace aptk
 			Lazy
 		};
 
+		namespace detail
+		{
+			template <typename State>
+			auto pack(State *s, int) -> decltype(s->pack(), void()) { s->pack(); }
+			template <typename State>
+			void pack(State *, long) {}
+			template <typename State>
+			auto unpack(State *s, int) -> decltype(s->unpack(), void()) { s->unpack(); }
+			template <typename State>
+			void unpack(State *, long) {}
+		}
+
+		// Closed nodes are only compared and hashed, so engines may pack their
+		// states, see State::pack(). Does nothing for state types that cannot
+		// be packed
+		template <typename State>
+		void pack_state(State *s)
+		{
+			if (s)
+				detail::pack(s, 0);
+		}
+
+		// Restores the state of a closed node that is going to be expanded again
+		template <typename State>
+		void unpack_state(State *s)
+		{
+			if (s)
+				detail::unpack(s, 0);
+		}
+
 		template <typename Node, Node_Generation gen_opt = Node_Generation::Eager>
 		class Closed_List : public std::unordered_multimap<size_t, Node *>
 		{
@@ -0,0 +1,175 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __CONCURRENT_CLOSED_LIST__
+#define __CONCURRENT_CLOSED_LIST__
+
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+namespace aptk
+{
+
+	namespace search
+	{
+
+		/**
+		 * Closed list that can be queried and updated from several threads.
+		 *
+		 * The table is split in shards, each guarded by its own mutex. Every
+		 * entry carries a claim key: when two threads insert the same state,
+		 * the node with the smallest key owns the entry, so the outcome does
+		 * not depend on thread interleaving. Settled nodes (key 0) always win.
+		 */
+		template <typename Node>
+		class Concurrent_Closed_List
+		{
+		public:
+			typedef typename Node::State_Type State;
+			typedef std::pair<Node *, uint64_t> Entry;
+			typedef std::unordered_multimap<size_t, Entry> Table;
+
+			static const uint64_t settled_key = 0;
+
+			Concurrent_Closed_List(unsigned num_shards = 256)
+					: m_num_shards(1)
+			{
+				while (m_num_shards < num_shards)
+					m_num_shards <<= 1;
+				m_shards.reset(new Shard[m_num_shards]);
+			}
+
+			~Concurrent_Closed_List()
+			{
+			}
+
+			/**
+			 * Inserts n with the given key unless an equal node with a smaller
+			 * key is already there. Returns the node owning the state.
+			 */
+			Node *claim(Node *n, uint64_t key)
+			{
+				Shard &s = shard(n->hash());
+				std::lock_guard<std::mutex> guard(s.lock);
+				auto range = s.table.equal_range(n->hash());
+				for (auto it = range.first; it != range.second; it++)
+				{
+					if (!(*(it->second.first) == *n))
+						continue;
+					if (key < it->second.second)
+						it->second = std::make_pair(n, key);
+					return it->second.first;
+				}
+				s.table.insert(std::make_pair(n->hash(), std::make_pair(n, key)));
+				return n;
+			}
+
+			void put(Node *n) { claim(n, settled_key); }
+
+			Node *retrieve(Node *n)
+			{
+				Shard &s = shard(n->hash());
+				std::lock_guard<std::mutex> guard(s.lock);
+				auto range = s.table.equal_range(n->hash());
+				for (auto it = range.first; it != range.second; it++)
+					if (*(it->second.first) == *n)
+						return it->second.first;
+				return NULL;
+			}
+
+			/**
+			 * Makes n's entry permanent, no later claim can take it over
+			 */
+			void settle(Node *n)
+			{
+				Shard &s = shard(n->hash());
+				std::lock_guard<std::mutex> guard(s.lock);
+				auto range = s.table.equal_range(n->hash());
+				for (auto it = range.first; it != range.second; it++)
+					if (it->second.first == n)
+					{
+						it->second.second = settled_key;
+						return;
+					}
+			}
+
+			void erase(Node *n)
+			{
+				Shard &s = shard(n->hash());
+				std::lock_guard<std::mutex> guard(s.lock);
+				auto range = s.table.equal_range(n->hash());
+				for (auto it = range.first; it != range.second; it++)
+					if (it->second.first == n)
+					{
+						s.table.erase(it);
+						return;
+					}
+			}
+
+			size_t size() const
+			{
+				size_t sz = 0;
+				for (unsigned i = 0; i < m_num_shards; i++)
+					sz += m_shards[i].table.size();
+				return sz;
+			}
+
+			/**
+			 * Not thread-safe, meant to be called once the search is over
+			 */
+			void clear(bool delete_nodes = false)
+			{
+				for (unsigned i = 0; i < m_num_shards; i++)
+				{
+					if (delete_nodes)
+						for (auto it = m_shards[i].table.begin(); it != m_shards[i].table.end(); it++)
+							delete it->second.first;
+					m_shards[i].table.clear();
+				}
+			}
+
+		protected:
+			struct alignas(64) Shard
+			{
+				std::mutex lock;
+				Table table;
+			};
+
+			Shard &shard(size_t h) { return m_shards[(h ^ (h >> 16)) & (m_num_shards - 1)]; }
+
+			unsigned m_num_shards;
+			std::unique_ptr<Shard[]> m_shards;
+		};
+
+	}
+
+}
+
+#endif // concurrent_closed_list.hxx
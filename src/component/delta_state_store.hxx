@@ -0,0 +1,261 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __DELTA_STATE_STORE__
+#define __DELTA_STATE_STORE__
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <action.hxx>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace aptk
+{
+
+	namespace search
+	{
+
+		/**
+		 * Fluents a node adds to and deletes from the state of its parent,
+		 * together with the hash its full state was closed under
+		 */
+		struct State_Delta
+		{
+			Fluent_Vec added;
+			Fluent_Vec deleted;
+			size_t hash;
+		};
+
+		/**
+		 * Keeps closed nodes small by replacing their states with deltas
+		 * against their parent. Every snapshot_interval generations along a
+		 * path a node keeps its full state, so rebuilding any state applies at
+		 * most that many deltas. Rebuilt states are kept in a small LRU cache,
+		 * as duplicate checks tend to hit the same few closed nodes.
+		 *
+		 * Nodes must provide delta() and set_delta(), and own the delta they
+		 * are given.
+		 */
+		template <typename Node>
+		class Delta_State_Store
+		{
+		public:
+			typedef typename Node::State_Type State;
+
+			Delta_State_Store(const STRIPS_Problem &task, unsigned snapshot_interval, unsigned cache_size = 64)
+					: m_task(task), m_snapshot_interval(snapshot_interval), m_cache_size(cache_size)
+			{
+			}
+
+			~Delta_State_Store() { clear(); }
+
+			unsigned snapshot_interval() const { return m_snapshot_interval; }
+			unsigned cache_size() const { return m_cache_size; }
+
+			/**
+			 * Called on nodes that have been expanded and closed, drops their
+			 * state unless it is due to be a snapshot
+			 */
+			void store(Node *n)
+			{
+				if (!n->has_state() || n->parent() == nullptr)
+					return;
+
+				unsigned depth = 1;
+				for (Node *m = n->parent(); m != nullptr && m->delta() != nullptr; m = m->parent())
+					depth++;
+				if (depth >= m_snapshot_interval)
+					return;
+
+				// Effects whose condition did not hold in the parent are
+				// harmless: their adds are only kept if true in the state,
+				// their deletes only if false
+				State *s = n->state();
+				const Action *a = m_task.actions()[n->action()];
+				State_Delta *d = new State_Delta;
+				collect(*s, a->add_vec(), a->del_vec(), *d);
+				for (auto ce : a->ceff_vec())
+					collect(*s, ce->add_vec(), ce->del_vec(), *d);
+				d->hash = s->hash();
+
+				delete s;
+				n->set_state(nullptr);
+				n->set_delta(d);
+			}
+
+			/**
+			 * Full state of n. States rebuilt from deltas belong to the cache
+			 * and are only valid until the next call
+			 */
+			State *state(Node *n)
+			{
+				if (n->has_state())
+					return n->state();
+
+				auto it = m_index.find(n);
+				if (it != m_index.end())
+				{
+					m_lru.splice(m_lru.begin(), m_lru, it->second);
+					return it->second->second;
+				}
+
+				std::vector<Node *> path;
+				Node *m = n;
+				State *base = nullptr;
+				while (base == nullptr)
+				{
+					if (m->has_state())
+						base = m->state();
+					else if ((it = m_index.find(m)) != m_index.end())
+						base = it->second->second;
+					else
+					{
+						path.push_back(m);
+						m = m->parent();
+					}
+				}
+
+				State *s = new State(*base);
+				if (s->is_packed())
+					s->unpack();
+				for (auto rit = path.rbegin(); rit != path.rend(); rit++)
+				{
+					const State_Delta *d = (*rit)->delta();
+					if (d != nullptr)
+					{
+						s->unset(d->deleted);
+						s->set(d->added);
+						continue;
+					}
+					// Closed without being expanded, its state was never generated
+					State *succ = s->progress_through(*(m_task.actions()[(*rit)->action()]));
+					delete s;
+					s = succ;
+				}
+				s->update_hash();
+
+				m_lru.emplace_front(n, s);
+				m_index[n] = m_lru.begin();
+				if (m_lru.size() > m_cache_size)
+				{
+					m_index.erase(m_lru.back().first);
+					delete m_lru.back().second;
+					m_lru.pop_back();
+				}
+				return s;
+			}
+
+			/**
+			 * Hash n was put into the closed list under
+			 */
+			size_t key(Node *n) const
+			{
+				if (n->has_state())
+					return n->state()->hash();
+				if (n->delta() != nullptr)
+					return n->delta()->hash;
+				return n->hash();
+			}
+
+			/**
+			 * Same as Closed_List::retrieve(), closed nodes without a state
+			 * are compared against their rebuilt one
+			 */
+			template <typename Closed_List>
+			Node *retrieve(Closed_List &closed, Node *n)
+			{
+				auto range = closed.equal_range(key(n));
+				for (auto it = range.first; it != range.second; it++)
+				{
+					Node *c = it->second;
+					if (c->has_state())
+					{
+						if (*c == *n)
+							return c;
+						continue;
+					}
+					c->set_state(state(c));
+					const bool equal = (*c == *n);
+					c->set_state(nullptr);
+					if (equal)
+						return c;
+				}
+				return nullptr;
+			}
+
+			/**
+			 * Position of the closed node n itself in the closed list
+			 */
+			template <typename Closed_List>
+			typename Closed_List::iterator retrieve_iterator(Closed_List &closed, Node *n)
+			{
+				auto range = closed.equal_range(key(n));
+				for (auto it = range.first; it != range.second; it++)
+					if (it->second == n)
+						return it;
+				return closed.end();
+			}
+
+			/**
+			 * Forgets rebuilt states, must be called before closed nodes
+			 * are deleted
+			 */
+			void clear()
+			{
+				for (auto &entry : m_lru)
+					delete entry.second;
+				m_lru.clear();
+				m_index.clear();
+			}
+
+		protected:
+			void collect(const State &s, const Fluent_Vec &add, const Fluent_Vec &del, State_Delta &d)
+			{
+				for (auto p : del)
+					if (!s.entails(p))
+						d.deleted.push_back(p);
+				for (auto p : add)
+					if (s.entails(p))
+						d.added.push_back(p);
+			}
+
+		protected:
+			const STRIPS_Problem &m_task;
+			unsigned m_snapshot_interval;
+			unsigned m_cache_size;
+			std::list<std::pair<Node *, State *>> m_lru;
+			std::unordered_map<Node *, typename std::list<std::pair<Node *, State *>>::iterator> m_index;
+		};
+
+	}
+
+}
+
+#endif // delta_state_store.hxx
@@ -95,7 +95,7 @@ namespace aptk
 		{
 
 		public:
-			Match_Tree(const STRIPS_Problem &prob) : m_problem(prob) {}
+			Match_Tree(const STRIPS_Problem &prob) : m_problem(prob), root_node(nullptr) {}
 
 			~Match_Tree() { delete root_node; };
 
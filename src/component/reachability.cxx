@@ -27,6 +27,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <reachability.hxx>
 #include <action.hxx>
+#include <cond_eff.hxx>
+#include <algorithm>
 
 namespace aptk
 {
@@ -35,7 +37,7 @@ namespace aptk
 	{
 
 		Reachability_Test::Reachability_Test(const STRIPS_Problem &p)
-				: m_problem(p)
+				: m_problem(p), m_effects_built(false)
 		{
 			m_reachable_atoms.resize(m_problem.fluents().size());
 			m_reach_next.resize(m_problem.fluents().size());
@@ -153,13 +155,72 @@ namespace aptk
 					std::cout << m_problem.fluents()[k]->signature() << std::endl;
 		}
 
+		void Reachability_Test::build_effects()
+		{
+			m_effect_requiring.assign(m_problem.fluents().size(), std::vector<unsigned>());
+			m_effect_num_prec.clear();
+			m_effect_adds.clear();
+
+			Fluent_Vec prec;
+			for (unsigned i = 0; i < m_problem.actions().size(); i++)
+			{
+				const Action *a = m_problem.actions()[i];
+				for (int j = -1; j < (int)a->ceff_vec().size(); j++)
+				{
+					prec = a->prec_vec();
+					if (j >= 0)
+						prec.insert(prec.end(), a->ceff_vec()[j]->prec_vec().begin(), a->ceff_vec()[j]->prec_vec().end());
+					std::sort(prec.begin(), prec.end());
+					prec.erase(std::unique(prec.begin(), prec.end()), prec.end());
+
+					for (unsigned p : prec)
+						m_effect_requiring[p].push_back(m_effect_num_prec.size());
+					m_effect_num_prec.push_back(prec.size());
+					m_effect_adds.push_back(j >= 0 ? &(a->ceff_vec()[j]->add_vec()) : &(a->add_vec()));
+				}
+			}
+			m_effects_built = true;
+		}
+
+		// Same layers as apply_actions(), but each fluent only visits the
+		// effects needing it once, when it first becomes reachable
 		void Reachability_Test::get_reachable_actions(const Fluent_Vec &s, const Fluent_Vec &g, Bit_Set &reach_actions)
 		{
 
+			if (!m_effects_built)
+				build_effects();
 			initialize(s);
 
-			while (!apply_actions())
+			std::vector<unsigned> missing(m_effect_num_prec);
+			std::vector<unsigned> fired;
+			for (unsigned e = 0; e < missing.size(); e++)
+				if (missing[e] == 0)
+					fired.push_back(e);
+
+			Fluent_Vec layer, next;
+			for (unsigned i = 0; i < m_reachable_atoms.size(); i++)
+				if (m_reachable_atoms[i])
+					layer.push_back(i);
+
+			while (true)
 			{
+				for (unsigned p : layer)
+					for (unsigned e : m_effect_requiring[p])
+						if (--missing[e] == 0)
+							fired.push_back(e);
+
+				next.clear();
+				for (unsigned e : fired)
+					for (unsigned q : *m_effect_adds[e])
+						if (!m_reachable_atoms[q])
+						{
+							m_reachable_atoms[q] = true;
+							next.push_back(q);
+						}
+				fired.clear();
+
+				if (next.empty())
+					break;
 #ifdef DEBUG
 				std::cout << "Reachable atoms:" << std::endl;
 				print_reachable_atoms();
@@ -167,6 +228,7 @@ namespace aptk
 
 				if (check(g))
 					break;
+				layer.swap(next);
 			}
 
 			reach_actions.resize(m_problem.actions().size());
@@ -56,6 +56,7 @@ namespace aptk
 			bool apply_actions();
 			void initialize(const Fluent_Vec &s);
 			bool check(const Fluent_Vec &set);
+			void build_effects();
 
 			void print_reachable_atoms();
 
@@ -64,6 +65,13 @@ namespace aptk
 			std::vector<bool> m_reachable_atoms;
 			std::vector<bool> m_reach_next;
 			Bit_Set m_action_mask;
+
+			// Actions and their conditional effects, with their preconditions
+			// counted once, and for each fluent the effects requiring it
+			bool m_effects_built;
+			std::vector<unsigned> m_effect_num_prec;
+			std::vector<const Fluent_Vec *> m_effect_adds;
+			std::vector<std::vector<unsigned>> m_effect_requiring;
 		};
 
 	}
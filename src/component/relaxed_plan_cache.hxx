@@ -0,0 +1,173 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef __RELAXED_PLAN_CACHE__
+#define __RELAXED_PLAN_CACHE__
+
+#include <strips_state.hxx>
+#include <hash_table.hxx>
+#include <types.hxx>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace aptk
+{
+
+	namespace search
+	{
+
+		/**
+		 * Fluents added by the actions of a relaxed plan, as a vector and as
+		 * a set. Never modified once built, so nodes whose relaxed plans agree
+		 * share the same instance
+		 */
+		struct Relevant_Fluents
+		{
+			Relevant_Fluents(unsigned num_fluents)
+					: set(num_fluents)
+			{
+			}
+
+			Fluent_Vec vec;
+			Fluent_Set set;
+		};
+
+		typedef std::shared_ptr<const Relevant_Fluents> Relevant_Fluents_Ptr;
+
+		/**
+		 * Bounded map from a state, and the goals its relaxed plan was
+		 * extracted for, to the relevant fluents of that plan. The least
+		 * recently used entry is evicted once capacity entries are stored. A
+		 * null pointer records that the goals are unreachable from the state.
+		 *
+		 * States are keyed by their fluents rather than by State::hash(), as
+		 * lazily progressed states keep the hash of the state they came from.
+		 */
+		class Relaxed_Plan_Cache
+		{
+		public:
+			Relaxed_Plan_Cache(unsigned capacity)
+					: m_capacity(capacity), m_hits(0), m_misses(0)
+			{
+			}
+
+			static size_t goal_set_id(const Fluent_Vec &goals)
+			{
+				Fluent_Vec sorted(goals);
+				Hash_Key hasher;
+				hasher.add(sorted); // sorts them
+				return (size_t)hasher;
+			}
+
+			/**
+			 * Looks up the relaxed plan of s for the goal set with the given
+			 * id, returns whether it is cached
+			 */
+			bool find(const State &s, size_t goals, Relevant_Fluents_Ptr &rf)
+			{
+				size_t k = key(s, goals);
+				auto it = m_index.find(k);
+				if (it == m_index.end() || it->second->goals != goals || it->second->atoms != m_atoms)
+				{
+					m_misses++;
+					return false;
+				}
+				m_hits++;
+				m_entries.splice(m_entries.begin(), m_entries, it->second);
+				rf = m_entries.front().fluents;
+				return true;
+			}
+
+			void insert(const State &s, size_t goals, const Relevant_Fluents_Ptr &rf)
+			{
+				if (m_capacity == 0)
+					return;
+				size_t k = key(s, goals);
+				auto it = m_index.find(k);
+				if (it != m_index.end())
+					m_entries.splice(m_entries.begin(), m_entries, it->second);
+				else
+				{
+					if (m_entries.size() == m_capacity)
+					{
+						m_index.erase(m_entries.back().key);
+						m_entries.pop_back();
+					}
+					m_entries.emplace_front();
+					m_index[k] = m_entries.begin();
+				}
+				Entry &e = m_entries.front();
+				e.key = k;
+				e.goals = goals;
+				e.atoms = m_atoms;
+				e.fluents = rf;
+			}
+
+			void clear()
+			{
+				m_entries.clear();
+				m_index.clear();
+			}
+
+			unsigned capacity() const { return m_capacity; }
+			unsigned size() const { return m_entries.size(); }
+			unsigned hits() const { return m_hits; }
+			unsigned misses() const { return m_misses; }
+
+		protected:
+			struct Entry
+			{
+				size_t key;
+				size_t goals;
+				Fluent_Vec atoms;
+				Relevant_Fluents_Ptr fluents;
+			};
+
+			// Also leaves the sorted fluents of s in m_atoms, Hash_Key sorts them
+			size_t key(const State &s, size_t goals)
+			{
+				m_atoms.assign(s.fluent_vec().begin(), s.fluent_vec().end());
+				Hash_Key hasher(goals);
+				hasher.add(m_atoms);
+				return (size_t)hasher;
+			}
+
+			unsigned m_capacity;
+			unsigned m_hits;
+			unsigned m_misses;
+			std::list<Entry> m_entries;
+			std::unordered_map<size_t, std::list<Entry>::iterator> m_index;
+			Fluent_Vec m_atoms;
+		};
+
+	}
+
+}
+
+#endif // relaxed_plan_cache.hxx
@@ -0,0 +1,95 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef __SHARED_INCUMBENT__
+#define __SHARED_INCUMBENT__
+
+#include <search_prob.hxx>
+#include <ext_math.hxx>
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+namespace aptk
+{
+
+	namespace search
+	{
+
+		/**
+		 * Best plan found so far by engines running concurrently on the same
+		 * task. Engines read cost() as an upper bound on the cost of the plans
+		 * still worth finding, and publish cheaper plans through update().
+		 * Once some engine proves no cheaper plan exists it calls close(),
+		 * telling the others to stop.
+		 */
+		class Shared_Incumbent
+		{
+		public:
+			Shared_Incumbent()
+					: m_cost(infty), m_closed(false)
+			{
+			}
+
+			float cost() const { return m_cost.load(std::memory_order_acquire); }
+
+			/**
+			 * Replaces the incumbent if plan is cheaper, returns whether it did
+			 */
+			bool update(float cost, const std::vector<Action_Idx> &plan)
+			{
+				std::lock_guard<std::mutex> guard(m_lock);
+				if (!(cost < m_cost.load(std::memory_order_relaxed)))
+					return false;
+				m_plan = plan;
+				m_cost.store(cost, std::memory_order_release);
+				return true;
+			}
+
+			std::vector<Action_Idx> plan() const
+			{
+				std::lock_guard<std::mutex> guard(m_lock);
+				return m_plan;
+			}
+
+			void close() { m_closed.store(true); }
+			bool closed() const { return m_closed.load(std::memory_order_relaxed); }
+			const std::atomic<bool> *closed_flag() const { return &m_closed; }
+
+		protected:
+			std::atomic<float> m_cost;
+			std::atomic<bool> m_closed;
+			mutable std::mutex m_lock;
+			std::vector<Action_Idx> m_plan;
+		};
+
+	}
+
+}
+
+#endif // shared_incumbent.hxx
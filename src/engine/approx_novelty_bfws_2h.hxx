@@ -37,6 +37,8 @@
 #include <resources_control.hxx>
 #include <closed_list.hxx>
 #include <landmark_graph_manager.hxx>
+#include <relaxed_plan_cache.hxx>
+#include <achieved_fluents.hxx>
 #include <vector>
 #include <algorithm>
 #include <iostream>
@@ -54,6 +56,7 @@ class Node
 {
 public:
   typedef aptk::agnostic::Landmarks_Graph_Manager<Search_Model> Landmarks_Graph_Manager;
+  typedef aptk::agnostic::Landmark_Delta Landmark_Delta;
   typedef State State_Type;
   typedef Node<Search_Model, State> *Node_Ptr;
   typedef typename std::vector<Node<Search_Model, State> *> Node_Vec_Ptr;
@@ -63,8 +66,7 @@ public:
   Node(State *s, float cost, Action_Idx action,
       Node<Search_Model, State> *parent, int num_actions) : m_state(s),
                                   m_parent(parent), m_action(action), m_g(0), m_g_unit(0), m_h1(0),
-                                  m_h2(0), m_r(0), m_partition(0), m_M(0), m_land_consumed(NULL),
-                                  m_land_unconsumed(NULL), m_rp_fl_vec(NULL), m_rp_fl_set(NULL),
+                                  m_h2(0), m_r(0), m_partition(0), m_M(0), m_land_delta(NULL),
                                   m_relaxed_deadend(false), m_in_holding_q(false)
   {
     m_g = (parent ? parent->m_g + cost : 0.0f);
@@ -76,10 +78,8 @@ public:
   {
     if (m_state != NULL)
       delete m_state;
-    if (m_rp_fl_vec != NULL)
-      delete m_rp_fl_vec;
-    if (m_rp_fl_set != NULL)
-      delete m_rp_fl_set;
+    if (m_land_delta != NULL)
+      delete m_land_delta;
   }
 
   // unsigned&       gen_id()                { return m_gen_id; }
@@ -108,10 +108,11 @@ public:
   void set_state(State *s) { m_state = s; }
   bool has_state() const { return m_state != NULL; }
   const State &state() const { return *m_state; }
-  Bool_Vec_Ptr *&land_consumed() { return m_land_consumed; }
-  Bool_Vec_Ptr *&land_unconsumed() { return m_land_unconsumed; }
-  Fluent_Vec *&rp_vec() { return m_rp_fl_vec; }
-  Fluent_Set *&rp_set() { return m_rp_fl_set; }
+  Landmark_Delta *&land_delta() { return m_land_delta; }
+  Relevant_Fluents_Ptr &relevant_fluents() { return m_relevant_fluents; }
+  // Relevant fluents r(n) counts, from the closest ancestor with a relaxed plan
+  Relevant_Fluents_Ptr &rp_relevant() { return m_rp_relevant; }
+  Achieved_Fluents_Ptr &rp_achieved() { return m_rp_achieved; }
   bool &relaxed_deadend() { return m_relaxed_deadend; }
 
   // Used to update novelty table
@@ -126,30 +127,12 @@ public:
 
   void update_land_graph(Landmarks_Graph_Manager *lgm)
   {
-    Node_Vec_Ptr path(gn_unit() + 1);
-    Node_Vec_Ptr_Rit rit = path.rbegin();
-    Node_Ptr n = this;
-    do
-    {
-      *rit = n;
-      rit++;
-      n = n->parent();
-    } while (n);
-    if (rit != path.rend())
-      *rit = NULL;
-
-    lgm->reset_graph();
-    for (Node_Vec_Ptr_It it = path.begin(); it != path.end(); it++)
-    {
-      if (*it == NULL)
-        break;
-      lgm->update_graph((*it)->land_consumed(), (*it)->land_unconsumed());
-    }
+    lgm->move_to(this);
   }
 
   void undo_land_graph(Landmarks_Graph_Manager *lgm)
   {
-    lgm->undo_graph(land_consumed(), land_unconsumed());
+    lgm->undo_node(this);
   }
 
   void print(std::ostream &os) const
@@ -210,10 +193,10 @@ public:
   unsigned m_M;
 
   size_t m_hash;
-  Bool_Vec_Ptr *m_land_consumed;
-  Bool_Vec_Ptr *m_land_unconsumed;
-  Fluent_Vec *m_rp_fl_vec;
-  Fluent_Set *m_rp_fl_set;
+  Landmark_Delta *m_land_delta;
+  Relevant_Fluents_Ptr m_relevant_fluents;
+  Relevant_Fluents_Ptr m_rp_relevant;
+  Achieved_Fluents_Ptr m_rp_achieved;
 
   Fluent_Vec m_goals_achieved;
   Fluent_Vec m_goal_candidates;
@@ -316,27 +299,17 @@ public:
             return;
         }
 
+        Relevant_Fluents* rf = new Relevant_Fluents( this->problem().task().num_fluents() );
+
 #ifdef DEBUG        
         for ( unsigned p = 0; p < this->problem().task().num_fluents(); p++ ) {
             if (!m_rp_h->is_relaxed_plan_relevant(p)) continue;
-            n->rp_vec()->push_back( p );
-            n->rp_set()->set( p );
+            rf->vec.push_back( p );
+            rf->set.set( p );
         }
         
         std::cout << "rel_plan size: "<< rel_plan.size() << " "<<std::flush;
 #endif
-        /**
-         * Reserve space
-         */
-        if( !n->rp_vec() ){
-            n->rp_vec() = new Fluent_Vec;
-            n->rp_set() = new Fluent_Set( this->problem().task().num_fluents() );
-        }
-        else{
-            n->rp_vec()->clear();
-            n->rp_set()->reset();
-        }
-        
         for(std::vector<Action_Idx>::iterator it_a = rel_plan.begin(); 
             it_a != rel_plan.end(); it_a++ )
         {
@@ -347,9 +320,9 @@ public:
                 for( unsigned i = 0; i < a->ceff_vec().size(); i++ ){
                     Conditional_Effect* ce = a->ceff_vec()[i];
                     for ( auto p : ce->add_vec() ) {
-                        if ( ! n->rp_set()->isset( p ) ){
-                            n->rp_vec()->push_back( p );
-                            n->rp_set()->set( p );
+                        if ( ! rf->set.isset( p ) ){
+                            rf->vec.push_back( p );
+                            rf->set.set( p );
 #ifdef DEBUG
                             std::cout << this->problem().task().fluents()
                                 [add[i]]->signature() << std::endl;
@@ -367,10 +340,10 @@ public:
 #endif
             for ( unsigned i = 0; i < add.size(); i++ )
             {
-                if ( ! n->rp_set()->isset( add[i] ) )
+                if ( ! rf->set.isset( add[i] ) )
                 {
-                    n->rp_vec()->push_back( add[i] );
-                    n->rp_set()->set( add[i] );
+                    rf->vec.push_back( add[i] );
+                    rf->set.set( add[i] );
 #ifdef DEBUG
                     std::cout << this->problem().task().fluents()
                         [add[i]]->signature() << std::endl;
@@ -378,6 +351,8 @@ public:
                 }
             }
         }
+
+        n->relevant_fluents() = Relevant_Fluents_Ptr( rf );
     }
 
     virtual void    start( float B = infty) 
@@ -403,8 +378,10 @@ public:
         
         //if using the landmark manager to count goals or landmarks
         if(m_lgm){              
+            m_lgm->reset_graph();
             m_lgm->apply_state( m_root->state()->fluent_vec(), 
-                    m_root->land_consumed(), m_root->land_unconsumed() );
+                    m_root->land_delta() );
+            m_lgm->set_node( m_root );
 
             eval(m_root);
 
@@ -414,8 +391,6 @@ public:
             }
             if(m_use_novelty)
                 eval_novel( m_root );               
-                
-            m_root->undo_land_graph( m_lgm );
         }
         else{       
             eval(m_root);
@@ -462,21 +437,24 @@ public:
                 if( !candidate->has_state() && has_cond_eff ){
                     //  candidate->parent()->state()->progress_lazy_state(  m_problem.task().actions()[ candidate->action() ] );    
                      m_lgm->apply_action( candidate->parent()->state(), 
-                        candidate->action(), candidate->land_consumed(), 
-                        candidate->land_unconsumed() );
+                        candidate->action(), candidate->land_delta() );
                     //candidate->parent()->state()->regress_lazy_state( m_problem.task().actions()[ candidate->action() ] );
                 }else{
                     //update the counter with current state
                     m_lgm->apply_action( candidate->state(), candidate->action(), 
-                        candidate->land_consumed(), candidate->land_unconsumed() );
+                        candidate->land_delta() );
                 }
             }
             else //If it's the root node, just initialize the counter
                 m_lgm->apply_state( m_root->state()->fluent_vec(), 
-                        m_root->land_consumed(), m_root->land_unconsumed() );
+                        m_root->land_delta() );
         }
         //Count land/goal unachieved
         m_second_h->eval( *(candidate->state()), candidate->h2n());
+
+        //Leave the graph at the parent, candidates may still be pruned
+        if(m_lgm)
+            candidate->undo_land_graph( m_lgm );
         
         if(candidate->h2n() < m_max_h2n ){
             m_max_h2n = candidate->h2n();
@@ -513,43 +491,26 @@ public:
         }
     }
 
+    // r(n) follows from the parent, evaluated before n, and the fluents
+    // added by the action of n
     unsigned        rp_fl_achieved( Search_Node* n ){
-        unsigned count = 0;
-        static Fluent_Set counted( this->problem().task().num_fluents() );
-        Search_Node* n_start = n;
-        while( !n_start->rp_vec() ){
-            n_start = n_start->parent();
+        n->rp_achieved() = nullptr;
+        if( n->action() == no_op || n->relevant_fluents() ){
+            n->rp_relevant() = n->relevant_fluents();
+            return 0;
         }
 
-        while( n->action()!= no_op && n != n_start )
-        {
-            const Action* a = this->problem().task().actions()[ n->action() ];
-            //Add Conditional Effects
-            if( !a->ceff_vec().empty() ){       
-                for( unsigned i = 0; i < a->ceff_vec().size(); i++ ){
-                    Conditional_Effect* ce = a->ceff_vec()[i];
-                    for ( auto p : ce->add_vec() ) {
-                        if( n_start->rp_set()->isset( p ) && ! counted.isset(p) ){
-                            count++;
-                            counted.set( p );   
-                        }
-                    }
-                }
-            }
-            const Fluent_Vec& add = a->add_vec();
-                
-            //std::cout << this->problem().task().actions()[*it_a]->signature() << std::endl;
-            for ( unsigned i = 0; i < add.size(); i++ ){
-                const unsigned p = add[i];
-                if( n_start->rp_set()->isset( p ) && ! counted.isset(p) ){
-                    count++;
-                    counted.set( p );
-                }
-            }
-            n = n->parent();
+        Search_Node* parent = n->parent();
+        if( parent->relevant_fluents() )
+            n->rp_relevant() = parent->relevant_fluents();
+        else{
+            n->rp_relevant() = parent->rp_relevant();
+            n->rp_achieved() = parent->rp_achieved();
         }
-        counted.reset();
-        return count;                  
+
+        const Action* a = this->problem().task().actions()[ n->action() ];
+        n->rp_achieved() = achieve_fluents( n->rp_achieved(), *a, n->rp_relevant()->set );
+        return num_achieved( n->rp_achieved() );
     }
 
     void            eval_relevant_fluents( Search_Node* candidate ) {
@@ -196,7 +196,11 @@ namespace aptk
 
 				float t0() const { return m_t0; }
 
-				void close(Search_Node *n) { m_closed.put(n); }
+				void close(Search_Node *n)
+				{
+					m_closed.put(n);
+					pack_state(n->state());
+				}
 				Closed_List_Type &closed() { return m_closed; }
 				Closed_List_Type &open_hash() { return m_open_hash; }
 
@@ -227,6 +231,7 @@ namespace aptk
 
 						// MRJ: This solves the memory leak and updates children nodes
 						// incrementally
+						unpack_state(n2->state());
 						n2->m_parent = n->m_parent;
 						n2->gn() = n->gn();
 						n2->m_action = n->action();
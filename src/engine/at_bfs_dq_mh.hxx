@@ -31,6 +31,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <search_prob.hxx>
 #include <resources_control.hxx>
 #include <closed_list.hxx>
+#include <shared_incumbent.hxx>
 #include <hash_table.hxx>
 #include <open_list.hxx>
 #include <vector>
@@ -270,7 +271,7 @@ namespace aptk
 				AT_BFS_DQ_MH(const Search_Model &search_problem)
 						: m_problem(search_problem), m_primary_h(NULL),
 							m_exp_count(0), m_gen_count(0), m_pruned_B_count(0), m_dead_end_count(0), m_open_repl_count(0),
-							m_B(infty), m_time_budget(infty), m_po_joint_exp_left(100), m_po_1_exp_left(50), m_non_po_exp_left(1), m_po_joint_exp_max(100), m_po_1_exp_max(50), m_non_po_exp_max(1)
+							m_B(infty), m_time_budget(infty), m_wall_clock(false), m_po_joint_exp_left(100), m_po_1_exp_left(50), m_non_po_exp_left(1), m_po_joint_exp_max(100), m_po_1_exp_max(50), m_non_po_exp_max(1), m_incumbent(NULL)
 				{
 					m_primary_h = new Primary_Heuristic(search_problem);
 					m_secondary_h = new Secondary_Heuristic(search_problem);
@@ -319,12 +320,12 @@ namespace aptk
 				bool find_solution(float &cost, std::vector<Action_Idx> &plan)
 				{
 					cost = infty;
-					m_t0 = time_used();
+					m_t0 = now();
 					Search_Node *end = do_search();
 					if (end == NULL)
 						return false;
 					extract_plan(m_root, end, plan, cost);
-					float t2 = time_used();
+					float t2 = now();
 					m_time_budget -= (t2 - m_t0);
 					return true;
 				}
@@ -336,8 +337,17 @@ namespace aptk
 					m_non_po_exp_max = max_non_po_exp;
 				}
 
-				float bound() const { return m_B; }
+				// With a shared incumbent, the bound tightens as soon as any engine finds a cheaper plan
+				float bound() const { return m_incumbent ? std::min(m_B, m_incumbent->cost()) : m_B; }
 				void set_bound(float v) { m_B = v; }
+				void set_incumbent(const Shared_Incumbent *inc) { m_incumbent = inc; }
+				const Shared_Incumbent *incumbent() const { return m_incumbent; }
+				bool interrupted() const { return (now() - m_t0) > m_time_budget || (m_incumbent && m_incumbent->closed()); }
+
+				// Measure the budget in wall time, e.g. while other engines run on other threads
+				void set_wall_clock(bool v) { m_wall_clock = v; }
+				bool wall_clock() const { return m_wall_clock; }
+				double now() const { return m_wall_clock ? wall_time() : time_used(); }
 
 				void inc_gen() { m_gen_count++; }
 				unsigned generated() const { return m_gen_count; }
@@ -544,7 +554,7 @@ namespace aptk
 							set_bound(head->gn());
 							return head;
 						}
-						if ((time_used() - m_t0) > m_time_budget)
+						if ((now() - m_t0) > m_time_budget)
 							return NULL;
 
 						eval(head);
@@ -642,6 +652,7 @@ namespace aptk
 				unsigned m_open_repl_count;
 				float m_B;
 				float m_time_budget;
+				bool m_wall_clock;
 				float m_t0;
 				Search_Node *m_root;
 				unsigned m_po_joint_exp_left;
@@ -651,6 +662,7 @@ namespace aptk
 				unsigned m_po_1_exp_max;
 				unsigned m_non_po_exp_max;
 				std::list<Search_Node *> m_garbage;
+				const Shared_Incumbent *m_incumbent;
 			};
 
 		}
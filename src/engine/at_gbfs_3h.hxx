@@ -30,8 +30,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <search_prob.hxx>
 #include <resources_control.hxx>
 #include <closed_list.hxx>
+#include <shared_incumbent.hxx>
 #include <landmark_graph_manager.hxx>
 #include <vector>
+#include <list>
 #include <algorithm>
 #include <iostream>
 #include <hash_table.hxx>
@@ -50,6 +52,7 @@ namespace aptk
 			{
 			public:
 				typedef aptk::agnostic::Landmarks_Graph_Manager<Search_Model> Landmarks_Graph_Manager;
+				typedef aptk::agnostic::Landmark_Delta Landmark_Delta;
 
 				typedef State State_Type;
 				typedef Node<Search_Model, State> *Node_Ptr;
@@ -58,7 +61,7 @@ namespace aptk
 				typedef typename std::vector<Node<Search_Model, State> *>::iterator Node_Vec_Ptr_It;
 
 				Node(State *s, float cost, Action_Idx action, Node<Search_Model, State> *parent, int num_actions)
-						: m_state(s), m_parent(parent), m_action(action), m_g(0), m_g_unit(0), m_f(0), m_h1(0), m_h2(0), m_h3(0), m_partition(0), m_po(num_actions), m_seen(false), m_helpful(false), m_land_consumed(NULL), m_land_unconsumed(NULL)
+						: m_state(s), m_parent(parent), m_action(action), m_g(0), m_g_unit(0), m_f(0), m_h1(0), m_h2(0), m_h3(0), m_partition(0), m_po(num_actions), m_seen(false), m_helpful(false), m_land_delta(NULL)
 				{
 					m_g = (parent ? parent->m_g + cost : 0.0f);
 					m_g_unit = (parent ? parent->m_g_unit + 1.0f : 0.0f);
@@ -68,6 +71,8 @@ namespace aptk
 				{
 					if (m_state != NULL)
 						delete m_state;
+					if (m_land_delta != NULL)
+						delete m_land_delta;
 				}
 
 				unsigned &h1n() { return m_h1; }
@@ -100,8 +105,7 @@ namespace aptk
 				bool seen() const { return m_seen; }
 				void set_helpful() { m_helpful = true; }
 				bool is_helpful() { return m_helpful; }
-				Bool_Vec_Ptr *&land_consumed() { return m_land_consumed; }
-				Bool_Vec_Ptr *&land_unconsumed() { return m_land_unconsumed; }
+				Landmark_Delta *&land_delta() { return m_land_delta; }
 
 				bool is_better(Node *n) const
 				{
@@ -130,37 +134,12 @@ namespace aptk
 
 				void update_land_graph(Landmarks_Graph_Manager *lgm)
 				{
-					Node_Vec_Ptr path(gn_unit() + 1);
-					Node_Vec_Ptr_Rit rit = path.rbegin();
-					Node_Ptr n = this;
-
-					do
-					{
-						*rit = n;
-						rit++;
-						n = n->parent();
-					} while (n);
-					if (rit != path.rend())
-						*rit = NULL;
-					// std::cout << "Updating Land Graph up to: " << std::flush;
-
-					lgm->reset_graph();
-					for (Node_Vec_Ptr_It it = path.begin(); it != path.end(); it++)
-					{
-
-						if (*it == NULL)
-							break;
-						lgm->update_graph((*it)->land_consumed(), (*it)->land_unconsumed());
-						//	if( (*it)->action() != -1 && lgm->graph()->node(150)->is_consumed())
-						//	std::cout << lgm->problem().actions()[ (*it)->action() ]->signature() << std::flush;
-					}
-					// std::cout << std::endl;
-					// std::cout << std::endl;
+					lgm->move_to(this);
 				}
 
 				void undo_land_graph(Landmarks_Graph_Manager *lgm)
 				{
-					lgm->undo_graph(land_consumed(), land_unconsumed());
+					lgm->undo_node(this);
 				}
 
 				void print(std::ostream &os) const
@@ -217,8 +196,7 @@ namespace aptk
 				bool m_seen;
 				bool m_helpful;
 				size_t m_hash;
-				Bool_Vec_Ptr *m_land_consumed;
-				Bool_Vec_Ptr *m_land_unconsumed;
+				Landmark_Delta *m_land_delta;
 			};
 
 			template <typename Search_Model, typename First_Heuristic, typename Second_Heuristic, typename Third_Heuristic, typename Open_List_Type>
@@ -233,7 +211,7 @@ namespace aptk
 
 				AT_GBFS_3H(const Search_Model &search_problem)
 						: m_problem(search_problem), m_exp_count(0), m_gen_count(0), m_pruned_B_count(0),
-							m_dead_end_count(0), m_open_repl_count(0), m_B(infty), m_time_budget(infty), m_lgm(NULL), m_max_h2n(no_such_index), m_max_h3n(no_such_index), m_verbose(true)
+							m_dead_end_count(0), m_open_repl_count(0), m_B(infty), m_time_budget(infty), m_wall_clock(false), m_lgm(NULL), m_max_h2n(no_such_index), m_max_h3n(no_such_index), m_verbose(true), m_incumbent(NULL)
 				{
 					m_first_h = new First_Heuristic(search_problem);
 					m_second_h = new Second_Heuristic(search_problem);
@@ -254,6 +232,9 @@ namespace aptk
 						delete n;
 					}
 					m_closed.clear();
+					for (typename std::list<Search_Node *>::iterator it = m_garbage.begin();
+							 it != m_garbage.end(); it++)
+						delete *it;
 
 					delete m_first_h;
 					delete m_second_h;
@@ -270,9 +251,10 @@ namespace aptk
 					if (m_lgm)
 					{
 						eval_po(m_root);
-						m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_consumed(), m_root->land_unconsumed());
+						m_lgm->reset_graph();
+						m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_delta());
+						m_lgm->set_node(m_root);
 						eval(m_root);
-						m_root->undo_land_graph(m_lgm);
 					}
 					else
 					{
@@ -299,7 +281,7 @@ namespace aptk
 
 				bool find_solution(float &cost, std::vector<Action_Idx> &plan)
 				{
-					m_t0 = time_used();
+					m_t0 = now();
 					Search_Node *end = do_search();
 					if (end == NULL)
 						return false;
@@ -308,8 +290,17 @@ namespace aptk
 					return true;
 				}
 
-				float bound() const { return m_B; }
+				// With a shared incumbent, the bound tightens as soon as any engine finds a cheaper plan
+				float bound() const { return m_incumbent ? std::min(m_B, m_incumbent->cost()) : m_B; }
 				void set_bound(float v) { m_B = v; }
+				void set_incumbent(const Shared_Incumbent *inc) { m_incumbent = inc; }
+				const Shared_Incumbent *incumbent() const { return m_incumbent; }
+				bool interrupted() const { return (now() - m_t0) > m_time_budget || (m_incumbent && m_incumbent->closed()); }
+
+				// CPU time adds up over every thread, so engines running side by side measure their budget in wall time
+				void set_wall_clock(bool v) { m_wall_clock = v; }
+				bool wall_clock() const { return m_wall_clock; }
+				double now() const { return m_wall_clock ? wall_time() : time_used(); }
 
 				void inc_gen() { m_gen_count++; }
 				unsigned generated() const { return m_gen_count; }
@@ -360,24 +351,25 @@ namespace aptk
 							{
 								candidate->parent()->state()->progress_lazy_state(m_problem.task().actions()[candidate->action()]);
 
-								m_lgm->apply_action(candidate->parent()->state(), candidate->action(), candidate->land_consumed(), candidate->land_unconsumed());
+								m_lgm->apply_action(candidate->parent()->state(), candidate->action(), candidate->land_delta());
 
 								candidate->parent()->state()->regress_lazy_state(m_problem.task().actions()[candidate->action()]);
 							}
 							else
 							{
 
-								m_lgm->apply_action(candidate->state(), candidate->action(), candidate->land_consumed(), candidate->land_unconsumed());
+								m_lgm->apply_action(candidate->state(), candidate->action(), candidate->land_delta());
 							}
 						}
 						else
-							m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_consumed(), m_root->land_unconsumed());
+							m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_delta());
 					}
 
 					m_second_h->eval(*(candidate->state()), candidate->h2n());
 
-					// if(m_lgm)
-					// 	candidate->undo_land_graph( m_lgm );
+					// Leave the graph at the parent, candidates may still be pruned
+					if (m_lgm)
+						candidate->undo_land_graph(m_lgm);
 
 					candidate->goals_unachieved() = candidate->h2n();
 					candidate->partition() = candidate->goals_unachieved();
@@ -406,6 +398,9 @@ namespace aptk
 				void eval_po(Search_Node *candidate)
 				{
 					std::vector<Action_Idx> po;
+					// Lets h_add start from the parent's values when they are cached
+					if (candidate->parent() != NULL)
+						m_third_h->set_parent(candidate->parent()->state());
 					m_third_h->eval(*(candidate->state()), candidate->h3n(), po);
 					if (candidate->h3n() < m_max_h3n)
 					{
@@ -571,7 +566,7 @@ namespace aptk
 							set_bound(head->gn());
 							return head;
 						}
-						if ((time_used() - m_t0) > m_time_budget)
+						if (interrupted())
 							return NULL;
 						// MRJ: What if we don't compute h_add and keep using the parent's h_add value for non-helpful
 
@@ -581,7 +576,8 @@ namespace aptk
 							if (m_verbose)
 								std::cout << "Already in CLOSED" << std::endl;
 #endif
-							delete head;
+							// novelty tables may still point to the duplicate
+							m_garbage.push_back(head);
 							head = get_node();
 							continue;
 						}
@@ -645,6 +641,7 @@ namespace aptk
 				unsigned m_open_repl_count;
 				float m_B;
 				float m_time_budget;
+				bool m_wall_clock;
 				float m_t0;
 				Search_Node *m_root;
 				std::vector<Action_Idx> m_app_set;
@@ -652,6 +649,8 @@ namespace aptk
 				unsigned m_max_h2n;
 				unsigned m_max_h3n;
 				bool m_verbose;
+				const Shared_Incumbent *m_incumbent;
+				std::list<Search_Node *> m_garbage;
 			};
 
 		}
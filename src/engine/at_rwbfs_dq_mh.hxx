@@ -190,7 +190,7 @@ namespace aptk
 							std::cout << "New W value = " << m_W << std::endl;
 							return head;
 						}
-						float t = time_used();
+						float t = this->now();
 						if ((t - this->t0()) > this->time_budget())
 						{
 							return NULL;
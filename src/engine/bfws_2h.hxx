@@ -31,6 +31,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <search_prob.hxx>
 #include <resources_control.hxx>
 #include <closed_list.hxx>
+#include <delta_state_store.hxx>
+#include <relaxed_plan_cache.hxx>
+#include <achieved_fluents.hxx>
 #include <landmark_graph_manager.hxx>
 #include <vector>
 #include <algorithm>
@@ -51,6 +54,7 @@ namespace aptk
 			{
 			public:
 				typedef aptk::agnostic::Landmarks_Graph_Manager<Search_Model> Landmarks_Graph_Manager;
+				typedef aptk::agnostic::Landmark_Delta Landmark_Delta;
 
 				typedef State State_Type;
 				typedef Node<Search_Model, State> *Node_Ptr;
@@ -59,7 +63,7 @@ namespace aptk
 				typedef typename std::vector<Node<Search_Model, State> *>::iterator Node_Vec_Ptr_It;
 
 				Node(State *s, float cost, Action_Idx action, Node<Search_Model, State> *parent, int num_actions)
-						: m_state(s), m_parent(parent), m_action(action), m_g(0), m_g_unit(0), m_h1(0), m_h2(0), m_r(0), m_partition(0), m_M(0), m_land_consumed(NULL), m_land_unconsumed(NULL), m_rp_fl_vec(NULL), m_rp_fl_set(NULL), m_relaxed_deadend(false)
+						: m_state(s), m_parent(parent), m_action(action), m_g(0), m_g_unit(0), m_h1(0), m_h2(0), m_r(0), m_partition(0), m_M(0), m_land_delta(NULL), m_delta(NULL), m_relaxed_deadend(false)
 				{
 					m_g = (parent ? parent->m_g + cost : 0.0f);
 					m_g_unit = (parent ? parent->m_g_unit + 1 : 0);
@@ -70,10 +74,10 @@ namespace aptk
 				{
 					if (m_state != NULL)
 						delete m_state;
-					if (m_rp_fl_vec != NULL)
-						delete m_rp_fl_vec;
-					if (m_rp_fl_set != NULL)
-						delete m_rp_fl_set;
+					if (m_land_delta != NULL)
+						delete m_land_delta;
+					if (m_delta != NULL)
+						delete m_delta;
 				}
 
 				unsigned &h1n() { return m_h1; }
@@ -99,10 +103,14 @@ namespace aptk
 				void set_state(State *s) { m_state = s; }
 				bool has_state() const { return m_state != NULL; }
 				const State &state() const { return *m_state; }
-				Bool_Vec_Ptr *&land_consumed() { return m_land_consumed; }
-				Bool_Vec_Ptr *&land_unconsumed() { return m_land_unconsumed; }
-				Fluent_Vec *&rp_vec() { return m_rp_fl_vec; }
-				Fluent_Set *&rp_set() { return m_rp_fl_set; }
+				State_Delta *delta() const { return m_delta; }
+				void set_delta(State_Delta *d) { m_delta = d; }
+				Landmark_Delta *&land_delta() { return m_land_delta; }
+				// Shared with other nodes whose relaxed plan came from the cache
+				Relevant_Fluents_Ptr &relevant_fluents() { return m_relevant_fluents; }
+				// Relevant fluents r(n) counts, from the closest ancestor with a relaxed plan
+				Relevant_Fluents_Ptr &rp_relevant() { return m_rp_relevant; }
+				Achieved_Fluents_Ptr &rp_achieved() { return m_rp_achieved; }
 				bool &relaxed_deadend() { return m_relaxed_deadend; }
 
 				// Used to update novelty table
@@ -119,32 +127,12 @@ namespace aptk
 
 				void update_land_graph(Landmarks_Graph_Manager *lgm)
 				{
-					Node_Vec_Ptr path(gn_unit() + 1);
-					Node_Vec_Ptr_Rit rit = path.rbegin();
-					Node_Ptr n = this;
-
-					do
-					{
-						*rit = n;
-						rit++;
-						n = n->parent();
-					} while (n);
-					if (rit != path.rend())
-						*rit = NULL;
-
-					lgm->reset_graph();
-					for (Node_Vec_Ptr_It it = path.begin(); it != path.end(); it++)
-					{
-
-						if (*it == NULL)
-							break;
-						lgm->update_graph((*it)->land_consumed(), (*it)->land_unconsumed());
-					}
+					lgm->move_to(this);
 				}
 
 				void undo_land_graph(Landmarks_Graph_Manager *lgm)
 				{
-					lgm->undo_graph(land_consumed(), land_unconsumed());
+					lgm->undo_node(this);
 				}
 
 				void print(std::ostream &os) const
@@ -204,10 +192,11 @@ namespace aptk
 				unsigned m_M;
 
 				size_t m_hash;
-				Bool_Vec_Ptr *m_land_consumed;
-				Bool_Vec_Ptr *m_land_unconsumed;
-				Fluent_Vec *m_rp_fl_vec;
-				Fluent_Set *m_rp_fl_set;
+				Landmark_Delta *m_land_delta;
+				Relevant_Fluents_Ptr m_relevant_fluents;
+				Relevant_Fluents_Ptr m_rp_relevant;
+				Achieved_Fluents_Ptr m_rp_achieved;
+				State_Delta *m_delta;
 
 				Fluent_Vec m_goals_achieved;
 				Fluent_Vec m_goal_candidates;
@@ -233,9 +222,10 @@ namespace aptk
 				typedef typename Open_List_Type::Node_Type Search_Node;
 				typedef Closed_List<Search_Node> Closed_List_Type;
 				typedef aptk::agnostic::Landmarks_Graph_Manager<Search_Model> Landmarks_Graph_Manager;
+				typedef Delta_State_Store<Search_Node> Delta_Store;
 
 				BFWS_2H(const Search_Model &search_problem, bool verbose)
-						: m_problem(search_problem), m_expanded_count_by_novelty(nullptr), m_generated_count_by_novelty(nullptr), m_novelty_count_plan(nullptr), m_exp_count(0), m_gen_count(0), m_dead_end_count(0), m_open_repl_count(0), m_max_depth(infty), m_max_novelty(1), m_time_budget(infty), m_lgm(NULL), m_max_h2n(no_such_index), m_max_r(no_such_index), m_verbose(verbose), m_use_novelty(true), m_use_novelty_pruning(false), m_use_rp(true), m_use_rp_from_init_only(false)
+						: m_problem(search_problem), m_expanded_count_by_novelty(nullptr), m_generated_count_by_novelty(nullptr), m_novelty_count_plan(nullptr), m_exp_count(0), m_gen_count(0), m_dead_end_count(0), m_open_repl_count(0), m_max_depth(infty), m_max_novelty(1), m_time_budget(infty), m_lgm(NULL), m_max_h2n(no_such_index), m_max_r(no_such_index), m_verbose(verbose), m_use_novelty(true), m_use_novelty_pruning(false), m_use_rp(true), m_use_rp_from_init_only(false), m_delta_store(nullptr), m_relplan_cache(nullptr), m_goal_set_id(0)
 				{
 					m_first_h = new First_Heuristic(search_problem);
 					m_second_h = new Second_Heuristic(search_problem);
@@ -244,6 +234,8 @@ namespace aptk
 
 				virtual ~BFWS_2H()
 				{
+					if (m_delta_store != nullptr)
+						delete m_delta_store;
 					for (typename Closed_List_Type::iterator i = m_closed.begin();
 							 i != m_closed.end(); i++)
 					{
@@ -275,6 +267,18 @@ namespace aptk
 
 				void set_relplan(Search_Node *n, State *s)
 				{
+					if (m_relplan_cache != nullptr)
+					{
+						Relevant_Fluents_Ptr cached;
+						if (m_relplan_cache->find(*s, m_goal_set_id, cached))
+						{
+							if (cached == nullptr)
+								n->relaxed_deadend() = true;
+							else
+								n->relevant_fluents() = cached;
+							return;
+						}
+					}
 
 					std::vector<Action_Idx> po;
 					std::vector<Action_Idx> rel_plan;
@@ -286,34 +290,24 @@ namespace aptk
 					if (h == std::numeric_limits<unsigned>::max())
 					{ // rel_plan infty
 						n->relaxed_deadend() = true;
+						if (m_relplan_cache != nullptr)
+							m_relplan_cache->insert(*s, m_goal_set_id, nullptr);
 						return;
 					}
 
+					Relevant_Fluents *rf = new Relevant_Fluents(this->problem().task().num_fluents());
+
 #ifdef DEBUG
 					for (unsigned p = 0; p < this->problem().task().num_fluents(); p++)
 					{
 						if (!m_rp_h->is_relaxed_plan_relevant(p))
 							continue;
-						n->rp_vec()->push_back(p);
-						n->rp_set()->set(p);
+						rf->vec.push_back(p);
+						rf->set.set(p);
 					}
 
 					std::cout << "rel_plan size: " << rel_plan.size() << " " << std::flush;
 #endif
-					/**
-					 * Reserve space
-					 */
-					if (!n->rp_vec())
-					{
-						n->rp_vec() = new Fluent_Vec;
-						n->rp_set() = new Fluent_Set(this->problem().task().num_fluents());
-					}
-					else
-					{
-						n->rp_vec()->clear();
-						n->rp_set()->reset();
-					}
-
 					for (std::vector<Action_Idx>::iterator it_a = rel_plan.begin();
 							 it_a != rel_plan.end(); it_a++)
 					{
@@ -327,10 +321,10 @@ namespace aptk
 								Conditional_Effect *ce = a->ceff_vec()[i];
 								for (auto p : ce->add_vec())
 								{
-									if (!n->rp_set()->isset(p))
+									if (!rf->set.isset(p))
 									{
-										n->rp_vec()->push_back(p);
-										n->rp_set()->set(p);
+										rf->vec.push_back(p);
+										rf->set.set(p);
 #ifdef DEBUG
 										std::cout << this->problem().task().fluents()[add[i]]->signature() << std::endl;
 #endif
@@ -346,16 +340,20 @@ namespace aptk
 #endif
 						for (unsigned i = 0; i < add.size(); i++)
 						{
-							if (!n->rp_set()->isset(add[i]))
+							if (!rf->set.isset(add[i]))
 							{
-								n->rp_vec()->push_back(add[i]);
-								n->rp_set()->set(add[i]);
+								rf->vec.push_back(add[i]);
+								rf->set.set(add[i]);
 #ifdef DEBUG
 								std::cout << this->problem().task().fluents()[add[i]]->signature() << std::endl;
 #endif
 							}
 						}
 					}
+
+					n->relevant_fluents() = Relevant_Fluents_Ptr(rf);
+					if (m_relplan_cache != nullptr)
+						m_relplan_cache->insert(*s, m_goal_set_id, n->relevant_fluents());
 				}
 
 				virtual void start(float B = infty)
@@ -384,7 +382,9 @@ namespace aptk
 					// if using the landmark manager to count goals or landmarks
 					if (m_lgm)
 					{
-						m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_consumed(), m_root->land_unconsumed());
+						m_lgm->reset_graph();
+						m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_delta());
+						m_lgm->set_node(m_root);
 
 						eval(m_root);
 
@@ -395,8 +395,6 @@ namespace aptk
 						}
 						if (m_use_novelty)
 							eval_novel(m_root);
-
-						m_root->undo_land_graph(m_lgm);
 					}
 					else
 					{
@@ -447,23 +445,27 @@ namespace aptk
 							{
 								//	candidate->parent()->state()->progress_lazy_state(  m_problem.task().actions()[ candidate->action() ] );
 
-								m_lgm->apply_action(candidate->parent()->state(), candidate->action(), candidate->land_consumed(), candidate->land_unconsumed());
+								m_lgm->apply_action(candidate->parent()->state(), candidate->action(), candidate->land_delta());
 
 								// candidate->parent()->state()->regress_lazy_state( m_problem.task().actions()[ candidate->action() ] );
 							}
 							else
 							{
 								// update the counter with current state
-								m_lgm->apply_action(candidate->state(), candidate->action(), candidate->land_consumed(), candidate->land_unconsumed());
+								m_lgm->apply_action(candidate->state(), candidate->action(), candidate->land_delta());
 							}
 						}
 						else // If it's the root node, just initialize the counter
-							m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_consumed(), m_root->land_unconsumed());
+							m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_delta());
 					}
 
 					// Count land/goal unachieved
 					m_second_h->eval(*(candidate->state()), candidate->h2n());
 
+					// Leave the graph at the parent, candidates may still be pruned
+					if (m_lgm)
+						candidate->undo_land_graph(m_lgm);
+
 					if (candidate->h2n() < m_max_h2n)
 					{
 						m_max_h2n = candidate->h2n();
@@ -499,55 +501,29 @@ namespace aptk
 					}
 				}
 
+				// r(n) follows from the parent, evaluated before n, and the fluents
+				// added by the action of n
 				unsigned rp_fl_achieved(Search_Node *n)
 				{
-					unsigned count = 0;
-					static Fluent_Set counted(this->problem().task().num_fluents());
-					Search_Node *n_start = n;
-					while (!n_start->rp_vec())
+					n->rp_achieved() = nullptr;
+					if (n->action() == no_op || n->relevant_fluents())
 					{
-						n_start = n_start->parent();
+						n->rp_relevant() = n->relevant_fluents();
+						return 0;
 					}
 
-					while (n->action() != no_op && n != n_start)
+					Search_Node *parent = n->parent();
+					if (parent->relevant_fluents())
+						n->rp_relevant() = parent->relevant_fluents();
+					else
 					{
-
-						const Action *a = this->problem().task().actions()[n->action()];
-
-						// Add Conditional Effects
-						if (!a->ceff_vec().empty())
-						{
-							for (unsigned i = 0; i < a->ceff_vec().size(); i++)
-							{
-								Conditional_Effect *ce = a->ceff_vec()[i];
-								for (auto p : ce->add_vec())
-								{
-									if (n_start->rp_set()->isset(p) && !counted.isset(p))
-									{
-										count++;
-										counted.set(p);
-									}
-								}
-							}
-						}
-
-						const Fluent_Vec &add = a->add_vec();
-
-						// std::cout << this->problem().task().actions()[*it_a]->signature() << std::endl;
-						for (unsigned i = 0; i < add.size(); i++)
-						{
-							const unsigned p = add[i];
-							if (n_start->rp_set()->isset(p) && !counted.isset(p))
-							{
-								count++;
-								counted.set(p);
-							}
-						}
-
-						n = n->parent();
+						n->rp_relevant() = parent->rp_relevant();
+						n->rp_achieved() = parent->rp_achieved();
 					}
-					counted.reset();
-					return count;
+
+					const Action *a = this->problem().task().actions()[n->action()];
+					n->rp_achieved() = achieve_fluents(n->rp_achieved(), *a, n->rp_relevant()->set);
+					return num_achieved(n->rp_achieved());
 				}
 
 				void eval_relevant_fluents(Search_Node *candidate)
@@ -570,7 +546,7 @@ namespace aptk
 
 				bool is_closed(Search_Node *n)
 				{
-					Search_Node *n2 = this->closed().retrieve(n);
+					Search_Node *n2 = m_delta_store ? m_delta_store->retrieve(this->closed(), n) : this->closed().retrieve(n);
 
 					if (n2 != NULL)
 					{
@@ -582,7 +558,7 @@ namespace aptk
 						}
 						// Otherwise, we put it into Open and remove
 						// n2 from closed
-						this->closed().erase(this->closed().retrieve_iterator(n2));
+						this->closed().erase(m_delta_store ? m_delta_store->retrieve_iterator(this->closed(), n2) : this->closed().retrieve_iterator(n2));
 					}
 					return false;
 				}
@@ -725,7 +701,7 @@ namespace aptk
 
 						// Generate state
 						if (!head->has_state())
-							head->set_state(m_problem.next(*(head->parent()->state()), head->action()));
+							head->set_state(m_problem.next(*(parent_state(head)), head->action()));
 
 						if (m_problem.goal(*(head->state())))
 						{
@@ -748,6 +724,8 @@ namespace aptk
 						}
 						process(head);
 						close(head);
+						if (m_delta_store)
+							m_delta_store->store(head);
 						head = get_node();
 					}
 					return NULL;
@@ -786,6 +764,28 @@ namespace aptk
 				void set_use_novelty(bool v) { m_use_novelty = v; }
 				void set_use_novelty_pruning(bool v) { m_use_novelty_pruning = v; }
 
+				/**
+				 * Expanded nodes keep their state only every snapshot_interval
+				 * generations, and a delta against their parent otherwise
+				 */
+				void set_delta_states(unsigned snapshot_interval, unsigned cache_size = 64)
+				{
+					if (m_delta_store != nullptr)
+						delete m_delta_store;
+					m_delta_store = new Delta_Store(m_problem.task(), snapshot_interval, cache_size);
+				}
+
+				/**
+				 * Relaxed plans are looked up in, and added to, the given cache,
+				 * which is not owned and can be shared by the engines of
+				 * successive searches on the same task
+				 */
+				void set_relplan_cache(Relaxed_Plan_Cache *cache)
+				{
+					m_relplan_cache = cache;
+					m_goal_set_id = Relaxed_Plan_Cache::goal_set_id(m_problem.task().goal());
+				}
+
 				unsigned get_max_novelty_expanded()
 				{
 					for (int i = m_max_novelty + 1; i >= 0; i--)
@@ -851,7 +851,7 @@ namespace aptk
 					while (tmp != s)
 					{
 						m_novelty_count_plan[tmp->h1n() - 1]++;
-						cost += m_problem.cost(*(tmp->state()), tmp->action());
+						cost += m_problem.cost(*(m_delta_store ? m_delta_store->state(tmp) : tmp->state()), tmp->action());
 						plan.push_back(tmp->action());
 						tmp = tmp->parent();
 					}
@@ -859,6 +859,11 @@ namespace aptk
 					std::reverse(plan.begin(), plan.end());
 				}
 
+				State *parent_state(Search_Node *n)
+				{
+					return m_delta_store ? m_delta_store->state(n->parent()) : n->parent()->state();
+				}
+
 				void extract_path(Search_Node *s, Search_Node *t, std::vector<Search_Node *> &plan)
 				{
 					Search_Node *tmp = t;
@@ -906,6 +911,9 @@ namespace aptk
 				bool m_use_novelty_pruning;
 				bool m_use_rp;
 				bool m_use_rp_from_init_only;
+				Delta_Store *m_delta_store;
+				Relaxed_Plan_Cache *m_relplan_cache;
+				size_t m_goal_set_id;
 			};
 
 		}
@@ -50,6 +50,7 @@ namespace aptk
 			{
 			public:
 				typedef aptk::agnostic::Landmarks_Graph_Manager<Search_Model> Landmarks_Graph_Manager;
+				typedef aptk::agnostic::Landmark_Delta Landmark_Delta;
 
 				typedef State State_Type;
 				typedef Node<Search_Model, State> *Node_Ptr;
@@ -58,7 +59,7 @@ namespace aptk
 				typedef typename std::vector<Node<Search_Model, State> *>::iterator Node_Vec_Ptr_It;
 
 				Node(State *s, float cost, Action_Idx action, Node<Search_Model, State> *parent, int num_actions)
-						: m_state(s), m_parent(parent), m_action(action), m_g(0), m_g_unit(0), m_f(0), m_h1(0), m_h2(0), m_h3(0), m_h4(0), m_partition(0), m_partition2(0), m_seen(false), m_helpful(false), m_land_consumed(NULL), m_land_unconsumed(NULL)
+						: m_state(s), m_parent(parent), m_action(action), m_g(0), m_g_unit(0), m_f(0), m_h1(0), m_h2(0), m_h3(0), m_h4(0), m_partition(0), m_partition2(0), m_seen(false), m_helpful(false), m_land_delta(NULL)
 				{
 					m_g = (parent ? parent->m_g + cost : 0.0f);
 					m_g_unit = (parent ? parent->m_g_unit + 1.0f : 0.0f);
@@ -71,6 +72,8 @@ namespace aptk
 				{
 					if (m_state != NULL)
 						delete m_state;
+					if (m_land_delta != NULL)
+						delete m_land_delta;
 					if (m_po != NULL)
 						delete m_po;
 					if (m_po2 != NULL)
@@ -112,8 +115,7 @@ namespace aptk
 				bool seen() const { return m_seen; }
 				void set_helpful() { m_helpful = true; }
 				bool is_helpful() { return m_helpful; }
-				Bool_Vec_Ptr *&land_consumed() { return m_land_consumed; }
-				Bool_Vec_Ptr *&land_unconsumed() { return m_land_unconsumed; }
+				Landmark_Delta *&land_delta() { return m_land_delta; }
 
 				/**
 				 * Use as a reward the h that is not used to partitioning
@@ -173,37 +175,12 @@ namespace aptk
 
 				void update_land_graph(Landmarks_Graph_Manager *lgm)
 				{
-					Node_Vec_Ptr path(gn_unit() + 1);
-					Node_Vec_Ptr_Rit rit = path.rbegin();
-					Node_Ptr n = this;
-
-					do
-					{
-						*rit = n;
-						rit++;
-						n = n->parent();
-					} while (n);
-					if (rit != path.rend())
-						*rit = NULL;
-					// std::cout << "Updating Land Graph up to: " << std::flush;
-
-					lgm->reset_graph();
-					for (Node_Vec_Ptr_It it = path.begin(); it != path.end(); it++)
-					{
-
-						if (*it == NULL)
-							break;
-						lgm->update_graph((*it)->land_consumed(), (*it)->land_unconsumed());
-						//	if( (*it)->action() != -1 && lgm->graph()->node(150)->is_consumed())
-						//	std::cout << lgm->problem().actions()[ (*it)->action() ]->signature() << std::flush;
-					}
-					// std::cout << std::endl;
-					// std::cout << std::endl;
+					lgm->move_to(this);
 				}
 
 				void undo_land_graph(Landmarks_Graph_Manager *lgm)
 				{
-					lgm->undo_graph(land_consumed(), land_unconsumed());
+					lgm->undo_node(this);
 				}
 
 				void print(std::ostream &os) const
@@ -268,8 +245,7 @@ namespace aptk
 				bool m_seen;
 				bool m_helpful;
 				size_t m_hash;
-				Bool_Vec_Ptr *m_land_consumed;
-				Bool_Vec_Ptr *m_land_unconsumed;
+				Landmark_Delta *m_land_delta;
 			};
 
 			template <typename Search_Model, typename First_Heuristic, typename Second_Heuristic, typename Third_Heuristic, typename Fourth_Heuristic, typename Open_List_Type>
@@ -322,13 +298,13 @@ namespace aptk
 
 					if (m_lgm)
 					{
-						m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_consumed(), m_root->land_unconsumed());
+						m_lgm->reset_graph();
+						m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_delta());
+						m_lgm->set_node(m_root);
 						eval(m_root);
 						eval_po(m_root);
 						eval_novel(m_root);
 						eval_po_novel(m_root);
-
-						m_root->undo_land_graph(m_lgm);
 					}
 					else
 					{
@@ -436,18 +412,18 @@ namespace aptk
 							{
 								// candidate->parent()->state()->progress_lazy_state(  m_problem.task().actions()[ candidate->action() ] );
 
-								m_lgm->apply_action(candidate->parent()->state(), candidate->action(), candidate->land_consumed(), candidate->land_unconsumed());
+								m_lgm->apply_action(candidate->parent()->state(), candidate->action(), candidate->land_delta());
 
 								// candidate->parent()->state()->regress_lazy_state( m_problem.task().actions()[ candidate->action() ] );
 							}
 							else
 							{
 
-								m_lgm->apply_action(candidate->state(), candidate->action(), candidate->land_consumed(), candidate->land_unconsumed());
+								m_lgm->apply_action(candidate->state(), candidate->action(), candidate->land_delta());
 							}
 						}
 						else
-							m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_consumed(), m_root->land_unconsumed());
+							m_lgm->apply_state(m_root->state()->fluent_vec(), m_root->land_delta());
 					}
 
 					if (po)
@@ -459,8 +435,9 @@ namespace aptk
 					else
 						m_second_h->eval(*(candidate->state()), candidate->h2n());
 
-					// if(m_lgm)
-					// 	candidate->undo_land_graph( m_lgm );
+					// Leave the graph at the parent, candidates may still be pruned
+					if (m_lgm)
+						candidate->undo_land_graph(m_lgm);
 
 					if (candidate->h2n() < m_max_h2n)
 					{
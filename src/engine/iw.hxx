@@ -65,7 +65,11 @@ namespace aptk
 					delete m_novelty;
 				}
 
-				void set_verbose(bool v) { m_verbose = v; }
+				void set_verbose(bool v)
+				{
+					m_verbose = v;
+					BRFS<Search_Model>::set_verbose(v);
+				}
 				bool verbose() const { return m_verbose; }
 
 				void start(State *s = NULL)
@@ -101,6 +105,9 @@ namespace aptk
 					this->inc_gen();
 				}
 
+				// IW has no options besides its bound, see RP_IW::copy_options()
+				void copy_options(const IW &, const Fluent_Vec *, Fluent_Vec *) {}
+
 				float bound() const { return m_B; }
 				bool set_bound(float v)
 				{
@@ -0,0 +1,335 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __LIFTED_WIDTH__
+#define __LIFTED_WIDTH__
+
+#include <search_prob.hxx>
+#include <closed_list.hxx>
+#include <lifted_novelty.hxx>
+#include <queue>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+namespace aptk
+{
+
+	namespace search
+	{
+
+		/**
+		 * Width-based search over models that do not expose a grounded
+		 * STRIPS_Problem, like Lifted_Search_Problem: IW(k) and BFWS
+		 * guided by novelty and goal counting. Search_Model must provide
+		 * init(), goal(), goals_left(), applicable_set_v2(), next() and
+		 * cost(), and states fluent_vec(), hash() and operator==.
+		 */
+		namespace lifted
+		{
+
+			template <typename State>
+			class Node
+			{
+			public:
+				typedef State State_Type;
+
+				Node(State *s, Action_Idx action, Node<State> *parent = nullptr, float cost = 1.0f)
+						: m_state(s), m_parent(parent), m_action(action), m_g(parent ? parent->m_g + cost : 0.0f),
+							m_depth(parent ? parent->m_depth + 1 : 0), m_w(0), m_goals_left(0), m_order(0)
+				{
+				}
+
+				~Node() { delete m_state; }
+
+				State *state() { return m_state; }
+				const State *state() const { return m_state; }
+				Node<State> *parent() { return m_parent; }
+				Action_Idx action() const { return m_action; }
+				float gn() const { return m_g; }
+				unsigned depth() const { return m_depth; }
+				size_t hash() const { return m_state->hash(); }
+
+				bool operator==(const Node<State> &o) const { return *m_state == *o.m_state; }
+
+			public:
+				State *m_state;
+				Node<State> *m_parent;
+				Action_Idx m_action;
+				float m_g;
+				unsigned m_depth;
+				unsigned m_w;
+				unsigned m_goals_left;
+				unsigned long m_order;
+			};
+
+			// Bookkeeping shared by the engines: nodes, duplicates and plans
+			template <typename Search_Model>
+			class Width_Search
+			{
+			public:
+				typedef typename Search_Model::State_Type State;
+				typedef Node<State> Search_Node;
+				typedef Closed_List<Search_Node> Closed_List_Type;
+
+				Width_Search(const Search_Model &search_problem, unsigned bound)
+						: m_problem(search_problem), m_novelty(bound), m_B(bound), m_exp_count(0), m_gen_count(0),
+							m_pruned_B_count(0), m_root(nullptr), m_verbose(true)
+				{
+				}
+
+				virtual ~Width_Search() { reset(); }
+
+				void set_verbose(bool v) { m_verbose = v; }
+				bool verbose() const { return m_verbose; }
+
+				unsigned bound() const { return m_B; }
+				bool set_bound(unsigned b)
+				{
+					m_B = b;
+					return m_novelty.set_arity(b) == b;
+				}
+
+				unsigned expanded() const { return m_exp_count; }
+				unsigned generated() const { return m_gen_count; }
+				unsigned pruned_by_bound() const { return m_pruned_B_count; }
+
+				const Search_Model &problem() const { return m_problem; }
+
+				bool find_solution(float &cost, std::vector<Action_Idx> &plan)
+				{
+					Search_Node *end = do_search();
+					if (end == nullptr)
+						return false;
+					cost = 0.0f;
+					for (Search_Node *n = end; n != m_root; n = n->parent())
+					{
+						cost += m_problem.cost(*(n->parent()->state()), n->action());
+						plan.push_back(n->action());
+					}
+					std::reverse(plan.begin(), plan.end());
+					return true;
+				}
+
+			protected:
+				virtual Search_Node *do_search() = 0;
+
+				void reset()
+				{
+					for (auto &entry : m_seen)
+						delete entry.second;
+					m_seen.clear();
+					m_root = nullptr;
+					m_exp_count = m_gen_count = m_pruned_B_count = 0;
+					m_novelty.init();
+				}
+
+				Search_Node *make_root(State *s)
+				{
+					reset();
+					m_root = new Search_Node(s ? s : m_problem.init(), no_op, nullptr);
+					m_root->m_goals_left = m_problem.goals_left(*(m_root->state()));
+					m_seen.put(m_root);
+					m_gen_count++;
+					return m_root;
+				}
+
+				// Successors of head not seen before, nullptr for duplicates
+				Search_Node *generate(Search_Node *head, Action_Idx a)
+				{
+					State *succ = m_problem.next(*(head->state()), a);
+					Search_Node *n = new Search_Node(succ, a, head, m_problem.cost(*(head->state()), a));
+					if (m_seen.retrieve(n) != nullptr)
+					{
+						delete n;
+						return nullptr;
+					}
+					n->m_goals_left = m_problem.goals_left(*succ);
+					n->m_order = m_gen_count++;
+					m_seen.put(n);
+					return n;
+				}
+
+				void report_depth(Search_Node *n)
+				{
+					if (verbose() && n->depth() > m_max_depth)
+					{
+						m_max_depth = n->depth();
+						std::cout << "[" << m_max_depth << "]" << std::flush;
+					}
+				}
+
+			protected:
+				const Search_Model &m_problem;
+				agnostic::Lifted_Novelty m_novelty;
+				unsigned m_B;
+				unsigned m_exp_count;
+				unsigned m_gen_count;
+				unsigned m_pruned_B_count;
+				unsigned m_max_depth = 0;
+				// every node generated, open or closed
+				Closed_List_Type m_seen;
+				Search_Node *m_root;
+				std::vector<Action_Idx> m_app_set;
+				bool m_verbose;
+			};
+
+			// Breadth-first search pruning nodes of novelty above the bound
+			template <typename Search_Model>
+			class IW : public Width_Search<Search_Model>
+			{
+			public:
+				typedef typename Width_Search<Search_Model>::State State;
+				typedef typename Width_Search<Search_Model>::Search_Node Search_Node;
+
+				IW(const Search_Model &search_problem, unsigned bound = 1)
+						: Width_Search<Search_Model>(search_problem, bound)
+				{
+				}
+
+				void start(State *s = nullptr)
+				{
+					m_open = std::queue<Search_Node *>();
+					this->m_max_depth = 0;
+					Search_Node *root = this->make_root(s);
+					this->m_novelty.eval(root->state()->fluent_vec());
+					m_open.push(root);
+				}
+
+			protected:
+				virtual Search_Node *do_search()
+				{
+					if (m_open.empty())
+						return nullptr;
+					if (this->m_problem.goal(*(m_open.front()->state())))
+						return m_open.front();
+					while (!m_open.empty())
+					{
+						Search_Node *head = m_open.front();
+						m_open.pop();
+						this->m_problem.applicable_set_v2(*(head->state()), this->m_app_set);
+						this->m_exp_count++;
+						for (auto a : this->m_app_set)
+						{
+							Search_Node *n = this->generate(head, a);
+							if (n == nullptr)
+								continue;
+							if (this->m_novelty.eval(n->state()->fluent_vec()) > this->bound())
+							{
+								this->m_pruned_B_count++;
+								continue;
+							}
+							this->report_depth(n);
+							if (this->m_problem.goal(*(n->state())))
+								return n;
+							m_open.push(n);
+						}
+					}
+					return nullptr;
+				}
+
+			protected:
+				std::queue<Search_Node *> m_open;
+			};
+
+			/**
+			 * Greedy best-first search on <w_#g, #g>: the novelty of a
+			 * node among those with the same number of goals left, then
+			 * the goals left. Nodes of novelty above the bound are kept,
+			 * behind all others, so the search is complete.
+			 */
+			template <typename Search_Model>
+			class BFWS : public Width_Search<Search_Model>
+			{
+			public:
+				typedef typename Width_Search<Search_Model>::State State;
+				typedef typename Width_Search<Search_Model>::Search_Node Search_Node;
+
+				BFWS(const Search_Model &search_problem, unsigned bound = 2)
+						: Width_Search<Search_Model>(search_problem, bound)
+				{
+				}
+
+				void start(State *s = nullptr)
+				{
+					m_open = Open_List();
+					this->m_max_depth = 0;
+					Search_Node *root = this->make_root(s);
+					root->m_w = this->m_novelty.eval(root->state()->fluent_vec(), root->m_goals_left);
+					m_open.push(root);
+				}
+
+			protected:
+				struct Comparer
+				{
+					bool operator()(const Search_Node *a, const Search_Node *b) const
+					{
+						if (a->m_w != b->m_w)
+							return a->m_w > b->m_w;
+						if (a->m_goals_left != b->m_goals_left)
+							return a->m_goals_left > b->m_goals_left;
+						return a->m_order > b->m_order;
+					}
+				};
+				typedef std::priority_queue<Search_Node *, std::vector<Search_Node *>, Comparer> Open_List;
+
+				virtual Search_Node *do_search()
+				{
+					while (!m_open.empty())
+					{
+						Search_Node *head = m_open.top();
+						m_open.pop();
+						if (this->m_problem.goal(*(head->state())))
+							return head;
+						this->m_problem.applicable_set_v2(*(head->state()), this->m_app_set);
+						this->m_exp_count++;
+						for (auto a : this->m_app_set)
+						{
+							Search_Node *n = this->generate(head, a);
+							if (n == nullptr)
+								continue;
+							n->m_w = this->m_novelty.eval(n->state()->fluent_vec(), n->m_goals_left);
+							if (n->m_w > this->bound())
+								this->m_pruned_B_count++;
+							this->report_depth(n);
+							m_open.push(n);
+						}
+					}
+					return nullptr;
+				}
+
+			protected:
+				Open_List m_open;
+			};
+
+		}
+
+	}
+
+}
+
+#endif // lifted_width.hxx
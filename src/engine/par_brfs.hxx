@@ -0,0 +1,343 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef __PARALLEL_BREADTH_FIRST_SEARCH__
+#define __PARALLEL_BREADTH_FIRST_SEARCH__
+
+#include <search_prob.hxx>
+#include <resources_control.hxx>
+#include <concurrent_closed_list.hxx>
+#include <thread_pool.hxx>
+#include <brfs.hxx>
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <iostream>
+
+namespace aptk
+{
+
+	namespace search
+	{
+
+		namespace brfs
+		{
+
+			/**
+			 * Layer-synchronous breadth-first search.
+			 *
+			 * Each depth layer is expanded by a group of threads that take
+			 * frontier nodes in chunks. Every successor gets a key made of the
+			 * position of its parent in the frontier and its own position in the
+			 * applicable set, i.e. the order in which BRFS would generate it.
+			 * Duplicates are resolved in the concurrent closed list by keeping the
+			 * smallest key, so the next layer (and the plan returned) does not
+			 * depend on how the work was split among threads.
+			 */
+			template <typename Search_Model>
+			class Parallel_BRFS
+			{
+
+			public:
+				typedef typename Search_Model::State_Type State;
+				typedef Node<State> Search_Node;
+				typedef Concurrent_Closed_List<Search_Node> Closed_List_Type;
+
+				Parallel_BRFS(const Search_Model &search_problem, unsigned num_threads = 0)
+						: m_problem(search_problem), m_exp_count(0), m_gen_count(0), m_cl_count(0), m_max_depth(0),
+							m_root(NULL), m_num_threads(1), m_verbose(true), m_token(NULL)
+				{
+					set_num_threads(num_threads);
+				}
+
+				virtual ~Parallel_BRFS()
+				{
+					m_closed.clear(true);
+				}
+
+				void set_verbose(bool v) { m_verbose = v; }
+				bool verbose() const { return m_verbose; }
+
+				// 0 means one thread per hardware core
+				void set_num_threads(unsigned n)
+				{
+					if (n == 0)
+						n = std::thread::hardware_concurrency();
+					m_num_threads = n == 0 ? 1 : n;
+				}
+				unsigned num_threads() const { return m_num_threads; }
+
+				// The search gives up, returning no plan, at the first layer started after token is cancelled
+				void set_cancellation_token(const Cancellation_Token *token) { m_token = token; }
+
+				void reset()
+				{
+					m_closed.clear(true);
+					m_frontier.clear();
+					m_max_depth = 0;
+					m_root = NULL;
+				}
+
+				void start(State *s = NULL)
+				{
+					reset();
+
+					if (!s)
+						m_root = new Search_Node(m_problem.init(), no_op, NULL);
+					else
+						m_root = new Search_Node(s, no_op, NULL);
+
+					if (prune_root(m_root))
+					{
+						if (verbose())
+							std::cout << "Initial State pruned! No Solution found." << std::endl;
+						delete m_root;
+						m_root = NULL;
+						return;
+					}
+					m_closed.put(m_root);
+					m_frontier.push_back(m_root);
+					inc_gen();
+				}
+
+				virtual bool find_solution(float &cost, std::vector<Action_Idx> &plan)
+				{
+					Search_Node *end = do_search();
+					if (end == NULL)
+						return false;
+					extract_plan(m_root, end, plan, cost);
+
+					return true;
+				}
+
+				void inc_gen() { m_gen_count++; }
+				unsigned generated() const { return m_gen_count; }
+				void inc_exp() { m_exp_count++; }
+				unsigned expanded() const { return m_exp_count; }
+
+				void inc_closed() { m_cl_count++; }
+				unsigned pruned_closed() const { return m_cl_count; }
+
+				Closed_List_Type &closed() { return m_closed; }
+				const Search_Model &problem() const { return m_problem; }
+				bool search_exhausted() { return m_frontier.empty(); }
+
+				bool is_goal(Search_Node *n) { return m_problem.goal(*(n->state())); }
+
+				Search_Node *root() { return m_root; }
+				void extract_plan(Search_Node *s, Search_Node *t, std::vector<Action_Idx> &plan, float &cost, bool reverse = true)
+				{
+					Search_Node *tmp = t;
+					cost = 0.0f;
+					while (tmp != s)
+					{
+						cost += m_problem.cost(*(tmp->state()), tmp->action());
+						plan.push_back(tmp->action());
+						tmp = tmp->parent();
+					}
+
+					if (reverse)
+						std::reverse(plan.begin(), plan.end());
+				}
+
+			protected:
+				struct Successor
+				{
+					Search_Node *node;
+					uint64_t key;
+					std::vector<unsigned> tuples;
+					bool duplicate;
+					bool pruned;
+					bool goal;
+				};
+				typedef std::vector<Successor> Successor_Vec;
+
+				/**
+				 * Hooks for engines pruning successors (e.g. by novelty). All but
+				 * inc_pruned() are called concurrently from the worker threads,
+				 * each one in its own phase of the layer
+				 */
+				virtual bool prune_root(Search_Node * /* root */) { return false; }
+				virtual void evaluate(Successor & /* succ */) {}
+				virtual bool prune(Successor & /* succ */) { return false; }
+				virtual void release(Successor & /* succ */) {}
+				virtual void inc_pruned(Successor & /* succ */) {}
+
+				static uint64_t make_key(size_t parent_pos, size_t succ_pos)
+				{
+					return (((uint64_t)parent_pos << 32) | (uint64_t)succ_pos) + 1;
+				}
+
+				/**
+				 * Calls body(i) for every i in [0,n) on the shared pool, which hands
+				 * out indices in chunks so that expensive nodes do not stall the layer
+				 */
+				template <typename Body>
+				void parallel_for(size_t n, const Body &body)
+				{
+					Thread_Pool::global().parallel_for(0, n, body, 16, m_num_threads);
+				}
+
+				void generate(size_t i, Successor_Vec &succs)
+				{
+					Search_Node *head = m_frontier[i];
+					std::vector<Action_Idx> app_set;
+					m_problem.applicable_set_v2(*(head->state()), app_set);
+					succs.resize(app_set.size());
+					for (unsigned k = 0; k < app_set.size(); k++)
+					{
+						Action_Idx a = app_set[k];
+						Successor &succ = succs[k];
+						State *s = m_problem.next(*(head->state()), a);
+						succ.node = new Search_Node(s, a, head, m_problem.cost(*(head->state()), a));
+						succ.key = make_key(i, k);
+						succ.duplicate = succ.pruned = succ.goal = false;
+						m_closed.claim(succ.node, succ.key);
+					}
+				}
+
+				// Only the owner of a state is evaluated, as BRFS never looks past the closed list check
+				void resolve(Successor_Vec &succs)
+				{
+					for (auto &succ : succs)
+					{
+						if (m_closed.retrieve(succ.node) != succ.node)
+							succ.duplicate = true;
+						else
+							evaluate(succ);
+					}
+				}
+
+				void select(Successor_Vec &succs)
+				{
+					for (auto &succ : succs)
+					{
+						if (succ.duplicate)
+							continue;
+						if (prune(succ))
+						{
+							succ.pruned = true;
+							m_closed.erase(succ.node);
+							continue;
+						}
+						m_closed.settle(succ.node);
+						succ.goal = is_goal(succ.node);
+					}
+				}
+
+				Search_Node *expand_layer()
+				{
+					std::vector<Successor_Vec> layer(m_frontier.size());
+
+					parallel_for(m_frontier.size(), [&](size_t i)
+											 { generate(i, layer[i]); });
+					parallel_for(m_frontier.size(), [&](size_t i)
+											 { resolve(layer[i]); });
+					parallel_for(m_frontier.size(), [&](size_t i)
+											 { select(layer[i]); });
+					parallel_for(m_frontier.size(), [&](size_t i)
+											 { for (auto &succ : layer[i]) release(succ); });
+
+					Search_Node *goal = NULL;
+					std::vector<Search_Node *> next;
+					for (auto &succs : layer)
+					{
+						inc_exp();
+						for (auto &succ : succs)
+						{
+							if (succ.duplicate)
+							{
+								inc_closed();
+								delete succ.node;
+								continue;
+							}
+							if (succ.pruned)
+							{
+								inc_pruned(succ);
+								delete succ.node;
+								continue;
+							}
+							next.push_back(succ.node);
+							inc_gen();
+							if (succ.goal && goal == NULL)
+								goal = succ.node;
+						}
+					}
+					m_frontier.swap(next);
+
+					if (!m_frontier.empty())
+					{
+						m_max_depth++;
+						if (verbose())
+							std::cout << "[" << m_max_depth << "]" << std::flush;
+					}
+					return goal;
+				}
+
+				virtual Search_Node *do_search()
+				{
+					if (m_root == NULL)
+						return NULL;
+					if (is_goal(m_root))
+						return m_root;
+
+					while (!m_frontier.empty())
+					{
+						if (m_token && m_token->cancelled())
+							return NULL;
+						Search_Node *goal = expand_layer();
+						if (goal)
+							return goal;
+					}
+					return NULL;
+				}
+
+			protected:
+				const Search_Model &m_problem;
+				std::vector<Search_Node *> m_frontier;
+				Closed_List_Type m_closed;
+				unsigned m_exp_count;
+				unsigned m_gen_count;
+				unsigned m_cl_count;
+				unsigned m_max_depth;
+				Search_Node *m_root;
+				unsigned m_num_threads;
+				bool m_verbose;
+				const Cancellation_Token *m_token;
+			};
+
+		}
+
+	}
+
+}
+
+#endif // par_brfs.hxx
@@ -0,0 +1,141 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef __PARALLEL_ITERATIVE_WIDTH__
+#define __PARALLEL_ITERATIVE_WIDTH__
+
+#include <par_brfs.hxx>
+#include <concurrent_novelty.hxx>
+
+namespace aptk
+{
+
+	namespace search
+	{
+
+		namespace brfs
+		{
+
+			/**
+			 * IW(k) on top of the layer-synchronous BRFS, for k in {1,2}.
+			 * Successors are pruned through a novelty table shared by all the
+			 * threads of a layer, see Concurrent_Novelty for how ties between
+			 * successors of the same layer are broken.
+			 */
+			template <typename Search_Model>
+			class Parallel_IW : public Parallel_BRFS<Search_Model>
+			{
+
+			public:
+				typedef typename Search_Model::State_Type State;
+				typedef typename Parallel_BRFS<Search_Model>::Search_Node Search_Node;
+				typedef typename Parallel_BRFS<Search_Model>::Successor Successor;
+				typedef agnostic::Concurrent_Novelty<Search_Model> Novelty_Type;
+
+				Parallel_IW(const Search_Model &search_problem, unsigned num_threads = 0)
+						: Parallel_BRFS<Search_Model>(search_problem, num_threads), m_pruned_B_count(0), m_B(infty)
+				{
+					m_novelty = new Novelty_Type(search_problem);
+				}
+
+				virtual ~Parallel_IW()
+				{
+					delete m_novelty;
+				}
+
+				void start(State *s = NULL)
+				{
+					m_pruned_B_count = 0;
+					m_novelty->init();
+					Parallel_BRFS<Search_Model>::start(s);
+				}
+
+				float bound() const { return m_B; }
+				bool set_bound(float v)
+				{
+					m_B = v;
+					return (m_novelty->set_arity(m_B) == m_B);
+				}
+
+				float arity() { return m_novelty->arity(); }
+
+				void inc_pruned_bound() { m_pruned_B_count++; }
+				unsigned pruned_by_bound() const { return m_pruned_B_count; }
+
+			protected:
+				virtual bool prune_root(Search_Node *root)
+				{
+					Successor succ;
+					succ.node = root;
+					succ.key = 0;
+					m_novelty->tuples(*(root->state()), NULL, NULL, succ.tuples);
+					m_novelty->claim(succ.tuples, succ.key);
+					bool novel = m_novelty->holds_any(succ.tuples, succ.key);
+					if (novel)
+						m_novelty->cover(succ.tuples, succ.key);
+					m_novelty->release(succ.tuples);
+					if (!novel)
+						inc_pruned_bound();
+					return !novel;
+				}
+
+				virtual void evaluate(Successor &succ)
+				{
+					Search_Node *n = succ.node;
+					m_novelty->tuples(*(n->state()), n->parent()->state(), this->problem().task().actions()[n->action()], succ.tuples);
+					m_novelty->claim(succ.tuples, succ.key);
+				}
+
+				virtual bool prune(Successor &succ)
+				{
+					if (!m_novelty->holds_any(succ.tuples, succ.key))
+						return true;
+					m_novelty->cover(succ.tuples, succ.key);
+					return false;
+				}
+
+				virtual void release(Successor &succ)
+				{
+					m_novelty->release(succ.tuples);
+				}
+
+				virtual void inc_pruned(Successor & /* succ */) { inc_pruned_bound(); }
+
+			protected:
+				Novelty_Type *m_novelty;
+				unsigned m_pruned_B_count;
+				float m_B;
+			};
+
+		}
+
+	}
+
+}
+
+#endif // par_iw.hxx
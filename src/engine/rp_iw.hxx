@@ -31,6 +31,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <search_prob.hxx>
 #include <resources_control.hxx>
 #include <closed_list.hxx>
+#include <delta_state_store.hxx>
 #include <hash_table.hxx>
 #include <node_novelty_spaces.hxx>
 
@@ -56,15 +57,17 @@ namespace aptk
 				typedef typename Search_Model::State_Type State;
 				typedef Node<State> Search_Node;
 				typedef Closed_List<Search_Node> Closed_List_Type;
+				typedef Delta_State_Store<Search_Node> Delta_Store;
 
 				RP_IW(const Search_Model &search_problem)
-						: m_problem(search_problem), m_exp_count(0), m_gen_count(0), m_cl_count(0), m_max_depth(0), m_pruned_B_count(0), m_B(infty), m_use_relplan(true), m_goals(NULL), m_verbose(true), m_init_pruned(false)
+						: m_problem(search_problem), m_exp_count(0), m_gen_count(0), m_cl_count(0), m_max_depth(0), m_pruned_B_count(0), m_B(infty), m_use_relplan(true), m_goals(NULL), m_verbose(true), m_init_pruned(false), m_delta_store(nullptr)
 				{
 					m_novelty = new Abstract_Novelty(search_problem);
 					m_novelty->set_full_state_computation(false);
 					m_rp_h = new RP_Heuristic(search_problem);
 					m_rp_h->ignore_rp_h_value(true);
 					m_rp_fl_set.resize(this->problem().task().num_fluents());
+					m_counted.resize(this->problem().task().num_fluents());
 				}
 
 				bool init_pruned() { return m_init_pruned; }
@@ -73,6 +76,8 @@ namespace aptk
 
 				virtual ~RP_IW()
 				{
+					if (m_delta_store != nullptr)
+						delete m_delta_store;
 					for (typename Closed_List_Type::iterator i = m_closed.begin();
 							 i != m_closed.end(); i++)
 					{
@@ -95,6 +100,8 @@ namespace aptk
 
 				void reset()
 				{
+					if (m_delta_store != nullptr)
+						m_delta_store->clear();
 					for (typename Closed_List_Type::iterator i = m_closed.begin();
 							 i != m_closed.end(); i++)
 					{
@@ -122,6 +129,17 @@ namespace aptk
 
 				void set_goals(Fluent_Vec *g) { m_goals = g; }
 
+				/**
+				 * Expanded nodes keep their state only every snapshot_interval
+				 * generations, and a delta against their parent otherwise
+				 */
+				void set_delta_states(unsigned snapshot_interval, unsigned cache_size = 64)
+				{
+					if (m_delta_store != nullptr)
+						delete m_delta_store;
+					m_delta_store = new Delta_Store(m_problem.task(), snapshot_interval, cache_size);
+				}
+
 				void set_relplan(State *s)
 				{
 					std::vector<Action_Idx> po;
@@ -138,7 +156,8 @@ namespace aptk
 						m_rp_fl_set.set( p );
 					}
 					*/
-					std::cout << "rel_plan size: " << rel_plan.size() << std::endl;
+					if (verbose())
+						std::cout << "rel_plan size: " << rel_plan.size() << std::endl;
 
 					for (std::vector<Action_Idx>::iterator it_a = rel_plan.begin();
 							 it_a != rel_plan.end(); it_a++)
@@ -189,6 +208,25 @@ namespace aptk
 				}
 
 				void set_use_relplan(bool b) { m_use_relplan = b; }
+
+				/**
+				 * Takes the options other was set up with. If other computes its
+				 * relaxed plans for other_goals, this one computes them for goals
+				 */
+				void copy_options(const RP_IW &other, const Fluent_Vec *other_goals, Fluent_Vec *goals)
+				{
+					m_use_relplan = other.m_use_relplan;
+					m_goals = other.m_goals != NULL && other.m_goals == other_goals ? goals : other.m_goals;
+					if (other.m_delta_store == nullptr)
+					{
+						delete m_delta_store;
+						m_delta_store = nullptr;
+					}
+					else if (m_delta_store == nullptr ||
+									 m_delta_store->snapshot_interval() != other.m_delta_store->snapshot_interval() ||
+									 m_delta_store->cache_size() != other.m_delta_store->cache_size())
+						set_delta_states(other.m_delta_store->snapshot_interval(), other.m_delta_store->cache_size());
+				}
 				bool use_relplan() { return m_use_relplan; }
 
 				void start(State *s = NULL)
@@ -207,7 +245,8 @@ namespace aptk
 						set_relplan(this->m_root->state());
 
 					m_novelty->set_arity(m_B, m_rp_fl_vec.size());
-					std::cout << "#RP_fluents " << m_rp_fl_vec.size() << std::flush;
+					if (verbose())
+						std::cout << "#RP_fluents " << m_rp_fl_vec.size() << std::flush;
 
 					if (prune(this->m_root))
 					{
@@ -275,7 +314,7 @@ namespace aptk
 
 				bool is_closed(Search_Node *n)
 				{
-					Search_Node *n2 = this->closed().retrieve(n);
+					Search_Node *n2 = m_delta_store ? m_delta_store->retrieve(this->closed(), n) : this->closed().retrieve(n);
 					if (n2 != NULL)
 						return true;
 
@@ -305,7 +344,8 @@ namespace aptk
 					{
 						// if( m_max_depth == 0 ) std::cout << std::endl;
 						m_max_depth = n->gn() + 1;
-						std::cout << "[" << m_max_depth << "]" << std::flush;
+						if (verbose())
+							std::cout << "[" << m_max_depth << "]" << std::flush;
 					}
 				}
 				virtual Search_Node *do_search()
@@ -329,6 +369,8 @@ namespace aptk
 								goal->set_state(m_problem.next(*(goal->parent()->state()), goal->action()));
 							return goal;
 						}
+						if (m_delta_store)
+							m_delta_store->store(head);
 						counter++;
 						head = get_node();
 					}
@@ -352,7 +394,7 @@ namespace aptk
 					cost = 0.0f;
 					while (tmp != s)
 					{
-						cost += m_problem.cost(*(tmp->state()), tmp->action());
+						cost += m_problem.cost(*(m_delta_store ? m_delta_store->state(tmp) : tmp->state()), tmp->action());
 						plan.push_back(tmp->action());
 						tmp = tmp->parent();
 					}
@@ -377,7 +419,7 @@ namespace aptk
 				unsigned rp_fl_achieved(Search_Node *n)
 				{
 					unsigned count = 0;
-					static Fluent_Set counted(this->problem().task().num_fluents());
+					Fluent_Set &counted = m_counted;
 					while (n->action() != no_op)
 					{
 
@@ -529,12 +571,14 @@ namespace aptk
 				RP_Heuristic *m_rp_h;
 				Fluent_Vec m_rp_fl_vec;
 				Fluent_Set m_rp_fl_set;
+				Fluent_Set m_counted;
 				unsigned m_pruned_B_count;
 				float m_B;
 				bool m_use_relplan;
 				Fluent_Vec *m_goals;
 				bool m_verbose;
 				bool m_init_pruned;
+				Delta_Store *m_delta_store;
 			};
 
 		}
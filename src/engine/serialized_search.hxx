@@ -33,9 +33,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <closed_list.hxx>
 // #include <aptk/iw.hxx>
 #include <reachability.hxx>
+#include <thread_pool.hxx>
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <thread>
+#include <atomic>
 
 namespace aptk
 {
@@ -52,7 +55,8 @@ namespace aptk
 			typedef Closed_List<Search_Node> Closed_List_Type;
 
 			Serialized_Search(const Search_Model &search_problem)
-					: Search_Strategy(search_problem), m_consistency_test(true), m_closed_goal_states(NULL)
+					: Search_Strategy(search_problem), m_consistency_test(true), m_closed_goal_states(NULL), m_goal_states_read_only(false),
+						m_excluded(search_problem.num_actions()), m_num_threads(1), m_cancel(NULL), m_abort(NULL)
 			{
 				m_reachability = new aptk::agnostic::Reachability_Test(this->problem().task());
 			}
@@ -61,13 +65,38 @@ namespace aptk
 			{
 				delete m_reachability;
 				m_closed_goal_states = NULL;
+				for (auto w : m_workers)
+					delete w;
+			}
+
+			/**
+			 * With more than one thread, every call to do_search() runs one
+			 * subsearch per goal candidate concurrently (see speculate()).
+			 * 0 means one thread per hardware core.
+			 */
+			void set_num_threads(unsigned n)
+			{
+				if (n == 0)
+					n = std::thread::hardware_concurrency();
+				m_num_threads = n == 0 ? 1 : n;
+			}
+			unsigned num_threads() const { return m_num_threads; }
+
+			/**
+			 * Lets another thread stop the search: once the flag is raised,
+			 * subsearches stop expanding nodes and do_search() returns NULL
+			 */
+			void set_cancel_flag(const std::atomic<bool> *flag) { m_abort = flag; }
+			bool cancelled() const
+			{
+				return (m_cancel != NULL && m_cancel->load(std::memory_order_relaxed)) || (m_abort != NULL && m_abort->load(std::memory_order_relaxed));
 			}
 
 			void set_consistency_test(bool b) { m_consistency_test = b; }
 			void set_closed_goal_states(Closed_List_Type *c) { m_closed_goal_states = c; }
 			void close_goal_state(Search_Node *n)
 			{
-				if (closed_goal_states())
+				if (closed_goal_states() && !m_goal_states_read_only)
 				{
 					// m_closed_goal_states->put( n );
 					State *new_state = new State(this->problem().task());
@@ -170,8 +199,8 @@ namespace aptk
 			{
 
 				const bool has_state = n->has_state();
-				static Fluent_Vec added_fluents;
-				static Fluent_Vec deleted_fluents;
+				Fluent_Vec &added_fluents = m_added_fluents;
+				Fluent_Vec &deleted_fluents = m_deleted_fluents;
 
 				State *s = has_state ? n->state() : n->parent()->state();
 
@@ -210,7 +239,7 @@ namespace aptk
 							continue;
 						}
 
-						static Bit_Set excluded(this->problem().num_actions());
+						Bit_Set &excluded = m_excluded;
 						exclude_actions(excluded);
 
 #ifdef DEBUG
@@ -281,13 +310,164 @@ namespace aptk
 			Fluent_Vec &goal_candidates() { return m_goal_candidates; }
 			Fluent_Vec &goals_achieved() { return m_goals_achieved; }
 
+			virtual Search_Node *do_search()
+			{
+				if (m_num_threads > 1 && m_goal_candidates.size() > 1)
+					return speculate();
+				return Search_Strategy::do_search();
+			}
+
 		protected:
+			/**
+			 * A cancelled subsearch stops expanding nodes, so its open list
+			 * drains without generating anything new
+			 */
+			virtual Search_Node *process(Search_Node *head)
+			{
+				if (cancelled())
+					return NULL;
+				return Search_Strategy::process(head);
+			}
+
+			/**
+			 * Speculative serialization: each thread takes goal candidates in
+			 * turn and runs, from the current root, a subsearch with the same
+			 * bound that only accepts that candidate. The first subsearch
+			 * reaching its candidate consistently wins and cancels the rest. Its
+			 * subplan is replayed from m_root so the caller gets a node of this
+			 * search space, as it would from a sequential do_search(). Returns
+			 * NULL if no candidate is reached within the bound.
+			 *
+			 * Workers are set up like this search and prune the goal states it
+			 * has closed, but only read them: the winner's goal state is closed
+			 * here, once it is known.
+			 */
+			Search_Node *speculate()
+			{
+				unsigned num_workers = std::min<size_t>(m_num_threads, m_goal_candidates.size());
+				while (m_workers.size() < num_workers)
+				{
+					Serialized_Search *w = new Serialized_Search(this->problem());
+					w->set_verbose(false);
+					w->m_novelty->set_verbose(false);
+					w->m_cancel = &m_cancelled;
+					m_workers.push_back(w);
+				}
+				for (auto w : m_workers)
+				{
+					w->m_abort = m_abort;
+					w->copy_options(*this, &m_goal_candidates, &w->m_goal_candidates);
+					w->m_closed_goal_states = m_closed_goal_states;
+					w->m_goal_states_read_only = true;
+				}
+
+				std::atomic<unsigned> next(0);
+				std::atomic<int> winner(-1);
+				std::vector<Search_Node *> ends(num_workers, NULL);
+				std::vector<unsigned> pruned(num_workers, 0), expanded(num_workers, 0), generated(num_workers, 0);
+				m_cancelled.store(false);
+
+				// The fluents of the root are read here, as asking the shared
+				// root state for a vector it does not keep would build one
+				Fluent_Vec root_buffer;
+				const Fluent_Vec &root_fluents = this->m_root->state()->fluent_vec(root_buffer);
+
+				auto run = [&](unsigned t)
+				{
+					Serialized_Search *w = m_workers[t];
+					unsigned c;
+					while (!cancelled() && !m_cancelled.load() && (c = next.fetch_add(1)) < m_goal_candidates.size())
+					{
+						State *s = new State(this->problem().task());
+						s->set(root_fluents);
+						s->update_hash();
+
+						// counters of some strategies are cumulative across start()
+						unsigned exp_0 = w->expanded(), gen_0 = w->generated();
+						w->set_consistency_test(m_consistency_test);
+						w->m_goals_achieved = m_goals_achieved;
+						w->m_goal_candidates.assign(1, m_goal_candidates[c]);
+						w->set_bound(this->bound());
+						w->start(s);
+						// As in SIW+, a novelty table too large for memory is
+						// downgraded to arity 1, which is not a search with this bound
+						if (w->arity() != w->bound())
+							continue;
+
+						Search_Node *end = w->Search_Strategy::do_search();
+						pruned[t] += w->pruned_by_bound();
+						expanded[t] += w->expanded() - exp_0;
+						generated[t] += w->generated() - gen_0;
+
+						int none = -1;
+						if (end != NULL && winner.compare_exchange_strong(none, (int)t))
+						{
+							ends[t] = end;
+							m_cancelled.store(true);
+						}
+					}
+				};
+
+				Thread_Pool &pool = Thread_Pool::global();
+				std::vector<std::future<void>> tasks;
+				for (unsigned t = 1; t < num_workers; t++)
+					tasks.push_back(pool.submit([&run, t]()
+																			{ run(t); }));
+				run(0);
+				for (auto &task : tasks)
+					pool.wait(task);
+
+				for (unsigned t = 0; t < num_workers; t++)
+				{
+					this->m_pruned_B_count += pruned[t];
+					this->m_exp_count += expanded[t];
+					this->m_gen_count += generated[t];
+				}
+
+				if (winner.load() < 0)
+					return NULL;
+
+				Serialized_Search *w = m_workers[winner.load()];
+				std::vector<Action_Idx> sub_plan;
+				float sub_cost;
+				w->extract_plan(w->root(), ends[winner.load()], sub_plan, sub_cost);
+
+				Search_Node *n = this->m_root;
+				for (auto a : sub_plan)
+				{
+					Search_Node *succ = new Search_Node(this->problem().next(*(n->state()), a), a, n, this->problem().task().actions()[a]->cost());
+					this->close(succ);
+					n = succ;
+				}
+
+				Fluent_Vec unachieved;
+				for (auto g : m_goal_candidates)
+					if (std::find(w->m_goals_achieved.begin(), w->m_goals_achieved.end(), g) == w->m_goals_achieved.end())
+						unachieved.push_back(g);
+				m_goals_achieved = w->m_goals_achieved;
+				m_goal_candidates = unachieved;
+				close_goal_state(n);
+				return n;
+			}
+
 			aptk::agnostic::Reachability_Test *m_reachability;
 
 			Fluent_Vec m_goals_achieved;
 			Fluent_Vec m_goal_candidates;
 			bool m_consistency_test;
 			Closed_List_Type *m_closed_goal_states;
+			bool m_goal_states_read_only;
+
+			// scratch buffers of is_goal()
+			Fluent_Vec m_added_fluents;
+			Fluent_Vec m_deleted_fluents;
+			Bit_Set m_excluded;
+
+			unsigned m_num_threads;
+			std::vector<Serialized_Search *> m_workers;
+			std::atomic<bool> m_cancelled;
+			const std::atomic<bool> *m_cancel;
+			const std::atomic<bool> *m_abort;
 		};
 
 	}
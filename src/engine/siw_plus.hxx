@@ -106,6 +106,8 @@ namespace aptk
 
 						if (end == NULL)
 						{
+							if (this->cancelled())
+								return false;
 
 							/**
 							 * If no partial plan to achieve any goal is  found,
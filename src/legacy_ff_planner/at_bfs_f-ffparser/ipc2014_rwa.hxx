@@ -46,6 +46,7 @@ namespace aptk
 			public:
 				typedef Fibonacci_Open_List<Node> Open_List;
 				typedef State State_Type;
+				typedef aptk::agnostic::Landmark_Delta Landmark_Delta;
 
 				typedef Node<State> *Node_Ptr;
 				typedef typename std::list<Node<State> *> Node_Ptr_List;
@@ -54,7 +55,7 @@ namespace aptk
 
 				Node(State *s, float cost, Action_Idx action, Node<State> *parent, int num_actions)
 						: m_state(s), m_parent(parent), m_action(action), m_g(0), m_g_unit(0), m_po_1(num_actions), m_po_2(num_actions), m_seen(false),
-							current(nullptr), m_land_consumed(nullptr), m_land_unconsumed(nullptr)
+							current(nullptr), m_land_delta(nullptr)
 				{
 					m_g = (parent ? parent->m_g + cost : 0.0f);
 					m_g_unit = (parent ? parent->m_g_unit + 1.0f : 0.0f);
@@ -64,6 +65,8 @@ namespace aptk
 				{
 					if (m_state != NULL)
 						delete m_state;
+					if (m_land_delta != NULL)
+						delete m_land_delta;
 				}
 
 				float &h1n() { return m_h1; }
@@ -90,8 +93,7 @@ namespace aptk
 				void set_seen() { m_seen = true; }
 				bool seen() const { return m_seen; }
 
-				Bool_Vec_Ptr *&land_consumed() { return m_land_consumed; }
-				Bool_Vec_Ptr *&land_unconsumed() { return m_land_unconsumed; }
+				Landmark_Delta *&land_delta() { return m_land_delta; }
 
 				void print(std::ostream &os) const
 				{
@@ -102,35 +104,13 @@ namespace aptk
 				template <typename Landmarks_Graph_Manager>
 				void update_land_graph(Landmarks_Graph_Manager *lgm)
 				{
-
-					Node_Ptr_List path;
-					Node_Ptr n = this;
-					do
-					{
-						path.push_front(n);
-						n = n->parent();
-					} while (n);
-
-					// std::cout << "Updating Land Graph up to: " << path.size() << std::flush;
-
-					lgm->reset_graph();
-					for (Node_Ptr_List_It it = path.begin(); it != path.end(); it++)
-					{
-						if (*it == NULL)
-							break;
-
-						// if( (*it)->action() != -1)
-						//  std::cout << lgm->problem().actions()[ (*it)->action() ]->signature() << std::flush;
-
-						lgm->update_graph((*it)->land_consumed(), (*it)->land_unconsumed());
-					}
-					// std::cout << std::endl;
+					lgm->move_to( this );
 				}
 
 				template <typename Landmarks_Graph_Manager>
 				void undo_land_graph(Landmarks_Graph_Manager *lgm)
 				{
-					lgm->undo_graph(land_consumed(), land_unconsumed());
+					lgm->undo_node( this );
 				}
 
 				bool operator==(const Node<State> &o) const
@@ -209,8 +189,7 @@ namespace aptk
 				typename Open_List::Handle heap_handle;
 				Open_List *current;
 
-				Bool_Vec_Ptr *m_land_consumed;
-				Bool_Vec_Ptr *m_land_unconsumed;
+				Landmark_Delta *m_land_delta;
 			};
 		} // ipc2014
 
@@ -243,6 +222,7 @@ namespace aptk
 					this->set_bound(B);
 					this->set_root(new Search_Node(this->problem().init(), 0.0f, no_op, NULL, this->problem().num_actions()));
 					assert(m_lgm != nullptr);
+					m_lgm->reset_graph();
 					this->eval(this->root());
 					this->open().insert(this->root());
 					this->open_hash().put(this->root());
@@ -272,9 +252,9 @@ namespace aptk
 						candidate->parent()->update_land_graph(m_lgm);
 
 					if (candidate->action() != no_op)
-						m_lgm->apply_action(candidate->state(), candidate->action(), candidate->land_consumed(), candidate->land_unconsumed());
+						m_lgm->apply_action(candidate->state(), candidate->action(), candidate->land_delta());
 					else
-						m_lgm->apply_state(this->root()->state()->fluent_vec(), this->root()->land_consumed(), this->root()->land_unconsumed());
+						m_lgm->apply_state(this->root()->state()->fluent_vec(), this->root()->land_delta());
 
 					this->h2().eval(*(candidate->state()), candidate->h2n(), po);
 
@@ -286,7 +266,8 @@ namespace aptk
 						std::cout << "\t" << this->problem().task().actions()[ index ]->signature() << std::endl;
 					}
 					*/
-					// candidate->undo_land_graph( m_lgm );
+					// Leave the graph at the parent, candidates may still be pruned
+					candidate->undo_land_graph(m_lgm);
 				}
 
 				virtual Search_Node *do_search()
@@ -427,6 +408,7 @@ namespace aptk
 							{
 								n2->gn() = n->gn();
 								n2->gn_unit() = n->gn_unit();
+								m_lgm->reset_graph();
 								n2->m_parent = n->m_parent;
 								n2->m_action = n->action();
 							}
@@ -442,6 +424,7 @@ namespace aptk
 							{
 								n2->gn() = n->gn();
 								n2->gn_unit() = n->gn_unit();
+								m_lgm->reset_graph();
 								n2->m_parent = n->m_parent;
 								n2->m_action = n->action();
 								n2->set_seen();
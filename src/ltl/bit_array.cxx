@@ -46,6 +46,7 @@ namespace aptk
 	}
 
 	Bit_Array::Bit_Array(const Bit_Array &other)
+			: m_packs(nullptr)
 	{
 		m_pack_sz = 32;
 		m_n_packs = other.m_n_packs;
@@ -71,7 +72,7 @@ namespace aptk
 		m_pack_sz = sizeof(unsigned);
 		m_n_packs = other.m_n_packs;
 		if (m_packs != nullptr)
-			delete m_packs;
+			delete[] m_packs;
 		m_packs = other.m_packs;
 		m_max_idx = other.m_max_idx;
 		other.m_packs = nullptr;
@@ -83,7 +84,7 @@ namespace aptk
 		m_pack_sz = sizeof(unsigned);
 		m_n_packs = other.m_n_packs;
 		if (m_packs != nullptr)
-			delete m_packs;
+			delete[] m_packs;
 		m_packs = new unsigned[m_n_packs];
 		m_max_idx = other.m_max_idx;
 		memcpy(m_packs, other.m_packs, m_n_packs * sizeof(unsigned));
@@ -95,6 +96,8 @@ namespace aptk
 		m_max_idx = dim + 1;
 		unsigned nbits = (dim + 1);
 		m_n_packs = (nbits / 32) + 1;
+		if (m_packs != nullptr)
+			delete[] m_packs;
 		m_packs = new unsigned[m_n_packs];
 		memset(m_packs, 0, m_n_packs * sizeof(unsigned));
 	}
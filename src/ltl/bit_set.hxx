@@ -93,6 +93,7 @@ namespace aptk
 		iterator end() const { return iterator(*this, m_fset.max_index()); }
 
 		static int bits_in_word(unsigned w);
+		static uint32_t tail_mask(unsigned max_index);
 
 	protected:
 		Bit_Array m_fset;
@@ -146,36 +147,52 @@ namespace aptk
 		return m_fset;
 	}
 
+	// add() and set_intersection() work a pack at a time, so compilers can
+	// vectorize them. Bits of the last pack past max_index() are left alone,
+	// set_all() sets them too
+	inline uint32_t Bit_Set::tail_mask(unsigned max_index)
+	{
+		return (max_index % 32) ? (1u << (max_index % 32)) - 1 : ~0u;
+	}
+
 	inline void Bit_Set::add(const Bit_Set &other)
 	{
 		assert(m_fset.max_index() >= other.m_fset.max_index());
-		for (unsigned k = 0; k < other.bits().max_index(); k++)
-		{
-			if (other.isset(k))
-				m_fset.set(k);
-		}
+		unsigned np = (other.bits().max_index() + 31) / 32;
+		if (np == 0)
+			return;
+		uint32_t *packs = m_fset.packs();
+		const uint32_t *op = other.bits().packs();
+		for (unsigned i = 0; i + 1 < np; i++)
+			packs[i] |= op[i];
+		packs[np - 1] |= op[np - 1] & tail_mask(other.bits().max_index());
 	}
 
 	inline void Bit_Set::set_intersection(const Bit_Set &lhs, const Bit_Set &rhs)
 	{
 		assert(lhs.m_fset.max_index() == rhs.m_fset.max_index() && lhs.m_fset.max_index() == m_fset.max_index());
-		for (unsigned k = 0; k < lhs.bits().max_index(); k++)
-		{
-			if (lhs.m_fset[k] && rhs.m_fset[k])
-				m_fset.set(k);
-		}
+		unsigned np = (lhs.bits().max_index() + 31) / 32;
+		if (np == 0)
+			return;
+		uint32_t *packs = m_fset.packs();
+		const uint32_t *lp = lhs.bits().packs();
+		const uint32_t *rp = rhs.bits().packs();
+		for (unsigned i = 0; i + 1 < np; i++)
+			packs[i] |= lp[i] & rp[i];
+		packs[np - 1] |= lp[np - 1] & rp[np - 1] & tail_mask(lhs.bits().max_index());
 	}
 
 	inline void Bit_Set::set_intersection(const Bit_Set &other)
 	{
 		assert(m_fset.max_index() == other.m_fset.max_index());
-		for (unsigned k = 0; k < bits().max_index(); k++)
-		{
-			if (m_fset[k] && other.m_fset[k])
-				m_fset.set(k);
-			else if (m_fset[k] && !other.m_fset[k])
-				m_fset.unset(k);
-		}
+		unsigned np = (bits().max_index() + 31) / 32;
+		if (np == 0)
+			return;
+		uint32_t *packs = m_fset.packs();
+		const uint32_t *op = other.bits().packs();
+		for (unsigned i = 0; i + 1 < np; i++)
+			packs[i] &= op[i];
+		packs[np - 1] &= op[np - 1] | ~tail_mask(bits().max_index());
 	}
 
 	inline void Bit_Set::set_union(const Bit_Set &other)
@@ -0,0 +1,111 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __RADIX_HEAP__
+#define __RADIX_HEAP__
+
+#include <vector>
+#include <utility>
+#include <cassert>
+
+namespace aptk
+{
+
+	/**
+	 * Priority queue for unsigned keys that only works when keys are pushed
+	 * in a monotone way, i.e. never smaller than the last key popped, as in
+	 * Dijkstra's algorithm. Items are kept in buckets by the highest bit in
+	 * which their key differs from the last key popped, so push takes
+	 * constant time and pop amortized time logarithmic in the key range,
+	 * with no bound on the keys.
+	 */
+	template <typename T>
+	class Radix_Heap
+	{
+	public:
+		typedef std::pair<unsigned, T> Item;
+
+		Radix_Heap()
+				: m_buckets(33), m_last(0), m_size(0)
+		{
+		}
+
+		bool empty() const { return m_size == 0; }
+		size_t size() const { return m_size; }
+
+		void push(unsigned key, const T &value)
+		{
+			assert(key >= m_last);
+			m_buckets[bucket(key)].emplace_back(key, value);
+			m_size++;
+		}
+
+		// Removes an item with the smallest key
+		Item pop()
+		{
+			if (m_buckets[0].empty())
+			{
+				unsigned i = 1;
+				while (m_buckets[i].empty())
+					i++;
+				unsigned min_key = m_buckets[i][0].first;
+				for (const Item &it : m_buckets[i])
+					min_key = it.first < min_key ? it.first : min_key;
+				m_last = min_key;
+				for (const Item &it : m_buckets[i])
+					m_buckets[bucket(it.first)].push_back(it);
+				m_buckets[i].clear();
+			}
+			Item top = m_buckets[0].back();
+			m_buckets[0].pop_back();
+			m_size--;
+			return top;
+		}
+
+		void clear()
+		{
+			for (auto &b : m_buckets)
+				b.clear();
+			m_last = 0;
+			m_size = 0;
+		}
+
+	protected:
+		unsigned bucket(unsigned key) const
+		{
+			return key == m_last ? 0 : 32 - __builtin_clz(key ^ m_last);
+		}
+
+	protected:
+		std::vector<std::vector<Item>> m_buckets;
+		unsigned m_last;
+		size_t m_size;
+	};
+
+}
+
+#endif // radix_heap.hxx
@@ -36,6 +36,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <unistd.h>
 #include <iostream>
 #include <iomanip>
+#include <chrono>
 #include <resources_control.hxx>
 
 #ifdef WIN32
@@ -93,6 +94,13 @@ int aptk::getrusage(int who, struct rusage *rusage)
 }
 #endif
 
+static const std::chrono::steady_clock::time_point process_start = std::chrono::steady_clock::now();
+
+double aptk::wall_time()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - process_start).count();
+}
+
 double aptk::time_used()
 {
     struct rusage data;
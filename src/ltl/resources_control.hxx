@@ -53,6 +53,10 @@ namespace aptk
 
     double time_used();
 
+    // Seconds elapsed on a steady wall clock since the process started.
+    // Unlike time_used(), it does not add up the CPU time of every thread
+    double wall_time();
+
     template <typename Stream>
     void report_interval(double t0, double t1, Stream &os);
 
@@ -0,0 +1,144 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <thread_pool.hxx>
+
+namespace aptk
+{
+
+	namespace
+	{
+		// Pool and deque of the worker running on this thread, if any
+		thread_local Thread_Pool *tl_pool = nullptr;
+		thread_local unsigned tl_index = 0;
+	}
+
+	Thread_Pool::Thread_Pool(unsigned num_threads)
+			: m_pending(0), m_next_queue(0), m_stop(false)
+	{
+		if (num_threads == 0)
+			num_threads = std::thread::hardware_concurrency();
+		if (num_threads == 0)
+			num_threads = 1;
+
+		for (unsigned k = 0; k < num_threads; k++)
+			m_queues.emplace_back(new Task_Queue);
+		for (unsigned k = 0; k < num_threads; k++)
+			m_threads.emplace_back(&Thread_Pool::worker_loop, this, k);
+	}
+
+	Thread_Pool::~Thread_Pool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_sleep_lock);
+			m_stop.store(true);
+		}
+		m_wake.notify_all();
+		for (auto &t : m_threads)
+			t.join();
+	}
+
+	Thread_Pool &Thread_Pool::global()
+	{
+		static Thread_Pool pool;
+		return pool;
+	}
+
+	void Thread_Pool::push(Task t)
+	{
+		unsigned q = tl_pool == this ? tl_index : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+		{
+			std::lock_guard<std::mutex> guard(m_queues[q]->lock);
+			m_queues[q]->tasks.push_back(std::move(t));
+		}
+		m_pending.fetch_add(1);
+		{
+			// Taking the lock orders the push with a worker checking m_pending before going to sleep
+			std::lock_guard<std::mutex> guard(m_sleep_lock);
+		}
+		m_wake.notify_one();
+	}
+
+	bool Thread_Pool::pop(Task &t)
+	{
+		if (m_pending.load() == 0)
+			return false;
+
+		unsigned n = m_queues.size();
+		unsigned self = tl_pool == this ? tl_index : m_next_queue.load(std::memory_order_relaxed) % n;
+		{
+			Task_Queue &own = *m_queues[self];
+			std::lock_guard<std::mutex> guard(own.lock);
+			if (!own.tasks.empty())
+			{
+				t = std::move(own.tasks.back());
+				own.tasks.pop_back();
+				m_pending.fetch_sub(1);
+				return true;
+			}
+		}
+		for (unsigned k = 1; k < n; k++)
+		{
+			Task_Queue &victim = *m_queues[(self + k) % n];
+			std::lock_guard<std::mutex> guard(victim.lock);
+			if (!victim.tasks.empty())
+			{
+				t = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				m_pending.fetch_sub(1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool Thread_Pool::run_pending_task()
+	{
+		Task t;
+		if (!pop(t))
+			return false;
+		t();
+		return true;
+	}
+
+	void Thread_Pool::worker_loop(unsigned index)
+	{
+		tl_pool = this;
+		tl_index = index;
+		while (true)
+		{
+			if (run_pending_task())
+				continue;
+			std::unique_lock<std::mutex> lock(m_sleep_lock);
+			m_wake.wait(lock, [this]()
+									{ return m_stop.load() || m_pending.load() > 0; });
+			if (m_stop.load() && m_pending.load() == 0)
+				return;
+		}
+	}
+
+}
@@ -0,0 +1,256 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __THREAD_POOL__
+#define __THREAD_POOL__
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <algorithm>
+#include <cstdint>
+
+namespace aptk
+{
+
+	/**
+	 * Cooperative cancellation shared by the tasks of a computation. Tasks
+	 * poll cancelled() at points where stopping is safe; once the deadline
+	 * (if any) passes, the first poll raises the flag so later polls only
+	 * read an atomic.
+	 */
+	class Cancellation_Token
+	{
+	public:
+		Cancellation_Token()
+				: m_cancelled(false), m_deadline(0)
+		{
+		}
+
+		void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+
+		// Cancels the token once secs seconds of wall-clock time have passed
+		void set_deadline(double secs)
+		{
+			m_deadline.store(now() + (int64_t)(secs * 1e9), std::memory_order_relaxed);
+		}
+
+		bool cancelled() const
+		{
+			if (m_cancelled.load(std::memory_order_relaxed))
+				return true;
+			int64_t deadline = m_deadline.load(std::memory_order_relaxed);
+			if (deadline == 0 || now() < deadline)
+				return false;
+			m_cancelled.store(true, std::memory_order_relaxed);
+			return true;
+		}
+
+		// For components polling a plain flag, it is raised by cancel() or by the first poll past the deadline
+		const std::atomic<bool> *flag() const { return &m_cancelled; }
+
+	protected:
+		static int64_t now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		mutable std::atomic<bool> m_cancelled;
+		std::atomic<int64_t> m_deadline;
+	};
+
+	/**
+	 * Work-stealing thread pool.
+	 *
+	 * Every worker owns a deque: it pushes and pops tasks at the back and,
+	 * when its deque is empty, steals from the front of the others. Tasks
+	 * submitted from outside the pool are spread over the deques round
+	 * robin. Threads waiting on the pool (parallel_for(), wait()) run
+	 * pending tasks meanwhile, so tasks can submit and wait on other tasks
+	 * without deadlocking it.
+	 *
+	 * global() is the pool shared by engines and preprocessing, with one
+	 * worker per hardware core.
+	 */
+	class Thread_Pool
+	{
+	public:
+		typedef std::function<void()> Task;
+
+		// 0 means one worker per hardware core
+		explicit Thread_Pool(unsigned num_threads = 0);
+		~Thread_Pool();
+
+		Thread_Pool(const Thread_Pool &) = delete;
+		Thread_Pool &operator=(const Thread_Pool &) = delete;
+
+		static Thread_Pool &global();
+
+		unsigned num_threads() const { return m_threads.size(); }
+
+		/**
+		 * Queues f() and returns a future for its result. Exceptions thrown
+		 * by f() are rethrown by the future
+		 */
+		template <typename F>
+		auto submit(F &&f) -> std::future<decltype(f())>
+		{
+			typedef decltype(f()) Result;
+			auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+			std::future<Result> result = task->get_future();
+			push([task]()
+					 { (*task)(); });
+			return result;
+		}
+
+		/**
+		 * Waits for a future of this pool and returns its value, running
+		 * pending tasks in the meantime
+		 */
+		template <typename T>
+		T wait(std::future<T> &f)
+		{
+			while (f.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				if (!run_pending_task())
+					std::this_thread::yield();
+			}
+			return f.get();
+		}
+
+		/**
+		 * Calls body(i) for every i in [begin,end). Indices are handed out in
+		 * chunks of grain off a shared counter, to the calling thread and up
+		 * to max_threads - 1 workers (0 means all of them). When token is
+		 * given and gets cancelled, no further chunks are started. The first
+		 * exception thrown by body is rethrown once the loop has stopped.
+		 */
+		template <typename Body>
+		void parallel_for(size_t begin, size_t end, const Body &body, size_t grain = 1, unsigned max_threads = 0, const Cancellation_Token *token = nullptr)
+		{
+			if (end <= begin)
+				return;
+			grain = std::max<size_t>(grain, 1);
+			size_t chunks = (end - begin + grain - 1) / grain;
+			if (max_threads == 0 || max_threads > num_threads() + 1)
+				max_threads = num_threads() + 1;
+			size_t helpers = std::min<size_t>(max_threads - 1, chunks - 1);
+
+			// Helpers may start after the loop is over, the state they touch must outlive the call
+			auto loop = std::make_shared<Loop_State>(chunks);
+			auto run = [loop, &body, begin, end, grain, token]()
+			{
+				size_t c;
+				while ((c = loop->next.fetch_add(1)) < loop->chunks)
+				{
+					if (!loop->failed.load(std::memory_order_relaxed) && !(token && token->cancelled()))
+					{
+						try
+						{
+							size_t last = std::min(begin + (c + 1) * grain, end);
+							for (size_t i = begin + c * grain; i < last; i++)
+								body(i);
+						}
+						catch (...)
+						{
+							loop->fail(std::current_exception());
+						}
+					}
+					loop->done.fetch_add(1, std::memory_order_release);
+				}
+			};
+
+			for (size_t k = 0; k < helpers; k++)
+				push(run);
+			run();
+			while (loop->done.load(std::memory_order_acquire) < chunks)
+			{
+				if (!run_pending_task())
+					std::this_thread::yield();
+			}
+			if (loop->error)
+				std::rethrow_exception(loop->error);
+		}
+
+		/**
+		 * Runs one queued task on the calling thread, returns false if there
+		 * was none
+		 */
+		bool run_pending_task();
+
+	protected:
+		struct Task_Queue
+		{
+			std::mutex lock;
+			std::deque<Task> tasks;
+		};
+
+		struct Loop_State
+		{
+			Loop_State(size_t n)
+					: chunks(n), next(0), done(0), failed(false)
+			{
+			}
+
+			void fail(std::exception_ptr e)
+			{
+				bool expected = false;
+				if (failed.compare_exchange_strong(expected, true))
+					error = e;
+			}
+
+			size_t chunks;
+			std::atomic<size_t> next;
+			std::atomic<size_t> done;
+			std::atomic<bool> failed;
+			std::exception_ptr error;
+		};
+
+		void push(Task t);
+		bool pop(Task &t);
+		void worker_loop(unsigned index);
+
+		std::vector<std::unique_ptr<Task_Queue>> m_queues;
+		std::vector<std::thread> m_threads;
+		std::atomic<size_t> m_pending;
+		std::atomic<unsigned> m_next_queue;
+		std::atomic<bool> m_stop;
+		std::mutex m_sleep_lock;
+		std::condition_variable m_wake;
+	};
+
+}
+
+#endif // thread_pool.hxx
@@ -26,12 +26,14 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include <action.hxx>
+#include <algorithm>
 #include <iostream>
 namespace aptk
 {
 
 	Action::Action(STRIPS_Problem &p, bool flag_tarski)
-			: m_cost(1), m_active(true)
+			: m_signatures(&p.action_signatures()), m_signature(no_such_index),
+				m_cost(1), m_active(true)
 	{
 		if (!flag_tarski)
 		{
@@ -76,6 +78,44 @@ namespace aptk
 		}
 	}
 
+	void Action::remap_fluents(const Index_Vec &new_index, unsigned num_fluents)
+	{
+		remap_fluent_list(new_index, num_fluents, prec_vec(), prec_set());
+		remap_fluent_list(new_index, num_fluents, add_vec(), add_set());
+		remap_fluent_list(new_index, num_fluents, del_vec(), del_set());
+		remap_fluent_list(new_index, num_fluents, edel_vec(), edel_set());
+		m_prec_varval.clear();
+		for (auto p : prec_vec())
+			m_prec_varval.push_back(std::make_pair(p, 0));
+		for (auto ceff : ceff_vec())
+			ceff->remap_fluents(new_index, num_fluents);
+	}
+
+	void Action::compile_ceffs()
+	{
+		m_ceff_offsets.assign(1, 0);
+		m_ceff_words.clear();
+		m_ceff_masks.clear();
+		Fluent_Vec cond;
+		for (auto ceff : ceff_vec())
+		{
+			// Sorted, the fluents of the same word are next to each other
+			cond = ceff->prec_vec();
+			std::sort(cond.begin(), cond.end());
+			for (auto p : cond)
+			{
+				unsigned w = p / 32;
+				if (m_ceff_words.size() == m_ceff_offsets.back() || m_ceff_words.back() != w)
+				{
+					m_ceff_words.push_back(w);
+					m_ceff_masks.push_back(0);
+				}
+				m_ceff_masks.back() |= 1u << (p % 32);
+			}
+			m_ceff_offsets.push_back(m_ceff_words.size());
+		}
+	}
+
 	void Action::print(const STRIPS_Problem &prob, std::ostream &os) const
 	{
 
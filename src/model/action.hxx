@@ -64,15 +64,27 @@ namespace aptk
 		const Conditional_Effect_Vec &ceff_vec() const { return m_cond_effects; }
 
 		bool has_ceff() const { return !m_cond_effects.empty(); }
+
+		// Compiles the conditions of the conditional effects into masks over
+		// the words of a fluent bitset, so that progression tests each effect
+		// once per application with a few word comparisons. Called when the
+		// action is registered in the problem's action tables
+		void compile_ceffs();
+		bool ceffs_compiled() const { return m_ceff_offsets.size() == m_cond_effects.size() + 1; }
+		// Whether the condition of the i-th conditional effect holds on the
+		// bitset whose words are packs
+		bool ceff_holds(unsigned i, const uint32_t *packs) const;
 		/* Added for match trees */
 		VarVal_Vec &prec_varval() { return m_prec_varval; }
 		const VarVal_Vec &prec_varval() const { return m_prec_varval; }
 
-		std::string signature() const { return m_signature; }
-		void set_signature(std::string sig) { m_signature = sig; }
+		// Signatures live in the problem's Signature_Table and are rendered
+		// on demand
+		std::string signature() const { return m_signature == no_such_index ? std::string() : m_signatures->str(m_signature); }
+		void set_signature(std::string sig) { m_signature = m_signatures->add(sig); }
 
-		std::string name() const { return m_name; }
-		void set_name(std::string nam) { m_name = nam; }
+		// Name of the action schema, the first symbol of the signature
+		std::string name() const { return m_signature == no_such_index ? std::string() : std::string(m_signatures->head(m_signature)); }
 
 		unsigned index() const { return m_index; }
 		void set_index(unsigned idx) { m_index = idx; }
@@ -102,6 +114,10 @@ namespace aptk
 
 		void print(const STRIPS_Problem &prob, std::ostream &) const;
 
+		// Renumbers fluents, and those of the conditional effects, after
+		// STRIPS_Problem drops some of them
+		void remap_fluents(const Index_Vec &new_index, unsigned num_fluents);
+
 		static bool are_effect_interfering(const Action &a1, const Action &a2);
 		static bool deletes_precondition_of(const Action &a1, const Action &a2);
 		static bool deletes_precondition_of(const Action &a1, const Action &a2, Fluent_Vec &deleted);
@@ -110,8 +126,8 @@ namespace aptk
 
 	protected:
 		// Preconditions and Effects ( Adds and Deletes)
-		std::string m_signature;
-		std::string m_name;
+		Signature_Table *m_signatures;
+		unsigned m_signature;
 		Fluent_Vec m_prec_vec;
 		Fluent_Set m_prec_set;
 		Fluent_Vec m_add_vec;
@@ -122,6 +138,11 @@ namespace aptk
 		Fluent_Set m_edel_set;
 		VarVal_Vec m_prec_varval;
 		Conditional_Effect_Vec m_cond_effects;
+		// Condition of the i-th conditional effect: the words m_ceff_words[k]
+		// cover m_ceff_masks[k] for every k in [m_ceff_offsets[i], m_ceff_offsets[i+1])
+		Index_Vec m_ceff_offsets;
+		Index_Vec m_ceff_words;
+		std::vector<uint32_t> m_ceff_masks;
 		float m_cost;
 		unsigned m_index;
 		bool m_active;
@@ -217,6 +238,16 @@ namespace aptk
 		return true;
 	}
 
+	// Written without early exits so that the comparisons vectorize,
+	// conditions span a handful of words
+	inline bool Action::ceff_holds(unsigned i, const uint32_t *packs) const
+	{
+		uint32_t missing = 0;
+		for (unsigned k = m_ceff_offsets[i]; k < m_ceff_offsets[i + 1]; k++)
+			missing |= m_ceff_masks[k] & ~packs[m_ceff_words[k]];
+		return missing == 0;
+	}
+
 	inline bool Action::can_be_applied_on(const State &s) const
 	{
 		return s.entails(prec_vec());
@@ -63,4 +63,26 @@ namespace aptk
 		}
 	}
 
+	void Conditional_Effect::remap_fluents(const Index_Vec &new_index, unsigned num_fluents)
+	{
+		remap_fluent_list(new_index, num_fluents, prec_vec(), prec_set());
+		remap_fluent_list(new_index, num_fluents, add_vec(), add_set());
+		remap_fluent_list(new_index, num_fluents, del_vec(), del_set());
+	}
+
+	void remap_fluent_list(const Index_Vec &new_index, unsigned num_fluents, Fluent_Vec &list, Fluent_Set &set)
+	{
+		unsigned n = 0;
+		for (unsigned k = 0; k < list.size(); k++)
+			if (new_index[list[k]] != no_such_index)
+				list[n++] = new_index[list[k]];
+		list.resize(n);
+		// Tarski front end leaves the sets empty
+		if (set.bits().npacks() == 0)
+			return;
+		set = Fluent_Set(num_fluents);
+		for (auto f : list)
+			set.set(f);
+	}
+
 }
@@ -67,6 +67,9 @@ namespace aptk
 
 		bool can_be_applied_on(const State &s, bool regress = false) const;
 
+		// Renumbers fluents after STRIPS_Problem drops some of them
+		void remap_fluents(const Index_Vec &new_index, unsigned num_fluents);
+
 		bool active() const { return m_active; }
 		void activate() { m_active = true; }
 		void deactivate() { m_active = false; }
@@ -81,6 +84,10 @@ namespace aptk
 		bool m_active;
 	};
 
+	// Renames the fluents in list as given by new_index, dropping those mapped
+	// to no_such_index, and rebuilds set over num_fluents unless it is unused
+	void remap_fluent_list(const Index_Vec &new_index, unsigned num_fluents, Fluent_Vec &list, Fluent_Set &set);
+
 	inline bool Conditional_Effect::requires(unsigned f) const
 	{
 		return prec_set().isset(f);
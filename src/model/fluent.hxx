@@ -53,7 +53,8 @@ namespace aptk
 	protected:
 		STRIPS_Problem &m_problem;
 		unsigned m_index;
-		std::string m_signature;
+		// Entry in the problem's fluent Signature_Table
+		unsigned m_signature;
 	};
 
 	inline unsigned Fluent::index() const
@@ -63,7 +64,9 @@ namespace aptk
 
 	inline std::string Fluent::signature() const
 	{
-		return m_signature;
+		if (m_signature == no_such_index)
+			return "(not-a-fluent)";
+		return m_problem.fluent_signatures().str(m_signature);
 	}
 
 	inline void Fluent::set_index(unsigned idx)
@@ -73,7 +76,7 @@ namespace aptk
 
 	inline void Fluent::set_signature(std::string sig)
 	{
-		m_signature = sig;
+		m_signature = m_problem.fluent_signatures().add(sig);
 	}
 
 }
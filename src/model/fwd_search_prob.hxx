@@ -33,6 +33,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <action.hxx>
 
 #include <strips_state.hxx>
+#include <cassert>
 
 namespace aptk
 {
@@ -104,6 +105,103 @@ namespace aptk
 			STRIPS_Problem *m_task;
 		};
 
+		// Properties of a task that do not change once it is set up
+		enum class Effects_Policy
+		{
+			Conditional_Effects,
+			STRIPS
+		};
+
+		enum class Costs_Policy
+		{
+			Use_Costs,
+			Unit_Costs
+		};
+
+		/**
+		 * Fwd_Search_Problem for a task known, when it is set up, to have no
+		 * conditional effects or only unit costs. Without conditional effects
+		 * next() calls State::progress_strips(), which progresses dense and
+		 * dual states a word at a time, and with unit costs cost() is a constant. The
+		 * class is final, so engines instantiated over it call next() and
+		 * cost() without going through the virtual table.
+		 * dispatch_search_problem() picks the instantiation for a task.
+		 */
+		template <Effects_Policy effects, Costs_Policy costs>
+		class Specialized_Fwd_Search_Problem final : public Fwd_Search_Problem
+		{
+		public:
+			Specialized_Fwd_Search_Problem(STRIPS_Problem *p)
+					: Fwd_Search_Problem(p)
+			{
+				assert(effects == Effects_Policy::Conditional_Effects || !p->has_conditional_effects());
+			}
+
+			virtual float cost(const State &s, Action_Idx a) const
+			{
+				if (costs == Costs_Policy::Unit_Costs)
+					return 1.0f;
+				return task().actions()[a]->cost();
+			}
+
+			virtual State *next(const State &s, Action_Idx a) const
+			{
+				const Action &act = *(task().actions()[a]);
+				State *succ = effects == Effects_Policy::STRIPS ? s.progress_strips(act) : s.progress_through(act);
+				succ->update_hash();
+				return succ;
+			}
+
+			virtual State *next(const State &s, Action_Idx a, Fluent_Vec *added, Fluent_Vec *deleted) const
+			{
+				const Action &act = *(task().actions()[a]);
+				State *succ = effects == Effects_Policy::STRIPS ? s.progress_strips(act, added, deleted) : s.progress_through(act, added, deleted);
+				succ->update_hash();
+				return succ;
+			}
+		};
+
+		// Whether every action of the task costs 1
+		inline bool has_unit_costs(const STRIPS_Problem &task)
+		{
+			for (auto a : task.actions())
+				if (a->cost() != 1.0f)
+					return false;
+			return true;
+		}
+
+		/**
+		 * Calls f with the search model over task that matches its effects
+		 * and costs, so that f, usually a generic lambda setting up a search
+		 * engine, is instantiated once for each of them
+		 */
+		template <typename F>
+		void dispatch_search_problem(STRIPS_Problem *task, F f)
+		{
+			bool strips = !task->has_conditional_effects();
+			bool unit = has_unit_costs(*task);
+			if (strips && unit)
+			{
+				Specialized_Fwd_Search_Problem<Effects_Policy::STRIPS, Costs_Policy::Unit_Costs> search_prob(task);
+				f(search_prob);
+			}
+			else if (strips)
+			{
+				Specialized_Fwd_Search_Problem<Effects_Policy::STRIPS, Costs_Policy::Use_Costs> search_prob(task);
+				f(search_prob);
+			}
+			else if (unit)
+			{
+				Specialized_Fwd_Search_Problem<Effects_Policy::Conditional_Effects, Costs_Policy::Unit_Costs> search_prob(task);
+				f(search_prob);
+			}
+			else
+			{
+				Fwd_Search_Problem search_prob(task);
+				f(search_prob);
+			}
+		}
+
 	}
 
 }
@@ -0,0 +1,255 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <h2_mutexes.hxx>
+#include <strips_prob.hxx>
+#include <action.hxx>
+#include <cond_eff.hxx>
+#include <mutex_set.hxx>
+#include <thread_pool.hxx>
+#include <algorithm>
+
+namespace aptk
+{
+
+	namespace agnostic
+	{
+
+		H2_Mutex_Finder::H2_Mutex_Finder(const STRIPS_Problem &prob)
+				: m_model(prob), m_num_fluents(prob.num_fluents()), m_words((prob.num_fluents() + 63) / 64),
+					m_rows(new std::atomic<Word>[(size_t)m_num_fluents * m_words]), m_reached(new std::atomic<Word>[m_words]),
+					m_num_threads(0), m_time_budget(0), m_complete(false), m_num_sweeps(0), m_time(0),
+					m_changed(false)
+		{
+			for (size_t k = 0; k < (size_t)m_num_fluents * m_words; k++)
+				m_rows[k].store(0, std::memory_order_relaxed);
+			for (unsigned w = 0; w < m_words; w++)
+				m_reached[w].store(0, std::memory_order_relaxed);
+		}
+
+		bool H2_Mutex_Finder::reachable(const Fluent_Vec &c) const
+		{
+			for (unsigned i = 0; i < c.size(); i++)
+				for (unsigned j = i; j < c.size(); j++)
+					if (!reachable(c[i], c[j]))
+						return false;
+			return true;
+		}
+
+		bool H2_Mutex_Finder::reachable(const Fluent_Vec &c, const Fluent_Vec &d) const
+		{
+			if (!reachable(c) || !reachable(d))
+				return false;
+			for (auto p : c)
+				for (auto q : d)
+					if (!reachable(p, q))
+						return false;
+			return true;
+		}
+
+		bool H2_Mutex_Finder::set_reachable(unsigned p, unsigned q)
+		{
+			if (reachable(p, q))
+				return false;
+			m_rows[(size_t)p * m_words + q / 64].fetch_or(Word(1) << (q % 64), std::memory_order_relaxed);
+			m_rows[(size_t)q * m_words + p / 64].fetch_or(Word(1) << (p % 64), std::memory_order_relaxed);
+			if (p == q)
+				m_reached[p / 64].fetch_or(Word(1) << (p % 64), std::memory_order_relaxed);
+			m_changed.store(true, std::memory_order_relaxed);
+			return true;
+		}
+
+		// Pairs (p, r) with p added by an effect and r persisting through it:
+		// r is reachable along with every condition of the effect and is not
+		// deleted by it
+		void H2_Mutex_Finder::persist(const Fluent_Vec &prec, const Fluent_Vec *cond, const Fluent_Vec &add,
+									  const Fluent_Vec &del, const Fluent_Vec *cond_del, std::vector<Word> &mask)
+		{
+			if (add.empty())
+				return;
+			for (unsigned w = 0; w < m_words; w++)
+				mask[w] = m_reached[w].load(std::memory_order_relaxed);
+			auto restrict_to = [&](const Fluent_Vec &c)
+			{
+				for (auto s : c)
+					for (unsigned w = 0; w < m_words; w++)
+						mask[w] &= m_rows[(size_t)s * m_words + w].load(std::memory_order_relaxed);
+			};
+			restrict_to(prec);
+			if (cond)
+				restrict_to(*cond);
+			for (auto r : del)
+				mask[r / 64] &= ~(Word(1) << (r % 64));
+			if (cond_del)
+				for (auto r : *cond_del)
+					mask[r / 64] &= ~(Word(1) << (r % 64));
+
+			for (auto p : add)
+				for (unsigned w = 0; w < m_words; w++)
+				{
+					Word cand = mask[w] & ~m_rows[(size_t)p * m_words + w].load(std::memory_order_relaxed);
+					while (cand)
+					{
+						unsigned r = w * 64 + __builtin_ctzll(cand);
+						cand &= cand - 1;
+						set_reachable(p, r);
+					}
+				}
+		}
+
+		void H2_Mutex_Finder::sweep(unsigned begin, unsigned end, const Cancellation_Token &token)
+		{
+			std::vector<Word> mask(m_words);
+			std::vector<const Conditional_Effect *> fired;
+			Fluent_Vec adds;
+			for (unsigned i = begin; i < end; i++)
+			{
+				if ((i - begin) % 64 == 0 && token.cancelled())
+					return;
+
+				const Action &a = *(m_model.actions()[i]);
+				if (!reachable(a.prec_vec()))
+					continue;
+
+				// Conditional effects whose condition is reachable along with
+				// the precondition may fire, together or not
+				fired.clear();
+				adds = a.add_vec();
+				for (auto ceff : a.ceff_vec())
+				{
+					if (!reachable(a.prec_vec(), ceff->prec_vec()))
+						continue;
+					fired.push_back(ceff);
+					adds.insert(adds.end(), ceff->add_vec().begin(), ceff->add_vec().end());
+				}
+
+				for (unsigned j = 0; j < adds.size(); j++)
+					for (unsigned k = j; k < adds.size(); k++)
+						set_reachable(adds[j], adds[k]);
+
+				persist(a.prec_vec(), nullptr, a.add_vec(), a.del_vec(), nullptr, mask);
+				for (auto ceff : fired)
+					persist(a.prec_vec(), &ceff->prec_vec(), ceff->add_vec(), a.del_vec(), &ceff->del_vec(), mask);
+			}
+		}
+
+		bool H2_Mutex_Finder::compute()
+		{
+			auto t0 = std::chrono::steady_clock::now();
+			Cancellation_Token token;
+			if (m_time_budget > 0)
+				token.set_deadline(m_time_budget);
+			m_num_sweeps = 0;
+
+			const Fluent_Vec &init = m_model.init();
+			for (unsigned i = 0; i < init.size(); i++)
+				for (unsigned j = i; j < init.size(); j++)
+					set_reachable(init[i], init[j]);
+
+			// Blocks of actions are the unit of work, so a few actions are swept by the calling thread alone
+			const unsigned block_size = 256;
+			unsigned na = m_model.num_actions();
+			unsigned num_blocks = (na + block_size - 1) / block_size;
+			do
+			{
+				m_changed = false;
+				m_num_sweeps++;
+				Thread_Pool::global().parallel_for(0, num_blocks, [&](size_t b)
+												   { sweep(b * block_size, std::min<size_t>((b + 1) * block_size, na), token); }, 1, m_num_threads, &token);
+			} while (m_changed && !token.cancelled());
+
+			m_complete = !token.cancelled();
+			m_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+			return m_complete;
+		}
+
+		unsigned H2_Mutex_Finder::num_mutex_pairs() const
+		{
+			unsigned n = 0;
+			for (unsigned p = 0; p < m_num_fluents; p++)
+				for (unsigned q = p + 1; reachable(p) && q < m_num_fluents; q++)
+					if (reachable(q) && !reachable(p, q))
+						n++;
+			return n;
+		}
+
+		void H2_Mutex_Finder::mutex_groups(const Mutex_Set &known, std::vector<Fluent_Vec> &groups) const
+		{
+			auto row = [&](unsigned p, unsigned w)
+			{
+				return m_rows[(size_t)p * m_words + w].load(std::memory_order_relaxed);
+			};
+
+			// Mutex pairs between reachable fluents not covered yet
+			std::vector<Word> pending((size_t)m_num_fluents * m_words, 0);
+			for (unsigned p = 0; p < m_num_fluents; p++)
+				if (reachable(p))
+					for (unsigned w = 0; w < m_words; w++)
+						pending[(size_t)p * m_words + w] = m_reached[w].load(std::memory_order_relaxed) & ~row(p, w);
+			auto cover = [&](const Fluent_Vec &group)
+			{
+				for (auto p : group)
+					for (auto q : group)
+						pending[(size_t)p * m_words + q / 64] &= ~(Word(1) << (q % 64));
+			};
+			for (unsigned g = 0; g < known.num_groups(); g++)
+				cover(known.group(g));
+
+			// Greedy clique cover: a group grows first with fluents whose pair
+			// with p is not covered, then with any fluent mutex with all members
+			std::vector<Word> cand(m_words);
+			for (unsigned p = 0; p < m_num_fluents; p++)
+			{
+				Word *p_pending = pending.data() + (size_t)p * m_words;
+				for (unsigned w = 0; w < m_words; w++)
+					while (p_pending[w])
+					{
+						Fluent_Vec group = {p};
+						for (unsigned v = 0; v < m_words; v++)
+							cand[v] = m_reached[v].load(std::memory_order_relaxed) & ~row(p, v);
+						for (bool uncovered_first : {true, false})
+							for (unsigned v = 0; v < m_words; v++)
+								while (true)
+								{
+									Word c = cand[v] & (uncovered_first ? p_pending[v] : ~Word(0));
+									if (!c)
+										break;
+									unsigned r = v * 64 + __builtin_ctzll(c);
+									group.push_back(r);
+									for (unsigned u = 0; u < m_words; u++)
+										cand[u] &= ~row(r, u);
+								}
+						cover(group);
+						std::sort(group.begin(), group.end());
+						groups.push_back(group);
+					}
+			}
+		}
+
+	}
+
+}
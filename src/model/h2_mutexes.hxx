@@ -0,0 +1,121 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __H2_MUTEXES__
+#define __H2_MUTEXES__
+
+#include <types.hxx>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace aptk
+{
+
+	class STRIPS_Problem;
+	class Cancellation_Token;
+
+	namespace agnostic
+	{
+
+		class Mutex_Set;
+
+		// Finds the pairs of fluents that h^2 proves can never hold together
+		// in a state reachable from init, as a preprocessing step independent
+		// of H2_Heuristic. Pairs reachable together are kept as one bit row
+		// per fluent, and blocks of actions are swept on Thread_Pool::global(),
+		// setting bits with atomic ors until a sweep changes nothing. Conditional
+		// effects are over-approximated: an effect whose condition is
+		// reachable may or may not fire along with the others.
+		class H2_Mutex_Finder
+		{
+		public:
+			typedef uint64_t Word;
+
+			H2_Mutex_Finder(const STRIPS_Problem &prob);
+
+			// Threads of Thread_Pool::global() to sweep with, 0 means all
+			void set_num_threads(unsigned n) { m_num_threads = n; }
+			unsigned num_threads() const { return m_num_threads; }
+
+			// Wall clock seconds, 0 means no limit
+			void set_time_budget(double secs) { m_time_budget = secs; }
+
+			// Computes the pairs reachable together from init. Returns false
+			// when the time budget runs out, nothing is known about mutexes then
+			bool compute();
+			bool complete() const { return m_complete; }
+
+			bool reachable(unsigned p) const { return reachable(p, p); }
+			bool reachable(unsigned p, unsigned q) const
+			{
+				return m_rows[(size_t)p * m_words + q / 64].load(std::memory_order_relaxed) & (Word(1) << (q % 64));
+			}
+			// All fluents and pairs of fluents in c are reachable
+			bool reachable(const Fluent_Vec &c) const;
+			// Same for the union of c and d
+			bool reachable(const Fluent_Vec &c, const Fluent_Vec &d) const;
+			bool are_mutex(unsigned p, unsigned q) const { return !reachable(p, q); }
+
+			// Covers the mutex pairs between reachable fluents with groups of
+			// pairwise mutex fluents, leaving out the pairs already covered by
+			// the groups in known
+			void mutex_groups(const Mutex_Set &known, std::vector<Fluent_Vec> &groups) const;
+
+			unsigned num_mutex_pairs() const;
+			unsigned num_sweeps() const { return m_num_sweeps; }
+			double time() const { return m_time; }
+
+		protected:
+			bool set_reachable(unsigned p, unsigned q);
+			void sweep(unsigned begin, unsigned end, const Cancellation_Token &token);
+			void persist(const Fluent_Vec &prec, const Fluent_Vec *cond, const Fluent_Vec &add,
+						 const Fluent_Vec &del, const Fluent_Vec *cond_del, std::vector<Word> &mask);
+
+		protected:
+			const STRIPS_Problem &m_model;
+			unsigned m_num_fluents;
+			unsigned m_words;
+			// Row p has bit q set when p and q are reachable together, and
+			// m_reached bit p when p is reachable at all
+			std::unique_ptr<std::atomic<Word>[]> m_rows;
+			std::unique_ptr<std::atomic<Word>[]> m_reached;
+			unsigned m_num_threads;
+			double m_time_budget;
+			bool m_complete;
+			unsigned m_num_sweeps;
+			double m_time;
+			std::atomic<bool> m_changed;
+		};
+
+	}
+
+}
+
+#endif // h2_mutexes.hxx
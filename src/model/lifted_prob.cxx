@@ -0,0 +1,513 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <lifted_prob.hxx>
+#include <algorithm>
+#include <sstream>
+
+namespace aptk
+{
+
+	size_t Lifted_Problem::Tuple_Hash::operator()(const std::vector<unsigned> &t) const
+	{
+		size_t h = t.size();
+		for (unsigned x : t)
+			h ^= x + 0x9e3779b9 + (h << 6) + (h >> 2);
+		return h;
+	}
+
+	void Lifted_Problem::Relation::init(unsigned a, unsigned num_objects)
+	{
+		arity = a;
+		count = 0;
+		tuples.clear();
+		by_arg.assign(arity, std::vector<std::vector<unsigned>>(num_objects));
+	}
+
+	void Lifted_Problem::Relation::add(const unsigned *args)
+	{
+		unsigned t = count++;
+		for (unsigned i = 0; i < arity; i++)
+		{
+			tuples.push_back(args[i]);
+			by_arg[i][args[i]].push_back(t);
+		}
+	}
+
+	// Only touches the index lists in use, states are much smaller than
+	// the relations they could hold
+	void Lifted_Problem::Relation::clear()
+	{
+		for (unsigned k = 0; k < tuples.size(); k++)
+			by_arg[k % arity][tuples[k]].clear();
+		tuples.clear();
+		count = 0;
+	}
+
+	Lifted_Problem::Lifted_Problem(std::string dom_name, std::string prob_name)
+			: m_domain_name(dom_name), m_problem_name(prob_name),
+				m_finalized(false), m_static_goal_holds(true), m_state(nullptr)
+	{
+	}
+
+	Lifted_Problem::~Lifted_Problem()
+	{
+	}
+
+	unsigned Lifted_Problem::add_object(std::string name)
+	{
+		m_objects.push_back(name);
+		return m_objects.size() - 1;
+	}
+
+	unsigned Lifted_Problem::add_predicate(std::string name, unsigned arity)
+	{
+		m_predicates.push_back({name, arity, true});
+		return m_predicates.size() - 1;
+	}
+
+	unsigned Lifted_Problem::add_schema(const Action_Schema &schema)
+	{
+		m_schemas.push_back(schema);
+		return m_schemas.size() - 1;
+	}
+
+	void Lifted_Problem::add_init(unsigned predicate, const std::vector<unsigned> &args)
+	{
+		m_init_atoms.push_back(args);
+		m_init_atoms.back().insert(m_init_atoms.back().begin(), predicate);
+	}
+
+	void Lifted_Problem::add_goal(unsigned predicate, const std::vector<unsigned> &args)
+	{
+		m_goal_atoms.push_back(args);
+		m_goal_atoms.back().insert(m_goal_atoms.back().begin(), predicate);
+	}
+
+	bool Lifted_Problem::finalize()
+	{
+		if (m_finalized)
+			return m_error.empty();
+		m_finalized = true;
+
+		auto valid_atom = [&](const Lifted_Atom &atom, unsigned num_params)
+		{
+			if (atom.predicate >= m_predicates.size() ||
+					atom.args.size() != m_predicates[atom.predicate].arity)
+				return false;
+			for (auto t : atom.args)
+				if (is_lifted_param(t) ? (unsigned)~t >= num_params : (unsigned)t >= m_objects.size())
+					return false;
+			return true;
+		};
+		auto valid_ground = [&](const std::vector<unsigned> &atom)
+		{
+			if (atom[0] >= m_predicates.size() || atom.size() != m_predicates[atom[0]].arity + 1)
+				return false;
+			for (unsigned i = 1; i < atom.size(); i++)
+				if (atom[i] >= m_objects.size())
+					return false;
+			return true;
+		};
+
+		m_in_domain.resize(m_schemas.size());
+		for (unsigned s = 0; s < m_schemas.size(); s++)
+		{
+			Action_Schema &sc = m_schemas[s];
+			unsigned n = sc.params.size();
+			sc.domains.resize(n);
+			for (auto *atoms : {&sc.pre, &sc.neg_pre, &sc.add, &sc.del})
+				for (auto &atom : *atoms)
+					if (!valid_atom(atom, n))
+					{
+						m_error = "bad atom in schema " + sc.name;
+						return false;
+					}
+			for (auto *atoms : {&sc.add, &sc.del})
+				for (auto &atom : *atoms)
+					m_predicates[atom.predicate].is_static = false;
+
+			m_in_domain[s].resize(n);
+			for (unsigned p = 0; p < n; p++)
+			{
+				if (sc.domains[p].empty())
+					continue;
+				m_in_domain[s][p].assign(m_objects.size(), false);
+				for (auto o : sc.domains[p])
+				{
+					if (o >= m_objects.size())
+					{
+						m_error = "bad object in domain of schema " + sc.name;
+						return false;
+					}
+					m_in_domain[s][p][o] = true;
+				}
+			}
+		}
+
+		m_static.resize(m_predicates.size());
+		m_state_rel.resize(m_predicates.size());
+		m_rel.resize(m_predicates.size());
+		for (unsigned p = 0; p < m_predicates.size(); p++)
+		{
+			if (is_static(p))
+			{
+				m_static[p].init(m_predicates[p].arity, m_objects.size());
+				m_rel[p] = &m_static[p];
+			}
+			else
+			{
+				m_state_rel[p].init(m_predicates[p].arity, m_objects.size());
+				m_rel[p] = &m_state_rel[p];
+			}
+		}
+
+		for (auto &atom : m_init_atoms)
+		{
+			if (!valid_ground(atom))
+			{
+				m_error = "bad initial atom";
+				return false;
+			}
+			if (!is_static(atom[0]))
+				m_init.push_back(intern_fluent(atom[0], atom.data() + 1));
+			else if (m_static_atoms.insert(atom).second)
+				m_static[atom[0]].add(atom.data() + 1);
+		}
+		for (auto &atom : m_goal_atoms)
+		{
+			if (!valid_ground(atom))
+			{
+				m_error = "bad goal atom";
+				return false;
+			}
+			if (!is_static(atom[0]))
+				m_goal.push_back(intern_fluent(atom[0], atom.data() + 1));
+			else if (!m_static_atoms.count(atom))
+				m_static_goal_holds = false;
+		}
+		for (auto *v : {&m_init, &m_goal})
+		{
+			std::sort(v->begin(), v->end());
+			v->erase(std::unique(v->begin(), v->end()), v->end());
+		}
+		m_init_atoms.clear();
+		m_goal_atoms.clear();
+		return true;
+	}
+
+	int Lifted_Problem::fluent(unsigned predicate, const unsigned *args) const
+	{
+		m_key.assign(1, predicate);
+		m_key.insert(m_key.end(), args, args + m_predicates[predicate].arity);
+		auto it = m_fluent_map.find(m_key);
+		return it == m_fluent_map.end() ? -1 : (int)it->second;
+	}
+
+	unsigned Lifted_Problem::intern_fluent(unsigned predicate, const unsigned *args)
+	{
+		m_key.assign(1, predicate);
+		m_key.insert(m_key.end(), args, args + m_predicates[predicate].arity);
+		auto res = m_fluent_map.emplace(m_key, m_fluent_pred.size());
+		if (res.second)
+		{
+			m_fluent_pred.push_back(predicate);
+			m_fluent_offset.push_back(m_fluent_args.size());
+			m_fluent_args.insert(m_fluent_args.end(), m_key.begin() + 1, m_key.end());
+		}
+		return res.first->second;
+	}
+
+	std::string Lifted_Problem::fluent_signature(unsigned f) const
+	{
+		std::stringstream ss;
+		unsigned p = m_fluent_pred[f];
+		ss << "(" << m_predicates[p].name;
+		for (unsigned i = 0; i < m_predicates[p].arity; i++)
+			ss << " " << m_objects[m_fluent_args[m_fluent_offset[f] + i]];
+		ss << ")";
+		return ss.str();
+	}
+
+	std::string Lifted_Problem::action_signature(unsigned a) const
+	{
+		std::stringstream ss;
+		const Action_Schema &sc = m_schemas[m_action_schema[a]];
+		ss << "(" << sc.name;
+		for (unsigned i = 0; i < sc.params.size(); i++)
+			ss << " " << m_objects[action_args(a)[i]];
+		ss << ")";
+		return ss.str();
+	}
+
+	bool Lifted_Problem::holds(unsigned predicate, const unsigned *args, const Fluent_Vec &s) const
+	{
+		if (is_static(predicate))
+		{
+			m_key.assign(1, predicate);
+			m_key.insert(m_key.end(), args, args + m_predicates[predicate].arity);
+			return m_static_atoms.count(m_key) > 0;
+		}
+		int f = fluent(predicate, args);
+		return f >= 0 && std::binary_search(s.begin(), s.end(), (unsigned)f);
+	}
+
+	void Lifted_Problem::ground(const Lifted_Atom &atom, const unsigned *binding, std::vector<unsigned> &args) const
+	{
+		args.resize(atom.args.size());
+		for (unsigned i = 0; i < atom.args.size(); i++)
+			args[i] = is_lifted_param(atom.args[i]) ? binding[~atom.args[i]] : atom.args[i];
+	}
+
+	void Lifted_Problem::bind_relations(const Fluent_Vec &s)
+	{
+		for (unsigned p = 0; p < m_predicates.size(); p++)
+			if (!is_static(p))
+				m_state_rel[p].clear();
+		for (auto f : s)
+			m_state_rel[m_fluent_pred[f]].add(&m_fluent_args[m_fluent_offset[f]]);
+		m_state = &s;
+	}
+
+	// Greedy join order: atoms sharing a bound argument with what is
+	// already matched go first, smaller relations break ties
+	void Lifted_Problem::order_atoms(unsigned schema, std::vector<unsigned> &order) const
+	{
+		const Action_Schema &sc = m_schemas[schema];
+		std::vector<bool> bound(sc.params.size(), false);
+		std::vector<bool> used(sc.pre.size(), false);
+		order.clear();
+		while (order.size() < sc.pre.size())
+		{
+			unsigned best = 0;
+			bool best_bound = false;
+			unsigned best_size = 0;
+			bool first = true;
+			for (unsigned i = 0; i < sc.pre.size(); i++)
+			{
+				if (used[i])
+					continue;
+				const Lifted_Atom &atom = sc.pre[i];
+				bool has_bound = false;
+				for (auto t : atom.args)
+					if (!is_lifted_param(t) || bound[~t])
+						has_bound = true;
+				unsigned size = m_rel[atom.predicate]->count;
+				if (first || (has_bound && !best_bound) ||
+						(has_bound == best_bound && size < best_size))
+				{
+					best = i;
+					best_bound = has_bound;
+					best_size = size;
+					first = false;
+				}
+			}
+			used[best] = true;
+			order.push_back(best);
+			for (auto t : sc.pre[best].args)
+				if (is_lifted_param(t))
+					bound[~t] = true;
+		}
+	}
+
+	void Lifted_Problem::applicable_actions(const Fluent_Vec &s, std::vector<int> &actions)
+	{
+		bind_relations(s);
+		std::vector<unsigned> order;
+		for (unsigned schema = 0; schema < m_schemas.size(); schema++)
+		{
+			const Action_Schema &sc = m_schemas[schema];
+			bool empty = false;
+			for (auto &atom : sc.pre)
+				if (m_rel[atom.predicate]->count == 0)
+					empty = true;
+			if (empty)
+				continue;
+			order_atoms(schema, order);
+			m_binding.assign(sc.params.size(), 0);
+			m_bound.assign(sc.params.size(), false);
+			match(schema, 0, order, actions);
+		}
+		m_state = nullptr;
+	}
+
+	// Binds the parameters of the k-th atom in join order against the
+	// tuples of its relation, through the shortest index list available
+	void Lifted_Problem::match(unsigned schema, unsigned k, std::vector<unsigned> &order, std::vector<int> &actions)
+	{
+		if (k == order.size())
+		{
+			emit(schema, 0, actions);
+			return;
+		}
+		const Lifted_Atom &atom = m_schemas[schema].pre[order[k]];
+		const Relation &r = *m_rel[atom.predicate];
+		const std::vector<std::vector<bool>> &in_domain = m_in_domain[schema];
+
+		const std::vector<unsigned> *cands = nullptr;
+		for (unsigned i = 0; i < r.arity; i++)
+		{
+			Lifted_Term t = atom.args[i];
+			if (is_lifted_param(t) && !m_bound[~t])
+				continue;
+			unsigned o = is_lifted_param(t) ? m_binding[~t] : (unsigned)t;
+			const std::vector<unsigned> &l = r.by_arg[i][o];
+			if (!cands || l.size() < cands->size())
+				cands = &l;
+		}
+
+		std::vector<unsigned> newly;
+		unsigned n = cands ? cands->size() : r.count;
+		for (unsigned j = 0; j < n; j++)
+		{
+			const unsigned *tuple = r.tuples.data() + (size_t)(cands ? (*cands)[j] : j) * r.arity;
+			bool ok = true;
+			for (unsigned i = 0; ok && i < r.arity; i++)
+			{
+				Lifted_Term t = atom.args[i];
+				if (!is_lifted_param(t))
+					ok = (unsigned)t == tuple[i];
+				else if (m_bound[~t])
+					ok = m_binding[~t] == tuple[i];
+				else if (!in_domain[~t].empty() && !in_domain[~t][tuple[i]])
+					ok = false;
+				else
+				{
+					m_binding[~t] = tuple[i];
+					m_bound[~t] = true;
+					newly.push_back(~t);
+				}
+			}
+			if (ok)
+				match(schema, k + 1, order, actions);
+			for (auto p : newly)
+				m_bound[p] = false;
+			newly.clear();
+		}
+	}
+
+	// Enumerates the parameters no precondition binds, then checks the
+	// negative preconditions
+	void Lifted_Problem::emit(unsigned schema, unsigned param, std::vector<int> &actions)
+	{
+		const Action_Schema &sc = m_schemas[schema];
+		while (param < sc.params.size() && m_bound[param])
+			param++;
+		if (param < sc.params.size())
+		{
+			m_bound[param] = true;
+			if (sc.domains[param].empty())
+				for (unsigned o = 0; o < m_objects.size(); o++)
+				{
+					m_binding[param] = o;
+					emit(schema, param + 1, actions);
+				}
+			else
+				for (auto o : sc.domains[param])
+				{
+					m_binding[param] = o;
+					emit(schema, param + 1, actions);
+				}
+			m_bound[param] = false;
+			return;
+		}
+
+		std::vector<unsigned> args;
+		for (auto &atom : sc.neg_pre)
+		{
+			ground(atom, m_binding.data(), args);
+			if (holds(atom.predicate, args.data(), *m_state))
+				return;
+		}
+
+		m_key.assign(1, schema);
+		m_key.insert(m_key.end(), m_binding.begin(), m_binding.end());
+		auto res = m_action_map.emplace(m_key, m_action_schema.size());
+		if (res.second)
+		{
+			m_action_schema.push_back(schema);
+			m_action_offset.push_back(m_action_args.size());
+			m_action_args.insert(m_action_args.end(), m_binding.begin(), m_binding.end());
+		}
+		actions.push_back(res.first->second);
+	}
+
+	bool Lifted_Problem::is_applicable(const Fluent_Vec &s, unsigned a) const
+	{
+		const Action_Schema &sc = m_schemas[m_action_schema[a]];
+		std::vector<unsigned> args;
+		for (auto &atom : sc.pre)
+		{
+			ground(atom, action_args(a), args);
+			if (!holds(atom.predicate, args.data(), s))
+				return false;
+		}
+		for (auto &atom : sc.neg_pre)
+		{
+			ground(atom, action_args(a), args);
+			if (holds(atom.predicate, args.data(), s))
+				return false;
+		}
+		return true;
+	}
+
+	void Lifted_Problem::effects(unsigned a, Fluent_Vec &add, Fluent_Vec &del)
+	{
+		const Action_Schema &sc = m_schemas[m_action_schema[a]];
+		std::vector<unsigned> binding(action_args(a), action_args(a) + sc.params.size());
+		std::vector<unsigned> args;
+		add.clear();
+		del.clear();
+		for (auto &atom : sc.add)
+		{
+			ground(atom, binding.data(), args);
+			add.push_back(intern_fluent(atom.predicate, args.data()));
+		}
+		for (auto &atom : sc.del)
+		{
+			ground(atom, binding.data(), args);
+			// an atom never reached cannot be in any state
+			int f = fluent(atom.predicate, args.data());
+			if (f >= 0)
+				del.push_back(f);
+		}
+	}
+
+	void Lifted_Problem::progress(const Fluent_Vec &s, unsigned a, Fluent_Vec &succ)
+	{
+		Fluent_Vec add, del;
+		effects(a, add, del);
+		succ.clear();
+		for (auto f : s)
+			if (std::find(del.begin(), del.end(), f) == del.end())
+				succ.push_back(f);
+		succ.insert(succ.end(), add.begin(), add.end());
+		std::sort(succ.begin(), succ.end());
+		succ.erase(std::unique(succ.begin(), succ.end()), succ.end());
+	}
+
+}
@@ -0,0 +1,204 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __LIFTED_PROB__
+#define __LIFTED_PROB__
+
+#include <types.hxx>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace aptk
+{
+
+	// Argument of a lifted atom: an object, or ~i for parameter i of the schema
+	typedef int Lifted_Term;
+	inline Lifted_Term lifted_param(unsigned i) { return ~(int)i; }
+	inline bool is_lifted_param(Lifted_Term t) { return t < 0; }
+
+	struct Lifted_Atom
+	{
+		unsigned predicate;
+		std::vector<Lifted_Term> args;
+	};
+
+	struct Action_Schema
+	{
+		std::string name;
+		std::vector<std::string> params;
+		// objects each parameter ranges over, an empty domain means any object
+		std::vector<std::vector<unsigned>> domains;
+		std::vector<Lifted_Atom> pre, neg_pre, add, del;
+		float cost = 1.0f;
+	};
+
+	/**
+	 * A planning task kept at the level of action schemas, for tasks too
+	 * large to ground up front.
+	 *
+	 * Predicates no schema adds or deletes are static: their atoms stay in
+	 * per-predicate relations and never become fluents. Fluents (ground
+	 * atoms of the other predicates) and ground actions get an index the
+	 * first time search reaches them, so num_fluents() and num_actions()
+	 * grow as search goes on and only count what actually appeared.
+	 *
+	 * Applicable actions are found by joining the precondition atoms of
+	 * each schema with the relations of the state, binding parameters one
+	 * atom at a time and looking tuples up through per-argument indices.
+	 * Not thread safe, lookups intern new fluents and actions.
+	 */
+	class Lifted_Problem
+	{
+	public:
+		Lifted_Problem(std::string dom_name = "Unnamed", std::string prob_name = "Unnamed");
+		~Lifted_Problem();
+
+		unsigned add_object(std::string name);
+		unsigned add_predicate(std::string name, unsigned arity);
+		unsigned add_schema(const Action_Schema &schema);
+		void add_init(unsigned predicate, const std::vector<unsigned> &args);
+		void add_goal(unsigned predicate, const std::vector<unsigned> &args);
+		// To be called once the task is complete. Returns false if a
+		// schema is malformed, see error()
+		bool finalize();
+
+		const std::string &error() const { return m_error; }
+		std::string domain_name() const { return m_domain_name; }
+		std::string problem_name() const { return m_problem_name; }
+		void set_domain_name(std::string n) { m_domain_name = n; }
+		void set_problem_name(std::string n) { m_problem_name = n; }
+
+		unsigned num_objects() const { return m_objects.size(); }
+		unsigned num_predicates() const { return m_predicates.size(); }
+		unsigned num_schemas() const { return m_schemas.size(); }
+		const std::string &object_name(unsigned o) const { return m_objects[o]; }
+		const std::string &predicate_name(unsigned p) const { return m_predicates[p].name; }
+		bool is_static(unsigned p) const { return m_predicates[p].is_static; }
+		const Action_Schema &schema(unsigned s) const { return m_schemas[s]; }
+
+		unsigned num_fluents() const { return m_fluent_pred.size(); }
+		// Index of the ground atom, or -1 if it has not been reached
+		int fluent(unsigned predicate, const unsigned *args) const;
+		unsigned intern_fluent(unsigned predicate, const unsigned *args);
+		std::string fluent_signature(unsigned f) const;
+
+		unsigned num_actions() const { return m_action_schema.size(); }
+		unsigned action_schema(unsigned a) const { return m_action_schema[a]; }
+		const unsigned *action_args(unsigned a) const { return &m_action_args[m_action_offset[a]]; }
+		float action_cost(unsigned a) const { return m_schemas[m_action_schema[a]].cost; }
+		std::string action_signature(unsigned a) const;
+
+		const Fluent_Vec &init() const { return m_init; }
+		const Fluent_Vec &goal() const { return m_goal; }
+		// false if some static goal atom does not hold
+		bool static_goal_holds() const { return m_static_goal_holds; }
+
+		// Appends the ground actions applicable in s (sorted fluents)
+		void applicable_actions(const Fluent_Vec &s, std::vector<int> &actions);
+		bool is_applicable(const Fluent_Vec &s, unsigned a) const;
+		// Sorted successor of s through a
+		void progress(const Fluent_Vec &s, unsigned a, Fluent_Vec &succ);
+		void effects(unsigned a, Fluent_Vec &add, Fluent_Vec &del);
+
+	protected:
+		struct Predicate
+		{
+			std::string name;
+			unsigned arity;
+			bool is_static;
+		};
+
+		// Tuples of one predicate, indexed by the object at each argument
+		struct Relation
+		{
+			unsigned arity = 0;
+			unsigned count = 0;
+			std::vector<unsigned> tuples; // flat, arity objects each
+			// by_arg[i][o] lists the tuples with object o as argument i
+			std::vector<std::vector<std::vector<unsigned>>> by_arg;
+
+			void init(unsigned arity, unsigned num_objects);
+			void add(const unsigned *args);
+			void clear();
+		};
+
+		struct Tuple_Hash
+		{
+			size_t operator()(const std::vector<unsigned> &t) const;
+		};
+		typedef std::unordered_map<std::vector<unsigned>, unsigned, Tuple_Hash> Tuple_Map;
+
+		void bind_relations(const Fluent_Vec &s);
+		void match(unsigned schema, unsigned k, std::vector<unsigned> &order, std::vector<int> &actions);
+		void emit(unsigned schema, unsigned param, std::vector<int> &actions);
+		bool holds(unsigned predicate, const unsigned *args, const Fluent_Vec &s) const;
+		void ground(const Lifted_Atom &atom, const unsigned *binding, std::vector<unsigned> &args) const;
+		void order_atoms(unsigned schema, std::vector<unsigned> &order) const;
+
+	protected:
+		std::string m_domain_name;
+		std::string m_problem_name;
+		std::string m_error;
+		std::vector<std::string> m_objects;
+		std::vector<Predicate> m_predicates;
+		std::vector<Action_Schema> m_schemas;
+		// per schema and parameter, which objects it admits (empty means all)
+		std::vector<std::vector<std::vector<bool>>> m_in_domain;
+
+		std::vector<Relation> m_static;
+		std::unordered_set<std::vector<unsigned>, Tuple_Hash> m_static_atoms;
+		std::vector<std::vector<unsigned>> m_init_atoms, m_goal_atoms;
+		bool m_finalized;
+		bool m_static_goal_holds;
+
+		Tuple_Map m_fluent_map;
+		std::vector<unsigned> m_fluent_pred;
+		std::vector<unsigned> m_fluent_offset;
+		std::vector<unsigned> m_fluent_args;
+
+		Tuple_Map m_action_map;
+		std::vector<unsigned> m_action_schema;
+		std::vector<unsigned> m_action_offset;
+		std::vector<unsigned> m_action_args;
+
+		Fluent_Vec m_init;
+		Fluent_Vec m_goal;
+
+		// scratch space of applicable_actions()
+		std::vector<Relation> m_state_rel;
+		std::vector<const Relation *> m_rel;
+		const Fluent_Vec *m_state;
+		std::vector<unsigned> m_binding;
+		std::vector<bool> m_bound;
+		mutable std::vector<unsigned> m_key;
+	};
+
+}
+
+#endif // lifted_prob.hxx
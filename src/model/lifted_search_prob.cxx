@@ -0,0 +1,105 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <lifted_search_prob.hxx>
+
+namespace aptk
+{
+
+	namespace agnostic
+	{
+
+		Lifted_Search_Problem::Lifted_Search_Problem(Lifted_Problem *p)
+				: Search_Problem<Lifted_State>(), m_task(p)
+		{
+		}
+
+		Lifted_Search_Problem::~Lifted_Search_Problem()
+		{
+		}
+
+		int Lifted_Search_Problem::num_actions() const
+		{
+			return task().num_actions();
+		}
+
+		Lifted_State *Lifted_Search_Problem::init() const
+		{
+			return new Lifted_State(task(), task().init());
+		}
+
+		bool Lifted_Search_Problem::goal(const Lifted_State &s) const
+		{
+			return task().static_goal_holds() && s.entails(task().goal());
+		}
+
+		unsigned Lifted_Search_Problem::goals_left(const Lifted_State &s) const
+		{
+			unsigned n;
+			s.entails(task().goal(), n);
+			return n;
+		}
+
+		bool Lifted_Search_Problem::is_applicable(const Lifted_State &s, Action_Idx a) const
+		{
+			return task().is_applicable(s.fluent_vec(), a);
+		}
+
+		void Lifted_Search_Problem::applicable_set(const Lifted_State &s, std::vector<Action_Idx> &app_set) const
+		{
+			app_set.clear();
+			m_task->applicable_actions(s.fluent_vec(), app_set);
+		}
+
+		void Lifted_Search_Problem::applicable_set_v2(const Lifted_State &s, std::vector<Action_Idx> &app_set) const
+		{
+			applicable_set(s, app_set);
+		}
+
+		float Lifted_Search_Problem::cost(const Lifted_State &s, Action_Idx a) const
+		{
+			return task().action_cost(a);
+		}
+
+		Lifted_State *Lifted_Search_Problem::next(const Lifted_State &s, Action_Idx a) const
+		{
+			Lifted_State *succ = new Lifted_State(task());
+			m_task->progress(s.fluent_vec(), a, succ->fluent_vec());
+			succ->update_hash();
+			return succ;
+		}
+
+		void Lifted_Search_Problem::print(std::ostream &os) const
+		{
+			os << "Lifted task " << task().domain_name() << " / " << task().problem_name() << ": "
+				 << task().num_objects() << " objects, " << task().num_predicates() << " predicates, "
+				 << task().num_schemas() << " schemas" << std::endl;
+		}
+
+	}
+
+}
@@ -0,0 +1,166 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __LIFTED_SEARCH_PROB__
+#define __LIFTED_SEARCH_PROB__
+
+#include <lifted_prob.hxx>
+#include <search_prob.hxx>
+#include <hash_table.hxx>
+#include <algorithm>
+#include <iostream>
+
+namespace aptk
+{
+
+	// State of a Lifted_Problem: the sorted fluents that hold
+	class Lifted_State
+	{
+	public:
+		Lifted_State(const Lifted_Problem &p) : m_problem(&p), m_hash(0) {}
+		Lifted_State(const Lifted_Problem &p, const Fluent_Vec &fv)
+				: m_problem(&p), m_fluent_vec(fv)
+		{
+			update_hash();
+		}
+
+		Fluent_Vec &fluent_vec() { return m_fluent_vec; }
+		const Fluent_Vec &fluent_vec() const { return m_fluent_vec; }
+
+		bool entails(unsigned f) const { return std::binary_search(m_fluent_vec.begin(), m_fluent_vec.end(), f); }
+		bool entails(const Fluent_Vec &fv) const
+		{
+			for (auto f : fv)
+				if (!entails(f))
+					return false;
+			return true;
+		}
+		bool entails(const Fluent_Vec &fv, unsigned &num_unsat) const
+		{
+			num_unsat = 0;
+			for (auto f : fv)
+				if (!entails(f))
+					num_unsat++;
+			return num_unsat == 0;
+		}
+
+		size_t hash() const { return m_hash; }
+		void update_hash()
+		{
+			Hash_Key hasher;
+			hasher.add(m_fluent_vec);
+			m_hash = (size_t)hasher;
+		}
+
+		const Lifted_Problem &problem() const { return *m_problem; }
+
+		bool operator==(const Lifted_State &o) const { return m_fluent_vec == o.m_fluent_vec; }
+
+		void print(std::ostream &os) const
+		{
+			for (auto f : m_fluent_vec)
+				os << m_problem->fluent_signature(f) << ", ";
+			os << std::endl;
+		}
+
+	protected:
+		const Lifted_Problem *m_problem;
+		Fluent_Vec m_fluent_vec;
+		size_t m_hash;
+	};
+
+	namespace agnostic
+	{
+
+		/**
+		 * Search model over a Lifted_Problem, the counterpart of
+		 * Fwd_Search_Problem for tasks that are not grounded. Action
+		 * indices are the ground actions of the task, interned when first
+		 * found applicable, so num_actions() grows during search.
+		 */
+		class Lifted_Search_Problem : public Search_Problem<Lifted_State>
+		{
+		public:
+			Lifted_Search_Problem(Lifted_Problem *);
+			virtual ~Lifted_Search_Problem();
+
+			virtual int num_actions() const;
+			virtual Lifted_State *init() const;
+			virtual bool goal(const Lifted_State &s) const;
+			// number of goal fluents s does not entail
+			unsigned goals_left(const Lifted_State &s) const;
+			virtual bool is_applicable(const Lifted_State &s, Action_Idx a) const;
+			virtual void applicable_set(const Lifted_State &s, std::vector<Action_Idx> &app_set) const;
+			virtual void applicable_set_v2(const Lifted_State &s, std::vector<Action_Idx> &app_set) const;
+			virtual float cost(const Lifted_State &s, Action_Idx a) const;
+			virtual Lifted_State *next(const Lifted_State &s, Action_Idx a) const;
+			virtual void print(std::ostream &os) const;
+
+			Lifted_Problem &task() { return *m_task; }
+			const Lifted_Problem &task() const { return *m_task; }
+
+			class Action_Iterator
+			{
+			public:
+				Action_Iterator(const Lifted_Search_Problem &p)
+						: m_problem(p)
+				{
+				}
+
+				int start(const Lifted_State &s)
+				{
+					m_app_set.clear();
+					m_problem.applicable_set_v2(s, m_app_set);
+					m_it = m_app_set.begin();
+					if (m_it == m_app_set.end())
+						return no_op;
+					return *m_it;
+				}
+
+				int next()
+				{
+					m_it++;
+					if (m_it == m_app_set.end())
+						return no_op;
+					return *m_it;
+				}
+
+			private:
+				const Lifted_Search_Problem &m_problem;
+				std::vector<Action_Idx> m_app_set;
+				std::vector<Action_Idx>::iterator m_it;
+			};
+
+		private:
+			Lifted_Problem *m_task;
+		};
+
+	}
+
+}
+
+#endif // lifted_search_prob.hxx
@@ -26,8 +26,14 @@ namespace aptk
 			bool cond_eff_edeletes(const Action *a, unsigned eff, unsigned p) const;
 
 			void add(const Fluent_Vec &group);
+			void clear()
+			{
+				m_mutex_groups.clear();
+				m_mutex_groups_bitmap.clear();
+			}
 
 			unsigned num_groups() const { return m_mutex_groups.size(); }
+			const Fluent_Vec &group(unsigned i) const { return m_mutex_groups[i]; }
 
 			void print(std::ostream &os) const;
 
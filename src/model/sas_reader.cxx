@@ -0,0 +1,337 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sas_reader.hxx>
+#include <strips_prob.hxx>
+#include <action.hxx>
+#include <cond_eff.hxx>
+#include <fluent.hxx>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <sstream>
+
+namespace aptk
+{
+
+	bool SAS_Reader::read(const std::string &path, STRIPS_Problem &p)
+	{
+		std::ifstream in(path);
+		if (!in)
+		{
+			m_error = "cannot open " + path;
+			return false;
+		}
+		return read(in, p);
+	}
+
+	bool SAS_Reader::fail(const std::string &msg)
+	{
+		m_error = "line " + std::to_string(m_line_no) + ": " + msg;
+		return false;
+	}
+
+	bool SAS_Reader::next_line(std::istream &in, std::string &line)
+	{
+		if (!std::getline(in, line))
+			return false;
+		m_line_no++;
+		while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+			line.pop_back();
+		return true;
+	}
+
+	bool SAS_Reader::expect(std::istream &in, const std::string &word)
+	{
+		std::string line;
+		if (!next_line(in, line) || line != word)
+			return fail("expected " + word);
+		return true;
+	}
+
+	bool SAS_Reader::read_number(std::istream &in, long &n, long lo, long hi)
+	{
+		std::string line;
+		if (!next_line(in, line))
+			return fail("unexpected end of file");
+		std::istringstream ss(line);
+		if (!(ss >> n) || n < lo || n > hi)
+			return fail("expected a number in [" + std::to_string(lo) + ", " + std::to_string(hi) + "]");
+		return true;
+	}
+
+	bool SAS_Reader::read_fact(std::istream &in, unsigned &var, unsigned &val)
+	{
+		std::string line;
+		if (!next_line(in, line))
+			return fail("unexpected end of file");
+		std::istringstream ss(line);
+		long v, d;
+		if (!(ss >> v >> d) || v < 0 || v >= (long)m_variables.size() ||
+				d < 0 || d >= (long)m_variables[v].values.size())
+			return fail("invalid fact");
+		var = v;
+		val = d;
+		return true;
+	}
+
+	std::string SAS_Reader::fluent_signature(const std::string &value, const std::string &var_name)
+	{
+		bool negated = false;
+		std::string atom;
+		if (value.compare(0, 5, "Atom ") == 0)
+			atom = value.substr(5);
+		else if (value.compare(0, 12, "NegatedAtom ") == 0)
+		{
+			atom = value.substr(12);
+			negated = true;
+		}
+		else
+			return "(none-of " + var_name + ")";
+
+		// pred(a, b) -> (pred a b)
+		std::string sig = "(";
+		for (char c : atom)
+		{
+			if (c == '(')
+				sig += ' ';
+			else if (c == ',' || c == ')')
+				continue;
+			else
+				sig += c;
+		}
+		if (sig.back() == ' ')
+			sig.pop_back();
+		sig += ')';
+		return negated ? "(not " + sig + ")" : sig;
+	}
+
+	void SAS_Reader::assign(unsigned var, long pre, unsigned val, Fluent_Vec &add, Fluent_Vec &del) const
+	{
+		add.push_back(fluent(var, val));
+		if (pre >= 0)
+		{
+			if ((unsigned)pre != val)
+				del.push_back(fluent(var, pre));
+			return;
+		}
+		for (unsigned d = 0; d < m_variables[var].values.size(); d++)
+			if (d != val)
+				del.push_back(fluent(var, d));
+	}
+
+	bool SAS_Reader::read(std::istream &in, STRIPS_Problem &p)
+	{
+		const long max_count = 1L << 30;
+		std::string line;
+		long n;
+		m_variables.clear();
+		m_error.clear();
+		m_line_no = 0;
+
+		if (!expect(in, "begin_version") || !read_number(in, n, 3, 3) || !expect(in, "end_version"))
+			return false;
+		if (!expect(in, "begin_metric") || !read_number(in, n, 0, 1) || !expect(in, "end_metric"))
+			return false;
+		m_metric = n == 1;
+
+		// Variables, one fluent per value
+		long num_vars;
+		if (!read_number(in, num_vars, 0, max_count))
+			return false;
+		m_variables.resize(num_vars);
+		unsigned num_fluents = 0;
+		for (auto &var : m_variables)
+		{
+			long layer, range;
+			if (!expect(in, "begin_variable") || !next_line(in, var.name) ||
+					!read_number(in, layer, -1, max_count) || !read_number(in, range, 1, max_count))
+				return false;
+			if (layer != -1)
+				return fail("derived variables are not supported");
+			var.first = num_fluents;
+			var.values.resize(range);
+			for (auto &value : var.values)
+				if (!next_line(in, value))
+					return fail("unexpected end of file");
+			if (!expect(in, "end_variable"))
+				return false;
+			num_fluents += range;
+		}
+		for (auto &var : m_variables)
+			for (auto &value : var.values)
+				STRIPS_Problem::add_fluent(p, fluent_signature(value, var.name));
+
+		// Mutex groups, added once negated values are fluents like any other
+		long num_groups;
+		if (!read_number(in, num_groups, 0, max_count))
+			return false;
+		std::vector<Fluent_Vec> groups(num_groups);
+		std::vector<bool> single_variable(num_groups, true);
+		for (unsigned g = 0; g < groups.size(); g++)
+		{
+			long size;
+			if (!expect(in, "begin_mutex_group") || !read_number(in, size, 0, max_count))
+				return false;
+			unsigned first_var = 0;
+			for (long k = 0; k < size; k++)
+			{
+				unsigned var, val;
+				if (!read_fact(in, var, val))
+					return false;
+				if (k == 0)
+					first_var = var;
+				else if (var != first_var)
+					single_variable[g] = false;
+				groups[g].push_back(fluent(var, val));
+			}
+			if (!expect(in, "end_mutex_group"))
+				return false;
+		}
+
+		// Initial state, one value per variable
+		Fluent_Vec init;
+		if (!expect(in, "begin_state"))
+			return false;
+		for (unsigned v = 0; v < m_variables.size(); v++)
+		{
+			if (!read_number(in, n, 0, (long)m_variables[v].values.size() - 1))
+				return false;
+			init.push_back(fluent(v, n));
+		}
+		if (!expect(in, "end_state"))
+			return false;
+
+		Fluent_Vec goal;
+		long num_goals;
+		if (!expect(in, "begin_goal") || !read_number(in, num_goals, 0, max_count))
+			return false;
+		for (long k = 0; k < num_goals; k++)
+		{
+			unsigned var, val;
+			if (!read_fact(in, var, val))
+				return false;
+			goal.push_back(fluent(var, val));
+		}
+		if (!expect(in, "end_goal"))
+			return false;
+
+		// Operators
+		long num_ops;
+		if (!read_number(in, num_ops, 0, max_count))
+			return false;
+		p.actions().reserve(num_ops);
+		for (long o = 0; o < num_ops; o++)
+		{
+			std::string name;
+			long num_prevail, num_effects, cost;
+			Fluent_Vec pre, add, del;
+			// (condition, add, del) of each conditional effect, the effects
+			// are only created once the whole operator has been read
+			std::vector<std::array<Fluent_Vec, 3>> ceff_defs;
+			if (!expect(in, "begin_operator") || !next_line(in, name) ||
+					!read_number(in, num_prevail, 0, max_count))
+				return false;
+			for (long k = 0; k < num_prevail; k++)
+			{
+				unsigned var, val;
+				if (!read_fact(in, var, val))
+					return false;
+				pre.push_back(fluent(var, val));
+			}
+			if (!read_number(in, num_effects, 0, max_count))
+				return false;
+			for (long k = 0; k < num_effects; k++)
+			{
+				if (!next_line(in, line))
+					return fail("unexpected end of file");
+				std::istringstream ss(line);
+				long num_cond, var, pre_val, post_val;
+				if (!(ss >> num_cond) || num_cond < 0)
+					return fail("invalid effect");
+				Fluent_Vec cond;
+				for (long c = 0; c < num_cond; c++)
+				{
+					long cv, cd;
+					if (!(ss >> cv >> cd) || cv < 0 || cv >= num_vars || cd < 0 ||
+							cd >= (long)m_variables[cv].values.size())
+						return fail("invalid effect condition");
+					cond.push_back(fluent(cv, cd));
+				}
+				if (!(ss >> var >> pre_val >> post_val) || var < 0 || var >= num_vars ||
+						pre_val < -1 || pre_val >= (long)m_variables[var].values.size() ||
+						post_val < 0 || post_val >= (long)m_variables[var].values.size())
+					return fail("invalid effect");
+				if (pre_val >= 0 && std::find(pre.begin(), pre.end(), fluent(var, pre_val)) == pre.end())
+					pre.push_back(fluent(var, pre_val));
+				if (cond.empty())
+				{
+					assign(var, pre_val, post_val, add, del);
+					continue;
+				}
+				Fluent_Vec ce_add, ce_del;
+				assign(var, pre_val, post_val, ce_add, ce_del);
+				ceff_defs.push_back({cond, ce_add, ce_del});
+			}
+			if (!read_number(in, cost, 0, max_count) || !expect(in, "end_operator"))
+				return false;
+			Conditional_Effect_Vec ceffs;
+			for (auto &def : ceff_defs)
+			{
+				Conditional_Effect *ce = new Conditional_Effect(p);
+				ce->define(def[0], def[1], def[2]);
+				ceffs.push_back(ce);
+			}
+			STRIPS_Problem::add_action(p, "(" + name + ")", pre, add, del, ceffs,
+																 m_metric ? (float)cost : 1.0f);
+		}
+
+		long num_axioms;
+		if (!read_number(in, num_axioms, 0, max_count))
+			return false;
+		if (num_axioms > 0)
+			return fail("axioms are not supported");
+
+		// A variable takes exactly one of its values, so its values are a
+		// mutex group, and translator groups within one variable add nothing
+		for (auto &var : m_variables)
+			if (var.values.size() >= 2)
+			{
+				Fluent_Vec group(var.values.size());
+				for (unsigned d = 0; d < group.size(); d++)
+					group[d] = var.first + d;
+				p.mutexes().add(group);
+			}
+		for (unsigned g = 0; g < groups.size(); g++)
+			if (groups[g].size() >= 2 && !single_variable[g])
+				p.mutexes().add(groups[g]);
+		STRIPS_Problem::set_init(p, init);
+		STRIPS_Problem::set_goal(p, goal);
+		return true;
+	}
+
+}
@@ -0,0 +1,96 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __SAS_READER__
+#define __SAS_READER__
+
+#include <types.hxx>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace aptk
+{
+	class STRIPS_Problem;
+
+	/**
+	 * Builds a STRIPS_Problem straight from the SAS+ task written by the
+	 * Fast Downward translator (output.sas, format version 3).
+	 *
+	 * Every value of a finite-domain variable becomes one fluent, so the
+	 * fluents of variable v are variables()[v].first onwards. Operators
+	 * become actions whose effects delete the other values of the
+	 * variables they assign. The values of every variable, and the
+	 * translator's mutex groups spanning several variables, are added to
+	 * the problem's Mutex_Set. Tasks with axioms are rejected.
+	 */
+	class SAS_Reader
+	{
+	public:
+		struct Variable
+		{
+			std::string name;
+			unsigned first; // fluent of value 0
+			std::vector<std::string> values;
+		};
+
+		SAS_Reader() : m_line_no(0), m_metric(false) {}
+
+		// Returns false on malformed or unsupported input, see error().
+		// p must be empty, and is left partially filled on failure
+		bool read(const std::string &path, STRIPS_Problem &p);
+		bool read(std::istream &in, STRIPS_Problem &p);
+
+		const std::string &error() const { return m_error; }
+		const std::vector<Variable> &variables() const { return m_variables; }
+		unsigned fluent(unsigned var, unsigned val) const { return m_variables[var].first + val; }
+		// false when the task has no action costs (all costs are 1)
+		bool has_metric() const { return m_metric; }
+
+		// Turns a translator value, like "Atom at(a, b)", into a signature
+		static std::string fluent_signature(const std::string &value, const std::string &var_name);
+
+	protected:
+		bool next_line(std::istream &in, std::string &line);
+		bool expect(std::istream &in, const std::string &word);
+		bool read_number(std::istream &in, long &n, long lo, long hi);
+		bool read_fact(std::istream &in, unsigned &var, unsigned &val);
+		bool fail(const std::string &msg);
+
+		// Adds the deletes of assigning val to var: pre if known, else every other value
+		void assign(unsigned var, long pre, unsigned val, Fluent_Vec &add, Fluent_Vec &del) const;
+
+	protected:
+		std::vector<Variable> m_variables;
+		std::string m_error;
+		unsigned m_line_no;
+		bool m_metric;
+	};
+
+}
+
+#endif // sas_reader.hxx
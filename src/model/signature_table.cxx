@@ -0,0 +1,215 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <signature_table.hxx>
+#include <types.hxx>
+#include <hash_table.hxx>
+#include <algorithm>
+
+namespace aptk
+{
+
+	Symbol_Table::Symbol_Table()
+			: m_current(nullptr), m_block_free(0)
+	{
+	}
+
+	const char *Symbol_Table::store(std::string_view s)
+	{
+		// Long strings get a block of their own
+		if (s.size() > BLOCK_SIZE / 4)
+		{
+			m_blocks.emplace_back(new char[s.size()]);
+			std::copy(s.begin(), s.end(), m_blocks.back().get());
+			return m_blocks.back().get();
+		}
+		if (m_current == nullptr || s.size() > m_block_free)
+		{
+			m_blocks.emplace_back(new char[BLOCK_SIZE]);
+			m_current = m_blocks.back().get();
+			m_block_free = BLOCK_SIZE;
+		}
+		char *dst = m_current + (BLOCK_SIZE - m_block_free);
+		std::copy(s.begin(), s.end(), dst);
+		m_block_free -= s.size();
+		return dst;
+	}
+
+	unsigned Symbol_Table::intern(std::string_view s)
+	{
+		auto it = m_index.find(s);
+		if (it != m_index.end())
+			return it->second;
+		std::string_view stored(store(s), s.size());
+		m_strings.push_back(stored);
+		m_index.emplace(stored, m_strings.size() - 1);
+		return m_strings.size() - 1;
+	}
+
+	int Symbol_Table::find(std::string_view s) const
+	{
+		auto it = m_index.find(s);
+		return it == m_index.end() ? -1 : (int)it->second;
+	}
+
+	size_t Symbol_Table::bytes() const
+	{
+		size_t b = m_strings.capacity() * sizeof(std::string_view);
+		for (auto s : m_strings)
+			b += s.size();
+		return b + m_index.size() * (sizeof(std::string_view) + 2 * sizeof(void *));
+	}
+
+	static inline bool is_separator(char c)
+	{
+		return c == ' ' || c == '(' || c == ')' || c == ',';
+	}
+
+	Signature_Table::Signature_Table(bool indexed)
+			: m_indexed(indexed)
+	{
+		m_offsets.push_back(0);
+	}
+
+	bool Signature_Table::encode(std::string_view sig, bool lookup_only) const
+	{
+		// The shape keeps the separators, with a '|' in place of each symbol
+		m_key.assign(1, 0);
+		m_shape.clear();
+		size_t i = 0, n = sig.size();
+		while (true)
+		{
+			size_t j = i;
+			while (j < n && is_separator(sig[j]))
+				j++;
+			m_shape.append(sig.substr(i, j - i));
+			if (j == n)
+				break;
+			m_shape.push_back('|');
+			size_t k = j;
+			while (k < n && !is_separator(sig[k]))
+				k++;
+			std::string_view sym = sig.substr(j, k - j);
+			if (lookup_only)
+			{
+				int id = m_symbols.find(sym);
+				if (id < 0)
+					return false;
+				m_key.push_back(id);
+			}
+			else
+				m_key.push_back(m_symbols.intern(sym));
+			i = k;
+		}
+		if (lookup_only)
+		{
+			int id = m_symbols.find(m_shape);
+			if (id < 0)
+				return false;
+			m_key[0] = id;
+		}
+		else
+			m_key[0] = m_symbols.intern(m_shape);
+		return true;
+	}
+
+	size_t Signature_Table::hash_key() const
+	{
+		Hash_Key h;
+		for (auto w : m_key)
+			h.add(w);
+		return h;
+	}
+
+	bool Signature_Table::matches_key(unsigned id) const
+	{
+		return m_offsets[id + 1] - m_offsets[id] == m_key.size() &&
+					 std::equal(m_key.begin(), m_key.end(), m_words.begin() + m_offsets[id]);
+	}
+
+	unsigned Signature_Table::add(std::string_view sig)
+	{
+		encode(sig, false);
+		unsigned id = size();
+		m_words.insert(m_words.end(), m_key.begin(), m_key.end());
+		m_offsets.push_back(m_words.size());
+		if (m_indexed)
+		{
+			// A signature added twice maps to its latest id
+			size_t h = hash_key();
+			auto range = m_lookup.equal_range(h);
+			for (auto it = range.first; it != range.second; ++it)
+				if (matches_key(it->second))
+				{
+					it->second = id;
+					return id;
+				}
+			m_lookup.emplace(h, id);
+		}
+		return id;
+	}
+
+	int Signature_Table::find(std::string_view sig) const
+	{
+		if (!m_indexed || !encode(sig, true))
+			return -1;
+		auto range = m_lookup.equal_range(hash_key());
+		for (auto it = range.first; it != range.second; ++it)
+			if (matches_key(it->second))
+				return it->second;
+		return -1;
+	}
+
+	std::string Signature_Table::str(unsigned id) const
+	{
+		std::string_view shape = m_symbols.str(m_words[m_offsets[id]]);
+		std::string s;
+		s.reserve(shape.size() + 8 * num_symbols(id));
+		const unsigned *sym = &m_words[m_offsets[id] + 1];
+		for (char c : shape)
+		{
+			if (c == '|')
+				s.append(m_symbols.str(*sym++));
+			else
+				s.push_back(c);
+		}
+		return s;
+	}
+
+	std::string_view Signature_Table::head(unsigned id) const
+	{
+		return num_symbols(id) > 0 ? symbol(id, 0) : std::string_view();
+	}
+
+	size_t Signature_Table::bytes() const
+	{
+		return m_symbols.bytes() + m_words.capacity() * sizeof(unsigned) +
+					 m_offsets.capacity() * sizeof(size_t) +
+					 m_lookup.size() * (sizeof(size_t) + sizeof(unsigned) + 2 * sizeof(void *));
+	}
+
+}
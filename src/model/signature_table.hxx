@@ -0,0 +1,114 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __SIGNATURE_TABLE__
+#define __SIGNATURE_TABLE__
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace aptk
+{
+
+	// Interns strings, each distinct string is stored once in a block arena
+	// and identified by a dense id
+	class Symbol_Table
+	{
+	public:
+		Symbol_Table();
+		Symbol_Table(const Symbol_Table &) = delete;
+		Symbol_Table &operator=(const Symbol_Table &) = delete;
+
+		unsigned intern(std::string_view s);
+		// Id of s, or -1 if it was never interned
+		int find(std::string_view s) const;
+		std::string_view str(unsigned id) const { return m_strings[id]; }
+
+		unsigned size() const { return m_strings.size(); }
+		size_t bytes() const;
+
+	protected:
+		const char *store(std::string_view s);
+
+		static const size_t BLOCK_SIZE = 1 << 16;
+		std::vector<std::unique_ptr<char[]>> m_blocks;
+		char *m_current;
+		size_t m_block_free;
+		std::vector<std::string_view> m_strings;
+		std::unordered_map<std::string_view, unsigned> m_index;
+	};
+
+	// Signatures of fluents or actions, as given by the front end, e.g.
+	// "(move a b)" or "Atom on(a, b)". A signature is split into symbols,
+	// maximal runs without blanks, parentheses or commas, and the separators
+	// between them. It is kept as the interned id of its separators (its
+	// shape) followed by the ids of its symbols, i.e. the schema or predicate
+	// and its objects, and is only rendered back into a string on demand.
+	class Signature_Table
+	{
+	public:
+		// Indexed tables also support lookup of signatures with find()
+		Signature_Table(bool indexed = false);
+		Signature_Table(const Signature_Table &) = delete;
+		Signature_Table &operator=(const Signature_Table &) = delete;
+
+		unsigned add(std::string_view sig);
+		// Id of the last signature added equal to sig, or -1 if none was
+		int find(std::string_view sig) const;
+
+		std::string str(unsigned id) const;
+		// First symbol of the signature, the schema name for actions
+		std::string_view head(unsigned id) const;
+		unsigned num_symbols(unsigned id) const { return m_offsets[id + 1] - m_offsets[id] - 1; }
+		std::string_view symbol(unsigned id, unsigned k) const { return m_symbols.str(m_words[m_offsets[id] + 1 + k]); }
+
+		unsigned size() const { return m_offsets.size() - 1; }
+		size_t bytes() const;
+
+	protected:
+		// Sets m_key to the shape and symbol ids of sig. When lookup_only,
+		// nothing is interned and false is returned if sig has parts that
+		// were never seen
+		bool encode(std::string_view sig, bool lookup_only) const;
+		size_t hash_key() const;
+		bool matches_key(unsigned id) const;
+
+		bool m_indexed;
+		mutable Symbol_Table m_symbols;
+		std::vector<unsigned> m_words;
+		std::vector<size_t> m_offsets;
+		std::unordered_multimap<size_t, unsigned> m_lookup;
+		mutable std::vector<unsigned> m_key;
+		mutable std::string m_shape;
+	};
+
+}
+
+#endif // signature_table.hxx
@@ -0,0 +1,149 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <state_packer.hxx>
+#include <strips_prob.hxx>
+#include <algorithm>
+#include <cassert>
+
+namespace aptk
+{
+
+	State_Packer::State_Packer(const STRIPS_Problem &prob)
+			: m_num_group_vars(0), m_num_words(0), m_num_bits(0)
+	{
+		const unsigned nf = prob.num_fluents();
+		const agnostic::Mutex_Set &mutexes = prob.mutexes();
+
+		std::vector<bool> in_init(nf, false);
+		for (auto p : prob.init())
+			in_init[p] = true;
+
+		// Larger groups first, so that they keep most of their fluents when
+		// groups overlap
+		std::vector<unsigned> order(mutexes.num_groups());
+		for (unsigned g = 0; g < order.size(); g++)
+			order[g] = g;
+		std::stable_sort(order.begin(), order.end(), [&](unsigned a, unsigned b)
+										 { return mutexes.group(a).size() > mutexes.group(b).size(); });
+
+		m_var_of.assign(nf, no_such_index);
+		for (auto g : order)
+		{
+			Fluent_Vec values;
+			unsigned true_in_init = 0;
+			for (auto p : mutexes.group(g))
+			{
+				if (p >= nf || m_var_of[p] != no_such_index || std::find(values.begin(), values.end(), p) != values.end())
+					continue;
+				values.push_back(p);
+				if (in_init[p])
+					true_in_init++;
+			}
+			// A group with two fluents true in init is not a mutex
+			if (values.size() < 2 || true_in_init > 1)
+				continue;
+			for (auto p : values)
+				m_var_of[p] = m_vars.size();
+			m_vars.push_back({values, 0, 0, 0});
+			m_num_group_vars++;
+		}
+
+		for (unsigned p = 0; p < nf; p++)
+		{
+			if (m_var_of[p] != no_such_index)
+				continue;
+			m_var_of[p] = m_vars.size();
+			m_vars.push_back({Fluent_Vec(1, p), 0, 0, 0});
+		}
+
+		for (auto &x : m_vars)
+		{
+			x.width = 1;
+			while ((1ul << x.width) < x.values.size() + 1)
+				x.width++;
+		}
+
+		// Next-fit of the widest variables first into words
+		std::vector<unsigned> by_width(m_vars.size());
+		for (unsigned x = 0; x < by_width.size(); x++)
+			by_width[x] = x;
+		std::stable_sort(by_width.begin(), by_width.end(), [&](unsigned a, unsigned b)
+										 { return m_vars[a].width > m_vars[b].width; });
+
+		const unsigned word_bits = sizeof(Word) * 8;
+		unsigned used = word_bits;
+		for (auto x : by_width)
+		{
+			Variable &var = m_vars[x];
+			assert(var.width < word_bits);
+			if (used + var.width > word_bits)
+			{
+				m_num_words++;
+				used = 0;
+			}
+			var.word = m_num_words - 1;
+			var.shift = used;
+			used += var.width;
+			m_num_bits += var.width;
+		}
+
+		m_word.resize(nf);
+		m_mask.resize(nf);
+		m_code.resize(nf);
+		for (auto &var : m_vars)
+			for (unsigned k = 0; k < var.values.size(); k++)
+			{
+				unsigned p = var.values[k];
+				m_word[p] = var.word;
+				m_mask[p] = ((Word(1) << var.width) - 1) << var.shift;
+				m_code[p] = Word(k + 1) << var.shift;
+			}
+	}
+
+	void State_Packer::encode(const Fluent_Vec &fv, Word_Vec &words) const
+	{
+		words.assign(m_num_words, 0);
+		for (auto p : fv)
+		{
+			assert((words[m_word[p]] & m_mask[p]) == 0);
+			words[m_word[p]] |= m_code[p];
+		}
+	}
+
+	void State_Packer::decode(const Word_Vec &words, Fluent_Vec &fv) const
+	{
+		fv.clear();
+		for (auto &var : m_vars)
+		{
+			Word value = (words[var.word] >> var.shift) & ((Word(1) << var.width) - 1);
+			if (value != 0)
+				fv.push_back(var.values[value - 1]);
+		}
+	}
+
+}
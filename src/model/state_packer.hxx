@@ -0,0 +1,103 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __STATE_PACKER__
+#define __STATE_PACKER__
+
+#include <types.hxx>
+#include <vector>
+
+namespace aptk
+{
+
+	class STRIPS_Problem;
+
+	// Finite-domain encoding of STRIPS states. Every mutex group of the
+	// problem becomes a variable whose value is the index of its true fluent,
+	// or 0 when none is, stored in ceil(log2(|group|+1)) bits. Fluents not
+	// covered by any group take one bit each. Variables never straddle a
+	// word, so a fluent is set, unset or tested with a single mask.
+	class State_Packer
+	{
+	public:
+		typedef unsigned Word;
+		typedef std::vector<Word> Word_Vec;
+
+		State_Packer(const STRIPS_Problem &prob);
+
+		unsigned num_vars() const { return m_vars.size(); }
+		unsigned num_group_vars() const { return m_num_group_vars; }
+		unsigned num_words() const { return m_num_words; }
+		unsigned num_bits() const { return m_num_bits; }
+
+		// Domain of variable x, value k > 0 stands for values(x)[k-1]
+		const Fluent_Vec &values(unsigned x) const { return m_vars[x].values; }
+		unsigned var_of(unsigned f) const { return m_var_of[f]; }
+
+		void encode(const Fluent_Vec &fv, Word_Vec &words) const;
+		void decode(const Word_Vec &words, Fluent_Vec &fv) const;
+
+		void set(Word_Vec &words, unsigned f) const
+		{
+			words[m_word[f]] = (words[m_word[f]] & ~m_mask[f]) | m_code[f];
+		}
+
+		void unset(Word_Vec &words, unsigned f) const
+		{
+			if (entails(words, f))
+				words[m_word[f]] &= ~m_mask[f];
+		}
+
+		bool entails(const Word_Vec &words, unsigned f) const
+		{
+			return (words[m_word[f]] & m_mask[f]) == m_code[f];
+		}
+
+	protected:
+		struct Variable
+		{
+			Fluent_Vec values;
+			unsigned width;
+			unsigned word;
+			unsigned shift;
+		};
+
+		std::vector<Variable> m_vars;
+		unsigned m_num_group_vars;
+		unsigned m_num_words;
+		unsigned m_num_bits;
+		// Per fluent: its variable, the word holding it and the mask and code
+		// of its value, both shifted into place
+		std::vector<unsigned> m_var_of;
+		std::vector<unsigned> m_word;
+		Word_Vec m_mask;
+		Word_Vec m_code;
+	};
+
+}
+
+#endif // state_packer.hxx
@@ -0,0 +1,398 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <strips_image.hxx>
+#include <strips_prob.hxx>
+#include <action.hxx>
+#include <fluent.hxx>
+#include <cond_eff.hxx>
+#include <cassert>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aptk
+{
+	namespace
+	{
+		const char IMAGE_MAGIC[8] = {'L', 'A', 'P', 'K', 'T', 'S', 'K', 0};
+		const uint32_t IMAGE_BYTE_ORDER = 0x01020304;
+
+		// Appends a row to a CSR table, offs must start with 0
+		template <typename Vec>
+		void append_row(std::vector<uint32_t> &offs, std::vector<uint32_t> &idx, const Vec &row)
+		{
+			idx.insert(idx.end(), row.begin(), row.end());
+			offs.push_back(idx.size());
+		}
+
+		void append_string(std::vector<uint64_t> &offs, std::vector<char> &chars, const std::string &s)
+		{
+			chars.insert(chars.end(), s.begin(), s.end());
+			offs.push_back(chars.size());
+		}
+	}
+
+	STRIPS_Image::STRIPS_Image()
+			: m_data(nullptr), m_size(0)
+	{
+	}
+
+	STRIPS_Image::~STRIPS_Image()
+	{
+		close();
+	}
+
+	bool STRIPS_Image::write(const STRIPS_Problem &p, const std::string &path)
+	{
+		std::string domain_name = p.domain_name(), problem_name = p.problem_name();
+		std::vector<char> domain(domain_name.begin(), domain_name.end());
+		std::vector<char> problem(problem_name.begin(), problem_name.end());
+		std::vector<uint64_t> fluent_offs, action_offs;
+		std::vector<char> fluent_names, action_names;
+		std::vector<float> costs;
+		std::vector<uint32_t> pre_offs, pre, add_offs, add, del_offs, del;
+		std::vector<uint32_t> ceff_offs, ceff_pre_offs, ceff_pre, ceff_add_offs, ceff_add, ceff_del_offs, ceff_del;
+		std::vector<uint32_t> init(p.init().begin(), p.init().end());
+		std::vector<uint32_t> goal(p.goal().begin(), p.goal().end());
+		std::vector<uint32_t> mutex_offs, mutex;
+
+		fluent_offs.push_back(0);
+		for (auto f : p.fluents())
+			append_string(fluent_offs, fluent_names, f->signature());
+
+		action_offs.push_back(0);
+		pre_offs.push_back(0);
+		add_offs.push_back(0);
+		del_offs.push_back(0);
+		ceff_offs.push_back(0);
+		ceff_pre_offs.push_back(0);
+		ceff_add_offs.push_back(0);
+		ceff_del_offs.push_back(0);
+		for (auto a : p.actions())
+		{
+			append_string(action_offs, action_names, a->signature());
+			costs.push_back(a->cost());
+			append_row(pre_offs, pre, a->prec_vec());
+			append_row(add_offs, add, a->add_vec());
+			append_row(del_offs, del, a->del_vec());
+			for (auto ce : a->ceff_vec())
+			{
+				append_row(ceff_pre_offs, ceff_pre, ce->prec_vec());
+				append_row(ceff_add_offs, ceff_add, ce->add_vec());
+				append_row(ceff_del_offs, ceff_del, ce->del_vec());
+			}
+			ceff_offs.push_back(ceff_pre_offs.size() - 1);
+		}
+
+		mutex_offs.push_back(0);
+		for (unsigned g = 0; g < p.mutexes().num_groups(); g++)
+			append_row(mutex_offs, mutex, p.mutexes().group(g));
+
+		// Lay out the sections after the header, 8-byte aligned
+		Header h;
+		std::memset(&h, 0, sizeof(h));
+		std::memcpy(h.magic, IMAGE_MAGIC, sizeof(h.magic));
+		h.version = VERSION;
+		h.byte_order = IMAGE_BYTE_ORDER;
+
+		std::vector<std::pair<const void *, size_t>> blobs(NUM_SECTIONS);
+		auto place = [&](Section s, const auto &v)
+		{
+			h.sections[s].count = v.size();
+			blobs[s] = std::make_pair((const void *)v.data(), v.size() * sizeof(v[0]));
+		};
+		place(DOMAIN_NAME, domain);
+		place(PROBLEM_NAME, problem);
+		place(FLUENT_NAME_OFFS, fluent_offs);
+		place(FLUENT_NAMES, fluent_names);
+		place(ACTION_NAME_OFFS, action_offs);
+		place(ACTION_NAMES, action_names);
+		place(ACTION_COST, costs);
+		place(PRE_OFFS, pre_offs);
+		place(PRE, pre);
+		place(ADD_OFFS, add_offs);
+		place(ADD, add);
+		place(DEL_OFFS, del_offs);
+		place(DEL, del);
+		place(CEFF_OFFS, ceff_offs);
+		place(CEFF_PRE_OFFS, ceff_pre_offs);
+		place(CEFF_PRE, ceff_pre);
+		place(CEFF_ADD_OFFS, ceff_add_offs);
+		place(CEFF_ADD, ceff_add);
+		place(CEFF_DEL_OFFS, ceff_del_offs);
+		place(CEFF_DEL, ceff_del);
+		place(INIT, init);
+		place(GOAL, goal);
+		place(MUTEX_OFFS, mutex_offs);
+		place(MUTEX, mutex);
+
+		uint64_t pos = sizeof(Header);
+		for (unsigned s = 0; s < NUM_SECTIONS; s++)
+		{
+			pos = (pos + 7) & ~uint64_t(7);
+			h.sections[s].offset = pos;
+			pos += blobs[s].second;
+		}
+		h.file_size = pos;
+
+		// Write to a temporary file and rename it, so that readers never
+		// map a partially written image
+		std::string tmp_path = path + ".tmp";
+		{
+			std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+			if (!out)
+				return false;
+			out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+			const char zeros[8] = {0};
+			uint64_t written = sizeof(Header);
+			for (unsigned s = 0; s < NUM_SECTIONS; s++)
+			{
+				out.write(zeros, h.sections[s].offset - written);
+				out.write(reinterpret_cast<const char *>(blobs[s].first), blobs[s].second);
+				written = h.sections[s].offset + blobs[s].second;
+			}
+			if (!out)
+				return false;
+		}
+		std::remove(path.c_str());
+		return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+	}
+
+	bool STRIPS_Image::open(const std::string &path)
+	{
+		close();
+#ifdef _WIN32
+		std::ifstream in(path, std::ios::binary);
+		if (!in)
+			return false;
+		m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header))
+		{
+			::close(fd);
+			return false;
+		}
+		void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (addr == MAP_FAILED)
+			return false;
+		m_data = static_cast<const char *>(addr);
+		m_size = st.st_size;
+#endif
+		if (!validate(m_size))
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void STRIPS_Image::close()
+	{
+		if (m_data == nullptr)
+			return;
+#ifndef _WIN32
+		munmap(const_cast<char *>(m_data), m_size);
+#endif
+		m_buffer.clear();
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	bool STRIPS_Image::validate(size_t size) const
+	{
+		if (size < sizeof(Header))
+			return false;
+		const Header &h = header();
+		if (std::memcmp(h.magic, IMAGE_MAGIC, sizeof(h.magic)) != 0 || h.version != VERSION ||
+				h.byte_order != IMAGE_BYTE_ORDER || h.file_size != size)
+			return false;
+
+		for (unsigned s = 0; s < NUM_SECTIONS; s++)
+		{
+			size_t elem = 4;
+			if (s == DOMAIN_NAME || s == PROBLEM_NAME || s == FLUENT_NAMES || s == ACTION_NAMES)
+				elem = 1;
+			else if (s == FLUENT_NAME_OFFS || s == ACTION_NAME_OFFS)
+				elem = 8;
+			const Section_Entry &e = h.sections[s];
+			if (e.offset % 8 != 0 || e.offset > size || e.count > (size - e.offset) / elem)
+				return false;
+		}
+
+		// Tables must have one row per element and stay within their index arrays
+		auto check_rows = [&](Section offs, Section idx, uint64_t rows, uint64_t bound)
+		{
+			if (count(offs) != rows + 1)
+				return false;
+			const uint32_t *o = array<uint32_t>(offs);
+			if (o[0] != 0 || o[rows] != count(idx))
+				return false;
+			for (uint64_t i = 0; i < rows; i++)
+				if (o[i] > o[i + 1])
+					return false;
+			const uint32_t *x = array<uint32_t>(idx);
+			for (uint64_t i = 0; i < count(idx); i++)
+				if (x[i] >= bound)
+					return false;
+			return true;
+		};
+		auto check_names = [&](Section offs, Section chars, uint64_t rows)
+		{
+			if (count(offs) != rows + 1)
+				return false;
+			const uint64_t *o = array<uint64_t>(offs);
+			if (o[0] != 0 || o[rows] != count(chars))
+				return false;
+			for (uint64_t i = 0; i < rows; i++)
+				if (o[i] > o[i + 1])
+					return false;
+			return true;
+		};
+		if (count(FLUENT_NAME_OFFS) == 0 || count(CEFF_PRE_OFFS) == 0 || count(MUTEX_OFFS) == 0)
+			return false;
+		uint64_t nf = count(FLUENT_NAME_OFFS) - 1;
+		uint64_t na = count(ACTION_COST);
+		uint64_t nce = count(CEFF_PRE_OFFS) - 1;
+		if (!check_names(FLUENT_NAME_OFFS, FLUENT_NAMES, nf) ||
+				!check_names(ACTION_NAME_OFFS, ACTION_NAMES, na) ||
+				!check_rows(PRE_OFFS, PRE, na, nf) ||
+				!check_rows(ADD_OFFS, ADD, na, nf) ||
+				!check_rows(DEL_OFFS, DEL, na, nf) ||
+				!check_rows(CEFF_PRE_OFFS, CEFF_PRE, nce, nf) ||
+				!check_rows(CEFF_ADD_OFFS, CEFF_ADD, nce, nf) ||
+				!check_rows(CEFF_DEL_OFFS, CEFF_DEL, nce, nf) ||
+				!check_rows(MUTEX_OFFS, MUTEX, count(MUTEX_OFFS) - 1, nf))
+			return false;
+		// Conditional effects of each action are a range of the ceff tables
+		if (count(CEFF_OFFS) != na + 1)
+			return false;
+		const uint32_t *ce = array<uint32_t>(CEFF_OFFS);
+		if (ce[0] != 0 || ce[na] != nce)
+			return false;
+		for (uint64_t a = 0; a < na; a++)
+			if (ce[a] > ce[a + 1])
+				return false;
+		for (auto p : whole(INIT))
+			if (p >= nf)
+				return false;
+		for (auto p : whole(GOAL))
+			if (p >= nf)
+				return false;
+		return true;
+	}
+
+	std::string STRIPS_Image::string(Section offs, Section chars, unsigned i) const
+	{
+		const uint64_t *o = array<uint64_t>(offs);
+		return std::string(array<char>(chars) + o[i], o[i + 1] - o[i]);
+	}
+
+	std::string STRIPS_Image::domain_name() const
+	{
+		return std::string(array<char>(DOMAIN_NAME), count(DOMAIN_NAME));
+	}
+
+	std::string STRIPS_Image::problem_name() const
+	{
+		return std::string(array<char>(PROBLEM_NAME), count(PROBLEM_NAME));
+	}
+
+	unsigned STRIPS_Image::num_fluents() const { return count(FLUENT_NAME_OFFS) - 1; }
+	unsigned STRIPS_Image::num_actions() const { return count(ACTION_COST); }
+	unsigned STRIPS_Image::num_cond_effects() const { return count(CEFF_PRE_OFFS) - 1; }
+	unsigned STRIPS_Image::num_mutex_groups() const { return count(MUTEX_OFFS) - 1; }
+
+	std::string STRIPS_Image::fluent_signature(unsigned f) const
+	{
+		return string(FLUENT_NAME_OFFS, FLUENT_NAMES, f);
+	}
+
+	std::string STRIPS_Image::action_signature(unsigned a) const
+	{
+		return string(ACTION_NAME_OFFS, ACTION_NAMES, a);
+	}
+
+	float STRIPS_Image::action_cost(unsigned a) const
+	{
+		return array<float>(ACTION_COST)[a];
+	}
+
+	void STRIPS_Image::load(STRIPS_Problem &p) const
+	{
+		assert(is_open());
+		assert(p.num_fluents() == 0 && p.num_actions() == 0);
+		p.set_domain_name(domain_name());
+		p.set_problem_name(problem_name());
+
+		p.fluents().reserve(num_fluents());
+		for (unsigned f = 0; f < num_fluents(); f++)
+			STRIPS_Problem::add_fluent(p, fluent_signature(f));
+
+		p.actions().reserve(num_actions());
+		for (unsigned a = 0; a < num_actions(); a++)
+		{
+			Fluent_Vec pre(prec(a).begin(), prec(a).end());
+			Fluent_Vec adds(add(a).begin(), add(a).end());
+			Fluent_Vec dels(del(a).begin(), del(a).end());
+			Conditional_Effect_Vec ceffs;
+			for (unsigned e = ceff_begin(a); e < ceff_begin(a + 1); e++)
+			{
+				Fluent_Vec ce_pre(ceff_prec(e).begin(), ceff_prec(e).end());
+				Fluent_Vec ce_add(ceff_add(e).begin(), ceff_add(e).end());
+				Fluent_Vec ce_del(ceff_del(e).begin(), ceff_del(e).end());
+				Conditional_Effect *ce = new Conditional_Effect(p);
+				ce->define(ce_pre, ce_add, ce_del);
+				ceffs.push_back(ce);
+			}
+			STRIPS_Problem::add_action(p, action_signature(a), pre, adds, dels, ceffs, action_cost(a));
+		}
+
+		for (unsigned g = 0; g < num_mutex_groups(); g++)
+			p.mutexes().add(Fluent_Vec(mutex_group(g).begin(), mutex_group(g).end()));
+
+		STRIPS_Problem::set_init(p, Fluent_Vec(init().begin(), init().end()));
+		STRIPS_Problem::set_goal(p, Fluent_Vec(goal().begin(), goal().end()));
+	}
+
+}
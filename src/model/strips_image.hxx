@@ -0,0 +1,189 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __STRIPS_IMAGE__
+#define __STRIPS_IMAGE__
+
+#include <types.hxx>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace aptk
+{
+	class STRIPS_Problem;
+
+	/**
+	 * A grounded STRIPS task stored as flat arrays in a binary file.
+	 * The file is memory-mapped read-only, so loading does not parse
+	 * anything and processes opening the same file share its pages.
+	 *
+	 * Fluents, actions, conditional effects and mutex groups are stored as
+	 * CSR tables (an offsets array plus an index array). Signatures are
+	 * stored the same way, as offsets into a character blob.
+	 *
+	 * The format has a version number and records the byte order. Images
+	 * written by an incompatible build are rejected by open().
+	 */
+	class STRIPS_Image
+	{
+	public:
+		static const uint32_t VERSION = 1;
+
+		// Contiguous read-only view of an index list in the image
+		class Range
+		{
+		public:
+			Range(const uint32_t *first = nullptr, const uint32_t *last = nullptr)
+					: m_first(first), m_last(last) {}
+			const uint32_t *begin() const { return m_first; }
+			const uint32_t *end() const { return m_last; }
+			size_t size() const { return m_last - m_first; }
+			bool empty() const { return m_first == m_last; }
+			uint32_t operator[](size_t i) const { return m_first[i]; }
+
+		private:
+			const uint32_t *m_first;
+			const uint32_t *m_last;
+		};
+
+		STRIPS_Image();
+		~STRIPS_Image();
+		STRIPS_Image(const STRIPS_Image &) = delete;
+		STRIPS_Image &operator=(const STRIPS_Image &) = delete;
+
+		// Writes the task to path, returns false on I/O errors
+		static bool write(const STRIPS_Problem &p, const std::string &path);
+
+		// Maps the image at path, returns false if missing or invalid
+		bool open(const std::string &path);
+		void close();
+		bool is_open() const { return m_data != nullptr; }
+
+		// Creates fluents, actions, init, goal and mutexes of the image in p,
+		// which must be empty. Action tables are not built, call
+		// p.make_action_tables() as with any other task
+		void load(STRIPS_Problem &p) const;
+
+		std::string domain_name() const;
+		std::string problem_name() const;
+		unsigned num_fluents() const;
+		unsigned num_actions() const;
+		unsigned num_cond_effects() const;
+		unsigned num_mutex_groups() const;
+
+		std::string fluent_signature(unsigned f) const;
+		std::string action_signature(unsigned a) const;
+		float action_cost(unsigned a) const;
+		Range prec(unsigned a) const { return row(PRE_OFFS, PRE, a); }
+		Range add(unsigned a) const { return row(ADD_OFFS, ADD, a); }
+		Range del(unsigned a) const { return row(DEL_OFFS, DEL, a); }
+		// conditional effects of action a are ceff_begin(a) .. ceff_begin(a+1)-1
+		unsigned ceff_begin(unsigned a) const { return array<uint32_t>(CEFF_OFFS)[a]; }
+		Range ceff_prec(unsigned e) const { return row(CEFF_PRE_OFFS, CEFF_PRE, e); }
+		Range ceff_add(unsigned e) const { return row(CEFF_ADD_OFFS, CEFF_ADD, e); }
+		Range ceff_del(unsigned e) const { return row(CEFF_DEL_OFFS, CEFF_DEL, e); }
+		Range init() const { return whole(INIT); }
+		Range goal() const { return whole(GOAL); }
+		Range mutex_group(unsigned g) const { return row(MUTEX_OFFS, MUTEX, g); }
+
+	protected:
+		enum Section
+		{
+			DOMAIN_NAME = 0,
+			PROBLEM_NAME,
+			FLUENT_NAME_OFFS,
+			FLUENT_NAMES,
+			ACTION_NAME_OFFS,
+			ACTION_NAMES,
+			ACTION_COST,
+			PRE_OFFS,
+			PRE,
+			ADD_OFFS,
+			ADD,
+			DEL_OFFS,
+			DEL,
+			CEFF_OFFS,
+			CEFF_PRE_OFFS,
+			CEFF_PRE,
+			CEFF_ADD_OFFS,
+			CEFF_ADD,
+			CEFF_DEL_OFFS,
+			CEFF_DEL,
+			INIT,
+			GOAL,
+			MUTEX_OFFS,
+			MUTEX,
+			NUM_SECTIONS
+		};
+
+		struct Section_Entry
+		{
+			uint64_t offset; // in bytes, from the start of the file
+			uint64_t count;	 // number of elements
+		};
+
+		struct Header
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t byte_order;
+			uint64_t file_size;
+			Section_Entry sections[NUM_SECTIONS];
+		};
+
+		template <typename T>
+		const T *array(Section s) const
+		{
+			return reinterpret_cast<const T *>(m_data + header().sections[s].offset);
+		}
+		uint64_t count(Section s) const { return header().sections[s].count; }
+		const Header &header() const { return *reinterpret_cast<const Header *>(m_data); }
+		Range row(Section offs, Section idx, unsigned i) const
+		{
+			const uint32_t *o = array<uint32_t>(offs);
+			const uint32_t *x = array<uint32_t>(idx);
+			return Range(x + o[i], x + o[i + 1]);
+		}
+		Range whole(Section s) const
+		{
+			const uint32_t *x = array<uint32_t>(s);
+			return Range(x, x + count(s));
+		}
+		std::string string(Section offs, Section chars, unsigned i) const;
+		bool validate(size_t size) const;
+
+	protected:
+		const char *m_data;
+		size_t m_size;
+		std::vector<char> m_buffer; // used where mmap is not available
+	};
+
+}
+
+#endif // strips_image.hxx
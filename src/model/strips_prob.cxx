@@ -28,9 +28,15 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <strips_prob.hxx>
 #include <action.hxx>
 #include <fluent.hxx>
+#include <cond_eff.hxx>
+#include <h2_mutexes.hxx>
+#include <state_packer.hxx>
+#include <strips_state.hxx>
+#include <resources_control.hxx>
 #include <cassert>
 #include <map>
 #include <iostream>
+#include <random>
 
 namespace aptk
 {
@@ -38,12 +44,17 @@ namespace aptk
 	STRIPS_Problem::STRIPS_Problem(std::string dom_name, std::string prob_name)
 			: m_domain_name(dom_name), m_problem_name(prob_name),
 				m_num_fluents(0), m_num_actions(0), m_end_operator_id(no_such_index), m_dummy_goal_id(no_such_index),
-				m_succ_gen(*this), m_succ_gen_v2(*this), m_has_cond_effs(false), m_verbose(true), m_mutexes(*this), m_succ_gen_v3(*this)
+				m_fluent_signatures(true), m_succ_gen(*this), m_succ_gen_v2(*this), m_has_cond_effs(false), m_verbose(true), m_mutexes(*this), m_succ_gen_v3(*this),
+				m_reduce_task(false), m_packed_states(false), m_state_packer(nullptr),
+				m_adaptive_states(false), m_state_representation(State_Representation::Dual), m_average_state_size(0.0f)
 	{
 	}
 
 	STRIPS_Problem::~STRIPS_Problem()
 	{
+		delete m_state_packer;
+		for (auto f : m_removed_fluents)
+			delete f;
 	}
 
 	void STRIPS_Problem::make_action_tables(bool generate_match_tree)
@@ -58,6 +69,20 @@ namespace aptk
 		for (unsigned k = 0; k < actions().size(); k++)
 			register_action_in_tables(actions()[k]);
 
+		if (m_reduce_task)
+			reduce();
+
+		delete m_state_packer;
+		m_state_packer = nullptr;
+		if (m_packed_states)
+		{
+			m_state_packer = new State_Packer(*this);
+			if (m_verbose)
+				std::cout << "Packed states: " << m_state_packer->num_vars() << " variables ("
+									<< m_state_packer->num_group_vars() << " from mutex groups) in "
+									<< m_state_packer->num_words() << " words, " << num_fluents() << " fluents" << std::endl;
+		}
+
 		if (generate_match_tree)
 		{
 			m_succ_gen_v2.build();
@@ -67,10 +92,56 @@ namespace aptk
 		}
 		else
 			m_succ_gen_v3.init();
+
+		if (m_adaptive_states)
+			choose_state_representation();
+	}
+
+	void STRIPS_Problem::choose_state_representation()
+	{
+		const unsigned num_walks = 20;
+		const unsigned walk_length = 50;
+
+		// Sampled states are dual, whatever was chosen before
+		m_state_representation = State_Representation::Dual;
+		std::mt19937 rng(1);
+		std::vector<int> app;
+		double total = 0.0;
+		unsigned samples = 0;
+		for (unsigned w = 0; w < num_walks; w++)
+		{
+			State *s = new State(*this);
+			s->set(init());
+			for (unsigned k = 0; k < walk_length; k++)
+			{
+				total += s->fluent_vec().size();
+				samples++;
+				app.clear();
+				applicable_actions_v2(*s, app);
+				if (app.empty())
+					break;
+				State *succ = s->progress_through(*actions()[app[rng() % app.size()]]);
+				delete s;
+				s = succ;
+			}
+			delete s;
+		}
+		m_average_state_size = samples ? total / samples : 0.0f;
+
+		// A vector spends 32 bits per true fluent, a bitset one per fluent
+		if (m_average_state_size * 32 < num_fluents())
+			m_state_representation = State_Representation::Sparse;
+		else
+			m_state_representation = State_Representation::Dense;
+
+		if (m_verbose)
+			std::cout << "States are " << (m_state_representation == State_Representation::Sparse ? "sparse" : "dense")
+								<< ", " << m_average_state_size << " of " << num_fluents() << " fluents true on average" << std::endl;
 	}
 
 	void STRIPS_Problem::register_action_in_tables(Action *a)
 	{
+		a->compile_ceffs();
 		if (a->prec_vec().empty())
 		{
 			m_empty_precs.push_back(a);
@@ -103,6 +174,263 @@ namespace aptk
 		}
 	}
 
+	void STRIPS_Problem::clear_action_tables()
+	{
+		m_requiring.assign(fluents().size(), std::vector<const Action *>());
+		m_deleting.assign(fluents().size(), std::vector<const Action *>());
+		m_edeleting.assign(fluents().size(), std::vector<const Action *>());
+		m_adding.assign(fluents().size(), std::vector<const Action *>());
+		m_ceffs_adding.assign(fluents().size(), std::vector<std::pair<unsigned, const Action *>>());
+		m_empty_precs.clear();
+	}
+
+	void STRIPS_Problem::reduce()
+	{
+		double t0 = time_used();
+		unsigned nf = num_fluents();
+		unsigned na = num_actions();
+
+		// Delete relaxed reachability with one counter of pending conditions
+		// per unit: units [0, na) are actions, the rest conditional effects,
+		// which also wait for their action
+		std::vector<unsigned> first_ceff(na + 1, na);
+		for (unsigned a = 0; a < na; a++)
+			first_ceff[a + 1] = first_ceff[a] + actions()[a]->ceff_vec().size();
+		unsigned nu = first_ceff[na];
+		std::vector<unsigned> unit_action(nu);
+		std::vector<unsigned> pending(nu);
+		std::vector<std::vector<unsigned>> waiting(nf);
+		auto unit_adds = [&](unsigned u) -> const Fluent_Vec &
+		{
+			if (u < na)
+				return actions()[u]->add_vec();
+			return actions()[unit_action[u]]->ceff_vec()[u - first_ceff[unit_action[u]]]->add_vec();
+		};
+		for (unsigned a = 0; a < na; a++)
+		{
+			unit_action[a] = a;
+			pending[a] = actions()[a]->prec_vec().size();
+			for (auto p : actions()[a]->prec_vec())
+				waiting[p].push_back(a);
+			for (unsigned u = first_ceff[a]; u < first_ceff[a + 1]; u++)
+			{
+				const Fluent_Vec &cond = actions()[a]->ceff_vec()[u - first_ceff[a]]->prec_vec();
+				unit_action[u] = a;
+				pending[u] = cond.size() + 1;
+				for (auto p : cond)
+					waiting[p].push_back(u);
+			}
+		}
+
+		std::vector<bool> reached_fluent(nf, false);
+		std::vector<bool> reached_unit(nu, false);
+		std::vector<unsigned> fluent_queue, unit_queue;
+		for (auto p : init())
+			if (!reached_fluent[p])
+			{
+				reached_fluent[p] = true;
+				fluent_queue.push_back(p);
+			}
+		for (unsigned a = 0; a < na; a++)
+			if (pending[a] == 0)
+				unit_queue.push_back(a);
+		while (!fluent_queue.empty() || !unit_queue.empty())
+		{
+			while (!unit_queue.empty())
+			{
+				unsigned u = unit_queue.back();
+				unit_queue.pop_back();
+				reached_unit[u] = true;
+				for (auto p : unit_adds(u))
+					if (!reached_fluent[p])
+					{
+						reached_fluent[p] = true;
+						fluent_queue.push_back(p);
+					}
+				if (u < na)
+					for (unsigned c = first_ceff[u]; c < first_ceff[u + 1]; c++)
+						if (--pending[c] == 0)
+							unit_queue.push_back(c);
+			}
+			while (!fluent_queue.empty())
+			{
+				unsigned p = fluent_queue.back();
+				fluent_queue.pop_back();
+				for (auto u : waiting[p])
+					if (--pending[u] == 0)
+						unit_queue.push_back(u);
+			}
+		}
+
+		// Backward relevance from the goal over reachable units. A relevant
+		// action keeps all its reachable conditional effects, so their
+		// conditions are relevant too
+		std::vector<std::vector<unsigned>> adders(nf);
+		for (unsigned u = 0; u < nu; u++)
+			if (reached_unit[u])
+				for (auto p : unit_adds(u))
+					adders[p].push_back(u);
+		std::vector<bool> relevant_fluent(nf, false);
+		std::vector<bool> relevant_action(na, false);
+		auto make_relevant = [&](unsigned p)
+		{
+			if (relevant_fluent[p])
+				return;
+			relevant_fluent[p] = true;
+			fluent_queue.push_back(p);
+		};
+		for (auto p : goal())
+			make_relevant(p);
+		while (!fluent_queue.empty())
+		{
+			unsigned p = fluent_queue.back();
+			fluent_queue.pop_back();
+			for (auto u : adders[p])
+			{
+				unsigned a = unit_action[u];
+				if (relevant_action[a])
+					continue;
+				relevant_action[a] = true;
+				for (auto q : actions()[a]->prec_vec())
+					make_relevant(q);
+				for (unsigned c = first_ceff[a]; c < first_ceff[a + 1]; c++)
+					if (reached_unit[c])
+						for (auto q : actions()[a]->ceff_vec()[c - first_ceff[a]]->prec_vec())
+							make_relevant(q);
+			}
+		}
+
+		m_reduction = Task_Reduction();
+		m_reduction.fluents_before = nf;
+		m_reduction.actions_before = na;
+		for (unsigned p = 0; p < nf; p++)
+		{
+			if (!reached_fluent[p])
+				m_reduction.unreachable_fluents++;
+			else if (!relevant_fluent[p])
+				m_reduction.irrelevant_fluents++;
+		}
+		for (unsigned a = 0; a < na; a++)
+		{
+			if (!reached_unit[a])
+				m_reduction.unreachable_actions++;
+			else if (!relevant_action[a])
+				m_reduction.irrelevant_actions++;
+		}
+
+		// Unreachable goals are kept, so the task stays unsolvable
+		std::vector<bool> keep_ceff(reached_unit.begin() + na, reached_unit.end());
+		bool all_kept = std::find(relevant_fluent.begin(), relevant_fluent.end(), false) == relevant_fluent.end() &&
+										std::find(relevant_action.begin(), relevant_action.end(), false) == relevant_action.end() &&
+										std::find(keep_ceff.begin(), keep_ceff.end(), false) == keep_ceff.end();
+		if (!all_kept)
+		{
+			remove_fluents_and_actions(relevant_fluent, relevant_action, keep_ceff);
+			clear_action_tables();
+			for (unsigned k = 0; k < actions().size(); k++)
+				register_action_in_tables(actions()[k]);
+		}
+		m_reduction.time = time_used() - t0;
+
+		if (m_verbose)
+			std::cout << "Task reduced in " << m_reduction.time << " secs: #Fluents " << nf << " -> " << num_fluents()
+								<< " (" << m_reduction.unreachable_fluents << " unreachable, " << m_reduction.irrelevant_fluents
+								<< " irrelevant), #Actions " << na << " -> " << num_actions()
+								<< " (" << m_reduction.unreachable_actions << " unreachable, " << m_reduction.irrelevant_actions
+								<< " irrelevant)" << std::endl;
+	}
+
+	void STRIPS_Problem::remove_fluents_and_actions(const std::vector<bool> &keep_fluent, const std::vector<bool> &keep_action,
+																								 const std::vector<bool> &keep_ceff)
+	{
+		Index_Vec new_fluent(num_fluents(), no_such_index);
+		unsigned nf = 0;
+		for (unsigned p = 0; p < num_fluents(); p++)
+			if (keep_fluent[p])
+				new_fluent[p] = nf++;
+
+		// Removed fluents are only freed with the problem, the front end may
+		// still point to them
+		Fluent_Ptr_Vec kept_fluents;
+		m_const_fluents.clear();
+		for (unsigned p = 0; p < num_fluents(); p++)
+			if (new_fluent[p] != no_such_index)
+			{
+				m_fluents[p]->set_index(new_fluent[p]);
+				kept_fluents.push_back(m_fluents[p]);
+				m_const_fluents.push_back(m_fluents[p]);
+			}
+			else
+				m_removed_fluents.push_back(m_fluents[p]);
+		m_fluents.swap(kept_fluents);
+		m_num_fluents = nf;
+		for (auto &p : m_fluent_of_signature)
+			if (p != no_such_index)
+				p = new_fluent[p];
+
+		unsigned c = 0;
+		unsigned na = 0;
+		unsigned end_operator = no_such_index;
+		Action_Ptr_Vec kept_actions;
+		m_const_actions.clear();
+		for (unsigned a = 0; a < m_actions.size(); a++)
+		{
+			Action *act = m_actions[a];
+			if (!keep_action[a])
+			{
+				c += act->ceff_vec().size();
+				for (auto ceff : act->ceff_vec())
+					delete ceff;
+				delete act;
+				continue;
+			}
+			Conditional_Effect_Vec ceffs;
+			for (auto ceff : act->ceff_vec())
+				if (keep_ceff[c++])
+					ceffs.push_back(ceff);
+				else
+					delete ceff;
+			act->ceff_vec().swap(ceffs);
+			act->remap_fluents(new_fluent, nf);
+			if (a == m_end_operator_id)
+				end_operator = na;
+			act->set_index(na++);
+			kept_actions.push_back(act);
+			m_const_actions.push_back(act);
+		}
+		m_actions.swap(kept_actions);
+		m_num_actions = na;
+		m_end_operator_id = end_operator;
+		if (m_dummy_goal_id != no_such_index)
+			m_dummy_goal_id = new_fluent[m_dummy_goal_id];
+
+		auto remap = [&](Fluent_Vec &v)
+		{
+			Fluent_Set unused;
+			remap_fluent_list(new_fluent, nf, v, unused);
+		};
+		remap(m_init);
+		remap(m_goal);
+		m_in_init.assign(nf, false);
+		for (auto p : m_init)
+			m_in_init[p] = true;
+		m_in_goal.assign(nf, false);
+		for (auto p : m_goal)
+			m_in_goal[p] = true;
+
+		std::vector<Fluent_Vec> groups;
+		for (unsigned g = 0; g < m_mutexes.num_groups(); g++)
+		{
+			Fluent_Vec group = m_mutexes.group(g);
+			remap(group);
+			if (group.size() > 1)
+				groups.push_back(group);
+		}
+		m_mutexes.clear();
+		for (auto &group : groups)
+			m_mutexes.add(group);
+	}
+
 	unsigned STRIPS_Problem::add_action(STRIPS_Problem &p, std::string signature,
 																			const Fluent_Vec &pre, const Fluent_Vec &add, const Fluent_Vec &del,
 																			const Conditional_Effect_Vec &ceffs, float cost, bool flag_tarski)
@@ -127,7 +455,8 @@ namespace aptk
 		Fluent *new_fluent = new Fluent(p);
 		new_fluent->set_index(p.fluents().size());
 		new_fluent->set_signature(signature);
-		p.m_fluents_map[signature] = new_fluent->index();
+		p.m_fluent_of_signature.resize(p.m_fluent_signatures.size());
+		p.m_fluent_of_signature.back() = new_fluent->index();
 		p.increase_num_fluents();
 		p.fluents().push_back(new_fluent);
 		p.m_const_fluents.push_back(new_fluent);
@@ -247,9 +576,10 @@ namespace aptk
 		}
 	}
 
-	unsigned STRIPS_Problem::get_fluent_index(std::string signature)
+	unsigned STRIPS_Problem::get_fluent_index(const std::string &signature) const
 	{
-		return m_fluents_map[signature];
+		int sig = m_fluent_signatures.find(signature);
+		return sig < 0 ? no_such_index : m_fluent_of_signature[sig];
 	}
 
 	void STRIPS_Problem::print(std::ostream &os) const
@@ -306,6 +636,51 @@ namespace aptk
 		}
 	}
 
+	bool STRIPS_Problem::compute_h2_mutexes(double time_budget, unsigned num_threads)
+	{
+		agnostic::H2_Mutex_Finder finder(*this);
+		finder.set_num_threads(num_threads);
+		finder.set_time_budget(time_budget);
+		if (!finder.compute())
+		{
+			if (m_verbose)
+				std::cout << "h^2 mutexes not computed, out of the " << time_budget << " secs budget after "
+									<< finder.num_sweeps() << " sweeps" << std::endl;
+			return false;
+		}
+
+		std::vector<Fluent_Vec> groups;
+		finder.mutex_groups(m_mutexes, groups);
+		for (auto &group : groups)
+			m_mutexes.add(group);
+
+		unsigned nf = num_fluents();
+		unsigned na = num_actions();
+		std::vector<bool> keep_fluent(nf), keep_action(na), keep_ceff;
+		for (unsigned p = 0; p < nf; p++)
+			keep_fluent[p] = finder.reachable(p);
+		// Unreachable goals are kept, so the task stays unsolvable
+		for (auto p : goal())
+			keep_fluent[p] = true;
+		for (unsigned a = 0; a < na; a++)
+		{
+			const Action &act = *actions()[a];
+			keep_action[a] = finder.reachable(act.prec_vec());
+			for (auto ceff : act.ceff_vec())
+				keep_ceff.push_back(keep_action[a] && finder.reachable(act.prec_vec(), ceff->prec_vec()));
+		}
+		if (std::find(keep_fluent.begin(), keep_fluent.end(), false) != keep_fluent.end() ||
+				std::find(keep_action.begin(), keep_action.end(), false) != keep_action.end() ||
+				std::find(keep_ceff.begin(), keep_ceff.end(), false) != keep_ceff.end())
+			remove_fluents_and_actions(keep_fluent, keep_action, keep_ceff);
+
+		if (m_verbose)
+			std::cout << "h^2 mutexes in " << finder.time() << " secs (" << finder.num_sweeps() << " sweeps): "
+								<< finder.num_mutex_pairs() << " mutex pairs in " << groups.size() << " new groups, #Fluents "
+								<< nf << " -> " << num_fluents() << ", #Actions " << na << " -> " << num_actions() << std::endl;
+		return true;
+	}
+
 	void STRIPS_Problem::make_delete_relaxation(const STRIPS_Problem &orig, STRIPS_Problem &relaxed)
 	{
 		// MRJ: Copy fluents
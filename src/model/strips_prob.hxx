@@ -38,10 +38,22 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <match_tree.hxx>
 #include <algorithm>
 #include <mutex_set.hxx>
+#include <signature_table.hxx>
 
 namespace aptk
 {
 
+	class State_Packer;
+
+	// How states keep their fluents: in a vector and a bitset, only in a
+	// vector, for tasks with few true fluents per state, or only in a bitset
+	enum class State_Representation
+	{
+		Dual,
+		Sparse,
+		Dense
+	};
+
 	class STRIPS_Problem
 	{
 	public:
@@ -165,6 +177,18 @@ namespace aptk
 			int m_cond_pending;
 		};
 
+		// Outcome of the reachability and relevance analysis
+		struct Task_Reduction
+		{
+			unsigned fluents_before = 0;
+			unsigned unreachable_fluents = 0;
+			unsigned irrelevant_fluents = 0;
+			unsigned actions_before = 0;
+			unsigned unreachable_actions = 0;
+			unsigned irrelevant_actions = 0;
+			double time = 0;
+		};
+
 		STRIPS_Problem(std::string dom_name = "Unnamed", std::string prob_name = "Unnamed ");
 		virtual ~STRIPS_Problem();
 
@@ -203,6 +227,7 @@ namespace aptk
 		const Fluent_Vec &init() const { return m_init; }
 		const Fluent_Vec &goal() const { return m_goal; }
 		agnostic::Mutex_Set &mutexes() { return m_mutexes; }
+		const agnostic::Mutex_Set &mutexes() const { return m_mutexes; }
 		std::vector<const Action *> &
 		actions_adding(unsigned f) { return m_adding[f]; }
 
@@ -264,10 +289,35 @@ namespace aptk
 		unsigned end_operator() const { return m_end_operator_id; }
 		unsigned dummy_goal() { return m_dummy_goal_id; }
 		unsigned dummy_goal() const { return m_dummy_goal_id; }
-		unsigned get_fluent_index(std::string signature);
+		// Index of the fluent with the given signature, no_such_index if none
+		unsigned get_fluent_index(const std::string &signature) const;
+
+		Signature_Table &fluent_signatures() { return m_fluent_signatures; }
+		const Signature_Table &fluent_signatures() const { return m_fluent_signatures; }
+		Signature_Table &action_signatures() { return m_action_signatures; }
+		const Signature_Table &action_signatures() const { return m_action_signatures; }
 
 		void make_action_tables(bool generate_match_tree = true);
 
+		// When set, make_action_tables() first removes the fluents and actions
+		// that are unreachable from init in the delete relaxation or that no
+		// goal depends on, and renumbers the rest
+		void set_reduce_task(bool b) { m_reduce_task = b; }
+		const Task_Reduction &reduction() const { return m_reduction; }
+
+		// When set, make_action_tables() also builds a finite-domain encoding
+		// of states out of the mutex groups, see State::pack()
+		void set_packed_states(bool b) { m_packed_states = b; }
+		const State_Packer *state_packer() const { return m_state_packer; }
+
+		// When set, make_action_tables() samples states along random walks from
+		// init and picks the sparse or the dense representation for states
+		// from their average number of true fluents. Otherwise states are dual
+		void set_adaptive_states(bool b) { m_adaptive_states = b; }
+		void set_state_representation(State_Representation r) { m_state_representation = r; }
+		State_Representation state_representation() const { return m_state_representation; }
+		float average_state_size() const { return m_average_state_size; }
+
 		void print(std::ostream &os) const;
 		void print_fluents(std::ostream &os) const;
 		void print_actions(std::ostream &os) const;
@@ -285,6 +335,14 @@ namespace aptk
 		// prevents the stronger inference that requires computing h^2
 		void compute_edeletes();
 
+		// Preprocessing, before make_action_tables(): adds the pairs of
+		// fluents that h^2 proves mutex from init as mutex groups, and removes
+		// the actions and conditional effects whose conditions are mutex and
+		// the unreachable fluents but goals. Returns false and leaves the task
+		// as is when time_budget (seconds, 0 for none) runs out, see
+		// H2_Mutex_Finder. num_threads 0 means all the thread pool's workers
+		bool compute_h2_mutexes(double time_budget = 0, unsigned num_threads = 0);
+
 		void set_verbose(bool v) { m_verbose = v; }
 
 		const std::vector<Best_Supporter> &effects() const { return m_effects; }
@@ -297,6 +355,11 @@ namespace aptk
 		void increase_num_fluents() { m_num_fluents++; }
 		void increase_num_actions() { m_num_actions++; }
 		void register_action_in_tables(Action *act);
+		void clear_action_tables();
+		void reduce();
+		void choose_state_representation();
+		void remove_fluents_and_actions(const std::vector<bool> &keep_fluent, const std::vector<bool> &keep_action,
+																		const std::vector<bool> &keep_ceff);
 
 	protected:
 		std::string m_domain_name;
@@ -307,6 +370,9 @@ namespace aptk
 		std::vector<const Action *> m_const_actions;
 		Fluent_Ptr_Vec m_fluents;
 		std::vector<const Fluent *> m_const_fluents;
+		// Fluents removed by the task reduction, the front end may still
+		// point to them so they live as long as the problem
+		Fluent_Ptr_Vec m_removed_fluents;
 		Fluent_Vec m_init;
 		Fluent_Vec m_goal;
 		Fluent_Action_Table m_adding;
@@ -317,7 +383,9 @@ namespace aptk
 		std::vector<bool> m_in_goal;
 		unsigned m_end_operator_id;
 		unsigned m_dummy_goal_id;
-		std::map<std::string, int> m_fluents_map;
+		Signature_Table m_fluent_signatures;
+		Signature_Table m_action_signatures;
+		std::vector<unsigned> m_fluent_of_signature;
 		agnostic::Successor_Generator m_succ_gen;
 		agnostic::Match_Tree m_succ_gen_v2;
 		aptk::WatchedLitSuccGen m_succ_gen_v3;
@@ -332,6 +400,13 @@ namespace aptk
 		mutable std::vector<Trigger> m_triggers;
 		std::vector<std::set<unsigned>> m_relevant_effects;
 		agnostic::Mutex_Set m_mutexes;
+		bool m_reduce_task;
+		Task_Reduction m_reduction;
+		bool m_packed_states;
+		State_Packer *m_state_packer;
+		bool m_adaptive_states;
+		State_Representation m_state_representation;
+		float m_average_state_size;
 	};
 
 }
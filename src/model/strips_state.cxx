@@ -32,33 +32,157 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <resources_control.hxx>
 #include <iostream>
 #include <cassert>
+#include <cstring>
 
 namespace aptk
 {
 
 	State::State(const STRIPS_Problem &problem)
-			: m_fluent_set(problem.num_fluents()), m_problem(problem)
+			: m_problem(problem), m_is_packed(false)
 	{
+		init_representation();
 	}
 
 	State::~State()
 	{
 	}
 
+	void State::init_representation()
+	{
+		State_Representation r = m_problem.state_representation();
+		m_has_vec = r != State_Representation::Dense;
+		m_has_set = r != State_Representation::Sparse;
+		if (m_has_set)
+			m_fluent_set.resize(m_problem.num_fluents());
+	}
+
+	void State::make_fluent_vec() const
+	{
+		m_fluent_vec.clear();
+		for_each_fluent([this](unsigned p)
+										{ m_fluent_vec.push_back(p); });
+		m_has_vec = true;
+	}
+
+	void State::make_fluent_set() const
+	{
+		m_fluent_set.resize(m_problem.num_fluents());
+		for (auto p : m_fluent_vec)
+			m_fluent_set.set(p);
+		m_has_set = true;
+	}
+
+	// Mixes a fluent index into a word, so that adding them up gives a hash
+	// that does not depend on the order of the fluent vector
+	static inline size_t mix_fluent(unsigned p)
+	{
+		uint64_t x = p + 0x9e3779b97f4a7c15ull;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+		return (size_t)(x ^ (x >> 31));
+	}
+
 	void State::update_hash()
 	{
+		if (m_is_packed)
+		{
+			// Packed and plain states must hash alike, as closed lists mix them
+			State s(*this);
+			s.unpack();
+			s.update_hash();
+			m_hash = s.m_hash;
+			return;
+		}
 		Hash_Key hasher;
+		if (m_problem.state_representation() == State_Representation::Sparse)
+		{
+			m_hash = m_fluent_vec.size();
+			for (auto p : m_fluent_vec)
+				m_hash += mix_fluent(p);
+			return;
+		}
 		hasher.add(fluent_set().bits());
 		m_hash = (size_t)hasher;
 	}
 
+	bool State::equals_sparse(const State &a) const
+	{
+		if (m_has_set && a.m_has_set)
+			return m_fluent_set == a.m_fluent_set;
+		const Fluent_Vec &fv = a.fluent_vec();
+		if (fv.size() != fluent_vec().size())
+			return false;
+		for (auto p : fv)
+			if (!entails(p))
+				return false;
+		return true;
+	}
+
+	void State::encode(State_Packer::Word_Vec &words) const
+	{
+		const State_Packer *packer = m_problem.state_packer();
+		words.assign(packer->num_words(), 0);
+		for_each_fluent([&](unsigned p)
+										{ packer->set(words, p); });
+	}
+
+	void State::pack()
+	{
+		const State_Packer *packer = m_problem.state_packer();
+		if (packer == nullptr || m_is_packed)
+			return;
+		encode(m_packed);
+		Fluent_Vec().swap(m_fluent_vec);
+		m_fluent_set = Fluent_Set();
+		m_has_vec = true;
+		m_has_set = false;
+		m_is_packed = true;
+	}
+
+	void State::unpack()
+	{
+		if (!m_is_packed)
+			return;
+		m_problem.state_packer()->decode(m_packed, m_fluent_vec);
+		State_Representation r = m_problem.state_representation();
+		if (r != State_Representation::Sparse)
+			make_fluent_set();
+		if (r == State_Representation::Dense)
+		{
+			Fluent_Vec().swap(m_fluent_vec);
+			m_has_vec = false;
+		}
+		State_Packer::Word_Vec().swap(m_packed);
+		m_is_packed = false;
+	}
+
+	bool State::equals_mixed(const State &a) const
+	{
+		// Only one of the states has been encoded, the other one still has its
+		// fluents
+		const State &encoded = m_packed.empty() ? a : *this;
+		const State &plain = m_packed.empty() ? *this : a;
+		State_Packer::Word_Vec words;
+		plain.encode(words);
+		return words == encoded.m_packed;
+	}
+
 	State *State::progress_through_df(const Action &a) const
 	{
+		if (m_is_packed)
+		{
+			State s(*this);
+			s.unpack();
+			return s.progress_through_df(a);
+		}
 		assert(a.can_be_applied_on(*this));
 
 		State *succ = new State(problem());
 
-		succ->set(fluent_vec());
+		if (m_problem.state_representation() == State_Representation::Dense)
+			succ->m_fluent_set.bits().set(fluent_set().bits());
+		else
+			succ->set(fluent_vec());
 
 		for (auto p : a.add_vec())
 		{
@@ -68,61 +192,78 @@ namespace aptk
 		}
 
 		// Add Conditional Effects
-		if (!a.ceff_vec().empty())
+		if (!a.has_ceff())
+			return succ;
+
+		Index_Vec fired;
+		fired_ceffs(a, fired);
+		for (auto i : fired)
+			for (auto p : a.ceff_vec()[i]->add_vec())
+				if (!succ->entails(p))
+					succ->set(p);
+
+		return succ;
+	}
+
+	void State::fired_ceffs(const Action &a, Index_Vec &fired) const
+	{
+		fired.clear();
+		if (m_has_set && a.ceffs_compiled())
 		{
+			const uint32_t *packs = m_fluent_set.bits().packs();
 			for (unsigned i = 0; i < a.ceff_vec().size(); i++)
-			{
-				Conditional_Effect *ce = a.ceff_vec()[i];
-				if (ce->can_be_applied_on(*this))
-				{
-					for (auto p : ce->add_vec())
-						if (!succ->entails(p))
-							succ->set(p);
-				}
-			}
+				if (a.ceff_holds(i, packs))
+					fired.push_back(i);
+			return;
 		}
+		for (unsigned i = 0; i < a.ceff_vec().size(); i++)
+			if (a.ceff_vec()[i]->can_be_applied_on(*this))
+				fired.push_back(i);
+	}
 
-		return succ;
+	static bool fired_ceffs_retract(const Action &a, const Index_Vec &fired, unsigned p)
+	{
+		for (auto i : fired)
+			if (a.ceff_vec()[i]->retracts(p))
+				return true;
+		return false;
 	}
 
 	State *State::progress_through(const Action &a, Fluent_Vec *added, Fluent_Vec *deleted) const
 	{
+		if (m_is_packed)
+		{
+			State s(*this);
+			s.unpack();
+			return s.progress_through(a, added, deleted);
+		}
+
+		if (m_problem.state_representation() == State_Representation::Dense)
+			return progress_dense(a, added, deleted);
 
 		assert(a.can_be_applied_on(*this));
 		State *succ = new State(problem());
 		succ->fluent_vec().reserve(m_fluent_vec.size());
 
+		// Conditional effects are tested once, before any fluent is looked at
+		Index_Vec fired;
+		if (a.has_ceff())
+			fired_ceffs(a, fired);
+
+		// The fluents of this state are distinct, so the ones kept go
+		// straight into the successor
 		for (unsigned k = 0; k < m_fluent_vec.size(); k++)
 		{
-			if (a.retracts(m_fluent_vec[k]))
-			{
-				if (deleted)
-					deleted->push_back(m_fluent_vec[k]);
-				continue;
-			}
-
-			if (a.ceff_vec().empty()) // it's not deleted by un-conditional effects, and there are no c.effs
-				succ->set(m_fluent_vec[k]);
-			// Check Conditional Effects
-			bool retracts = false;
-			for (unsigned i = 0; i < a.ceff_vec().size(); i++)
-			{
-				Conditional_Effect *ce = a.ceff_vec()[i];
-				if (!ce->retracts(m_fluent_vec[k])) // constant-time check
-					continue;
-				if (ce->can_be_applied_on(*this)) // linear-time check
-				{
-					retracts = true;
-					break;
-				}
-			}
-			if (retracts)
+			unsigned p = m_fluent_vec[k];
+			if (a.retracts(p) || (!fired.empty() && fired_ceffs_retract(a, fired, p)))
 			{
 				if (deleted)
-					deleted->push_back(m_fluent_vec[k]);
+					deleted->push_back(p);
 				continue;
 			}
-			succ->set(m_fluent_vec[k]);
+			succ->m_fluent_vec.push_back(p);
+			if (succ->m_has_set)
+				succ->m_fluent_set.set(p);
 		}
 
 		for (unsigned i = 0; i < a.add_vec().size(); i++)
@@ -137,14 +278,9 @@ namespace aptk
 		}
 
 		// Add Conditional Effects
-		if (a.ceff_vec().empty())
-			return succ;
-
-		for (unsigned i = 0; i < a.ceff_vec().size(); i++)
+		for (auto i : fired)
 		{
 			Conditional_Effect *ce = a.ceff_vec()[i];
-			if (!ce->can_be_applied_on(*this))
-				continue;
 			for (unsigned j = 0; j < ce->add_vec().size(); j++)
 			{
 				unsigned p = ce->add_vec()[j];
@@ -160,14 +296,103 @@ namespace aptk
 		return succ;
 	}
 
+	State *State::progress_strips(const Action &a, Fluent_Vec *added, Fluent_Vec *deleted) const
+	{
+		assert(!a.has_ceff());
+		if (m_is_packed || added || deleted || m_problem.state_representation() == State_Representation::Sparse)
+			return progress_through(a, added, deleted);
+
+		assert(a.can_be_applied_on(*this));
+		const Bit_Array &bits = fluent_set().bits();
+		const Bit_Array &del = a.del_set().bits();
+		const Bit_Array &add = a.add_set().bits();
+		unsigned n = bits.npacks();
+		// Fluents added after the action was defined are outside its sets
+		if (del.npacks() != n || add.npacks() != n)
+			return progress_through(a, added, deleted);
+
+		State *succ = new State(problem());
+		uint32_t *out = succ->m_fluent_set.bits().packs();
+		const uint32_t *in = bits.packs();
+		const uint32_t *d = del.packs();
+		const uint32_t *p = add.packs();
+		for (unsigned w = 0; w < n; w++)
+			out[w] = (in[w] & ~d[w]) | p[w];
+		if (!succ->m_has_vec)
+			return succ;
+
+		// Dual states keep the fluents still set, then gain the new bits of
+		// the words the action changed
+		succ->m_fluent_vec.reserve(m_fluent_vec.size() + a.add_vec().size());
+		for (auto q : m_fluent_vec)
+			if (out[q / 32] & (1u << (q % 32)))
+				succ->m_fluent_vec.push_back(q);
+		for (unsigned w = 0; w < n; w++)
+			for (uint32_t word = out[w] & ~in[w]; word != 0; word &= word - 1)
+				succ->m_fluent_vec.push_back(w * 32 + __builtin_ctz(word));
+		return succ;
+	}
+
+	// Copies the bitset and applies the effects on it, the fluent vector is
+	// never built
+	State *State::progress_dense(const Action &a, Fluent_Vec *added, Fluent_Vec *deleted) const
+	{
+		assert(a.can_be_applied_on(*this));
+		State *succ = new State(problem());
+		const Bit_Array &bits = fluent_set().bits();
+		memcpy(succ->m_fluent_set.bits().packs(), bits.packs(), bits.npacks() * sizeof(uint32_t));
+
+		auto retract = [&](unsigned p)
+		{
+			if (!succ->m_fluent_set.isset(p))
+				return;
+			succ->m_fluent_set.unset(p);
+			if (deleted)
+				deleted->push_back(p);
+		};
+		auto assert_fluent = [&](unsigned p)
+		{
+			if (succ->m_fluent_set.isset(p))
+				return;
+			succ->m_fluent_set.set(p);
+			if (added)
+				added->push_back(p);
+		};
+
+		Index_Vec fired;
+		if (a.has_ceff())
+			fired_ceffs(a, fired);
+
+		for (auto p : a.del_vec())
+			retract(p);
+		for (auto i : fired)
+			for (auto p : a.ceff_vec()[i]->del_vec())
+				retract(p);
+
+		for (auto p : a.add_vec())
+			assert_fluent(p);
+		for (auto i : fired)
+			for (auto p : a.ceff_vec()[i]->add_vec())
+				assert_fluent(p);
+
+		return succ;
+	}
+
 	State *State::regress_through(const Action &a) const
 	{
+		if (m_is_packed)
+		{
+			State s(*this);
+			s.unpack();
+			return s.regress_through(a);
+		}
 		if (!a.can_be_regressed_from(*this))
 			return NULL;
 
+		const Fluent_Vec &fv = fluent_vec();
 		State *succ = new State(problem());
-		for (unsigned k = 0; k < m_fluent_vec.size(); k++)
-			if (!a.asserts(m_fluent_vec[k]))
+		for (unsigned k = 0; k < fv.size(); k++)
+			if (!a.asserts(fv[k]))
 			{
 				// Check Conditional Effects
 				if (!a.ceff_vec().empty())
@@ -177,14 +402,14 @@ namespace aptk
 					{
 						Conditional_Effect *ce = a.ceff_vec()[i];
 						if (ce->can_be_applied_on(*this, true))
-							if (ce->asserts(m_fluent_vec[k]))
+							if (ce->asserts(fv[k]))
 								asserts = true;
 					}
 					if (!asserts)
-						succ->set(m_fluent_vec[k]);
+						succ->set(fv[k]);
 				}
 				else
-					succ->set(m_fluent_vec[k]);
+					succ->set(fv[k]);
 			}
 
 		succ->set(a.prec_vec());
@@ -205,6 +430,16 @@ namespace aptk
 
 	void State::progress_lazy_state(const Action *a, Fluent_Vec *added, Fluent_Vec *deleted)
 	{
+		unpack();
+		// Without added and deleted lists the bitset remembers the previous
+		// state, so both the vector and the bitset are needed
+		fluent_vec();
+		fluent_set();
+
+		// Conditional effects are tested on the state before it changes
+		Index_Vec fired;
+		if (a->has_ceff())
+			fired_ceffs(*a, fired);
 
 		/**
 		 * progress action
@@ -222,18 +457,7 @@ namespace aptk
 			else
 			{
 				// Check Conditional Effects
-				bool retracts = false;
-				for (unsigned i = 0; i < a->ceff_vec().size(); i++)
-				{
-					Conditional_Effect *ce = a->ceff_vec()[i];
-					if (!ce->retracts(*it)) // constant-time check
-						continue;
-					if (ce->can_be_applied_on(*this))
-					{ // linear-time check
-						retracts = true;
-						break;
-					}
-				}
+				bool retracts = !fired.empty() && fired_ceffs_retract(*a, fired, *it);
 
 				if (retracts)
 				{
@@ -267,12 +491,9 @@ namespace aptk
 			cit++;
 		}
 
-		for (unsigned i = 0; i < a->ceff_vec().size(); i++)
+		for (auto i : fired)
 		{
 			Conditional_Effect *ce = a->ceff_vec()[i];
-			if (!ce->can_be_applied_on(*this))
-				continue;
-
 			cit = ce->add_vec().begin();
 			while (cit != ce->add_vec().end())
 			{
@@ -297,6 +518,9 @@ namespace aptk
 
 	void State::regress_lazy_state(const Action *a, Fluent_Vec *added, Fluent_Vec *deleted)
 	{
+		unpack();
+		fluent_vec();
+		fluent_set();
 
 		Fluent_Vec::iterator it;
 		/**
@@ -373,7 +597,7 @@ namespace aptk
 	void State::print(std::ostream &os) const
 	{
 		os << "(:state ";
-		for (auto p = m_fluent_vec.begin(); p != m_fluent_vec.end(); p++)
+		for (auto p = fluent_vec().begin(); p != fluent_vec().end(); p++)
 		{
 			os << m_problem.fluents()[*p]->signature() << " ";
 		}
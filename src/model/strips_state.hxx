@@ -31,6 +31,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <strips_prob.hxx>
 #include <types.hxx>
 #include <fluent.hxx>
+#include <state_packer.hxx>
 #include <iostream>
 
 namespace aptk
@@ -38,33 +39,61 @@ namespace aptk
 
 	class Action;
 
+	// A state keeps its fluents in a vector, a bitset or both, as chosen by
+	// STRIPS_Problem::state_representation(). A missing one is built the
+	// first time it is asked for and kept up to date from then on. Even the
+	// const accessors build it, so they are not thread-safe: threads sharing
+	// a state read it with for_each_fluent() or fluent_vec(buffer), or have
+	// both forms built before they start.
 	class State
 	{
 	public:
 		State(const STRIPS_Problem &p);
 		~State();
 
-		Fluent_Vec &fluent_vec() { return m_fluent_vec; }
-		Fluent_Set &fluent_set() { return m_fluent_set; }
-		const Fluent_Vec &fluent_vec() const { return m_fluent_vec; }
-		const Fluent_Set &fluent_set() const { return m_fluent_set; }
-
-		unsigned value_for_var(unsigned var) const { return 0 == m_fluent_set.isset(var) ? 0 : 1; }
+		Fluent_Vec &fluent_vec();
+		Fluent_Set &fluent_set();
+		const Fluent_Vec &fluent_vec() const;
+		const Fluent_Set &fluent_set() const;
+		// The fluent vector of a state that keeps one. Otherwise the fluents
+		// are written into buffer, which is returned, and the state is left
+		// without a vector as it was
+		const Fluent_Vec &fluent_vec(Fluent_Vec &buffer) const;
+		// Calls f on every fluent of the state, from whichever of the vector
+		// or bitset it keeps
+		template <typename F>
+		void for_each_fluent(F f) const;
+
+		unsigned value_for_var(unsigned var) const { return entails(var) ? 1 : 0; }
 
 		void set(unsigned f);
 		void unset(unsigned f);
 		void set(const Fluent_Vec &fv);
 		void unset(const Fluent_Vec &fv);
 		void reset();
-		bool entails(unsigned f) const { return fluent_set().isset(f); }
+		bool entails(unsigned f) const;
 		bool entails(const State &s) const;
 		bool entails(const Fluent_Vec &fv) const;
 		bool entails(const Fluent_Vec &fv, unsigned &num_unsat) const;
 		size_t hash() const;
 		void update_hash();
 
+		// Drops the fluent vector and set, keeping only the packed words, and
+		// restores them. Packed states keep their hash, support == and can be
+		// progressed or regressed, but nothing else until unpacked. Both are
+		// no-ops if the problem does not pack states
+		void pack();
+		void unpack();
+		bool is_packed() const { return m_is_packed; }
+		const State_Packer::Word_Vec &packed() const { return m_packed; }
+
 		State *progress_through(const Action &a, Fluent_Vec *added = NULL, Fluent_Vec *deleted = NULL) const;
 
+		// progress_through() for actions without conditional effects. Dense
+		// and dual states are progressed a word at a time, as
+		// (s & ~del) | add, unless the added or deleted fluents are asked for
+		State *progress_strips(const Action &a, Fluent_Vec *added = NULL, Fluent_Vec *deleted = NULL) const;
+
 		State *progress_through_df(const Action &a) const;
 
 		State *regress_through(const Action &a) const;
@@ -80,12 +109,107 @@ namespace aptk
 		void print(std::ostream &os) const;
 
 	protected:
-		Fluent_Vec m_fluent_vec;
-		Fluent_Set m_fluent_set;
+		bool equals_mixed(const State &a) const;
+		bool equals_sparse(const State &a) const;
+		bool vec_contains(unsigned f) const;
+		void encode(State_Packer::Word_Vec &words) const;
+		void make_fluent_vec() const;
+		void make_fluent_set() const;
+		void init_representation();
+		State *progress_dense(const Action &a, Fluent_Vec *added, Fluent_Vec *deleted) const;
+		// Conditional effects of a whose condition holds in this state
+		void fired_ceffs(const Action &a, Index_Vec &fired) const;
+
+	protected:
+		mutable Fluent_Vec m_fluent_vec;
+		mutable Fluent_Set m_fluent_set;
+		mutable bool m_has_vec;
+		mutable bool m_has_set;
 		const STRIPS_Problem &m_problem;
 		size_t m_hash;
+		State_Packer::Word_Vec m_packed;
+		bool m_is_packed;
 	};
 
+	inline Fluent_Vec &State::fluent_vec()
+	{
+		if (!m_has_vec)
+			make_fluent_vec();
+		return m_fluent_vec;
+	}
+
+	inline const Fluent_Vec &State::fluent_vec() const
+	{
+		if (!m_has_vec)
+			make_fluent_vec();
+		return m_fluent_vec;
+	}
+
+	inline Fluent_Set &State::fluent_set()
+	{
+		if (!m_has_set)
+			make_fluent_set();
+		return m_fluent_set;
+	}
+
+	inline const Fluent_Set &State::fluent_set() const
+	{
+		if (!m_has_set)
+			make_fluent_set();
+		return m_fluent_set;
+	}
+
+	// Linear scan written without early exits, so that it vectorizes; sparse
+	// states are short
+	inline bool State::vec_contains(unsigned f) const
+	{
+		const unsigned *v = m_fluent_vec.data();
+		const size_t n = m_fluent_vec.size();
+		size_t k = 0;
+		for (; k + 8 <= n; k += 8)
+		{
+			unsigned found = 0;
+			for (size_t j = 0; j < 8; j++)
+				found |= (v[k + j] == f);
+			if (found)
+				return true;
+		}
+		for (; k < n; k++)
+			if (v[k] == f)
+				return true;
+		return false;
+	}
+
+	inline bool State::entails(unsigned f) const
+	{
+		return m_has_set ? m_fluent_set.isset(f) : vec_contains(f);
+	}
+
+	template <typename F>
+	void State::for_each_fluent(F f) const
+	{
+		if (m_has_vec)
+		{
+			for (auto p : m_fluent_vec)
+				f(p);
+			return;
+		}
+		const Bit_Array &bits = m_fluent_set.bits();
+		for (unsigned w = 0; w < bits.npacks(); w++)
+			for (uint32_t word = bits.packs()[w]; word != 0; word &= word - 1)
+				f(w * 32 + __builtin_ctz(word));
+	}
+
+	inline const Fluent_Vec &State::fluent_vec(Fluent_Vec &buffer) const
+	{
+		if (m_has_vec)
+			return m_fluent_vec;
+		buffer.clear();
+		for_each_fluent([&buffer](unsigned p)
+										{ buffer.push_back(p); });
+		return buffer;
+	}
+
 	inline size_t State::hash() const
 	{
 		return m_hash;
@@ -93,7 +217,15 @@ namespace aptk
 
 	inline bool State::operator==(const State &a) const
 	{
-		return fluent_set() == a.fluent_set();
+		if (m_packed.empty() && a.m_packed.empty())
+		{
+			if (m_problem.state_representation() == State_Representation::Sparse)
+				return equals_sparse(a);
+			return fluent_set() == a.fluent_set();
+		}
+		if (!m_packed.empty() && !a.m_packed.empty())
+			return m_packed == a.m_packed;
+		return equals_mixed(a);
 	}
 
 	inline const STRIPS_Problem &State::problem() const
@@ -105,21 +237,16 @@ namespace aptk
 	{
 		if (entails(f))
 			return;
-		m_fluent_vec.push_back(f);
-		m_fluent_set.set(f);
+		if (m_has_vec)
+			m_fluent_vec.push_back(f);
+		if (m_has_set)
+			m_fluent_set.set(f);
 	}
 
 	inline void State::set(const Fluent_Vec &f)
 	{
-
 		for (unsigned i = 0; i < f.size(); i++)
-		{
-			if (!entails(f[i]))
-			{
-				m_fluent_vec.push_back(f[i]);
-				m_fluent_set.set(f[i]);
-			}
-		}
+			set(f[i]);
 	}
 
 	inline void State::unset(unsigned f)
@@ -127,41 +254,32 @@ namespace aptk
 		if (!entails(f))
 			return;
 
-		for (unsigned k = 0; k < m_fluent_vec.size(); k++)
-			if (m_fluent_vec[k] == f)
-			{
-				for (unsigned l = k + 1; l < m_fluent_vec.size(); l++)
-					m_fluent_vec[l - 1] = m_fluent_vec[l];
-				m_fluent_vec.resize(m_fluent_vec.size() - 1);
-				break;
-			}
-
-		m_fluent_set.unset(f);
-	}
-
-	inline void State::unset(const Fluent_Vec &f)
-	{
-
-		for (unsigned i = 0; i < f.size(); i++)
-		{
-			if (!entails(f[i]))
-				continue;
+		if (m_has_vec)
 			for (unsigned k = 0; k < m_fluent_vec.size(); k++)
-				if (m_fluent_vec[k] == f[i])
+				if (m_fluent_vec[k] == f)
 				{
 					for (unsigned l = k + 1; l < m_fluent_vec.size(); l++)
 						m_fluent_vec[l - 1] = m_fluent_vec[l];
 					m_fluent_vec.resize(m_fluent_vec.size() - 1);
 					break;
 				}
-			m_fluent_set.unset(f[i]);
-		}
+
+		if (m_has_set)
+			m_fluent_set.unset(f);
+	}
+
+	inline void State::unset(const Fluent_Vec &f)
+	{
+		for (unsigned i = 0; i < f.size(); i++)
+			unset(f[i]);
 	}
 
 	inline void State::reset()
 	{
 		m_fluent_vec.clear();
-		m_fluent_set.reset();
+		if (m_has_set)
+			m_fluent_set.reset();
+		m_packed.clear();
 	}
 
 	inline bool State::entails(const State &s) const
@@ -175,7 +293,7 @@ namespace aptk
 	inline bool State::entails(const Fluent_Vec &fv) const
 	{
 		for (unsigned i = 0; i < fv.size(); i++)
-			if (!fluent_set().isset(fv[i]))
+			if (!entails(fv[i]))
 			{
 				return false;
 			}
@@ -186,7 +304,7 @@ namespace aptk
 	{
 		num_unsat = 0;
 		for (unsigned i = 0; i < fv.size(); i++)
-			if (!fluent_set().isset(fv[i]))
+			if (!entails(fv[i]))
 				num_unsat++;
 		return num_unsat == 0;
 	}
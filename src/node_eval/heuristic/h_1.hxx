@@ -33,9 +33,15 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <ext_math.hxx>
 #include <strips_state.hxx>
 #include <strips_prob.hxx>
+#include <radix_heap.hxx>
 #include <boost/circular_buffer.hpp>
 #include <vector>
 #include <deque>
+#include <set>
+#include <list>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
 
 namespace aptk
 {
@@ -106,7 +112,8 @@ namespace aptk
 			typedef STRIPS_Problem::Best_Supporter Best_Supporter;
 
 			H1_Heuristic(const Search_Model &prob)
-					: Heuristic<State>(prob), m_strips_model(prob.task()), eval_func(m_values)
+					: Heuristic<State>(prob), m_strips_model(prob.task()), eval_func(m_values), m_use_radix_heap(false), m_radix_mode(false),
+						m_cache_size(0), m_parent(NULL)
 			{
 				m_values.resize(m_strips_model.num_fluents());
 				m_difficulties.resize(m_strips_model.num_fluents());
@@ -114,11 +121,16 @@ namespace aptk
 				m_already_updated.resize(m_strips_model.num_fluents());
 				m_allowed_actions.resize(m_strips_model.num_actions());
 				m_updated.resize(m_strips_model.num_fluents());
+				m_invalid.resize(m_strips_model.num_fluents());
 
 				// HAZ: Set up the relevant actions once here so we don't need
 				//      to iterate through all of them when evaluating.
-				m_relevant_actions.resize(m_strips_model.num_fluents());
+				std::vector<std::set<unsigned>> relevant_actions(m_strips_model.num_fluents());
+				// Same, split by where the fluent appears, for compute_radix()
+				std::vector<Index_Vec> prec_actions(m_strips_model.num_fluents());
+				std::vector<Index_Vec> cond_effects(m_strips_model.num_fluents());
 
+				m_ceff_begin.push_back(0);
 				for (unsigned i = 0; i < m_strips_model.num_actions(); i++)
 				{
 
@@ -127,8 +139,10 @@ namespace aptk
 					// Relevant if the fluent is in the precondition
 					for (unsigned j = 0; j < a.prec_vec().size(); ++j)
 					{
-						m_relevant_actions[a.prec_vec()[j]].insert(i);
+						relevant_actions[a.prec_vec()[j]].insert(i);
+						prec_actions[a.prec_vec()[j]].push_back(i);
 					}
+					m_num_precs.push_back(a.prec_vec().size());
 
 					// Relevant if the fluent is in the head of a conditional effect
 					for (unsigned j = 0; j < a.ceff_vec().size(); ++j)
@@ -138,10 +152,38 @@ namespace aptk
 
 						for (unsigned k = 0; k < ceff.prec_vec().size(); ++k)
 						{
-							m_relevant_actions[ceff.prec_vec()[k]].insert(i);
+							relevant_actions[ceff.prec_vec()[k]].insert(i);
+							cond_effects[ceff.prec_vec()[k]].push_back(m_num_cond_precs.size());
 						}
+						m_num_cond_precs.push_back(ceff.prec_vec().size());
+						m_ceff_action.push_back(i);
 					}
+					m_ceff_begin.push_back(m_num_cond_precs.size());
 				}
+
+				make_table(relevant_actions, m_relevant_offs, m_relevant_actions);
+				make_table(prec_actions, m_prec_offs, m_prec_actions);
+				make_table(cond_effects, m_cond_offs, m_cond_effects);
+				m_unsat_precs.resize(m_num_precs.size());
+				m_unsat_cond_precs.resize(m_num_cond_precs.size());
+
+				// Values are only integral, as the radix heap needs, when costs are
+				m_integer_costs = true;
+				if (cost_opt != H1_Cost_Function::Ignore_Costs)
+					for (unsigned i = 0; i < m_strips_model.num_actions(); i++)
+					{
+						float c = m_strips_model.actions()[i]->cost();
+						if (c < 0.0f || c != std::floor(c))
+							m_integer_costs = false;
+					}
+
+				// Repairing values after deletions follows best supporters, which
+				// can only form cycles through actions of cost zero
+				m_positive_costs = true;
+				if (cost_opt == H1_Cost_Function::Use_Costs)
+					for (unsigned i = 0; i < m_strips_model.num_actions(); i++)
+						if (m_strips_model.actions()[i]->cost() <= 0.0f)
+							m_positive_costs = false;
 			}
 
 			virtual ~H1_Heuristic()
@@ -150,6 +192,28 @@ namespace aptk
 
 			float value(unsigned p) const { return m_values[p]; }
 
+			// When set, fluents are settled in increasing order of their value,
+			// Dijkstra-like, instead of being swept until nothing changes. Only
+			// used when all action costs are integral
+			void set_radix_heap(bool b) { m_use_radix_heap = b; }
+			bool uses_radix_heap() const { return m_use_radix_heap && m_integer_costs; }
+
+			// When cache_size > 0, the values computed for the last cache_size
+			// states are kept, and a state whose parent (see set_parent()) is
+			// among them is evaluated from the parent's values, repairing only
+			// what its added and deleted fluents change. Only used when all
+			// action costs are positive
+			void set_incremental(unsigned cache_size)
+			{
+				m_cache_size = cache_size;
+				m_cache.clear();
+				m_cache_index.clear();
+			}
+			bool incremental() const { return m_cache_size > 0 && m_positive_costs; }
+
+			// Parent of the state evaluated next, forgotten after that eval()
+			void set_parent(const State *parent) { m_parent = parent; }
+
 			template <typename Search_Node>
 			void eval(const Search_Node *n, float &h_val, std::vector<Action_Idx> &pref_ops)
 			{
@@ -172,10 +236,23 @@ namespace aptk
 			void eval(const State &s, Cost_Type &h_out)
 			{
 				float h;
+				const State *parent = m_parent;
+				m_parent = NULL;
 				m_already_updated.reset();
 				m_updated.clear();
-				initialize(s);
-				compute();
+				const Cached_Values *cached = (incremental() && parent != NULL) ? find_cached(*parent) : NULL;
+				if (cached != NULL)
+					compute_incremental(s, *parent, *cached);
+				else
+				{
+					initialize(s);
+					if (uses_radix_heap())
+						compute_radix();
+					else
+						compute();
+				}
+				if (incremental())
+					store_cached(s);
 				h = eval_func(m_strips_model.goal().begin(), m_strips_model.goal().end());
 				h_out = h == infty ? std::numeric_limits<Cost_Type>::max() : (Cost_Type)h;
 			}
@@ -264,11 +341,34 @@ namespace aptk
 			}
 
 		protected:
-			void update(unsigned p, float v)
+			// Fluent values of an evaluated state, see set_incremental()
+			struct Cached_Values
 			{
-				if (v >= m_values[p])
+				size_t hash;
+				Fluent_Vec atoms;
+				std::vector<float> values;
+				std::vector<float> difficulties;
+				std::vector<Best_Supporter> best_supporters;
+			};
+
+			template <typename Row>
+			static void make_table(const std::vector<Row> &rows, Index_Vec &offs, Index_Vec &idx)
+			{
+				offs.assign(1, 0);
+				for (const Row &row : rows)
+				{
+					idx.insert(idx.end(), row.begin(), row.end());
+					offs.push_back(idx.size());
+				}
+			}
+
+			void enqueue(unsigned p)
+			{
+				if (m_radix_mode)
+				{
+					m_queue.push((unsigned)m_values[p], p);
 					return;
-				m_values[p] = v;
+				}
 				if (!m_already_updated.isset(p))
 				{
 					m_updated.push_back(p);
@@ -276,6 +376,14 @@ namespace aptk
 				}
 			}
 
+			void update(unsigned p, float v)
+			{
+				if (v >= m_values[p])
+					return;
+				m_values[p] = v;
+				enqueue(p);
+			}
+
 			void update(unsigned p, float v, Best_Supporter bs)
 			{
 				update(p, v, bs.act_idx, bs.eff_idx);
@@ -312,11 +420,7 @@ namespace aptk
 					return;
 				}
 				m_values[p] = v;
-				if (!m_already_updated.isset(p))
-				{
-					m_updated.push_back(p);
-					m_already_updated.set(p);
-				}
+				enqueue(p);
 				m_best_supporters[p].act_idx = act_idx;
 				m_best_supporters[p].eff_idx = eff_idx;
 				m_difficulties[p] = eval_diff(m_best_supporters[p]);
@@ -325,11 +429,7 @@ namespace aptk
 			void set(unsigned p, float v)
 			{
 				m_values[p] = v;
-				if (!m_already_updated.isset(p))
-				{
-					m_updated.push_back(p);
-					m_already_updated.set(p);
-				}
+				enqueue(p);
 			}
 
 			void initialize(const State &s)
@@ -381,10 +481,10 @@ namespace aptk
 					// int i = it.first();
 					// std::cout << "First action: " << i << std::endl;
 					// while ( i != -1 ) {
-					for (std::set<unsigned>::iterator action_it = m_relevant_actions[p].begin(); action_it != m_relevant_actions[p].end(); ++action_it)
+					for (unsigned k = m_relevant_offs[p]; k < m_relevant_offs[p + 1]; k++)
 					{
 
-						const Action &a = *(m_strips_model.actions()[*action_it]);
+						const Action &a = *(m_strips_model.actions()[m_relevant_actions[k]]);
 
 						float h_pre = eval_func(a.prec_vec().begin(), a.prec_vec().end());
 
@@ -392,7 +492,7 @@ namespace aptk
 							continue;
 						// assert( h_pre != infty );
 
-						// std::cout << "Action " << *action_it << ". " << a.signature() << " relevant cost " << a.cost() << std::endl;
+						// std::cout << "Action " << m_relevant_actions[k] << ". " << a.signature() << " relevant cost " << a.cost() << std::endl;
 
 						float v = (cost_opt == H1_Cost_Function::Ignore_Costs ? 1.0f + h_pre : (cost_opt == H1_Cost_Function::Use_Costs ? (float)a.cost() + h_pre : 1.0f + (float)a.cost() + h_pre));
 
@@ -418,6 +518,202 @@ namespace aptk
 				// print_values(std::cout);
 			}
 
+			// Sorted fluents of s, to tell apart cached states with the same hash
+			void sorted_atoms(const State &s, Fluent_Vec &atoms) const
+			{
+				atoms.assign(s.fluent_vec().begin(), s.fluent_vec().end());
+				std::sort(atoms.begin(), atoms.end());
+			}
+
+			const Cached_Values *find_cached(const State &s)
+			{
+				auto it = m_cache_index.find(s.hash());
+				if (it == m_cache_index.end())
+					return NULL;
+				sorted_atoms(s, m_atoms);
+				if (it->second->atoms != m_atoms)
+					return NULL;
+				m_cache.splice(m_cache.begin(), m_cache, it->second);
+				return &m_cache.front();
+			}
+
+			void store_cached(const State &s)
+			{
+				auto it = m_cache_index.find(s.hash());
+				if (it != m_cache_index.end())
+					m_cache.splice(m_cache.begin(), m_cache, it->second);
+				else if (m_cache.size() < m_cache_size)
+					m_cache.emplace_front();
+				else
+				{
+					// Reuse the least recently used entry
+					m_cache_index.erase(m_cache.back().hash);
+					m_cache.splice(m_cache.begin(), m_cache, std::prev(m_cache.end()));
+				}
+				Cached_Values &c = m_cache.front();
+				c.hash = s.hash();
+				sorted_atoms(s, c.atoms);
+				c.values = m_values;
+				c.difficulties = m_difficulties;
+				c.best_supporters = m_best_supporters;
+				m_cache_index[c.hash] = m_cache.begin();
+			}
+
+			/**
+			 * Starts from the values of the parent. Values of fluents whose best
+			 * supporter needs a deleted fluent, directly or through other such
+			 * fluents, are reset and taken again from their achievers; the
+			 * added fluents get value 0. compute() then propagates both changes
+			 */
+			void compute_incremental(const State &s, const State &parent, const Cached_Values &cached)
+			{
+				m_values = cached.values;
+				m_difficulties = cached.difficulties;
+				m_best_supporters = cached.best_supporters;
+
+				m_invalid.reset();
+				m_invalid_fluents.clear();
+				for (unsigned p : parent.fluent_vec())
+					if (!s.entails(p))
+					{
+						m_invalid.set(p);
+						m_invalid_fluents.push_back(p);
+					}
+
+				for (unsigned i = 0; i < m_invalid_fluents.size(); i++)
+				{
+					unsigned p = m_invalid_fluents[i];
+					for (unsigned k = m_relevant_offs[p]; k < m_relevant_offs[p + 1]; k++)
+					{
+						const Action &a = *(m_strips_model.actions()[m_relevant_actions[k]]);
+						for (unsigned q : a.add_vec())
+							invalidate(s, q, a.index());
+						for (unsigned j = 0; j < a.ceff_vec().size(); j++)
+							for (unsigned q : a.ceff_vec()[j]->add_vec())
+								invalidate(s, q, a.index());
+					}
+				}
+
+				for (unsigned q : m_invalid_fluents)
+				{
+					m_values[q] = m_difficulties[q] = infty;
+					m_best_supporters[q] = Best_Supporter(no_such_index, no_such_index);
+				}
+
+				for (unsigned q : m_invalid_fluents)
+				{
+					const std::vector<const Action *> &add_acts = m_strips_model.actions_adding(q);
+					for (unsigned k = 0; k < add_acts.size(); k++)
+					{
+						const Action &a = *(add_acts[k]);
+						float h_pre = eval_func(a.prec_vec().begin(), a.prec_vec().end());
+						if (h_pre == infty)
+							continue;
+						if (a.asserts(q))
+						{
+							float v = (cost_opt == H1_Cost_Function::Ignore_Costs ? 1.0f + h_pre : (cost_opt == H1_Cost_Function::Use_Costs ? (float)a.cost() + h_pre : 1.0f + (float)a.cost() + h_pre));
+							update(q, v, a.index(), no_such_index);
+						}
+						for (unsigned j = 0; j < a.ceff_vec().size(); j++)
+						{
+							const Conditional_Effect &ceff = *(a.ceff_vec()[j]);
+							if (!ceff.asserts(q))
+								continue;
+							float h_cond = eval_func(ceff.prec_vec().begin(), ceff.prec_vec().end(), h_pre);
+							if (h_cond == infty)
+								continue;
+							float v_eff = (cost_opt == H1_Cost_Function::Ignore_Costs ? 1.0f + h_cond : (cost_opt == H1_Cost_Function::Use_Costs ? (float)a.cost() + h_cond : 1.0f + (float)a.cost() + h_cond));
+							update(q, v_eff, a.index(), j);
+						}
+					}
+				}
+
+				for (unsigned p : s.fluent_vec())
+					if (!parent.entails(p))
+						set(p, 0.0f);
+
+				compute();
+			}
+
+			void invalidate(const State &s, unsigned q, unsigned act_idx)
+			{
+				if (m_invalid.isset(q) || m_best_supporters[q].act_idx != act_idx || s.entails(q))
+					return;
+				m_invalid.set(q);
+				m_invalid_fluents.push_back(q);
+			}
+
+			/**
+			 * Generalized Dijkstra: a fluent is settled once it is the cheapest
+			 * one left, and an action is applied once, when the last of its
+			 * preconditions gets settled, so its value is final
+			 */
+			void compute_radix()
+			{
+				std::copy(m_num_precs.begin(), m_num_precs.end(), m_unsat_precs.begin());
+				std::copy(m_num_cond_precs.begin(), m_num_cond_precs.end(), m_unsat_cond_precs.begin());
+
+				// initialize() left the fluents with a value in m_updated
+				m_radix_mode = true;
+				m_queue.clear();
+				m_already_updated.reset();
+				while (!m_updated.empty())
+				{
+					unsigned p = m_updated.front();
+					m_updated.pop_front();
+					enqueue(p);
+				}
+
+				// m_already_updated now marks the settled fluents
+				while (!m_queue.empty())
+				{
+					unsigned p = m_queue.pop().second;
+					if (m_already_updated.isset(p))
+						continue;
+					m_already_updated.set(p);
+
+					for (unsigned k = m_prec_offs[p]; k < m_prec_offs[p + 1]; k++)
+						if (--m_unsat_precs[m_prec_actions[k]] == 0)
+							apply_radix(m_prec_actions[k]);
+
+					// Conditional effects also wait for the precondition of their action
+					for (unsigned k = m_cond_offs[p]; k < m_cond_offs[p + 1]; k++)
+					{
+						unsigned e = m_cond_effects[k];
+						if (--m_unsat_cond_precs[e] == 0 && m_unsat_precs[m_ceff_action[e]] == 0)
+						{
+							const Action &a = *(m_strips_model.actions()[m_ceff_action[e]]);
+							apply_radix(a, e - m_ceff_begin[a.index()], eval_func(a.prec_vec().begin(), a.prec_vec().end()));
+						}
+					}
+				}
+				m_radix_mode = false;
+			}
+
+			void apply_radix(unsigned act_idx)
+			{
+				const Action &a = *(m_strips_model.actions()[act_idx]);
+				float h_pre = eval_func(a.prec_vec().begin(), a.prec_vec().end());
+				float v = (cost_opt == H1_Cost_Function::Ignore_Costs ? 1.0f + h_pre : (cost_opt == H1_Cost_Function::Use_Costs ? (float)a.cost() + h_pre : 1.0f + (float)a.cost() + h_pre));
+
+				for (Fluent_Vec::const_iterator it = a.add_vec().begin();
+						 it != a.add_vec().end(); it++)
+					update(*it, v, a.index(), no_such_index);
+				for (unsigned j = 0; j < a.ceff_vec().size(); j++)
+					if (m_unsat_cond_precs[m_ceff_begin[act_idx] + j] == 0)
+						apply_radix(a, j, h_pre);
+			}
+
+			void apply_radix(const Action &a, unsigned j, float h_pre)
+			{
+				const Conditional_Effect &ceff = *(a.ceff_vec()[j]);
+				float h_cond = eval_func(ceff.prec_vec().begin(), ceff.prec_vec().end(), h_pre);
+				float v_eff = (cost_opt == H1_Cost_Function::Ignore_Costs ? 1.0f + h_cond : (cost_opt == H1_Cost_Function::Use_Costs ? (float)a.cost() + h_cond : 1.0f + (float)a.cost() + h_cond));
+				for (Fluent_Vec::const_iterator it = ceff.add_vec().begin();
+						 it != ceff.add_vec().end(); it++)
+					update(*it, v_eff, a.index(), j);
+			}
+
 			/***************
 			 * Old Version *
 			 ***************/
@@ -593,11 +889,40 @@ namespace aptk
 			Fluent_Set_Eval_Func eval_func;
 			std::vector<Best_Supporter> m_best_supporters;
 			std::vector<const Action *> m_app_set;
-			std::vector<std::set<unsigned>> m_relevant_actions;
+			// Actions with a fluent in their precondition or in that of one of
+			// their conditional effects, for fluent p they are
+			// m_relevant_actions[m_relevant_offs[p]..m_relevant_offs[p + 1])
+			Index_Vec m_relevant_offs;
+			Index_Vec m_relevant_actions;
+			// Same tables, split into actions by precondition and conditional
+			// effects (numbered from m_ceff_begin[action]) by their condition
+			Index_Vec m_prec_offs;
+			Index_Vec m_prec_actions;
+			Index_Vec m_cond_offs;
+			Index_Vec m_cond_effects;
+			Index_Vec m_ceff_begin;
+			Index_Vec m_ceff_action;
+			Index_Vec m_num_precs;
+			Index_Vec m_num_cond_precs;
+			Index_Vec m_unsat_precs;
+			Index_Vec m_unsat_cond_precs;
+			Radix_Heap<unsigned> m_queue;
+			bool m_integer_costs;
+			bool m_use_radix_heap;
+			bool m_radix_mode;
 			// std::deque<unsigned> 			m_updated;
 			boost::circular_buffer<int> m_updated;
 			Bit_Set m_already_updated;
 			Bool_Vec m_allowed_actions;
+			// Recently evaluated states, most recent first, indexed by hash
+			unsigned m_cache_size;
+			bool m_positive_costs;
+			const State *m_parent;
+			std::list<Cached_Values> m_cache;
+			std::unordered_map<size_t, typename std::list<Cached_Values>::iterator> m_cache_index;
+			Fluent_Vec m_atoms;
+			Bit_Set m_invalid;
+			Fluent_Vec m_invalid_fluents;
 		};
 
 	}
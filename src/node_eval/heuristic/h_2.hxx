@@ -33,7 +33,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <bit_set.hxx>
 #include <strips_state.hxx>
 #include <strips_prob.hxx>
-#include <boost/circular_buffer.hpp>
+#include <thread_pool.hxx>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
 #include <vector>
 #include <list>
 #include <iosfwd>
@@ -52,6 +56,17 @@ namespace aptk
 				return (p >= q ? p * (p + 1) / 2 + q : q * (q + 1) / 2 + p);
 			}
 
+			// Inverse of pair_index, with p >= q
+			inline void pair_fluents(unsigned idx, unsigned &p, unsigned &q)
+			{
+				p = (unsigned)((std::sqrt(8.0 * idx + 1.0) - 1.0) / 2.0);
+				while (p * (p + 1) / 2 > idx)
+					p--;
+				while ((p + 1) * (p + 2) / 2 <= idx)
+					p++;
+				q = idx - p * (p + 1) / 2;
+			}
+
 		}
 
 		enum class H2_Cost_Function
@@ -61,63 +76,40 @@ namespace aptk
 			Use_Costs
 		};
 
+		/**
+		 * h² over the fluent pairs of the task.
+		 *
+		 * Pair values are kept as 16-bit integer costs: action costs are
+		 * rounded up to the next integer, and finite values saturate one
+		 * below the infinity marker, so saturation never produces a spurious
+		 * mutex. The actions relevant to a pair and the fluents each action
+		 * interferes with are stored as CSR arrays, built in parallel, so
+		 * apart from the value table memory grows with the size of the
+		 * preconditions rather than with the number of fluent pairs.
+		 */
 		template <typename Search_Model, H2_Cost_Function cost_opt = H2_Cost_Function::Use_Costs>
 		class H2_Heuristic : public Heuristic<State>
 		{
 
 		public:
-			H2_Heuristic(const Search_Model &prob)
+			typedef unsigned short Pair_Cost;
+
+			// The tables are built on the global thread pool, 0 means all of its
+			// workers, fewer on small tasks
+			H2_Heuristic(const Search_Model &prob, unsigned num_threads = 0)
 					: Heuristic<State>(prob), m_strips_model(prob.task())
 			{
 				unsigned F = m_strips_model.num_fluents();
 				m_values.resize((F * F + F) / 2);
 				m_op_values.resize(m_strips_model.num_actions());
-				m_interfering_ops.resize(F);
-				for (unsigned p = 0; p < m_interfering_ops.size(); p++)
-				{
-					m_interfering_ops[p] = new Bit_Set(m_strips_model.num_actions());
-					for (unsigned op = 0; op < m_strips_model.num_actions(); op++)
-					{
-						const Action *op_ptr = m_strips_model.actions()[op];
-						if (op_ptr->add_set().isset(p) || op_ptr->del_set().isset(p))
-							m_interfering_ops[p]->set(op);
-					}
-				}
-				// NIR: Set up the relevant actions once here so we don't need
-				//      to iterate through all of them when evaluating, similar to h1
 				m_already_updated.resize((F * F + F) / 2);
-				m_updated.resize((F * F + F) / 2);
-				m_relevant_actions.resize((F * F + F) / 2);
-
-				for (unsigned i = 0; i < m_strips_model.num_actions(); i++)
-				{
-
-					const Action &a = *(m_strips_model.actions()[i]);
-
-					// Relevant if the fluent is in the precondition
-					for (unsigned p = 0; p < a.prec_vec().size(); ++p)
-					{
-						for (unsigned q = p; q < a.prec_vec().size(); ++q)
-						{
-
-							m_relevant_actions[H2_Helper::pair_index(a.prec_vec()[p], a.prec_vec()[q])].insert(i);
-						}
-					}
-
-					// Relevant if the fluent is in the head of a conditional effect
-					for (unsigned j = 0; j < a.ceff_vec().size(); ++j)
-					{
 
-						const Conditional_Effect &ceff = *(a.ceff_vec()[j]);
-						for (unsigned p = 0; p < ceff.prec_vec().size(); ++p)
-						{
-							for (unsigned q = p; q < ceff.prec_vec().size(); ++q)
-							{
-								m_relevant_actions[H2_Helper::pair_index(ceff.prec_vec()[p], ceff.prec_vec()[q])].insert(i);
-							}
-						}
-					}
-				}
+				unsigned num_blocks = num_threads;
+				if (num_threads == 0)
+					num_blocks = std::min(Thread_Pool::global().num_threads() + 1, m_strips_model.num_actions() / 1024);
+				// NIR: Set up the relevant actions once here so we don't need
+				//      to iterate through all of them when evaluating, similar to h1
+				build_tables(std::max(num_blocks, 1u), num_threads);
 			}
 
 			virtual ~H2_Heuristic()
@@ -151,55 +143,39 @@ namespace aptk
 				eval(s, h_val);
 			}
 
-			float &op_value(unsigned a) { return m_op_values.at(a); }
-			float op_value(unsigned a) const { return m_op_values.at(a); }
-
-			float &value(unsigned p, unsigned q)
-			{
-				assert(H2_Helper::pair_index(p, q) < (int)m_values.size());
-				return m_values[H2_Helper::pair_index(p, q)];
-			}
+			float op_value(unsigned a) const { return to_value(m_op_values.at(a)); }
 
 			float value(unsigned p, unsigned q) const
 			{
 				assert(H2_Helper::pair_index(p, q) < (int)m_values.size());
-				return m_values[H2_Helper::pair_index(p, q)];
+				return to_value(m_values[H2_Helper::pair_index(p, q)]);
 			}
 
-			float &value(unsigned p)
+			float value(unsigned p) const
 			{
 				assert(H2_Helper::pair_index(p, p) < (int)m_values.size());
-				return m_values[H2_Helper::pair_index(p, p)];
+				return to_value(m_values[H2_Helper::pair_index(p, p)]);
 			}
 
-			float value(unsigned p) const
+			void set_value(unsigned p, unsigned q, float v)
 			{
-				assert(H2_Helper::pair_index(p, p) < (int)m_values.size());
-				return m_values[H2_Helper::pair_index(p, p)];
+				assert(H2_Helper::pair_index(p, q) < (int)m_values.size());
+				m_values[H2_Helper::pair_index(p, q)] = to_cost(v);
 			}
 
 			float eval(const Fluent_Vec &s) const
 			{
-				float v = 0;
-				for (unsigned i = 0; i < s.size(); i++)
-					for (unsigned j = i; j < s.size(); j++)
-					{
-						v = std::max(v, value(s[i], s[j]));
-						if (v == infty)
-							return infty;
-					}
-
-				return v;
+				return to_value(eval_cost(s));
 			}
 
 			bool is_mutex(const Fluent_Vec &s) const
 			{
-				return eval(s) == infty;
+				return eval_cost(s) == cost_infty;
 			}
 
 			bool is_mutex(unsigned p, unsigned q) const
 			{
-				return value(p, q) == infty;
+				return m_values[H2_Helper::pair_index(p, q)] == cost_infty;
 			}
 
 			float eval(const Fluent_Vec &s, unsigned p) const
@@ -207,16 +183,13 @@ namespace aptk
 				float v = 0;
 				for (unsigned k = 0; k < s.size(); k++)
 					v = std::max(v, value(s[k], p));
-				float v2 = 0;
-				for (unsigned i = 0; i < s.size(); i++)
-					for (unsigned j = i; j < s.size(); j++)
-						v2 = std::max(v2, value(s[i], s[j]));
-				return std::max(v, v2);
+				return std::max(v, eval(s));
 			}
 
 			bool interferes(unsigned a, unsigned p) const
 			{
-				return m_interfering_ops[p]->isset(a);
+				return std::binary_search(m_interfering.begin() + m_interfering_offsets[a],
+										  m_interfering.begin() + m_interfering_offsets[a + 1], p);
 			}
 
 			void print_values(std::ostream &os) const
@@ -315,7 +288,7 @@ namespace aptk
 			compute_mutexes_only_aij()
 			{
 				for (unsigned k = 0; k < m_values.size(); k++)
-					m_values[k] = 0.0f;
+					m_values[k] = 0;
 				typedef std::pair<unsigned, unsigned> Fluent_Pair;
 				typedef std::list<Fluent_Pair> Pair_List;
 				Pair_List M;
@@ -329,7 +302,7 @@ namespace aptk
 							if (value(p, q) == infty)
 								continue;
 							M.push_back(Fluent_Pair(p, q));
-							value(p, q) = infty;
+							set_value(p, q, infty);
 						}
 
 				Pair_List M_B;
@@ -348,7 +321,7 @@ namespace aptk
 							if (value(r, q) == infty)
 								continue;
 							M_B.push_back(Fluent_Pair(r, q));
-							value(r, q) = infty;
+							set_value(r, q, infty);
 						}
 					}
 				}
@@ -370,7 +343,7 @@ namespace aptk
 						unsigned q = P.second;
 						if (m_strips_model.is_in_init(p) && m_strips_model.is_in_init(q))
 						{
-							value(p, q) = 0.0f;
+							set_value(p, q, 0.0f);
 							changed = true;
 							continue;
 						}
@@ -402,7 +375,7 @@ namespace aptk
 						}
 						if (needs_to_be_removed)
 						{
-							value(p, q) = 0.0f;
+							set_value(p, q, 0.0f);
 							changed = true;
 						}
 						else
@@ -463,28 +436,176 @@ namespace aptk
 				}
 			}
 
+			static constexpr Pair_Cost cost_infty = std::numeric_limits<Pair_Cost>::max();
+			static constexpr Pair_Cost cost_max = cost_infty - 1;
+
+			static Pair_Cost to_cost(float v)
+			{
+				if (v == infty)
+					return cost_infty;
+				if (v <= 0.0f)
+					return 0;
+				// Rounding down keeps h2 a lower bound with fractional costs
+				float c = std::floor(v);
+				return c >= (float)cost_max ? cost_max : (Pair_Cost)c;
+			}
+
+			static float to_value(Pair_Cost v)
+			{
+				return v == cost_infty ? infty : (float)v;
+			}
+
+			// Adds c to the finite cost v, saturating below infinity
+			static Pair_Cost add_cost(Pair_Cost v, Pair_Cost c)
+			{
+				unsigned sum = (unsigned)v + c;
+				return sum >= cost_max ? cost_max : (Pair_Cost)sum;
+			}
+
+			Pair_Cost eval_cost(const Fluent_Vec &s) const
+			{
+				Pair_Cost v = 0;
+				for (unsigned i = 0; i < s.size(); i++)
+					for (unsigned j = i; j < s.size(); j++)
+					{
+						v = std::max(v, m_values[H2_Helper::pair_index(s[i], s[j])]);
+						if (v == cost_infty)
+							return cost_infty;
+					}
+
+				return v;
+			}
+
+			// An action, relevant to the pair made of the row's fluent and this one
+			struct Relevant_Action
+			{
+				unsigned fluent;
+				unsigned action;
+			};
+
+			struct Relevant_Action_Fluent_Order
+			{
+				bool operator()(const Relevant_Action &e, unsigned f) const { return e.fluent < f; }
+				bool operator()(unsigned f, const Relevant_Action &e) const { return f < e.fluent; }
+			};
+
+			void build_tables(unsigned num_blocks, unsigned num_threads)
+			{
+				unsigned F = m_strips_model.num_fluents();
+				unsigned A = m_strips_model.num_actions();
+				Thread_Pool &pool = Thread_Pool::global();
+
+				// Each task takes a block of actions and lists, per action, the
+				// fluents it adds or deletes and the pairs (p, q), p >= q, in its
+				// precondition or in the condition of one of its effects
+				struct Block
+				{
+					std::vector<unsigned> interfering;
+					std::vector<unsigned> interfering_count;
+					std::vector<std::pair<unsigned, Relevant_Action>> relevant;
+				};
+				std::vector<Block> blocks(num_blocks);
+				m_op_costs.resize(A);
+
+				pool.parallel_for(0, num_blocks, [&](size_t t)
+								  {
+					Block &block = blocks[t];
+					unsigned begin = (size_t)A * t / num_blocks, end = (size_t)A * (t + 1) / num_blocks;
+					std::vector<std::pair<unsigned, unsigned>> pairs;
+					for (unsigned i = begin; i < end; i++)
+					{
+						const Action &a = *(m_strips_model.actions()[i]);
+						m_op_costs[i] = (cost_opt == H2_Cost_Function::Unit_Costs ? 1 : (cost_opt == H2_Cost_Function::Use_Costs ? to_cost(a.cost()) : 0));
+
+						size_t first = block.interfering.size();
+						block.interfering.insert(block.interfering.end(), a.add_vec().begin(), a.add_vec().end());
+						block.interfering.insert(block.interfering.end(), a.del_vec().begin(), a.del_vec().end());
+						std::sort(block.interfering.begin() + first, block.interfering.end());
+						block.interfering.erase(std::unique(block.interfering.begin() + first, block.interfering.end()), block.interfering.end());
+						block.interfering_count.push_back(block.interfering.size() - first);
+
+						pairs.clear();
+						auto add_pairs = [&pairs](const Fluent_Vec &prec)
+						{
+							for (unsigned p = 0; p < prec.size(); ++p)
+								for (unsigned q = p; q < prec.size(); ++q)
+									pairs.push_back(std::make_pair(std::max(prec[p], prec[q]), std::min(prec[p], prec[q])));
+						};
+						// Relevant if the fluent is in the precondition
+						add_pairs(a.prec_vec());
+						// Relevant if the fluent is in the head of a conditional effect
+						for (unsigned j = 0; j < a.ceff_vec().size(); ++j)
+							add_pairs(a.ceff_vec()[j]->prec_vec());
+						std::sort(pairs.begin(), pairs.end());
+						pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+						for (auto &pq : pairs)
+							block.relevant.push_back(std::make_pair(pq.first, Relevant_Action{pq.second, i}));
+					} }, 1, num_threads);
+
+				m_interfering_offsets.assign(A + 1, 0);
+				m_relevant_offsets.assign(F + 1, 0);
+				unsigned a = 0;
+				for (auto &block : blocks)
+				{
+					for (unsigned count : block.interfering_count)
+					{
+						m_interfering_offsets[a + 1] = m_interfering_offsets[a] + count;
+						a++;
+					}
+					m_interfering.insert(m_interfering.end(), block.interfering.begin(), block.interfering.end());
+					for (auto &entry : block.relevant)
+						m_relevant_offsets[entry.first + 1]++;
+				}
+				for (unsigned p = 0; p < F; p++)
+					m_relevant_offsets[p + 1] += m_relevant_offsets[p];
+
+				// Blocks come in action order, so every row ends up sorted by
+				// action and only needs a stable sort on the fluent
+				m_relevant.resize(m_relevant_offsets[F]);
+				std::vector<unsigned> next(m_relevant_offsets.begin(), m_relevant_offsets.end() - 1);
+				for (auto &block : blocks)
+				{
+					for (auto &entry : block.relevant)
+						m_relevant[next[entry.first]++] = entry.second;
+					std::vector<std::pair<unsigned, Relevant_Action>>().swap(block.relevant);
+				}
+				pool.parallel_for(0, F, [this](size_t p)
+								  { std::stable_sort(m_relevant.begin() + m_relevant_offsets[p], m_relevant.begin() + m_relevant_offsets[p + 1],
+													 [](const Relevant_Action &x, const Relevant_Action &y)
+													 { return x.fluent < y.fluent; }); }, 64, num_threads);
+			}
+
+			// Actions relevant to the pair (p, q), p >= q
+			std::pair<const Relevant_Action *, const Relevant_Action *> relevant_actions(unsigned p, unsigned q) const
+			{
+				const Relevant_Action *row = m_relevant.data();
+				return std::equal_range(row + m_relevant_offsets[p], row + m_relevant_offsets[p + 1], q, Relevant_Action_Fluent_Order());
+			}
+
+			void push_update(int curr_idx)
+			{
+				if (!m_already_updated.isset(curr_idx))
+				{
+					m_updated.push_back(curr_idx);
+					m_already_updated.set(curr_idx);
+				}
+			}
+
 			void initialize_ceffs_and_emtpy_precs()
 			{
 				// conditional effects and empty precs
 				for (unsigned k = 0; k < m_strips_model.empty_prec_actions().size(); k++)
 				{
 					const Action &a = *(m_strips_model.empty_prec_actions()[k]);
-					float v = (cost_opt == H2_Cost_Function::Unit_Costs ? 1.0f : (cost_opt == H2_Cost_Function::Use_Costs ? (float)a.cost() : 1.0f + (float)a.cost()));
+					Pair_Cost v = (cost_opt == H2_Cost_Function::Unit_Costs ? 1 : (cost_opt == H2_Cost_Function::Use_Costs ? to_cost(a.cost()) : to_cost(1.0f + (float)a.cost())));
 
 					for (unsigned i = 0; i < a.add_vec().size(); i++)
 					{
-						for (unsigned j = i; i < a.add_vec().size(); j++)
+						for (unsigned j = i; j < a.add_vec().size(); j++)
 						{
-							unsigned p = a.add_vec()[i];
-							unsigned q = a.add_vec()[j];
-							value(p, q) = v;
-
-							int curr_idx = H2_Helper::pair_index(p, q);
-							if (!m_already_updated.isset(curr_idx))
-							{
-								m_updated.push_back(curr_idx);
-								m_already_updated.set(curr_idx);
-							}
+							int curr_idx = H2_Helper::pair_index(a.add_vec()[i], a.add_vec()[j]);
+							m_values[curr_idx] = v;
+							push_update(curr_idx);
 						}
 					}
 
@@ -494,118 +615,66 @@ namespace aptk
 						const Conditional_Effect &ceff = *(a.ceff_vec()[j]);
 						if (!ceff.prec_vec().empty())
 							continue;
-						float v_eff = v;
+						Pair_Cost v_eff = v;
 
 						for (unsigned i = 0; i < ceff.add_vec().size(); i++)
 						{
-							for (unsigned j = i; i < ceff.add_vec().size(); j++)
+							for (unsigned k = i; k < ceff.add_vec().size(); k++)
 							{
-								unsigned p = ceff.add_vec()[i];
-								unsigned q = ceff.add_vec()[j];
-								value(p, q) = v_eff;
-
-								int curr_idx = H2_Helper::pair_index(p, q);
-								if (!m_already_updated.isset(curr_idx))
-								{
-									m_updated.push_back(curr_idx);
-									m_already_updated.set(curr_idx);
-								}
+								int curr_idx = H2_Helper::pair_index(ceff.add_vec()[i], ceff.add_vec()[k]);
+								m_values[curr_idx] = v_eff;
+								push_update(curr_idx);
 							}
 						}
 					}
 				}
 			}
+
 			void initialize(const State &s)
 			{
-				for (unsigned k = 0; k < m_values.size(); k++)
-					m_values[k] = infty;
-				for (unsigned k = 0; k < m_op_values.size(); k++)
-					m_op_values[k] = infty;
-
-				initialize_ceffs_and_emtpy_precs();
-
-				for (unsigned i = 0; i < s.fluent_vec().size(); i++)
-				{
-					unsigned p = s.fluent_vec()[i];
-					value(p, p) = 0.0f;
-
-					int curr_idx = H2_Helper::pair_index(p, p);
-					if (!m_already_updated.isset(curr_idx))
-					{
-						m_updated.push_back(curr_idx);
-						m_already_updated.set(curr_idx);
-					}
-
-					for (unsigned j = i + 1; j < s.fluent_vec().size(); j++)
-					{
-						unsigned q = s.fluent_vec()[j];
-						value(p, q) = 0.0f;
-
-						int curr_idx = H2_Helper::pair_index(p, q);
-						if (!m_already_updated.isset(curr_idx))
-						{
-							m_updated.push_back(curr_idx);
-							m_already_updated.set(curr_idx);
-						}
-					}
-				}
+				initialize(s.fluent_vec());
 			}
 
 			void initialize(const Fluent_Vec &f)
 			{
-				for (unsigned k = 0; k < m_values.size(); k++)
-					m_values[k] = infty;
-				for (unsigned k = 0; k < m_op_values.size(); k++)
-					m_op_values[k] = infty;
+				std::fill(m_values.begin(), m_values.end(), cost_infty);
+				std::fill(m_op_values.begin(), m_op_values.end(), cost_infty);
 
 				initialize_ceffs_and_emtpy_precs();
 
 				for (unsigned i = 0; i < f.size(); i++)
 				{
-					unsigned p = f[i];
-					value(p, p) = 0.0f;
-
-					int curr_idx = H2_Helper::pair_index(p, p);
-					if (!m_already_updated.isset(curr_idx))
+					for (unsigned j = i; j < f.size(); j++)
 					{
-						m_updated.push_back(curr_idx);
-						m_already_updated.set(curr_idx);
-					}
-
-					for (unsigned j = i + 1; j < f.size(); j++)
-					{
-						unsigned q = f[j];
-						value(p, q) = 0.0f;
-
-						int curr_idx = H2_Helper::pair_index(p, q);
-						if (!m_already_updated.isset(curr_idx))
-						{
-							m_updated.push_back(curr_idx);
-							m_already_updated.set(curr_idx);
-						}
+						int curr_idx = H2_Helper::pair_index(f[i], f[j]);
+						m_values[curr_idx] = 0;
+						push_update(curr_idx);
 					}
 				}
 			}
 
 			void compute()
 			{
+				unsigned F = m_strips_model.num_fluents();
 				while (!m_updated.empty())
 				{
+					unsigned hi, lo;
+					H2_Helper::pair_fluents(m_updated.front(), hi, lo);
 
-					unsigned p = m_updated.front();
-
+					m_already_updated.unset(m_updated.front());
 					m_updated.pop_front();
-					m_already_updated.unset(p);
 
-					for (std::set<unsigned>::iterator action_it = m_relevant_actions[p].begin(); action_it != m_relevant_actions[p].end(); ++action_it)
+					auto range = relevant_actions(hi, lo);
+					for (const Relevant_Action *it = range.first; it != range.second; ++it)
 					{
 
-						const Action &action = *(m_strips_model.actions()[*action_it]);
+						const Action &action = *(m_strips_model.actions()[it->action]);
 						unsigned a = action.index();
 
-						op_value(a) = eval(action.prec_vec());
-						if (op_value(a) == infty)
+						Pair_Cost op_v = m_op_values[a] = eval_cost(action.prec_vec());
+						if (op_v == cost_infty)
 							continue;
+						Pair_Cost v = add_cost(op_v, m_op_costs[a]);
 
 						for (unsigned i = 0; i < action.add_vec().size(); i++)
 						{
@@ -613,76 +682,41 @@ namespace aptk
 							for (unsigned j = i; j < action.add_vec().size(); j++)
 							{
 								unsigned q = action.add_vec()[j];
-								float curr_value = value(p, q);
-								if (curr_value == 0.0f)
-									continue;
-								float v = op_value(a);
-								if (cost_opt == H2_Cost_Function::Unit_Costs)
-									v += 1.0f;
-								if (cost_opt == H2_Cost_Function::Use_Costs)
-									v += action.cost();
-								if (v < curr_value)
+								int curr_idx = H2_Helper::pair_index(p, q);
+								if (v < m_values[curr_idx])
 								{
-									value(p, q) = v;
-									int curr_idx = H2_Helper::pair_index(p, q);
-									if (!m_already_updated.isset(curr_idx))
-									{
-										m_updated.push_back(curr_idx);
-										m_already_updated.set(curr_idx);
-									}
-									curr_idx = H2_Helper::pair_index(p, p);
-									if (!m_already_updated.isset(curr_idx))
-									{
-										m_updated.push_back(curr_idx);
-										m_already_updated.set(curr_idx);
-									}
-									curr_idx = H2_Helper::pair_index(q, q);
-									if (!m_already_updated.isset(curr_idx))
-									{
-										m_updated.push_back(curr_idx);
-										m_already_updated.set(curr_idx);
-									}
+									m_values[curr_idx] = v;
+									push_update(curr_idx);
+									push_update(H2_Helper::pair_index(p, p));
+									push_update(H2_Helper::pair_index(q, q));
 								}
 							}
 
-							for (unsigned r = 0; r < m_strips_model.num_fluents(); r++)
+							// Fluents the action does not touch persist through it
+							const unsigned *intf = m_interfering.data() + m_interfering_offsets[a];
+							const unsigned *intf_end = m_interfering.data() + m_interfering_offsets[a + 1];
+							for (unsigned r = 0; r < F; r++)
 							{
-								if (interferes(a, r) || value(p, r) == 0.0f)
-									continue;
-								float h2_pre_noop = std::max(op_value(a), value(r, r));
-								if (h2_pre_noop == infty)
-									continue;
-								for (unsigned j = 0; j < action.prec_vec().size(); j++)
+								if (intf != intf_end && *intf == r)
 								{
-									unsigned s = action.prec_vec()[j];
-									h2_pre_noop = std::max(h2_pre_noop, value(r, s));
+									++intf;
+									continue;
 								}
-								float v = h2_pre_noop;
-								if (cost_opt == H2_Cost_Function::Unit_Costs)
-									v += 1.0f;
-								if (cost_opt == H2_Cost_Function::Use_Costs)
-									v += action.cost();
-								if (v < value(p, r))
+								int curr_idx = H2_Helper::pair_index(p, r);
+								if (m_values[curr_idx] == 0)
+									continue;
+								Pair_Cost h2_pre_noop = std::max(op_v, m_values[H2_Helper::pair_index(r, r)]);
+								for (unsigned j = 0; j < action.prec_vec().size() && h2_pre_noop != cost_infty; j++)
+									h2_pre_noop = std::max(h2_pre_noop, m_values[H2_Helper::pair_index(r, action.prec_vec()[j])]);
+								if (h2_pre_noop == cost_infty)
+									continue;
+								Pair_Cost v_noop = add_cost(h2_pre_noop, m_op_costs[a]);
+								if (v_noop < m_values[curr_idx])
 								{
-									value(p, r) = v;
-									int curr_idx = H2_Helper::pair_index(p, r);
-									if (!m_already_updated.isset(curr_idx))
-									{
-										m_updated.push_back(curr_idx);
-										m_already_updated.set(curr_idx);
-									}
-									curr_idx = H2_Helper::pair_index(r, r);
-									if (!m_already_updated.isset(curr_idx))
-									{
-										m_updated.push_back(curr_idx);
-										m_already_updated.set(curr_idx);
-									}
-									curr_idx = H2_Helper::pair_index(p, p);
-									if (!m_already_updated.isset(curr_idx))
-									{
-										m_updated.push_back(curr_idx);
-										m_already_updated.set(curr_idx);
-									}
+									m_values[curr_idx] = v_noop;
+									push_update(curr_idx);
+									push_update(H2_Helper::pair_index(r, r));
+									push_update(H2_Helper::pair_index(p, p));
 								}
 							}
 						}
@@ -692,22 +726,24 @@ namespace aptk
 
 			void compute_mutexes_only()
 			{
+				unsigned F = m_strips_model.num_fluents();
 				while (!m_updated.empty())
 				{
+					unsigned hi, lo;
+					H2_Helper::pair_fluents(m_updated.front(), hi, lo);
 
-					unsigned p = m_updated.front();
-
+					m_already_updated.unset(m_updated.front());
 					m_updated.pop_front();
-					m_already_updated.unset(p);
 
-					for (std::set<unsigned>::iterator action_it = m_relevant_actions[p].begin(); action_it != m_relevant_actions[p].end(); ++action_it)
+					auto range = relevant_actions(hi, lo);
+					for (const Relevant_Action *it = range.first; it != range.second; ++it)
 					{
 
-						const Action &action = *(m_strips_model.actions()[*action_it]);
+						const Action &action = *(m_strips_model.actions()[it->action]);
 						unsigned a = action.index();
 
-						op_value(a) = eval(action.prec_vec());
-						if (op_value(a) == infty)
+						Pair_Cost op_v = m_op_values[a] = eval_cost(action.prec_vec());
+						if (op_v == cost_infty)
 							continue;
 
 						for (unsigned i = 0; i < action.add_vec().size(); i++)
@@ -716,67 +752,36 @@ namespace aptk
 							for (unsigned j = i; j < action.add_vec().size(); j++)
 							{
 								unsigned q = action.add_vec()[j];
-								float curr_value = value(p, q);
-								if (curr_value == 0.0f)
-									continue;
-								value(p, q) = 0.0f;
 								int curr_idx = H2_Helper::pair_index(p, q);
-								if (!m_already_updated.isset(curr_idx))
-								{
-									m_updated.push_back(curr_idx);
-									m_already_updated.set(curr_idx);
-								}
-								curr_idx = H2_Helper::pair_index(p, p);
-								if (!m_already_updated.isset(curr_idx))
-								{
-									m_updated.push_back(curr_idx);
-									m_already_updated.set(curr_idx);
-								}
-								curr_idx = H2_Helper::pair_index(q, q);
-								if (!m_already_updated.isset(curr_idx))
-								{
-									m_updated.push_back(curr_idx);
-									m_already_updated.set(curr_idx);
-								}
+								if (m_values[curr_idx] == 0)
+									continue;
+								m_values[curr_idx] = 0;
+								push_update(curr_idx);
+								push_update(H2_Helper::pair_index(p, p));
+								push_update(H2_Helper::pair_index(q, q));
 							}
 
-							for (unsigned r = 0; r < m_strips_model.num_fluents(); r++)
+							const unsigned *intf = m_interfering.data() + m_interfering_offsets[a];
+							const unsigned *intf_end = m_interfering.data() + m_interfering_offsets[a + 1];
+							for (unsigned r = 0; r < F; r++)
 							{
-								if (interferes(a, r) || value(p, r) == 0.0f)
-									continue;
-								float h2_pre_noop = std::max(op_value(a), value(r, r));
-								if (h2_pre_noop == infty)
-									continue;
-
-								for (unsigned j = 0; j < action.prec_vec().size(); j++)
+								if (intf != intf_end && *intf == r)
 								{
-									unsigned s = action.prec_vec()[j];
-									h2_pre_noop = std::max(h2_pre_noop, value(r, s));
-									if (h2_pre_noop == infty)
-										break;
-								}
-
-								if (h2_pre_noop == infty)
+									++intf;
 									continue;
-								value(p, r) = 0.0f;
-								int curr_idx = H2_Helper::pair_index(p, r);
-								if (!m_already_updated.isset(curr_idx))
-								{
-									m_updated.push_back(curr_idx);
-									m_already_updated.set(curr_idx);
-								}
-								curr_idx = H2_Helper::pair_index(r, r);
-								if (!m_already_updated.isset(curr_idx))
-								{
-									m_updated.push_back(curr_idx);
-									m_already_updated.set(curr_idx);
-								}
-								curr_idx = H2_Helper::pair_index(p, p);
-								if (!m_already_updated.isset(curr_idx))
-								{
-									m_updated.push_back(curr_idx);
-									m_already_updated.set(curr_idx);
 								}
+								int curr_idx = H2_Helper::pair_index(p, r);
+								if (m_values[curr_idx] == 0)
+									continue;
+								Pair_Cost h2_pre_noop = std::max(op_v, m_values[H2_Helper::pair_index(r, r)]);
+								for (unsigned j = 0; j < action.prec_vec().size() && h2_pre_noop != cost_infty; j++)
+									h2_pre_noop = std::max(h2_pre_noop, m_values[H2_Helper::pair_index(r, action.prec_vec()[j])]);
+								if (h2_pre_noop == cost_infty)
+									continue;
+								m_values[curr_idx] = 0;
+								push_update(curr_idx);
+								push_update(H2_Helper::pair_index(r, r));
+								push_update(H2_Helper::pair_index(p, p));
 							}
 						}
 					}
@@ -785,12 +790,17 @@ namespace aptk
 
 		protected:
 			const STRIPS_Problem &m_strips_model;
-			std::vector<float> m_values;
-			std::vector<float> m_op_values;
-			std::vector<Bit_Set *> m_interfering_ops;
-
-			std::vector<std::set<unsigned>> m_relevant_actions;
-			boost::circular_buffer<int> m_updated;
+			std::vector<Pair_Cost> m_values;
+			std::vector<Pair_Cost> m_op_values;
+			std::vector<Pair_Cost> m_op_costs;
+			// Sorted fluents added or deleted by each action, in CSR form
+			std::vector<unsigned> m_interfering_offsets;
+			std::vector<unsigned> m_interfering;
+
+			// Row p lists the actions relevant to each pair (p, q), q <= p
+			std::vector<unsigned> m_relevant_offsets;
+			std::vector<Relevant_Action> m_relevant;
+			std::deque<unsigned> m_updated;
 			Bit_Set m_already_updated;
 		};
 
@@ -82,7 +82,6 @@ namespace aptk
 				unsigned fluent() const { return m_fluent; }
 				bool is_consumed() const { return m_consumed; }
 				bool is_consumed_once() const { return m_consumed_once; }
-				bool *is_consumed_ptr() { return &m_consumed; }
 				void consume()
 				{
 					m_consumed = true;
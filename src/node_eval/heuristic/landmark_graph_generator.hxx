@@ -36,8 +36,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <landmark_graph.hxx>
 #include <h_1.hxx>
 #include <action.hxx>
+#include <thread_pool.hxx>
 #include <vector>
 #include <deque>
+#include <utility>
 #include <iosfwd>
 
 namespace aptk
@@ -54,7 +56,8 @@ namespace aptk
 
 		public:
 			Landmarks_Graph_Generator(const Search_Model &prob)
-					: m_strips_model(prob.task()), m_only_goals(false), m_goal_ordering(true), m_h1(prob), m_verbose(false), m_collect_lm_in_init(false)
+					: m_strips_model(prob.task()), m_only_goals(false), m_goal_ordering(true), m_h1(prob), m_verbose(false), m_collect_lm_in_init(false),
+						m_num_threads(0), m_time_budget(0), m_timed_out(false)
 			{
 				m_reachability = new aptk::agnostic::Reachability_Test(prob.task());
 			}
@@ -74,6 +77,16 @@ namespace aptk
 
 			void set_goal_ordering(bool b) { m_goal_ordering = b; }
 
+			// Threads of Thread_Pool::global() to compute the graph with, 0 means all
+			void set_num_threads(unsigned n) { m_num_threads = n; }
+
+			// Seconds compute_lm_graph_set_additive() may take, 0 for no limit
+			void set_time_budget(double secs) { m_time_budget = secs; }
+			// h_max of the generator, see H1_Heuristic::set_radix_heap()
+			void set_radix_heap(bool b) { m_h1.set_radix_heap(b); }
+			// Whether the last graph only has the goals because time ran out
+			bool timed_out() const { return m_timed_out; }
+
 			void build_goal_ordering(Landmarks_Graph &graph)
 			{
 
@@ -135,10 +148,20 @@ namespace aptk
 				}
 			}
 
+			/**
+			 * Landmarks are back-chained from the goals a round at a time: the
+			 * fluents every achiever of a landmark requires are computed in
+			 * parallel for all the landmarks found in the previous round, and
+			 * then added in the order a FIFO queue would process them. Greedy
+			 * necessary orderings are also computed in parallel, one landmark
+			 * per task, and the graph is only filled once all of it is known.
+			 * When the time budget runs out, the goals are the only landmarks.
+			 */
 			void compute_lm_graph_set_additive(Landmarks_Graph &graph)
 			{
 
-				std::deque<unsigned> updated;
+				Fluent_Vec updated;
+				m_timed_out = false;
 
 				// 1. Insert goal atoms as landmarks
 				for (Fluent_Vec::const_iterator it = m_strips_model.goal().begin();
@@ -158,61 +181,59 @@ namespace aptk
 					return;
 				}
 
-				Bit_Set lm_set(m_strips_model.num_fluents());
-				Bit_Set processed(m_strips_model.num_fluents());
-
+				Cancellation_Token token;
+				if (m_time_budget > 0)
+					token.set_deadline(m_time_budget);
+				Thread_Pool &pool = Thread_Pool::global();
+
+				unsigned F = m_strips_model.num_fluents();
+				Bit_Set is_landmark(F);
+				for (unsigned p : m_strips_model.goal())
+					is_landmark.set(p);
+				Fluent_Vec new_landmarks;
+				std::vector<std::pair<unsigned, unsigned>> orderings;
+				std::vector<Fluent_Vec> required_by(F);
+
+				Bit_Set processed(F);
+				Fluent_Vec round;
+				std::vector<Fluent_Vec> lm_sets;
 				while (!updated.empty())
 				{
-					unsigned p = updated.front();
-					updated.pop_front();
-
-					if (processed.isset(p))
-						continue;
-					processed.set(p);
-
-					// std::cout << "Processing landmark: " << m_strips_model.fluents()[ p ]->signature() << std::endl;
-					const std::vector<const Action *> &add_acts = m_strips_model.actions_adding(p);
-					// std::cout << "Added by " << add_acts.size() << " actions" << std::endl;
-					if (!add_acts.empty())
+					round.clear();
+					for (unsigned p : updated)
 					{
-						lm_set.reset();
-						lm_set.add(add_acts[0]->prec_set());
-
-						for (unsigned k = 1; k < add_acts.size(); k++)
-							lm_set.set_intersection(add_acts[k]->prec_set());
+						if (processed.isset(p))
+							continue;
+						processed.set(p);
+						round.push_back(p);
 					}
+					updated.clear();
 
-					const std::vector<std::pair<unsigned, const Action *>> &add_acts_ce =
-							m_strips_model.ceffs_adding(p);
+					lm_sets.assign(round.size(), Fluent_Vec());
+					pool.parallel_for(0, round.size(), [&](size_t i)
+														{ shared_preconditions(round[i], lm_sets[i]); }, 16, m_num_threads, &token);
+					if (token.cancelled())
+						return use_goals_only(graph);
 
-					if (!add_acts_ce.empty())
+					for (unsigned i = 0; i < round.size(); i++)
 					{
-
-						for (unsigned k = 0; k < add_acts_ce.size(); k++)
+						unsigned p = round[i];
+						for (unsigned q : lm_sets[i])
 						{
-							lm_set.set_intersection(add_acts_ce[k].second->prec_set());
-							lm_set.set_intersection(add_acts_ce[k].second->ceff_vec()[add_acts_ce[k].first]->prec_set());
-						}
-					}
+							if (!m_collect_lm_in_init && m_strips_model.is_in_init(q))
+							{
+								continue;
+							}
 
-					// std::cout << "LM set size: " << lm_set.bits().count_elements() << std::endl;
-					for (unsigned q : lm_set)
-					{
-						if (!m_collect_lm_in_init && m_strips_model.is_in_init(q))
-						{
-							continue;
+							if (!is_landmark.isset(q))
+							{
+								is_landmark.set(q);
+								new_landmarks.push_back(q);
+							}
+							orderings.push_back(std::make_pair(p, q));
+							required_by[q].push_back(p);
+							updated.push_back(q);
 						}
-
-						if (!graph.is_landmark(q))
-							graph.add_landmark(q);
-						//				if ( ! m_strips_model.is_in_goal(p) )
-						graph.add_landmark_for(p, q);
-						// else{
-						// 	graph.add_landmark_for( p, q );
-						// 	//graph.node(p)->add_precedent_gn( graph.node(q) );
-						// 	//graph.node(q)->add_requiring_gn( graph.node(p) );
-						// }
-						updated.push_back(q);
 					}
 				}
 
@@ -226,51 +247,25 @@ namespace aptk
 				init_s.set(m_strips_model.init());
 				m_h1.eval(init_s, h_goal);
 
-				for (unsigned p = 1; p < m_strips_model.num_fluents(); p++)
+				Fluent_Vec landmarks;
+				for (unsigned p = 1; p < F; p++)
+					if (is_landmark.isset(p))
+						landmarks.push_back(p);
+				std::vector<Fluent_Vec> gn_sets(landmarks.size());
+				pool.parallel_for(0, landmarks.size(), [&](size_t i)
+													{ first_achievers_preconditions(landmarks[i], reach_actions, required_by, gn_sets[i]); }, 16, m_num_threads, &token);
+				if (token.cancelled())
+					return use_goals_only(graph);
+
+				for (unsigned q : new_landmarks)
+					graph.add_landmark(q);
+				for (auto &o : orderings)
+					graph.add_landmark_for(o.first, o.second);
+
+				for (unsigned i = 0; i < landmarks.size(); i++)
 				{
-
-					if (!graph.is_landmark(p))
-						continue;
-					Action_Ptr_Const_Vec best_supp;
-
-					m_h1.get_best_supporters(p, best_supp);
-
-					// const std::vector<const Action*>& add_acts = m_strips_model.actions_adding( p );
-
-					lm_set.reset();
-
-					for (unsigned k = 0; k < best_supp.size(); k++)
-					{
-						const Action *a = best_supp[k];
-						/**
-						 * if action is reachable
-						 */
-						if (!reach_actions.isset(a->index()))
-							continue;
-
-						Bit_Set lands_a(m_strips_model.num_fluents());
-
-						getPCFluentLandmarks(a->index(), lands_a, graph);
-
-						/**
-						 * if action do contain p as landmark
-						 */
-
-						if (lands_a.isset(p))
-						{
-							//				  std::cout << m_strips_model.actions()[a->index()]->signature() << "NOT first sup of " << m_strips_model.fluents()[p]->signature() << std::endl;
-
-							continue;
-						}
-						// std::cout << m_strips_model.actions()[a->index()]->signature() << "first sup of " << m_strips_model.fluents()[p]->signature() << std::endl;
-
-						if (k == 0)
-							lm_set.add(a->prec_set());
-						else
-							lm_set.set_intersection(a->prec_set());
-					}
-
-					for (unsigned q : lm_set)
+					unsigned p = landmarks[i];
+					for (unsigned q : gn_sets[i])
 					{
 						/**
 						 * Do not add gn of lands in intial state
@@ -305,38 +300,101 @@ namespace aptk
 			}
 
 		protected:
-			void getFluentLandmarks(unsigned p, Bit_Set &landmarks, Landmarks_Graph &graph)
+			void use_goals_only(Landmarks_Graph &graph)
 			{
+				m_timed_out = true;
+				if (m_verbose)
+					std::cout << "Landmark graph out of time, only goals are landmarks" << std::endl;
+				if (m_goal_ordering)
+					build_goal_ordering(graph);
+			}
 
-				if (!graph.is_landmark(p))
-					return;
-
-				for (std::vector<Landmarks_Graph::Node *>::const_iterator it = graph.node(p)->preceded_by().begin();
-						 it != graph.node(p)->preceded_by().end(); it++)
+			// Fluents required by every action and conditional effect adding p
+			void shared_preconditions(unsigned p, Fluent_Vec &lms) const
+			{
+				Bit_Set lm_set(m_strips_model.num_fluents());
+				bool first = true;
+				for (const Action *a : m_strips_model.actions_adding(p))
 				{
-					unsigned fl = (*it)->fluent();
+					if (first)
+						lm_set.add(a->prec_set());
+					else
+						lm_set.set_intersection(a->prec_set());
+					first = false;
+				}
 
-					if (landmarks.isset(fl))
-						continue;
-					// std::cout << m_strips_model.fluents()[fl]->signature() << " " <<std::endl;
-					landmarks.set(fl);
-					getFluentLandmarks(fl, landmarks, graph);
+				for (auto &ce : m_strips_model.ceffs_adding(p))
+				{
+					if (first)
+						lm_set.add(ce.second->prec_set());
+					else
+						lm_set.set_intersection(ce.second->prec_set());
+					lm_set.set_intersection(ce.second->ceff_vec()[ce.first]->prec_set());
+					first = false;
 				}
+
+				for (unsigned q : lm_set)
+					lms.push_back(q);
 			}
 
-			void getPCFluentLandmarks(unsigned act_idx,
-																Bit_Set &landmarks, Landmarks_Graph &graph)
+			/**
+			 * Fluents required by the reachable best supporters of p that can
+			 * be its first achievers, those without p among the landmarks of
+			 * their preconditions. A precondition has p as a landmark when it
+			 * is p or requires p through natural orderings. A landmark is
+			 * required by every achiever of the fluents that follow it, so
+			 * their h_max is not lower, and those above h_max(p) cannot be
+			 * preconditions of a best supporter of p.
+			 */
+			void first_achievers_preconditions(unsigned p, const Bit_Set &reach_actions,
+											   const std::vector<Fluent_Vec> &required_by, Fluent_Vec &lms) const
 			{
+				Action_Ptr_Const_Vec best_supp;
+				m_h1.get_best_supporters(p, best_supp);
+				if (best_supp.empty())
+					return;
 
-				// std::cout << "Action " << m_strips_model.actions()[act_idx]->signature() << " Land: ";
-				const Fluent_Vec &prec = m_strips_model.actions()[act_idx]->prec_vec();
-				for (unsigned i = 0; i < prec.size(); i++)
+				float h_p = m_h1.value(p);
+				Bit_Set after_p(m_strips_model.num_fluents());
+				Fluent_Vec open(1, p);
+				after_p.set(p);
+				while (!open.empty())
 				{
-					landmarks.set(prec[i]);
-					//	std::cout << m_strips_model.fluents()[prec[i]]->signature() << " " <<std::endl;
-					getFluentLandmarks(prec[i], landmarks, graph);
+					unsigned f = open.back();
+					open.pop_back();
+					for (unsigned g : required_by[f])
+					{
+						if (after_p.isset(g) || m_h1.value(g) > h_p)
+							continue;
+						after_p.set(g);
+						open.push_back(g);
+					}
 				}
-				//	std::cout << std::endl;
+
+				Bit_Set lm_set(m_strips_model.num_fluents());
+				for (unsigned k = 0; k < best_supp.size(); k++)
+				{
+					const Action *a = best_supp[k];
+					/**
+					 * if action is reachable
+					 */
+					if (!reach_actions.isset(a->index()))
+						continue;
+
+					/**
+					 * if action do contain p as landmark
+					 */
+					if (a->prec_set().intersects(after_p))
+						continue;
+
+					if (k == 0)
+						lm_set.add(a->prec_set());
+					else
+						lm_set.set_intersection(a->prec_set());
+				}
+
+				for (unsigned q : lm_set)
+					lms.push_back(q);
 			}
 
 		protected:
@@ -347,6 +405,9 @@ namespace aptk
 			H_Max m_h1;
 			bool m_verbose;
 			bool m_collect_lm_in_init;
+			unsigned m_num_threads;
+			double m_time_budget;
+			bool m_timed_out;
 		};
 
 	}
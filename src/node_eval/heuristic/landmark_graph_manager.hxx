@@ -44,12 +44,21 @@ namespace aptk
 	namespace agnostic
 	{
 
+		/**
+		 * Landmarks whose consumed flag changed when a node was generated,
+		 * in the order they changed. Each entry packs the landmark fluent
+		 * shifted left one bit with the new flag in the lowest bit, so a
+		 * node pays one word per landmark its action changed and the delta
+		 * is undone by replaying it backwards.
+		 */
+		typedef std::vector<unsigned> Landmark_Delta;
+
 		template <typename Search_Model>
 		class Landmarks_Graph_Manager
 		{
 		public:
 			Landmarks_Graph_Manager(const Search_Model &prob, Landmarks_Graph *lg)
-					: m_strips_model(prob.task())
+					: m_strips_model(prob.task()), m_node(NULL), m_tracking(false)
 			{
 				m_graph = lg;
 			}
@@ -61,29 +70,85 @@ namespace aptk
 			void reset_graph()
 			{
 				m_graph->unconsume_all();
+				m_node = NULL;
+				m_tracking = true;
+			}
+
+			void update_graph(const Landmark_Delta *delta)
+			{
+				if (delta)
+					for (Landmark_Delta::const_iterator it = delta->begin(); it != delta->end(); it++)
+						set_consumed(*it >> 1, *it & 1);
+			}
+
+			void undo_graph(const Landmark_Delta *delta)
+			{
+				if (delta)
+					for (Landmark_Delta::const_reverse_iterator it = delta->rbegin(); it != delta->rend(); it++)
+						set_consumed(*it >> 1, !(*it & 1));
 			}
 
-			void update_graph(Bool_Vec_Ptr *&keep_consumed, Bool_Vec_Ptr *&keep_unconsumed)
+			// The graph reflects the path to n, e.g. the root once
+			// apply_state() has recorded and applied its delta
+			template <typename Search_Node>
+			void set_node(Search_Node *n)
 			{
-				if (keep_consumed)
-					for (Bool_Vec_Ptr::iterator it = keep_consumed->begin(); it != keep_consumed->end(); it++)
-						**it = true;
-				if (keep_unconsumed)
-					for (Bool_Vec_Ptr::iterator it = keep_unconsumed->begin(); it != keep_unconsumed->end(); it++)
-						**it = false;
+				m_node = n;
+				m_tracking = true;
 			}
 
-			void undo_graph(Bool_Vec_Ptr *&undo_consumed, Bool_Vec_Ptr *&undo_unconsumed)
+			// Undoes the delta of n, the last one applied. When the graph
+			// rested on n it rests on the parent of n afterwards
+			template <typename Search_Node>
+			void undo_node(Search_Node *n)
 			{
-				if (undo_consumed)
-					for (Bool_Vec_Ptr::iterator it = undo_consumed->begin(); it != undo_consumed->end(); it++)
-						**it = false;
-				if (undo_unconsumed)
-					for (Bool_Vec_Ptr::iterator it = undo_unconsumed->begin(); it != undo_unconsumed->end(); it++)
-						**it = true;
+				undo_graph(n->land_delta());
+				if (m_node == n)
+					m_node = n->parent();
+			}
+
+			/**
+			 * Brings the graph to the landmarks consumed along the path from
+			 * the root to n. Deltas are undone from the node the graph was
+			 * last moved to up to its closest common ancestor with n, and
+			 * replayed from there down to n, so moving to a sibling or a child
+			 * costs the landmarks that changed rather than the depth of n.
+			 *
+			 * The node last moved to must still be alive, and keep its
+			 * parent, when the next move starts: engines undo the delta of a
+			 * candidate once it has been counted, so the graph only rests on
+			 * expanded nodes and the root, and call reset_graph() before
+			 * reparenting one.
+			 */
+			template <typename Search_Node>
+			void move_to(Search_Node *n)
+			{
+				m_path.clear();
+
+				if (!m_tracking)
+					reset_graph();
+
+				Search_Node *from = static_cast<Search_Node *>(m_node);
+				Search_Node *to = n;
+				while (from != to)
+				{
+					if (to == NULL || (from != NULL && from->gn_unit() >= to->gn_unit()))
+					{
+						undo_graph(from->land_delta());
+						from = from->parent();
+					}
+					else
+					{
+						m_path.push_back(to);
+						to = to->parent();
+					}
+				}
+				for (std::vector<void *>::reverse_iterator it = m_path.rbegin(); it != m_path.rend(); it++)
+					update_graph(static_cast<Search_Node *>(*it)->land_delta());
+				m_node = n;
 			}
 
-			void apply_action(State *s, Action_Idx a_idx, Bool_Vec_Ptr *&keep_consumed, Bool_Vec_Ptr *&keep_unconsumed)
+			void apply_action(State *s, Action_Idx a_idx, Landmark_Delta *&delta)
 			{
 				const Action *a = m_strips_model.actions()[a_idx];
 				const Fluent_Vec &add = a->add_vec();
@@ -99,11 +164,9 @@ namespace aptk
 						if (!n->is_consumed())
 							if (n->are_precedences_consumed() && n->are_gn_precedences_consumed())
 							{
-								if (!keep_consumed)
-									keep_consumed = new Bool_Vec_Ptr;
 								// std::cout << "\t -- "<<p <<" - " << m_strips_model.fluents()[ p ]->signature() << std::endl;
 								n->consume();
-								keep_consumed->push_back(n->is_consumed_ptr());
+								record(delta, p, true);
 							}
 					}
 				}
@@ -124,11 +187,8 @@ namespace aptk
 						if (unconsume)
 						{
 							// std::cout << "\t ++ "<<p <<" - " << m_strips_model.fluents()[ p ]->signature() << std::endl;
-							if (!keep_unconsumed)
-								keep_unconsumed = new Bool_Vec_Ptr;
-
 							n->unconsume();
-							keep_unconsumed->push_back(n->is_consumed_ptr());
+							record(delta, p, false);
 						}
 					}
 				}
@@ -139,12 +199,12 @@ namespace aptk
 					{
 						Conditional_Effect *ce = a->ceff_vec()[i];
 						if (ce->can_be_applied_on(*s))
-							apply_cond_eff(s, ce, keep_consumed, keep_unconsumed);
+							apply_cond_eff(s, ce, delta);
 					}
 				}
 			}
 
-			void apply_cond_eff(State *s, Conditional_Effect *ce, Bool_Vec_Ptr *&keep_consumed, Bool_Vec_Ptr *&keep_unconsumed)
+			void apply_cond_eff(State *s, Conditional_Effect *ce, Landmark_Delta *&delta)
 			{
 
 				const Fluent_Vec &add = ce->add_vec();
@@ -160,11 +220,9 @@ namespace aptk
 						if (!n->is_consumed())
 							if (n->are_precedences_consumed() && n->are_gn_precedences_consumed())
 							{
-								if (!keep_consumed)
-									keep_consumed = new Bool_Vec_Ptr;
 								// std::cout << "\t -- "<<p <<" - " << m_strips_model.fluents()[ p ]->signature() << std::endl;
 								n->consume();
-								keep_consumed->push_back(n->is_consumed_ptr());
+								record(delta, p, true);
 							}
 					}
 				}
@@ -185,11 +243,8 @@ namespace aptk
 						if (unconsume)
 						{
 							// std::cout << "\t ++ "<<p <<" - " << m_strips_model.fluents()[ p ]->signature() << std::endl;
-							if (!keep_unconsumed)
-								keep_unconsumed = new Bool_Vec_Ptr;
-
 							n->unconsume();
-							keep_unconsumed->push_back(n->is_consumed_ptr());
+							record(delta, p, false);
 						}
 					}
 				}
@@ -197,6 +252,7 @@ namespace aptk
 
 			void apply_action(const State *s, Action_Idx a_idx)
 			{
+				m_tracking = false;
 				const Action *a = m_strips_model.actions()[a_idx];
 				const Fluent_Vec &add = a->add_vec();
 				const Fluent_Vec &del = a->del_vec();
@@ -289,7 +345,7 @@ namespace aptk
 				}
 			}
 
-			void apply_state(const Fluent_Vec &fl, Bool_Vec_Ptr *&keep_consumed, Bool_Vec_Ptr *&keep_unconsumed)
+			void apply_state(const Fluent_Vec &fl, Landmark_Delta *&delta)
 			{
 
 				for (Fluent_Vec::const_iterator it_fl = fl.begin(); it_fl != fl.end(); it_fl++)
@@ -302,10 +358,8 @@ namespace aptk
 						Landmarks_Graph::Node *n = m_graph->node(p);
 						if ((!n->is_consumed()) && n->are_precedences_consumed() && n->are_gn_precedences_consumed())
 						{
-							if (!keep_consumed)
-								keep_consumed = new Bool_Vec_Ptr;
 							n->consume();
-							keep_consumed->push_back(n->is_consumed_ptr());
+							record(delta, p, true);
 						}
 					}
 				}
@@ -313,6 +367,7 @@ namespace aptk
 
 			void apply_state(const Fluent_Vec &fl)
 			{
+				m_tracking = false;
 
 				for (Fluent_Vec::const_iterator it_fl = fl.begin(); it_fl != fl.end(); it_fl++)
 				{
@@ -335,8 +390,28 @@ namespace aptk
 			const STRIPS_Problem &problem() const { return m_strips_model; }
 
 		protected:
+			void set_consumed(unsigned p, bool consumed)
+			{
+				if (consumed)
+					m_graph->consume_node(p);
+				else
+					m_graph->unconsume_node(p);
+			}
+
+			static void record(Landmark_Delta *&delta, unsigned p, bool consumed)
+			{
+				if (!delta)
+					delta = new Landmark_Delta;
+				delta->push_back((p << 1) | (consumed ? 1 : 0));
+			}
+
 			const STRIPS_Problem &m_strips_model;
 			Landmarks_Graph *m_graph;
+			// Node whose path the graph reflects, NULL for none, while tracking
+			void *m_node;
+			bool m_tracking;
+			// Nodes move_to() replays deltas from, kept to reuse the buffer
+			std::vector<void *> m_path;
 		};
 
 	}
@@ -543,6 +543,12 @@ namespace aptk
 
 			void ignore_rp_h_value(bool b) { m_plan_extractor.ignore_rp_h_value(b); }
 
+			// Options of the base heuristic, see H1_Heuristic::set_radix_heap()
+			// and H1_Heuristic::set_incremental()
+			void set_radix_heap(bool b) { m_base_heuristic.set_radix_heap(b); }
+			void set_incremental(unsigned cache_size) { m_base_heuristic.set_incremental(cache_size); }
+			void set_parent(const State *parent) { m_base_heuristic.set_parent(parent); }
+
 			void set_one_HA_per_fluent(bool b) { m_plan_extractor.set_one_HA_per_fluent(b); }
 
 			bool is_relaxed_plan_relevant(unsigned p) { return m_plan_extractor.is_relaxed_plan_relevant(p); }
@@ -0,0 +1,218 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef __CONCURRENT_NOVELTY__
+#define __CONCURRENT_NOVELTY__
+
+#include <strips_state.hxx>
+#include <strips_prob.hxx>
+#include <action.hxx>
+#include <ext_math.hxx>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <iostream>
+
+namespace aptk
+{
+
+	namespace agnostic
+	{
+
+		/**
+		 * Novelty table shared by the threads of a layered search (width 1 or 2).
+		 *
+		 * A layer is evaluated in three steps: every successor gathers the
+		 * tuples it would make true for the first time (tuples()) and claims
+		 * them with its generation key (claim()); a successor is novel iff it
+		 * holds the smallest key on at least one of its tuples (holds_any()),
+		 * in which case it marks those tuples as covered (cover()); finally the
+		 * claims are released (release()). Since the smallest key wins, the
+		 * result is the one sequential IW gets when it generates the layer in
+		 * key order.
+		 */
+		template <typename Search_Model>
+		class Concurrent_Novelty
+		{
+		public:
+			static const uint64_t no_claim = std::numeric_limits<uint64_t>::max();
+
+			Concurrent_Novelty(const Search_Model &prob, unsigned max_arity = 1, const unsigned max_MB = 2048)
+					: m_strips_model(prob.task()), m_arity(0), m_num_tuples(0), m_num_fluents(0), m_max_memory_size_MB(max_MB), m_verbose(true)
+			{
+				set_arity(max_arity);
+			}
+
+			virtual ~Concurrent_Novelty()
+			{
+			}
+
+			void set_verbose(bool v) { m_verbose = v; }
+			unsigned arity() const { return m_arity; }
+
+			unsigned set_arity(unsigned max_arity)
+			{
+				m_arity = max_arity > 2 ? 2 : (max_arity == 0 ? 1 : max_arity);
+				m_num_fluents = m_strips_model.num_fluents();
+
+				float size_novelty = ((float)pow(m_num_fluents, m_arity) / 1024000.) * (sizeof(uint64_t) + 1);
+				if (m_verbose)
+					std::cout << "Try allocate size: " << size_novelty << " MB" << std::endl;
+				if (size_novelty > m_max_memory_size_MB)
+				{
+					m_arity = 1;
+					size_novelty = ((float)m_num_fluents / 1024000.) * (sizeof(uint64_t) + 1);
+					if (m_verbose)
+						std::cout << "EXCEDED, m_arity downgraded to 1 --> size: " << size_novelty << " MB" << std::endl;
+				}
+
+				unsigned long num_tuples = m_arity == 1 ? m_num_fluents : (unsigned long)m_num_fluents * m_num_fluents;
+				if (num_tuples != m_num_tuples)
+				{
+					m_num_tuples = num_tuples;
+					m_claims.reset(new std::atomic<uint64_t>[m_num_tuples]);
+					m_covered.resize(m_num_tuples);
+				}
+				init();
+				return m_arity;
+			}
+
+			void init()
+			{
+				for (unsigned long i = 0; i < m_num_tuples; i++)
+					m_claims[i].store(no_claim, std::memory_order_relaxed);
+				std::fill(m_covered.begin(), m_covered.end(), 0);
+			}
+
+			/**
+			 * Tuples of s not covered yet. When a is given (s results from
+			 * applying a on parent) only the tuples containing an atom added
+			 * by a are considered, the rest were already made true by parent.
+			 * The fluents of s are walked in place, dense states are not given
+			 * a fluent vector.
+			 */
+			void tuples(const State &s, const State *parent, const Action *a, std::vector<unsigned> &out) const
+			{
+				out.clear();
+				if (a == nullptr || parent == nullptr)
+				{
+					s.for_each_fluent([&](unsigned p)
+														{
+						push(p, out);
+						if (m_arity == 2)
+							push_pairs(p, s, true, out); });
+					return;
+				}
+
+				add_tuples(a->add_vec(), s, out);
+				for (auto ce : a->ceff_vec())
+					if (ce->can_be_applied_on(*parent))
+						add_tuples(ce->add_vec(), s, out);
+			}
+
+			void claim(const std::vector<unsigned> &tuples, uint64_t key)
+			{
+				for (auto t : tuples)
+				{
+					uint64_t current = m_claims[t].load(std::memory_order_relaxed);
+					while (key < current && !m_claims[t].compare_exchange_weak(current, key, std::memory_order_relaxed))
+						;
+				}
+			}
+
+			bool holds_any(const std::vector<unsigned> &tuples, uint64_t key) const
+			{
+				for (auto t : tuples)
+					if (m_claims[t].load(std::memory_order_relaxed) == key)
+						return true;
+				return false;
+			}
+
+			void cover(const std::vector<unsigned> &tuples, uint64_t key)
+			{
+				for (auto t : tuples)
+					if (m_claims[t].load(std::memory_order_relaxed) == key)
+						m_covered[t] = 1;
+			}
+
+			void release(const std::vector<unsigned> &tuples)
+			{
+				for (auto t : tuples)
+					m_claims[t].store(no_claim, std::memory_order_relaxed);
+			}
+
+		protected:
+			void add_tuples(const Fluent_Vec &add, const State &s, std::vector<unsigned> &out) const
+			{
+				for (auto p : add)
+				{
+					push(p, out);
+					if (m_arity == 2)
+						push_pairs(p, s, false, out);
+				}
+			}
+
+			// Pairs of p with the other fluents q of s, only those with p < q
+			// when ordered
+			void push_pairs(unsigned p, const State &s, bool ordered, std::vector<unsigned> &out) const
+			{
+				s.for_each_fluent([&](unsigned q)
+													{
+					if (ordered ? p < q : p != q)
+						push(pair_idx(p, q), out); });
+			}
+
+			inline void push(unsigned t, std::vector<unsigned> &out) const
+			{
+				if (!m_covered[t])
+					out.push_back(t);
+			}
+
+			// same layout as Novelty, pairs never collide with single atoms
+			inline unsigned pair_idx(unsigned p, unsigned q) const
+			{
+				return p < q ? p + q * m_num_fluents : q + p * m_num_fluents;
+			}
+
+			const STRIPS_Problem &m_strips_model;
+			unsigned m_arity;
+			unsigned long m_num_tuples;
+			unsigned m_num_fluents;
+			unsigned m_max_memory_size_MB;
+			bool m_verbose;
+			std::unique_ptr<std::atomic<uint64_t>[]> m_claims;
+			std::vector<unsigned char> m_covered;
+		};
+
+	}
+
+}
+
+#endif // concurrent_novelty.hxx
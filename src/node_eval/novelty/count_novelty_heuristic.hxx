@@ -222,7 +222,7 @@ namespace aptk
 				if (!has_state)
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()]);
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
 				bool new_covers = false;
 
@@ -363,7 +363,7 @@ namespace aptk
 				if (!has_state)
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()]);
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
 				// /*debug*/
 				// std::cout << fl <<std::endl;
@@ -472,7 +472,7 @@ namespace aptk
 				return idx;
 			}
 
-			inline void idx2tuple(std::vector<unsigned> &tuple, Fluent_Vec &fl, unsigned idx, unsigned arity) const
+			inline void idx2tuple(std::vector<unsigned> &tuple, const Fluent_Vec &fl, unsigned idx, unsigned arity) const
 			{
 				unsigned next_idx, div;
 				unsigned current_idx = idx;
@@ -522,7 +522,7 @@ namespace aptk
                 if (!has_state)
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()]);
 
-                Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+                const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
                 std::vector<unsigned> tuple(m_arity);
 
@@ -564,6 +564,8 @@ namespace aptk
 			unsigned m_num_fluents;
 			unsigned m_max_memory_size_MB;
 			bool m_verbose;
+			// fluents of dense states, which keep no fluent vector
+			Fluent_Vec m_fluent_buffer;
 		};
 
 	}
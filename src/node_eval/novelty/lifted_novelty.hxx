@@ -0,0 +1,111 @@
+
+/*
+Lightweight Automated Planning Toolkit
+
+Copyright 2022
+Miquel Ramirez <miquel.ramirez@unimelb.edu.au>Nir Lipovetzky <nirlipo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject
+ to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef __LIFTED_NOVELTY__
+#define __LIFTED_NOVELTY__
+
+#include <types.hxx>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace aptk
+{
+
+	namespace agnostic
+	{
+
+		/**
+		 * Novelty of states whose fluents are numbered as they are reached,
+		 * as in a Lifted_Problem. Atoms seen are kept in bit vectors that
+		 * grow with the largest fluent index, and pairs in hash sets, so
+		 * memory follows the tuples that actually appear rather than
+		 * num_fluents()^arity. Supports arity 1 and 2, with one table per
+		 * partition (e.g. number of goals left in BFWS).
+		 */
+		class Lifted_Novelty
+		{
+		public:
+			Lifted_Novelty(unsigned arity = 1) { set_arity(arity); }
+
+			void init()
+			{
+				m_atoms.clear();
+				m_pairs.clear();
+			}
+
+			unsigned arity() const { return m_arity; }
+			unsigned set_arity(unsigned arity)
+			{
+				m_arity = arity < 1 ? 1 : (arity > 2 ? 2 : arity);
+				init();
+				return m_arity;
+			}
+
+			// Smallest size of a tuple of s not seen before in the
+			// partition, arity() + 1 if none. Records the tuples of s
+			unsigned eval(const Fluent_Vec &s, unsigned partition = 0)
+			{
+				if (partition >= m_atoms.size())
+				{
+					m_atoms.resize(partition + 1);
+					m_pairs.resize(partition + 1);
+				}
+				unsigned w = m_arity + 1;
+				std::vector<bool> &seen = m_atoms[partition];
+				for (auto f : s)
+				{
+					if (f >= seen.size())
+						seen.resize(f + 1, false);
+					if (!seen[f])
+					{
+						seen[f] = true;
+						w = 1;
+					}
+				}
+				if (m_arity < 2)
+					return w;
+
+				std::unordered_set<uint64_t> &pairs = m_pairs[partition];
+				for (unsigned i = 0; i < s.size(); i++)
+					for (unsigned j = i + 1; j < s.size(); j++)
+						if (pairs.insert(((uint64_t)s[i] << 32) | s[j]).second && w > 2)
+							w = 2;
+				return w;
+			}
+
+		protected:
+			unsigned m_arity;
+			std::vector<std::vector<bool>> m_atoms;
+			std::vector<std::unordered_set<uint64_t>> m_pairs;
+		};
+
+	}
+
+}
+
+#endif // lifted_novelty.hxx
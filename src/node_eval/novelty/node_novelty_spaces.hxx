@@ -31,6 +31,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <search_prob.hxx>
 #include <resources_control.hxx>
 #include <closed_list.hxx>
+#include <delta_state_store.hxx>
 #include <hash_table.hxx>
 
 #include <queue>
@@ -54,7 +55,7 @@ namespace aptk
         typedef State State_Type;
 
         Node(State *s, Action_Idx action, Node<State> *parent = nullptr, float cost = 1.0f, bool compute_hash = true)
-          : m_state(s), m_parent(parent), m_action(action), m_g(0), m_partition(0), m_compare_only_state(false)
+          : m_state(s), m_parent(parent), m_action(action), m_g(0), m_partition(0), m_delta(nullptr), m_compare_only_state(false)
         {
 
           m_g = (parent ? parent->m_g + cost : 0.0f);
@@ -66,6 +67,8 @@ namespace aptk
         {
           if (m_state != NULL)
             delete m_state;
+          if (m_delta != nullptr)
+            delete m_delta;
         }
 
         unsigned &gn() { return m_g; }
@@ -78,6 +81,8 @@ namespace aptk
         void set_state(State *s) { m_state = s; }
         bool has_state() const { return m_state != NULL; }
         const State &state() const { return *m_state; }
+        State_Delta *delta() const { return m_delta; }
+        void set_delta(State_Delta *d) { m_delta = d; }
         void compare_only_state(bool b) { m_compare_only_state = b; }
 
         void print(std::ostream &os) const
@@ -145,6 +150,7 @@ namespace aptk
         unsigned m_g;
         unsigned m_partition;
         size_t m_hash;
+        State_Delta *m_delta;
         bool m_compare_only_state;
       };
 
@@ -47,7 +47,8 @@ namespace aptk
 		{
 		public:
 			Novelty(const Search_Model &prob, unsigned max_arity = 1, const unsigned max_MB = 2048)
-					: Heuristic<State>(prob), m_strips_model(prob.task()), m_max_memory_size_MB(max_MB), m_verbose(true)
+					: Heuristic<State>(prob), m_strips_model(prob.task()), m_max_memory_size_MB(max_MB), m_verbose(true),
+						m_new_atom_set(prob.task().num_fluents() + 1)
 			{
 
 				set_arity(max_arity);
@@ -154,11 +155,11 @@ namespace aptk
 
 				const bool has_state = n->has_state();
 
-				static Fluent_Vec new_atom_vec;
+				Fluent_Vec &new_atom_vec = m_new_atom_vec;
 				const Action *a = m_strips_model.actions()[n->action()];
 				if (a->has_ceff())
 				{
-					static Fluent_Set new_atom_set(m_strips_model.num_fluents() + 1);
+					Fluent_Set &new_atom_set = m_new_atom_set;
 					new_atom_set.reset();
 					new_atom_vec.clear();
 					for (Fluent_Vec::const_iterator it = a->add_vec().begin(); it != a->add_vec().end(); it++)
@@ -191,7 +192,7 @@ namespace aptk
 				if (!has_state)
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()]);
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
 				bool new_covers = false;
 
@@ -313,7 +314,7 @@ namespace aptk
 				if (!has_state)
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()]);
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
 				bool new_covers = false;
 
@@ -415,7 +416,7 @@ namespace aptk
 				return idx;
 			}
 
-			inline void idx2tuple(std::vector<unsigned> &tuple, Fluent_Vec &fl, unsigned idx, unsigned arity) const
+			inline void idx2tuple(std::vector<unsigned> &tuple, const Fluent_Vec &fl, unsigned idx, unsigned arity) const
 			{
 				unsigned next_idx, div;
 				unsigned current_idx = idx;
@@ -458,6 +459,11 @@ namespace aptk
 			unsigned m_num_fluents;
 			unsigned m_max_memory_size_MB;
 			bool m_verbose;
+			// scratch buffers of cover_tuples_op(), one per instance so engines can run concurrently
+			Fluent_Vec m_new_atom_vec;
+			Fluent_Set m_new_atom_set;
+			// fluents of dense states, which keep no fluent vector
+			Fluent_Vec m_fluent_buffer;
 		};
 
 	}
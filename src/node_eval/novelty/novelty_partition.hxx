@@ -48,7 +48,8 @@ namespace aptk
 		{
 		public:
 			Novelty_Partition(const Search_Model &prob, unsigned max_arity = 1, const unsigned max_MB = 2048)
-					: Heuristic<State>(prob), m_strips_model(prob.task()), m_max_memory_size_MB(max_MB), m_always_full_state(false), m_partition_size(0), m_verbose(true)
+					: Heuristic<State>(prob), m_strips_model(prob.task()), m_max_memory_size_MB(max_MB), m_always_full_state(false), m_partition_size(0), m_verbose(true),
+						m_new_atom_set(prob.task().num_fluents() + 1)
 			{
 
 				set_arity(max_arity, 1);
@@ -188,7 +189,7 @@ namespace aptk
 				if (!has_state)
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()]);
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
 				bool new_covers = false;
 
@@ -273,11 +274,11 @@ namespace aptk
 
 				const bool has_state = n->has_state();
 
-				static Fluent_Vec new_atom_vec;
+				Fluent_Vec &new_atom_vec = m_new_atom_vec;
 				const Action *a = m_strips_model.actions()[n->action()];
 				if (a->has_ceff())
 				{
-					static Fluent_Set new_atom_set(m_strips_model.num_fluents() + 1);
+					Fluent_Set &new_atom_set = m_new_atom_set;
 					new_atom_set.reset();
 					new_atom_vec.clear();
 					for (Fluent_Vec::const_iterator it = a->add_vec().begin(); it != a->add_vec().end(); it++)
@@ -310,7 +311,7 @@ namespace aptk
 				if (!has_state)
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()]);
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
 				bool new_covers = false;
 
@@ -418,7 +419,7 @@ namespace aptk
 				return idx;
 			}
 
-			inline void idx2tuple(std::vector<unsigned> &tuple, Fluent_Vec &fl, unsigned idx, unsigned arity) const
+			inline void idx2tuple(std::vector<unsigned> &tuple, const Fluent_Vec &fl, unsigned idx, unsigned arity) const
 			{
 				unsigned next_idx, div;
 				unsigned current_idx = idx;
@@ -473,6 +474,11 @@ namespace aptk
 			bool m_always_full_state;
 			unsigned m_partition_size;
 			bool m_verbose;
+			// scratch buffers of cover_tuples_op(), one per instance so engines can run concurrently
+			Fluent_Vec m_new_atom_vec;
+			Fluent_Set m_new_atom_set;
+			// fluents of dense states, which keep no fluent vector
+			Fluent_Vec m_fluent_buffer;
 		};
 
 	}
@@ -266,7 +266,7 @@ namespace aptk
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()], &added, &deleted);
 				}
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 				Fluent_Set &fl_set = has_state ? n->state()->fluent_set() : n->parent()->state()->fluent_set();
 				bool new_covers = false;
 
@@ -339,7 +339,7 @@ namespace aptk
 				//	if(!has_state && arity == 2)
 				//	n->parent()->state()->progress_lazy_state(  m_strips_model.actions()[ n->action() ]);
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
 				std::vector<Fluent_Set *> *tables = NULL;
 				if (arity == 2)
@@ -429,6 +429,8 @@ namespace aptk
 			bool m_always_full_state;
 			unsigned m_partition_size;
 			bool m_verbose;
+			// fluents of dense states, which keep no fluent vector
+			Fluent_Vec m_fluent_buffer;
 		};
 
 	}
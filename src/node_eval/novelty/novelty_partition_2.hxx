@@ -263,7 +263,7 @@ namespace aptk
 					n->parent()->state()->progress_lazy_state(m_strips_model.actions()[n->action()], &added, &deleted);
 				}
 
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 				Fluent_Set &fl_set = has_state ? n->state()->fluent_set() : n->parent()->state()->fluent_set();
 				bool new_covers = false;
 
@@ -333,7 +333,7 @@ namespace aptk
 				const Fluent_Vec &add = a->has_ceff() ? new_atom_vec : a->add_vec();
 
 				// n->parent()->state()->progress_lazy_state(  m_strips_model.actions()[ n->action() ]);
-				Fluent_Vec &fl = has_state ? n->state()->fluent_vec() : n->parent()->state()->fluent_vec();
+				const Fluent_Vec &fl = (has_state ? n->state() : n->parent()->state())->fluent_vec(m_fluent_buffer);
 
 				std::vector<Fluent_Set *> *tables = NULL;
 				if (arity == 2)
@@ -422,6 +422,8 @@ namespace aptk
 			bool m_always_full_state;
 			bool m_verbose;
 			unsigned m_partition_size;
+			// fluents of dense states, which keep no fluent vector
+			Fluent_Vec m_fluent_buffer;
 		};
 
 	}
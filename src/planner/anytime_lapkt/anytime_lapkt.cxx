@@ -1,14 +1,15 @@
 #include <anytime_lapkt.hxx>
+#include <thread>
 
 AT_LAPKT_Planner::AT_LAPKT_Planner()
 		: STRIPS_Interface(), m_iw_bound(1),
-			m_max_novelty(2), m_log_filename("planner.log"), m_plan_filename("plan.ipc"), m_enable_siw_plus(true), m_enable_bfs_f(true)
+			m_max_novelty(2), m_log_filename("planner.log"), m_plan_filename("plan.ipc"), m_enable_siw_plus(true), m_enable_bfs_f(true), m_concurrent(false)
 {
 }
 
 AT_LAPKT_Planner::AT_LAPKT_Planner(std::string domain_file, std::string instance_file)
 		: STRIPS_Interface(domain_file, instance_file), m_iw_bound(1),
-			m_max_novelty(2), m_log_filename("planner.log"), m_plan_filename("plan.ipc"), m_enable_siw_plus(true), m_enable_bfs_f(true)
+			m_max_novelty(2), m_log_filename("planner.log"), m_plan_filename("plan.ipc"), m_enable_siw_plus(true), m_enable_bfs_f(true), m_concurrent(false)
 {
 }
 
@@ -34,6 +35,29 @@ void AT_LAPKT_Planner::setup(bool gen_match_tree)
 	m_details << "\t#Fluents: " << instance()->num_fluents() << std::endl;
 }
 
+bool AT_LAPKT_Planner::report_plan(float cost, const std::vector<aptk::Action_Idx> &plan)
+{
+	std::lock_guard<std::mutex> guard(m_report_mutex);
+	// A concurrent stage may have published a cheaper plan in the meantime
+	if (!m_incumbent.update(cost, plan))
+		return false;
+
+	m_details << "Plan found with cost: " << cost << std::endl;
+	std::cout << "Plan found with cost: " << cost << std::endl;
+	std::ofstream plan_stream(m_plan_filename.c_str());
+
+	for (unsigned k = 0; k < plan.size(); k++)
+	{
+		m_details << k + 1 << ". ";
+		const aptk::Action &a = *(instance()->actions()[plan[k]]);
+		m_details << a.signature();
+		m_details << std::endl;
+		plan_stream << a.signature() << std::endl;
+	}
+	plan_stream.close();
+	return true;
+}
+
 float AT_LAPKT_Planner::do_stage_1(SIW_Plus_Fwd &engine, float &cost)
 {
 	engine.set_bound(1);
@@ -44,31 +68,18 @@ float AT_LAPKT_Planner::do_stage_1(SIW_Plus_Fwd &engine, float &cost)
 	cost = 0.0f;
 	;
 
-	float ref = aptk::time_used();
-	float t0 = aptk::time_used();
+	float ref = now();
+	float t0 = now();
 
 	unsigned expanded_0 = engine.expanded();
 	unsigned generated_0 = engine.generated();
 
-	std::ofstream plan_stream(m_plan_filename.c_str());
-
 	if (engine.find_solution(cost, plan))
 	{
-		m_details << "Plan found with cost: " << cost << std::endl;
-		std::cout << "Plan found with cost: " << cost << std::endl;
-		std::ofstream plan_stream(m_plan_filename.c_str());
-
-		for (unsigned k = 0; k < plan.size(); k++)
-		{
-			m_details << k + 1 << ". ";
-			const aptk::Action &a = *(instance()->actions()[plan[k]]);
-			m_details << a.signature();
-			m_details << std::endl;
-			plan_stream << a.signature() << std::endl;
-		}
-		plan_stream.close();
+		report_plan(cost, plan);
 
-		float tf = aptk::time_used();
+		std::lock_guard<std::mutex> guard(m_report_mutex);
+		float tf = now();
 		unsigned expanded_f = engine.expanded();
 		unsigned generated_f = engine.generated();
 		m_details << "Time: " << tf - t0 << std::endl;
@@ -81,7 +92,9 @@ float AT_LAPKT_Planner::do_stage_1(SIW_Plus_Fwd &engine, float &cost)
 	}
 	else
 		cost = infty;
-	float total_time = aptk::time_used() - ref;
+	float total_time = now() - ref;
+
+	std::lock_guard<std::mutex> guard(m_report_mutex);
 	m_details << "Total time: " << total_time << std::endl;
 	m_details << "Nodes generated during search: " << engine.generated() << std::endl;
 	m_details << "Nodes expanded during search: " << engine.expanded() << std::endl;
@@ -95,21 +108,23 @@ float AT_LAPKT_Planner::do_stage_1(SIW_Plus_Fwd &engine, float &cost)
 	std::cout << "Nodes pruned by bound: " << engine.sum_pruned_by_bound() << std::endl;
 	std::cout << "Average ef. width: " << engine.avg_B() << std::endl;
 	std::cout << "Max ef. width: " << engine.max_B() << std::endl;
-	plan_stream.close();
 	return total_time;
 }
 
 float AT_LAPKT_Planner::do_stage_3(Anytime_RWA &engine, float B, float &cost)
 {
 	engine.start(B);
-	m_details << "Branch & Bound search: Initial Bound = " << B << std::endl;
+	{
+		std::lock_guard<std::mutex> guard(m_report_mutex);
+		m_details << "Branch & Bound search: Initial Bound = " << B << std::endl;
+	}
 	engine.set_schedule(1000, 1, 10);
 
 	std::vector<aptk::Action_Idx> plan;
 	cost = infty;
 
-	float ref = aptk::time_used();
-	float t0 = aptk::time_used();
+	float ref = now();
+	float t0 = now();
 
 	unsigned expanded_0 = engine.expanded();
 	unsigned generated_0 = engine.generated();
@@ -117,24 +132,11 @@ float AT_LAPKT_Planner::do_stage_3(Anytime_RWA &engine, float B, float &cost)
 	while (engine.find_solution(cost, plan))
 	{
 		if (!plan.empty())
-		{
-			m_details << "Plan found with cost: " << cost << std::endl;
-			std::cout << "Plan found with cost: " << cost << std::endl;
-			std::ofstream plan_stream(m_plan_filename.c_str());
-
-			for (unsigned k = 0; k < plan.size(); k++)
-			{
-				m_details << k + 1 << ". ";
-				const aptk::Action &a = *(instance()->actions()[plan[k]]);
-				m_details << a.signature();
-				m_details << std::endl;
-				plan_stream << a.signature() << std::endl;
-			}
-			plan_stream.close();
-		}
-		else
+			report_plan(cost, plan);
+		std::lock_guard<std::mutex> guard(m_report_mutex);
+		if (plan.empty())
 			m_details << "No plan found" << std::endl;
-		float tf = aptk::time_used();
+		float tf = now();
 		unsigned expanded_f = engine.expanded();
 		unsigned generated_f = engine.generated();
 		m_details << "Time: " << tf - t0 << std::endl;
@@ -145,7 +147,9 @@ float AT_LAPKT_Planner::do_stage_3(Anytime_RWA &engine, float B, float &cost)
 		generated_0 = generated_f;
 		plan.clear();
 	}
-	float total_time = aptk::time_used() - ref;
+	float total_time = now() - ref;
+
+	std::lock_guard<std::mutex> guard(m_report_mutex);
 	m_details << "Total time: " << total_time << std::endl;
 	m_details << "Nodes generated during search: " << engine.generated() << std::endl;
 	m_details << "Nodes expanded during search: " << engine.expanded() << std::endl;
@@ -170,27 +174,18 @@ float AT_LAPKT_Planner::do_stage_2(Anytime_GBFS_H_Add_Rp_Fwd &engine, float B, f
 	std::vector<aptk::Action_Idx> plan;
 	cost = 0.0f;
 
-	float ref = aptk::time_used();
-	float t0 = aptk::time_used();
+	float ref = now();
+	float t0 = now();
 
 	unsigned expanded_0 = engine.expanded();
 	unsigned generated_0 = engine.generated();
 
 	if (engine.find_solution(cost, plan))
 	{
-		m_details << "Plan found with cost: " << cost << std::endl;
-		std::cout << "Plan found with cost: " << cost << std::endl;
-		std::ofstream plan_stream(m_plan_filename.c_str());
-		for (unsigned k = 0; k < plan.size(); k++)
-		{
-			m_details << k + 1 << ". ";
-			const aptk::Action &a = *(instance()->actions()[plan[k]]);
-			m_details << a.signature();
-			m_details << std::endl;
-			plan_stream << a.signature() << std::endl;
-		}
-		plan_stream.close();
-		float tf = aptk::time_used();
+		report_plan(cost, plan);
+
+		std::lock_guard<std::mutex> guard(m_report_mutex);
+		float tf = now();
 		unsigned expanded_f = engine.expanded();
 		unsigned generated_f = engine.generated();
 		m_details << "Time: " << tf - t0 << std::endl;
@@ -205,7 +200,9 @@ float AT_LAPKT_Planner::do_stage_2(Anytime_GBFS_H_Add_Rp_Fwd &engine, float B, f
 	{
 		cost = infty;
 	}
-	float total_time = aptk::time_used() - ref;
+	float total_time = now() - ref;
+
+	std::lock_guard<std::mutex> guard(m_report_mutex);
 	m_details << "Total time: " << total_time << std::endl;
 	m_details << "Nodes generated during search: " << engine.generated() << std::endl;
 	m_details << "Nodes expanded during search: " << engine.expanded() << std::endl;
@@ -218,6 +215,11 @@ float AT_LAPKT_Planner::do_stage_2(Anytime_GBFS_H_Add_Rp_Fwd &engine, float B, f
 	return total_time;
 }
 
+double AT_LAPKT_Planner::now() const
+{
+	return m_concurrent ? aptk::wall_time() : aptk::time_used();
+}
+
 void AT_LAPKT_Planner::report_no_solution(std::string reason)
 {
 	std::ofstream plan_stream(m_plan_filename.c_str());
@@ -228,6 +230,11 @@ void AT_LAPKT_Planner::report_no_solution(std::string reason)
 
 void AT_LAPKT_Planner::solve()
 {
+	if (m_concurrent)
+	{
+		solve_concurrent();
+		return;
+	}
 
 	Fwd_Search_Problem search_prob(instance());
 
@@ -310,3 +317,86 @@ void AT_LAPKT_Planner::solve()
 		std::cout << "\nRWA search completed in " << at_search_t << " secs, found plan cost = " << rwa_cost << std::endl;
 	}
 }
+
+void AT_LAPKT_Planner::solve_concurrent()
+{
+	Fwd_Search_Problem search_prob(instance());
+
+	// Engines consume the landmarks of the graph they are given, so each stage gets its own
+	Gen_Lms_Fwd gen_lms(search_prob);
+	Landmarks_Graph goal_graph(*instance());
+	Landmarks_Graph bfs_f_graph(*instance());
+	Landmarks_Graph rwa_graph(*instance());
+
+	gen_lms.set_only_goals(true);
+	gen_lms.compute_lm_graph_set_additive(goal_graph);
+	gen_lms.set_only_goals(false);
+	gen_lms.compute_lm_graph_set_additive(bfs_f_graph);
+	gen_lms.compute_lm_graph_set_additive(rwa_graph);
+
+	m_details << "Landmarks found: " << goal_graph.num_landmarks() << std::endl;
+	m_details << "Landmarks and edges found: " << bfs_f_graph.num_landmarks_and_edges() << std::endl;
+
+	Land_Graph_Man bfs_f_lgm(search_prob, &bfs_f_graph);
+	Land_Graph_Man rwa_lgm(search_prob, &rwa_graph);
+
+	// MRJ: All stages run at once, bounded by the cheapest plan any of them has found so far
+	m_details << "Stages #1 - #3: SIW+, BFS(f) and RWA* running concurrently" << std::endl;
+
+	SIW_Plus_Fwd siw_plus_engine(search_prob);
+	siw_plus_engine.set_goal_agenda(&goal_graph);
+	siw_plus_engine.set_cancel_flag(m_incumbent.closed_flag());
+
+	Anytime_GBFS_H_Add_Rp_Fwd bfs_engine(search_prob);
+	bfs_engine.use_land_graph_manager(&bfs_f_lgm);
+	bfs_engine.set_arity(m_max_novelty, bfs_f_graph.num_landmarks_and_edges());
+	bfs_engine.set_incumbent(&m_incumbent);
+	bfs_engine.set_wall_clock(true);
+
+	Anytime_RWA wbfs_engine(search_prob, 10.0f, 0.95f);
+	wbfs_engine.use_land_graph_manager(&rwa_lgm);
+	wbfs_engine.set_incumbent(&m_incumbent);
+	wbfs_engine.set_wall_clock(true);
+
+	auto run_siw_plus = [&]()
+	{
+		float siw_cost = infty;
+		float iw_t = do_stage_1(siw_plus_engine, siw_cost);
+		std::lock_guard<std::mutex> guard(m_report_mutex);
+		m_details << "SIW+ search completed in " << iw_t << " secs, found plan cost = " << siw_cost << std::endl;
+		std::cout << "\nSIW+ search completed in " << iw_t << " secs, found plan cost = " << siw_cost << std::endl;
+	};
+
+	auto run_bfs_f = [&]()
+	{
+		float bfs_f_cost = infty;
+		float bfs_t = do_stage_2(bfs_engine, infty, bfs_f_cost);
+		// BFS(f) is complete: exhausting the space before anybody found a plan means there is none
+		if (bfs_f_cost == infty && m_incumbent.cost() == infty && !bfs_engine.interrupted())
+			m_incumbent.close();
+		std::lock_guard<std::mutex> guard(m_report_mutex);
+		m_details << "BFS(f) search completed in " << bfs_t << " secs, found plan cost = " << bfs_f_cost << std::endl;
+		std::cout << "\nBFS(f) search completed in " << bfs_t << " secs, found plan cost = " << bfs_f_cost << std::endl;
+	};
+
+	// The stages block until the search ends, so each gets its own thread rather than a pool worker
+	std::vector<std::thread> stages;
+	if (m_enable_siw_plus)
+		stages.emplace_back(run_siw_plus);
+	if (m_enable_bfs_f)
+		stages.emplace_back(run_bfs_f);
+
+	// RWA* runs on this thread and, once it proves the incumbent optimal or runs out of time, stops the others
+	float rwa_cost = infty;
+	float at_search_t = do_stage_3(wbfs_engine, infty, rwa_cost);
+	m_incumbent.close();
+	for (auto &stage : stages)
+		stage.join();
+
+	m_details << "RWA search completed in " << at_search_t << " secs, found plan cost = " << rwa_cost << std::endl;
+	std::cout << "\nRWA search completed in " << at_search_t << " secs, found plan cost = " << rwa_cost << std::endl;
+	m_details << "Best plan cost: " << m_incumbent.cost() << std::endl;
+	std::cout << "Best plan cost: " << m_incumbent.cost() << std::endl;
+	if (m_incumbent.cost() == infty)
+		report_no_solution("No stage found a plan");
+}
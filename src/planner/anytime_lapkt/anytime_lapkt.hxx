@@ -21,8 +21,10 @@
 #include <rp_iw.hxx>
 #include <serialized_search.hxx>
 #include <siw_plus.hxx>
+#include <shared_incumbent.hxx>
 
 #include <fstream>
+#include <mutex>
 
 using aptk::Action;
 using aptk::agnostic::Fwd_Search_Problem;
@@ -42,6 +44,7 @@ using aptk::agnostic::Unsat_Goals_Heuristic;
 using aptk::agnostic::Novelty;
 using aptk::agnostic::Novelty_Partition;
 using aptk::search::Serialized_Search;
+using aptk::search::Shared_Incumbent;
 using aptk::search::novelty_spaces::RP_IW;
 using aptk::search::novelty_spaces::SIW_Plus;
 
@@ -104,14 +107,22 @@ public:
     std::string m_plan_filename;
     bool m_enable_siw_plus;
     bool m_enable_bfs_f;
+    // Run all stages at once, sharing the cost of the best plan found as a bound
+    bool m_concurrent;
 
 protected:
+    void solve_concurrent();
+    bool report_plan(float cost, const std::vector<aptk::Action_Idx> &plan);
     float do_stage_1(SIW_Plus_Fwd &engine, float &cost);
     float do_stage_2(Anytime_GBFS_H_Add_Rp_Fwd &engine, float B, float &cost);
     float do_stage_3(Anytime_RWA &engine, float B, float &cost);
     void report_no_solution(std::string reason);
+    // Stage timings, in wall time when the stages run concurrently
+    double now() const;
 
     std::ofstream m_details;
+    Shared_Incumbent m_incumbent;
+    std::mutex m_report_mutex;
 };
 
 #endif
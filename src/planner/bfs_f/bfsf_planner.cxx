@@ -2,12 +2,14 @@
 #include <fstream>
 
 BFS_f_Planner::BFS_f_Planner()
-		: STRIPS_Interface(), m_max_novelty(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_one_ha_per_fluent(false)
+		: STRIPS_Interface(), m_max_novelty(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_one_ha_per_fluent(false),
+			m_h1_radix_heap(false), m_h1_incremental(0), m_landmarks_time(0)
 {
 }
 
 BFS_f_Planner::BFS_f_Planner(std::string domain_file, std::string instance_file)
-		: STRIPS_Interface(domain_file, instance_file), m_max_novelty(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_one_ha_per_fluent(false)
+		: STRIPS_Interface(domain_file, instance_file), m_max_novelty(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_one_ha_per_fluent(false),
+			m_h1_radix_heap(false), m_h1_incremental(0), m_landmarks_time(0)
 {
 }
 
@@ -86,6 +88,8 @@ void BFS_f_Planner::solve()
 	// 	instance()->compute_edeletes();
 
 	Gen_Lms_Fwd gen_lms(search_prob);
+	gen_lms.set_radix_heap(m_h1_radix_heap);
+	gen_lms.set_time_budget(m_landmarks_time);
 	Landmarks_Graph graph(*instance());
 
 	gen_lms.compute_lm_graph_set_additive(graph);
@@ -99,6 +103,8 @@ void BFS_f_Planner::solve()
 
 	// MRJ: Setting "one h.a. per fluent" flag
 	bfs_engine.h3().set_one_HA_per_fluent(m_one_ha_per_fluent);
+	bfs_engine.h3().set_radix_heap(m_h1_radix_heap);
+	bfs_engine.h3().set_incremental(m_h1_incremental);
 
 	Land_Graph_Man lgm(search_prob, &graph);
 	bfs_engine.use_land_graph_manager(&lgm);
@@ -70,6 +70,9 @@ public:
     std::string m_log_filename;
     std::string m_plan_filename;
     bool m_one_ha_per_fluent;
+    bool m_h1_radix_heap;
+    unsigned m_h1_incremental;
+    double m_landmarks_time;
 
 protected:
     float do_search(Anytime_GBFS_H_Add_Rp_Fwd &engine);
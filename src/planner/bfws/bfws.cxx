@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <type_traits>
 
 using aptk::agnostic::Fwd_Search_Problem;
 
@@ -21,6 +22,8 @@ BFWS::BFWS(std::string domain_file, std::string instance_file)
 
 BFWS::~BFWS()
 {
+	if (m_relplan_cache != nullptr)
+		delete m_relplan_cache;
 }
 
 void BFWS::setup(bool gen_match_tree)
@@ -34,16 +37,17 @@ void BFWS::setup(bool gen_match_tree)
 	std::cout << "\t#Fluents: " << instance()->num_fluents() << std::endl;
 }
 
-template <typename Search_Engine>
-void BFWS::bfws_options(Fwd_Search_Problem &search_prob, Search_Engine &bfs_engine, unsigned max_novelty, Landmarks_Graph &graph)
+template <typename Search_Model, typename Search_Engine>
+void BFWS::bfws_options(const Search_Model &search_prob, Search_Engine &bfs_engine, unsigned max_novelty, Landmarks_Graph &graph)
 {
 
 	bfs_engine.set_max_novelty(max_novelty);
 	bfs_engine.set_use_novelty(true);
 	bfs_engine.rel_fl_h().ignore_rp_h_value(true);
+	bfs_engine.rel_fl_h().set_radix_heap(m_h1_radix_heap);
 
 	// NIR: engine doesn't own the pointer, need to free at the end
-	Land_Graph_Man *lgm = new Land_Graph_Man(search_prob, &graph);
+	Landmarks_Graph_Manager<Search_Model> *lgm = new Landmarks_Graph_Manager<Search_Model>(search_prob, &graph);
 	bfs_engine.use_land_graph_manager(lgm);
 
 	// NIR: Approximate the domain of #r counter, so we can initialize the novelty table, making sure we've got
@@ -54,6 +58,38 @@ void BFWS::bfws_options(Fwd_Search_Problem &search_prob, Search_Engine &bfs_engi
 	hadd.eval(*s_0, h_init);
 
 	bfs_engine.set_arity(max_novelty, graph.num_landmarks() * h_init);
+
+	// The M and consistency variants generate states their own way
+	if constexpr (std::is_same<Search_Engine, k_BFWS<Search_Model>>::value)
+		if (m_delta_snapshot > 0)
+			bfs_engine.set_delta_states(m_delta_snapshot);
+
+	if constexpr (std::is_base_of<k_BFWS<Search_Model>, Search_Engine>::value)
+		if (m_relplan_cache != nullptr)
+			bfs_engine.set_relplan_cache(m_relplan_cache);
+}
+
+float BFWS::search_k_bfws(unsigned max_novelty, Landmarks_Graph &graph, std::ofstream &plan_stream, bool novelty_pruning, bool use_rp, bool rp_from_init_only)
+{
+	float bfs_t = 0;
+	aptk::agnostic::dispatch_search_problem(instance(), [&](const auto &search_prob)
+																					{
+		k_BFWS<typename std::decay<decltype(search_prob)>::type> bfs_engine(search_prob, m_verbose);
+
+		bfws_options(search_prob, bfs_engine, max_novelty, graph);
+
+		bfs_engine.set_use_novelty_pruning(novelty_pruning);
+		bfs_engine.set_use_rp(use_rp);
+		bfs_engine.set_use_rp_from_init_only(rp_from_init_only);
+
+		bfs_t = do_search(bfs_engine, *instance(), plan_stream); });
+	return bfs_t;
+}
+
+void BFWS::landmark_options(Gen_Lms_Fwd &gen_lms)
+{
+	gen_lms.set_radix_heap(m_h1_radix_heap);
+	gen_lms.set_time_budget(m_landmarks_time);
 }
 
 template <typename Search_Engine>
@@ -74,6 +110,9 @@ float BFWS::do_search(Search_Engine &engine, aptk::STRIPS_Problem &plan_prob, st
 
 	m_found_plan = engine.find_solution(m_cost, plan);
 
+	if (m_relplan_cache != nullptr)
+		std::cout << "Relaxed plan cache: " << m_relplan_cache->hits() << " hits, " << m_relplan_cache->misses() << " misses" << std::endl;
+
 	if (m_found_plan)
 	{
 		details << "Plan found with cost: " << m_cost << std::endl;
@@ -227,6 +266,7 @@ void BFWS::solve()
 	prob->compute_edeletes();
 
 	Gen_Lms_Fwd gen_lms(search_prob);
+	landmark_options(gen_lms);
 	Landmarks_Graph graph(*prob);
 
 	/**
@@ -248,24 +288,25 @@ void BFWS::solve()
 	m_found_plan = false;
 	m_cost = infty;
 
+	if (m_relplan_cache != nullptr)
+		delete m_relplan_cache;
+	m_relplan_cache = m_relplan_cache_size > 0 ? new aptk::search::Relaxed_Plan_Cache(m_relplan_cache_size) : nullptr;
+
 	if (m_search_alg.compare("BFWS-f5-landmarks") == 0)
 	{
 
 		std::cout << "Starting search with BFWS-f5-landmarks..." << std::endl;
 
-		k_BFWS bfs_engine(search_prob, m_verbose);
-
 		/**
 		 * Use landmark count instead of goal count
 		 */
 		Gen_Lms_Fwd gen_lms(search_prob);
+		landmark_options(gen_lms);
 		gen_lms.set_only_goals(false);
 		Landmarks_Graph graph1(*prob);
 		gen_lms.compute_lm_graph_set_additive(graph1);
 
-		bfws_options(search_prob, bfs_engine, m_max_novelty, graph1);
-
-		float bfs_t = do_search(bfs_engine, *prob, plan_stream);
+		float bfs_t = search_k_bfws(m_max_novelty, graph1, plan_stream, false);
 
 		std::cout << "Fast-BFS search completed in " << bfs_t << " secs" << std::endl;
 
@@ -278,14 +319,8 @@ void BFWS::solve()
 
 		std::cout << "Starting search with BFWS(w_(#G), #G)..." << std::endl;
 
-		k_BFWS bfs_engine(search_prob, m_verbose);
-
-		bfws_options(search_prob, bfs_engine, m_max_novelty, graph);
-
 		// Do not use #rp
-		bfs_engine.set_use_rp(false);
-
-		float bfs_t = do_search(bfs_engine, *prob, plan_stream);
+		float bfs_t = search_k_bfws(m_max_novelty, graph, plan_stream, false, false);
 
 		std::cout << "Fast-BFS search completed in " << bfs_t << " secs" << std::endl;
 	}
@@ -294,11 +329,7 @@ void BFWS::solve()
 
 		std::cout << "Starting search with BFWS-f5..." << std::endl;
 
-		k_BFWS bfs_engine(search_prob, m_verbose);
-
-		bfws_options(search_prob, bfs_engine, m_max_novelty, graph);
-
-		float bfs_t = do_search(bfs_engine, *prob, plan_stream);
+		float bfs_t = search_k_bfws(m_max_novelty, graph, plan_stream, false);
 
 		std::cout << "Fast-BFS search completed in " << bfs_t << " secs" << std::endl;
 	}
@@ -307,13 +338,7 @@ void BFWS::solve()
 
 		std::cout << "Starting search with BFWS-f5... R computed once from s0" << std::endl;
 
-		k_BFWS bfs_engine(search_prob, m_verbose);
-
-		bfws_options(search_prob, bfs_engine, m_max_novelty, graph);
-
-		bfs_engine.set_use_rp_from_init_only(true);
-
-		float bfs_t = do_search(bfs_engine, *prob, plan_stream);
+		float bfs_t = search_k_bfws(m_max_novelty, graph, plan_stream, false, true, true);
 
 		std::cout << "Fast-BFS search completed in " << bfs_t << " secs" << std::endl;
 	}
@@ -322,13 +347,7 @@ void BFWS::solve()
 
 		std::cout << "Starting search with k-BFWS..." << std::endl;
 
-		k_BFWS bfs_engine(search_prob, m_verbose);
-
-		bfws_options(search_prob, bfs_engine, m_max_novelty, graph);
-
-		bfs_engine.set_use_novelty_pruning(true);
-
-		float bfs_t = do_search(bfs_engine, *prob, plan_stream);
+		float bfs_t = search_k_bfws(m_max_novelty, graph, plan_stream, true);
 
 		std::cout << "Fast-BFS search completed in " << bfs_t << " secs" << std::endl;
 
@@ -422,13 +441,7 @@ void BFWS::solve()
 	{
 		std::cout << "Starting search with 1-BFWS..." << std::endl;
 
-		k_BFWS bfs_engine(search_prob, m_verbose);
-
-		bfws_options(search_prob, bfs_engine, 1, graph);
-
-		bfs_engine.set_use_novelty_pruning(true);
-
-		float bfs_t = do_search(bfs_engine, *prob, plan_stream);
+		float bfs_t = search_k_bfws(1, graph, plan_stream, true);
 
 		std::cout << "Fast-BFS search completed in " << bfs_t << " secs" << std::endl;
 
@@ -438,18 +451,10 @@ void BFWS::solve()
 	{
 		std::cout << "Starting search with 1-BFWS..." << std::endl;
 
-		k_BFWS *bfs_engine = new k_BFWS(search_prob, m_verbose);
-
-		bfws_options(search_prob, *bfs_engine, 1, graph);
-
-		bfs_engine->set_use_novelty_pruning(true);
-
-		float bfs_t = do_search(*bfs_engine, *prob, plan_stream);
+		float bfs_t = search_k_bfws(1, graph, plan_stream, true);
 
 		std::cout << "Fast-BFS search completed in " << bfs_t << " secs" << std::endl;
 
-		delete bfs_engine;
-
 		if (!m_found_plan)
 		{
 
@@ -460,6 +465,7 @@ void BFWS::solve()
 				 * Use a new goal count
 				 */
 				Gen_Lms_Fwd gen_lms(search_prob);
+				landmark_options(gen_lms);
 				gen_lms.set_only_goals(true);
 				Landmarks_Graph graph1(*prob);
 				gen_lms.compute_lm_graph_set_additive(graph1);
@@ -508,13 +514,7 @@ void BFWS::solve()
 	{
 		std::cout << "Starting search with 1-BFWS..." << m_verbose << std::endl;
 
-		k_BFWS bfs_engine(search_prob, m_verbose);
-
-		bfws_options(search_prob, bfs_engine, 1, graph);
-
-		bfs_engine.set_use_novelty_pruning(true);
-
-		float bfs_t = do_search(bfs_engine, *prob, plan_stream);
+		float bfs_t = search_k_bfws(1, graph, plan_stream, true);
 
 		std::cout << "Fast-BFS search completed in " << bfs_t << " secs" << std::endl;
 	}
@@ -530,6 +530,7 @@ void BFWS::solve()
 		 * Use landmark count instead of goal count
 		 */
 		Gen_Lms_Fwd gen_lms(search_prob);
+		landmark_options(gen_lms);
 		gen_lms.set_only_goals(false);
 		Landmarks_Graph graph1(*prob);
 		gen_lms.compute_lm_graph_set_additive(graph1);
@@ -560,6 +561,7 @@ void BFWS::solve()
 		 * Use landmark count instead of goal count
 		 */
 		Gen_Lms_Fwd gen_lms(search_prob);
+		landmark_options(gen_lms);
 		gen_lms.set_only_goals(false);
 		Landmarks_Graph graph1(*prob);
 		gen_lms.compute_lm_graph_set_additive(graph1);
@@ -138,7 +138,15 @@ typedef FF_Relaxed_Plan_Heuristic<Fwd_Search_Problem, Alt_H_Max, unsigned> Class
 
 // NIR: Now we're ready to define the BFS algorithm we're going to use, H_Lmcount can be used only with goals,
 // or with landmarks computed from s0
-typedef BFWS_2H<Fwd_Search_Problem, H_Novel_Fwd_2h, H_Lmcount_Fwd, H_Add_Rp_Fwd, BFS_Open_List_2h> k_BFWS;
+// k-BFWS is instantiated over the search model specialized to the effects and
+// costs of the task, see dispatch_search_problem(), with its node type,
+// heuristics and open list following it
+template <typename Search_Model>
+using k_BFWS_Node = aptk::search::bfws_2h::Node<Search_Model, aptk::State>;
+template <typename Search_Model>
+using k_BFWS = BFWS_2H<Search_Model, Novelty_Partition<Search_Model, k_BFWS_Node<Search_Model>>, Landmarks_Count_Heuristic<Search_Model>,
+											 Relaxed_Plan_Heuristic<Search_Model, H1_Heuristic<Search_Model, H_Add_Evaluation_Function, H1_Cost_Function::Ignore_Costs>, RP_Cost_Function::Ignore_Costs>,
+											 Open_List<Node_Comparer_2H_gn_unit<k_BFWS_Node<Search_Model>>, k_BFWS_Node<Search_Model>>>;
 typedef BFWS_2H_M<Fwd_Search_Problem, H_Novel_Fwd_2h, H_Lmcount_Fwd, H_Add_Rp_Fwd, BFS_Open_List_2h> k_BFWS_M;
 typedef BFWS_4H<Fwd_Search_Problem, H_Novel_Fwd_4h, H_Lmcount_Fwd, H_Novel_2_Fwd_4h, H_Add_Rp_Fwd, BFS_Open_List_4h> BFWS_w_hlm_hadd;
 
@@ -169,10 +177,23 @@ public:
 	float m_cost;
 	float m_cost_bound;
 	bool m_verbose = false;
+	unsigned m_delta_snapshot = 0;
+	unsigned m_relplan_cache_size = 0;
+	bool m_h1_radix_heap = false;
+	double m_landmarks_time = 0;
 
 protected:
-	template <typename Search_Engine>
-	void bfws_options(Fwd_Search_Problem &search_prob, Search_Engine &bfs_engine, unsigned max_novelty, Landmarks_Graph &graph);
+	// Relaxed plans shared by the searches of one solve(), see
+	// BFWS_2H::set_relplan_cache()
+	aptk::search::Relaxed_Plan_Cache *m_relplan_cache = nullptr;
+
+	void landmark_options(Gen_Lms_Fwd &gen_lms);
+
+	template <typename Search_Model, typename Search_Engine>
+	void bfws_options(const Search_Model &search_prob, Search_Engine &bfs_engine, unsigned max_novelty, Landmarks_Graph &graph);
+
+	// Runs k_BFWS over the search model that matches the task
+	float search_k_bfws(unsigned max_novelty, Landmarks_Graph &graph, std::ofstream &plan_stream, bool novelty_pruning, bool use_rp = true, bool rp_from_init_only = false);
 
 	template <typename Search_Engine>
 	float do_search(Search_Engine &engine, aptk::STRIPS_Problem &plan_prob, std::ofstream &plan_stream);
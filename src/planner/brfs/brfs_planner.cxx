@@ -2,12 +2,12 @@
 #include <fstream>
 
 BRFS_Planner::BRFS_Planner()
-		: STRIPS_Interface(), m_log_filename("iw.log"), m_plan_filename("plan.ipc")
+		: STRIPS_Interface(), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_num_threads(1)
 {
 }
 
 BRFS_Planner::BRFS_Planner(std::string domain_file, std::string instance_file)
-		: STRIPS_Interface(domain_file, instance_file), m_log_filename("iw.log"), m_plan_filename("plan.ipc")
+		: STRIPS_Interface(domain_file, instance_file), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_num_threads(1)
 {
 }
 
@@ -26,7 +26,8 @@ void BRFS_Planner::setup(bool gen_match_tree)
 	std::cout << "\t#Fluents: " << instance()->num_fluents() << std::endl;
 }
 
-float BRFS_Planner::do_search(BRFS_Fwd &engine)
+template <typename Search_Engine>
+float BRFS_Planner::do_search(Search_Engine &engine)
 {
 
 	engine.start();
@@ -72,16 +73,27 @@ float BRFS_Planner::do_search(BRFS_Fwd &engine)
 	return total_time;
 }
 
-void BRFS_Planner::solve()
+template <typename Search_Model>
+float BRFS_Planner::search(const Search_Model &search_prob)
 {
+	if (m_num_threads != 1)
+	{
+		Parallel_BRFS_Fwd<Search_Model> brfs_engine(search_prob, m_num_threads);
+		std::cout << "Using " << brfs_engine.num_threads() << " threads" << std::endl;
+		return do_search(brfs_engine);
+	}
+	BRFS_Fwd<Search_Model> brfs_engine(search_prob);
+	return do_search(brfs_engine);
+}
 
-	Fwd_Search_Problem search_prob(instance());
+void BRFS_Planner::solve()
+{
 
 	std::cout << "Starting search with BRFS (time budget is 60 secs)..." << std::endl;
 
-	BRFS_Fwd brfs_engine(search_prob);
-
-	float brfs_t = do_search(brfs_engine);
+	float brfs_t = 0;
+	aptk::agnostic::dispatch_search_problem(instance(), [&](const auto &search_prob)
+																					{ brfs_t = search(search_prob); });
 
 	std::cout << "BRFS search completed in " << brfs_t << " secs, check '" << m_log_filename << "' for details" << std::endl;
 }
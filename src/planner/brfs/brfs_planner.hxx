@@ -4,17 +4,23 @@
 #include <py_strips_interface.hxx>
 #include <fwd_search_prob.hxx>
 #include <brfs.hxx>
+#include <par_brfs.hxx>
 
 using aptk::Action;
 using aptk::agnostic::Fwd_Search_Problem;
 
 using aptk::search::brfs::BRFS;
+using aptk::search::brfs::Parallel_BRFS;
 
 class BRFS_Planner : public STRIPS_Interface
 {
 public:
-	// NIR: Now we're ready to define the BRFS algorithm
-	typedef BRFS<Fwd_Search_Problem> BRFS_Fwd;
+	// NIR: Now we're ready to define the BRFS algorithm, over a search model
+	// specialized to the effects and costs of the task
+	template <typename Search_Model>
+	using BRFS_Fwd = BRFS<Search_Model>;
+	template <typename Search_Model>
+	using Parallel_BRFS_Fwd = Parallel_BRFS<Search_Model>;
 
 	BRFS_Planner();
 	BRFS_Planner(std::string, std::string);
@@ -25,9 +31,15 @@ public:
 
 	std::string m_log_filename;
 	std::string m_plan_filename;
+	// More than one thread switches to the layer-synchronous engine, 0 uses all cores
+	unsigned m_num_threads;
 
 protected:
-	float do_search(BRFS_Fwd &engine);
+	template <typename Search_Model>
+	float search(const Search_Model &search_prob);
+
+	template <typename Search_Engine>
+	float do_search(Search_Engine &engine);
 };
 
 #endif
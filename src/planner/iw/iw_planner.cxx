@@ -294,14 +294,26 @@ void IW_Planner::solve()
 
     std::cout << "Starting search with IW ..." << std::endl;
 
-    IW_Fwd iw_engine(search_prob);
-
     // float iw_t = do_search( iw_engine, search_prob.task(), plan_stream );
     float iw_t;
-    if (m_atomic)
-        iw_t = do_search_single_goal(iw_engine, search_prob.task(), plan_stream);
+    if (m_num_threads != 1)
+    {
+        // Parallel_IW supports widths 1 and 2 only
+        Parallel_IW_Fwd iw_engine(search_prob, m_num_threads);
+        std::cout << "Using " << iw_engine.num_threads() << " threads" << std::endl;
+        if (m_atomic)
+            iw_t = do_search_single_goal(iw_engine, search_prob.task(), plan_stream);
+        else
+            iw_t = do_inc_bound_search(iw_engine, search_prob.task(), plan_stream);
+    }
     else
-        iw_t = do_inc_bound_search(iw_engine, search_prob.task(), plan_stream);
+    {
+        IW_Fwd iw_engine(search_prob);
+        if (m_atomic)
+            iw_t = do_search_single_goal(iw_engine, search_prob.task(), plan_stream);
+        else
+            iw_t = do_inc_bound_search(iw_engine, search_prob.task(), plan_stream);
+    }
 
     std::cout << "IW search completed in " << iw_t << " secs, check '" << m_log_filename << "' for details" << std::endl;
 
@@ -19,6 +19,7 @@
 #include <h_2.hxx>
 #include <h_1.hxx>
 #include <iw.hxx>
+#include <par_iw.hxx>
 
 using aptk::agnostic::Fwd_Search_Problem;
 
@@ -28,6 +29,7 @@ using aptk::agnostic::H_Max_Evaluation_Function;
 
 using aptk::agnostic::Novelty;
 using aptk::search::brfs::IW;
+using aptk::search::brfs::Parallel_IW;
 
 //---- IW_Planner Class -----------------------------------------------------//
 class IW_Planner : public STRIPS_Interface
@@ -40,6 +42,7 @@ public:
                              H_Max_Evaluation_Function>
             H1_Fwd;
         typedef IW<Fwd_Search_Problem, H_Novel_Fwd> IW_Fwd;
+        typedef Parallel_IW<Fwd_Search_Problem> Parallel_IW_Fwd;
 
         IW_Planner();
         IW_Planner(std::string, std::string);
@@ -54,6 +57,8 @@ public:
         std::string m_log_filename;
         std::string m_plan_filename;
         bool m_atomic = false;
+        // More than one thread switches to the layer-synchronous engine, 0 uses all cores
+        unsigned m_num_threads = 1;
 
 protected:
         template <typename Search_Engine>
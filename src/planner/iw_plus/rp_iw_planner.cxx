@@ -187,6 +187,8 @@ void RPIW_Planner::solve()
 	std::cout << "Starting search with RPIW ..." << std::endl;
 
 	RP_IW_Fwd engine(search_prob);
+	if (m_delta_snapshot > 0)
+		engine.set_delta_states(m_delta_snapshot);
 	float iw_t;
 
 	if (m_atomic)
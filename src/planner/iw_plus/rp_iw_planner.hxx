@@ -40,6 +40,7 @@ public:
 	std::string m_plan_filename;
 
 	bool m_atomic = false;
+	unsigned m_delta_snapshot = 0;
 
 protected:
 	float do_search_single_goal(RP_IW_Fwd &engine, aptk::STRIPS_Problem &plan_prob, std::ofstream &plan_stream);
@@ -0,0 +1,123 @@
+#include <lifted_planner.hxx>
+#include <memory.hxx>
+#include <resources_control.hxx>
+
+//---- Constructor ----------------------------------------------------------//
+Lifted_Planner::Lifted_Planner()
+	: Lifted_Interface(), m_search_alg("BFWS"), m_iw_bound(LIFTED_BOUND),
+	  m_log_filename(LOG_FILE), m_plan_filename(PLAN_FILE),
+	  m_found_plan(false), m_cost(0.0f) {}
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx//
+
+//---- Constructor ----------------------------------------------------------//
+Lifted_Planner::Lifted_Planner(std::string domain_file, std::string instance_file)
+	: Lifted_Interface(domain_file, instance_file), m_search_alg("BFWS"),
+	  m_iw_bound(LIFTED_BOUND), m_log_filename(LOG_FILE),
+	  m_plan_filename(PLAN_FILE), m_found_plan(false), m_cost(0.0f) {}
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx//
+
+//---- Destructor -----------------------------------------------------------//
+Lifted_Planner::~Lifted_Planner() {}
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx//
+
+//---------------------------------------------------------------------------//
+void Lifted_Planner::setup(bool gen_match_tree)
+{
+	Lifted_Interface::setup(gen_match_tree);
+	std::cout << "PDDL problem description loaded (lifted): " << std::endl;
+	std::cout << "\tDomain: " << get_domain_name() << std::endl;
+	std::cout << "\tProblem: " << get_problem_name() << std::endl;
+	std::cout << "\t#Schemas: " << instance()->num_schemas() << std::endl;
+	std::cout << "\t#Objects: " << instance()->num_objects() << std::endl;
+	std::cout << "\t#Fluents in init and goal: " << instance()->num_fluents() << std::endl;
+}
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx//
+
+//---------------------------------------------------------------------------//
+template <typename Search_Engine>
+float Lifted_Planner::do_search(Search_Engine &engine, Lifted_Search_Problem &search_prob,
+								std::ofstream &plan_stream, bool inc_bound)
+{
+	std::ofstream details(m_log_filename);
+
+	float ref = aptk::time_used();
+	unsigned expanded = 0;
+	unsigned generated = 0;
+	std::vector<aptk::Action_Idx> plan;
+	float cost = 0.0f;
+	unsigned b = inc_bound ? 1 : m_iw_bound;
+	do
+	{
+		engine.set_bound(b);
+		engine.start();
+		m_found_plan = engine.find_solution(cost, plan);
+		expanded += engine.expanded();
+		generated += engine.generated();
+		b++;
+	} while (!m_found_plan && b <= m_iw_bound);
+
+	if (m_found_plan)
+	{
+		m_cost = cost;
+		details << "Plan found with cost: " << cost << std::endl;
+		std::cout << "Plan found with cost: " << cost << std::endl;
+		for (unsigned k = 0; k < plan.size(); k++)
+		{
+			details << k + 1 << ". ";
+			details << search_prob.task().action_signature(plan[k]);
+			details << std::endl;
+			plan_stream << search_prob.task().action_signature(plan[k]) << std::endl;
+		}
+	}
+	else
+	{
+		details << ";; NOT I-REACHABLE ;;" << std::endl;
+		std::cout << ";; NOT I-REACHABLE ;;" << std::endl;
+	}
+
+	float total_time = aptk::time_used() - ref;
+	details << "Total time: " << total_time << std::endl;
+	details << "Nodes generated during search: " << generated << std::endl;
+	details << "Nodes expanded during search: " << expanded << std::endl;
+	details << "Fluents reached: " << search_prob.task().num_fluents() << std::endl;
+	details << "Ground actions reached: " << search_prob.task().num_actions() << std::endl;
+	details.close();
+
+	std::cout << "Total time: " << total_time << std::endl;
+	std::cout << "Nodes generated during search: " << generated << std::endl;
+	std::cout << "Nodes expanded during search: " << expanded << std::endl;
+	std::cout << "Fluents reached: " << search_prob.task().num_fluents() << std::endl;
+	std::cout << "Ground actions reached: " << search_prob.task().num_actions() << std::endl;
+#ifdef __linux__
+	aptk::report_memory_usage();
+#endif
+	return total_time;
+}
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx//
+
+//---------------------------------------------------------------------------//
+void Lifted_Planner::solve()
+{
+	Lifted_Search_Problem search_prob(instance());
+
+	std::ofstream plan_stream;
+	plan_stream.open(m_plan_filename);
+
+	float t;
+	if (m_search_alg == "IW")
+	{
+		std::cout << "Starting lifted search with IW ..." << std::endl;
+		IW_Lifted engine(search_prob);
+		t = do_search(engine, search_prob, plan_stream, true);
+	}
+	else
+	{
+		std::cout << "Starting lifted search with BFWS ..." << std::endl;
+		BFWS_Lifted engine(search_prob);
+		t = do_search(engine, search_prob, plan_stream, false);
+	}
+	std::cout << "Lifted search completed in " << t << " secs, check '" << m_log_filename << "' for details" << std::endl;
+
+	plan_stream.close();
+}
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx//
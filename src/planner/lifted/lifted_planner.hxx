@@ -0,0 +1,51 @@
+#ifndef __LIFTED_PLANNER__
+#define __LIFTED_PLANNER__
+
+//---- CONSTANTS
+#define LIFTED_BOUND 2
+#define LOG_FILE "planner.log"
+#define PLAN_FILE "plan.ipc"
+
+// Standard library
+#include <iostream>
+#include <fstream>
+#include <string>
+
+// LAPKT specific
+#include <py_lifted_interface.hxx>
+#include <lifted_prob.hxx>
+#include <lifted_search_prob.hxx>
+#include <lifted_width.hxx>
+
+using aptk::agnostic::Lifted_Search_Problem;
+
+//---- Lifted_Planner Class -------------------------------------------------//
+// Width-based planners searching the lifted task, without grounding it
+class Lifted_Planner : public Lifted_Interface
+{
+public:
+	typedef aptk::search::lifted::IW<Lifted_Search_Problem> IW_Lifted;
+	typedef aptk::search::lifted::BFWS<Lifted_Search_Problem> BFWS_Lifted;
+
+	Lifted_Planner();
+	Lifted_Planner(std::string, std::string);
+	virtual ~Lifted_Planner();
+
+	virtual void setup(bool gen_match_tree = true);
+	void solve();
+
+	// 'BFWS' (novelty and goal counting) or 'IW' (bounds 1 to m_iw_bound)
+	std::string m_search_alg;
+	unsigned m_iw_bound;
+	std::string m_log_filename;
+	std::string m_plan_filename;
+	bool m_found_plan;
+	float m_cost;
+
+protected:
+	template <typename Search_Engine>
+	float do_search(Search_Engine &engine, Lifted_Search_Problem &search_prob,
+		std::ofstream &plan_stream, bool inc_bound);
+};
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx//
+#endif
@@ -22,7 +22,10 @@
 #include <bfs_w_planner.hxx>
 #include <bfs_w_count_planner.hxx>
 
+#include <lifted_planner.hxx>
+
 #include <py_strips_interface.hxx>
+#include <py_lifted_interface.hxx>
 // #include <tarski_instantiator.hxx>
 // #include <strips_prob.hxx>
 
@@ -63,14 +66,18 @@ PYBIND11_MODULE(planner, m)
     .def_readwrite("max_novelty", &BFS_f_Planner::m_max_novelty)
     .def_readwrite("log_filename", &BFS_f_Planner::m_log_filename)
     .def_readwrite("plan_filename", &BFS_f_Planner::m_plan_filename)
-    .def_readwrite("one_ha_per_fluent", &BFS_f_Planner::m_one_ha_per_fluent);
+    .def_readwrite("one_ha_per_fluent", &BFS_f_Planner::m_one_ha_per_fluent)
+    .def_readwrite("h1_radix_heap", &BFS_f_Planner::m_h1_radix_heap)
+    .def_readwrite("h1_incremental", &BFS_f_Planner::m_h1_incremental)
+    .def_readwrite("landmarks_time", &BFS_f_Planner::m_landmarks_time);
 
   py::class_<BRFS_Planner, STRIPS_Interface>(m, "BRFS_Planner")
     .def(py::init<>())
     .def("setup", &BRFS_Planner::setup)
     .def("solve", &BRFS_Planner::solve)
     .def_readwrite("log_filename", &BRFS_Planner::m_log_filename)
-    .def_readwrite("plan_filename", &BRFS_Planner::m_plan_filename);
+    .def_readwrite("plan_filename", &BRFS_Planner::m_plan_filename)
+    .def_readwrite("num_threads", &BRFS_Planner::m_num_threads);
 
   py::class_<BFWS, STRIPS_Interface>(m, "BFWS")
     .def(py::init<>())
@@ -85,7 +92,11 @@ PYBIND11_MODULE(planner, m)
     .def_readwrite("found_plan", &BFWS::m_found_plan)
     .def_readwrite("plan_cost", &BFWS::m_cost)
     .def_readwrite("cost_bound", &BFWS::m_cost_bound)
-    .def_readwrite("verbose", &BFWS::m_verbose);
+    .def_readwrite("verbose", &BFWS::m_verbose)
+    .def_readwrite("delta_snapshot", &BFWS::m_delta_snapshot)
+    .def_readwrite("relplan_cache_size", &BFWS::m_relplan_cache_size)
+    .def_readwrite("h1_radix_heap", &BFWS::m_h1_radix_heap)
+    .def_readwrite("landmarks_time", &BFWS::m_landmarks_time);
 
   py::class_<Approximate_BFWS, STRIPS_Interface>(m, "Approximate_BFWS")
     .def(py::init<>())
@@ -156,7 +167,8 @@ PYBIND11_MODULE(planner, m)
     .def_readwrite("iw_bound", &IW_Planner::m_iw_bound)
     .def_readwrite("log_filename", &IW_Planner::m_log_filename)
     .def_readwrite("plan_filename", &IW_Planner::m_plan_filename)
-    .def_readwrite("atomic", &IW_Planner::m_atomic);
+    .def_readwrite("atomic", &IW_Planner::m_atomic)
+    .def_readwrite("num_threads", &IW_Planner::m_num_threads);
 
   py::class_<Approximate_IW, STRIPS_Interface>(m, "Approximate_IW")
     .def(py::init<>())
@@ -173,7 +185,8 @@ PYBIND11_MODULE(planner, m)
     .def_readwrite("iw_bound", &RPIW_Planner::m_iw_bound)
     .def_readwrite("log_filename", &RPIW_Planner::m_log_filename)
     .def_readwrite("plan_filename", &RPIW_Planner::m_plan_filename)
-    .def_readwrite("atomic", &RPIW_Planner::m_atomic);
+    .def_readwrite("atomic", &RPIW_Planner::m_atomic)
+    .def_readwrite("delta_snapshot", &RPIW_Planner::m_delta_snapshot);
 
   py::class_<Approximate_RP_IW, STRIPS_Interface>(m, "Approximate_RP_IW")
     .def(py::init<>())
@@ -189,7 +202,8 @@ PYBIND11_MODULE(planner, m)
     .def("solve", &SIW_Planner::solve)
     .def_readwrite("iw_bound", &SIW_Planner::m_iw_bound)
     .def_readwrite("log_filename", &SIW_Planner::m_log_filename)
-    .def_readwrite("plan_filename", &SIW_Planner::m_plan_filename);
+    .def_readwrite("plan_filename", &SIW_Planner::m_plan_filename)
+    .def_readwrite("num_threads", &SIW_Planner::m_num_threads);
 
   py::class_<Approximate_SIW, STRIPS_Interface>(m, "Approximate_SIW")
     .def(py::init<>())
@@ -205,7 +219,8 @@ PYBIND11_MODULE(planner, m)
     .def("solve", &SIW_Plus_Planner::solve)
     .def_readwrite("iw_bound", &SIW_Plus_Planner::m_iw_bound)
     .def_readwrite("log_filename", &SIW_Plus_Planner::m_log_filename)
-    .def_readwrite("plan_filename", &SIW_Plus_Planner::m_plan_filename);
+    .def_readwrite("plan_filename", &SIW_Plus_Planner::m_plan_filename)
+    .def_readwrite("num_threads", &SIW_Plus_Planner::m_num_threads);
 
   py::class_<SIW_PLUS_BFS_F_Planner, STRIPS_Interface>(m, "SIW_PLUS_BFS_F_Planner")
     .def(py::init<>())
@@ -252,4 +267,16 @@ PYBIND11_MODULE(planner, m)
     .def_readwrite("memory_budget", &BFS_W_COUNT_Planner::m_memory_budget)
     .def_readwrite("h2_blind_only", &BFS_W_COUNT_Planner::m_h2_blind_only);
 
+
+  py::class_<Lifted_Planner, Lifted_Interface>(m, "Lifted_Planner")
+    .def(py::init<>())
+    .def("setup", &Lifted_Planner::setup)
+    .def("solve", &Lifted_Planner::solve)
+    .def_readwrite("search", &Lifted_Planner::m_search_alg)
+    .def_readwrite("iw_bound", &Lifted_Planner::m_iw_bound)
+    .def_readwrite("log_filename", &Lifted_Planner::m_log_filename)
+    .def_readwrite("plan_filename", &Lifted_Planner::m_plan_filename)
+    .def_readwrite("found_plan", &Lifted_Planner::m_found_plan)
+    .def_readwrite("plan_cost", &Lifted_Planner::m_cost);
+
 }
\ No newline at end of file
@@ -34,6 +34,7 @@ PYBIND11_MODULE(planner, m)
         .def_readwrite("plan_filename", &AT_LAPKT_Planner::m_plan_filename)
         .def_readwrite("enable_siw_plus", &AT_LAPKT_Planner::m_enable_siw_plus)
         .def_readwrite("enable_bfs_f", &AT_LAPKT_Planner::m_enable_bfs_f)
+        .def_readwrite("concurrent", &AT_LAPKT_Planner::m_concurrent)
     ;
 
     py::class_<AT_BFS_f_Planner, STRIPS_Interface>(m, "AT_BFS_f_Planner")
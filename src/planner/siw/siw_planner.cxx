@@ -29,12 +29,12 @@ typedef IW<Fwd_Search_Problem, H_Novel_Fwd> IW_Fwd;
 // typedef		Serialized_Search< Fwd_Search_Problem, IW_Fwd, IW_Node >        SIW_Fwd;
 
 SIW_Planner::SIW_Planner()
-		: STRIPS_Interface(), m_iw_bound(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc")
+		: STRIPS_Interface(), m_iw_bound(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_num_threads(1)
 {
 }
 
 SIW_Planner::SIW_Planner(std::string domain_file, std::string instance_file)
-		: STRIPS_Interface(domain_file, instance_file), m_iw_bound(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc")
+		: STRIPS_Interface(domain_file, instance_file), m_iw_bound(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_num_threads(1)
 {
 }
 
@@ -58,6 +58,7 @@ float SIW_Planner::do_search(SIW_Fwd &engine)
 
 	engine.set_bound(1);
 	engine.set_max_bound(m_iw_bound - 1);
+	engine.set_num_threads(m_num_threads);
 	engine.start();
 
 	std::vector<aptk::Action_Idx> plan;
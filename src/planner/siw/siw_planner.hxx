@@ -21,6 +21,8 @@ public:
 	int m_iw_bound;
 	std::string m_log_filename;
 	std::string m_plan_filename;
+	// Goal candidates tried concurrently from each serialized state, 0 uses all cores
+	unsigned m_num_threads;
 
 protected:
 	float do_search(SIW_Fwd &engine);
@@ -14,12 +14,12 @@ using aptk::agnostic::Landmarks_Graph_Generator;
 typedef Landmarks_Graph_Generator<Fwd_Search_Problem> Gen_Lms_Fwd;
 
 SIW_Plus_Planner::SIW_Plus_Planner()
-		: STRIPS_Interface(), m_iw_bound(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc")
+		: STRIPS_Interface(), m_iw_bound(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_num_threads(1)
 {
 }
 
 SIW_Plus_Planner::SIW_Plus_Planner(std::string domain_file, std::string instance_file)
-		: STRIPS_Interface(domain_file, instance_file), m_iw_bound(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc")
+		: STRIPS_Interface(domain_file, instance_file), m_iw_bound(2), m_log_filename("iw.log"), m_plan_filename("plan.ipc"), m_num_threads(1)
 {
 }
 
@@ -43,6 +43,7 @@ float SIW_Plus_Planner::do_search(SIW_Plus_Fwd &engine)
 
 	engine.set_bound(1);
 	engine.set_max_bound(m_iw_bound - 1);
+	engine.set_num_threads(m_num_threads);
 	engine.start();
 
 	std::vector<aptk::Action_Idx> plan;
@@ -0,0 +1,107 @@
+"""
+MIT License
+
+Copyright (c) 2022 Anubhav Singh(anubhav.singh.er@pm.me)
+"""
+
+from hashlib import sha256
+from os import getpid, listdir, makedirs, remove, replace, stat, utime
+from os.path import isfile, join
+
+# Bump when the key inputs or the task image layout change
+CACHE_FORMAT = 1
+CACHE_SUFFIX = '.lapkt'
+# -----------------------------------------------------------------------------#
+
+
+class GroundingCache:
+    """On-disk cache of grounded tasks, stored as binary task images
+
+    Entries are keyed by a hash of the domain and problem files and the
+    grounder options. The least recently used entries are evicted once the
+    cache grows over its size bound.
+
+    :param cache_dir: directory holding the cached images
+    :type cache_dir: str
+    :param max_bytes: size bound of the cache, in bytes
+    :type max_bytes: int
+    """
+
+    def __init__(self, cache_dir: str, max_bytes: int):
+        self.cache_dir = cache_dir
+        self.max_bytes = max_bytes
+        makedirs(cache_dir, exist_ok=True)
+
+    @staticmethod
+    def key(domain: str, problem: str, options: dict) -> str:
+        """Content hash of a grounding request
+
+        :param domain: path to the domain pddl file
+        :param problem: path to the problem pddl file
+        :param options: grounder options affecting the grounded task
+        :return: hex digest naming the cache entry
+        """
+        digest = sha256()
+        digest.update(str(CACHE_FORMAT).encode())
+        for path in (domain, problem):
+            with open(path, 'rb') as in_f:
+                content = in_f.read()
+            digest.update(str(len(content)).encode() + b':')
+            digest.update(content)
+        for k in sorted(options):
+            digest.update('{}={};'.format(k, options[k]).encode())
+        return digest.hexdigest()
+
+    def path(self, key: str) -> str:
+        return join(self.cache_dir, key + CACHE_SUFFIX)
+
+    def load(self, key: str, task) -> bool:
+        """Fill task from the cache
+
+        :return: False on a miss, task is left untouched then
+        """
+        path = self.path(key)
+        if not isfile(path) or not task.load_task_image(path):
+            return False
+        try:
+            utime(path)  # mark as recently used
+        except OSError:
+            pass
+        return True
+
+    def store(self, key: str, task) -> bool:
+        """Add the grounded task to the cache and evict old entries"""
+        # Write under a private name, other processes may store the same key
+        part = self.path(key) + '.{}.part'.format(getpid())
+        if not task.write_task_image(part):
+            return False
+        replace(part, self.path(key))
+        self.evict(keep=key)
+        return True
+
+    def evict(self, keep: str = None):
+        """Remove least recently used entries until the bound is met
+
+        :param keep: key of an entry that must not be removed
+        """
+        entries = []
+        for name in listdir(self.cache_dir):
+            if not name.endswith(CACHE_SUFFIX):
+                continue
+            try:
+                st = stat(join(self.cache_dir, name))
+            except OSError:
+                continue  # removed by another process
+            entries.append((st.st_mtime, st.st_size, name))
+        total = sum(size for _, size, _ in entries)
+        for _, size, name in sorted(entries):
+            if total <= self.max_bytes:
+                break
+            if keep is not None and name == keep + CACHE_SUFFIX:
+                continue
+            try:
+                remove(join(self.cache_dir, name))
+            except OSError:
+                continue
+            total -= size
+# xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx#
@@ -14,6 +14,7 @@ from pathlib import Path
 
 # lapkt imports
 from . import planner
+from .grounding_cache import GroundingCache
 
 # External Libs
 from ruamel.yaml import YAML
@@ -22,6 +23,24 @@ parent_folder = Path(__file__).parent.absolute()
 rel_config_file = Path('planner/lapkt_planner_config.yml')
 PLANNER_CONFIG_PATH = join(parent_folder, rel_config_file)
 CWD = dirname(realpath(__file__))
+
+# Options of the grounded task common to all planners, as (name, keyword
+# arguments of ArgumentParser.add_argument). When given, each is set on the
+# planner instance under the same name before setup()
+TASK_OPTIONS = (
+    ('reduce_task', dict(
+        action='store_true',
+        help='If specified, fluents and actions unreachable from init' +
+        ' or irrelevant to the goal are removed before search')),
+    ('packed_states', dict(
+        action='store_true',
+        help='If specified, closed states are stored packed into' +
+        ' finite-domain variables built from the mutex groups')),
+    ('adaptive_states', dict(
+        action='store_true',
+        help='If specified, states keep their fluents either in a' +
+        ' vector or in a bitset, depending on their sampled size')),
+)
 # -----------------------------------------------------------------------------#
 
 
@@ -103,6 +122,41 @@ class Planner:
             print("'validate' check : Plan " + out_status)
 
     def _load_problem(self):
+        """
+        load problem from the grounding cache if enabled, else from pddl files
+        """
+        cache_dir = self.config.get('grounding_cache', {}).get('value', None)
+        # lifted tasks are not grounded, there is nothing to cache
+        if (not cache_dir
+                or self.config['grounder']['value'] == 'Tarski_Lifted'):
+            self._ground_problem()
+            return self._preprocess_problem()
+
+        cache = GroundingCache(
+            cache_dir,
+            self.config.get('grounding_cache_mb', {}).get('value', 1024)
+            * 1024 * 1024)
+        # options changing the grounded task are part of the key
+        options = {'grounder': self.config['grounder']['value'],
+                   'ignore_action_costs':
+                       self.planner_instance.ignore_action_costs}
+        if self._h2_mutex_time() is not None:
+            options['h2_mutexes'] = self._h2_mutex_time()
+        key = GroundingCache.key(
+            self.config['domain']['value'],
+            self.config['problem']['value'], options)
+        if cache.load(key, self.planner_instance):
+            print('Grounded task loaded from cache:', cache.path(key))
+            print('#Actions:', self.planner_instance.num_actions())
+            print('#Fluents:', self.planner_instance.num_atoms())
+            return 0
+        self._ground_problem()
+        self._preprocess_problem()
+        if not cache.store(key, self.planner_instance):
+            print('Grounded task could not be cached in', cache_dir)
+        return 0
+
+    def _ground_problem(self):
         """
         load problem from pddl files
         """
@@ -112,6 +166,12 @@ class Planner:
             except Exception:
                 print('Tarski PDDL translator is not installed!')
                 exit()
+        elif self.config['grounder']['value'] == 'Tarski_Lifted':
+            try:
+                from .pddl.tarski import lifted_generate_task as process_task
+            except Exception:
+                print('Tarski PDDL translator is not installed!')
+                exit()
         elif self.config['grounder']['value'] == 'FF':
             try:
                 from .pddl.ff import pddl_translate_ff as process_task
@@ -124,11 +184,17 @@ class Planner:
             except Exception:
                 print('FD translator is not installed!')
                 exit()
+        elif self.config['grounder']['value'] == 'FD_SAS':
+            try:
+                from .pddl.fd import sas as process_task
+            except Exception:
+                print('FD translator is not installed!')
+                exit()
         else:
             # We can add options for procedurally generated problems here
             raise ValueError(
                 "The value doesn't match supported parsers -" +
-                " Tarski/FF/FD")
+                " Tarski/Tarski_Lifted/FF/FD/FD_SAS")
 
         if self.config['grounder']['value'] == 'FF':
             process_task(
@@ -136,7 +202,7 @@ class Planner:
                 self.config['problem']['value'], self.planner_instance,
                 self.planner_instance.ignore_action_costs, False)
         elif (self.config['grounder']['value']
-              in ['Tarski', 'FD']):
+              in ['Tarski', 'Tarski_Lifted', 'FD', 'FD_SAS']):
             process_task(
                 self.config['domain']['value'],
                 self.config['problem']['value'], self.planner_instance)
@@ -147,6 +213,27 @@ class Planner:
         print('#Fluents:', self.planner_instance.num_atoms())
         return 0
 
+    def _h2_mutex_time(self):
+        """
+        time budget of the h^2 mutex preprocessing, None when disabled
+        """
+        if not (self.config.get('h2_mutexes', None)
+                and self.config['h2_mutexes']['value']):
+            return None
+        return self.config.get('h2_mutex_time', {}).get('value', 60.0)
+
+    def _preprocess_problem(self):
+        """
+        h^2 mutexes of the grounded task, they are cached along with it
+        """
+        time_budget = self._h2_mutex_time()
+        if time_budget is None:
+            return 0
+        if not hasattr(self.planner_instance, 'compute_h2_mutexes'):
+            raise ValueError('--h2_mutexes needs a grounded task')
+        self.planner_instance.compute_h2_mutexes(time_budget)
+        return 0
+
     def _configure_planner(self):
         """
         load configs into planner
@@ -172,6 +259,13 @@ class Planner:
         """
         run planner
         """
+        for name, _ in TASK_OPTIONS:
+            value = self.config.get(name, {}).get('value', None)
+            if not value:
+                continue
+            if not hasattr(self.planner_instance, name):
+                raise ValueError('--' + name + ' needs a grounded task')
+            setattr(self.planner_instance, name, value)
         self.planner_instance.setup(
             bool(not (self.config.get('no_match_tree',
                       None) and self.config['no_match_tree']['value'])))
@@ -9,7 +9,7 @@ from argparse import ArgumentParser
 from re import match
 
 # lapkt Imports
-from .load_planner import load_planner_config
+from .load_planner import TASK_OPTIONS, load_planner_config
 
 # CWD = dirname(realpath(__file__))
 """
@@ -62,6 +62,18 @@ def process_arguments(debug: bool = False) -> dict:
         parser.add_argument(
             '--no_match_tree', action='store_true',
             help='If specified, match tree is not generated')
+        for name, kwargs in TASK_OPTIONS:
+            parser.add_argument('--' + name, **kwargs)
+        parser.add_argument(
+            '--h2_mutexes', action='store_true',
+            help='If specified, h^2 mutexes are computed from init after' +
+            ' grounding, actions with mutex preconditions are removed and' +
+            ' the mutexes are kept as mutex groups of the task')
+        parser.add_argument(
+            '--h2_mutex_time', action='store', type=float,
+            default=60.0,
+            help='Time budget in seconds of --h2_mutexes, the task is left' +
+            ' as is when it runs out; **Default = 60')
         parser.add_argument(
             '--validate', action='store_true',
             help='If specified, plan is checked for correctioness' +
@@ -73,7 +85,19 @@ def process_arguments(debug: bool = False) -> dict:
         parser.add_argument(
             '--grounder', action='store',
             nargs='?', default='Tarski',
-            help='Choice of parser - Tarski<Default>,FD or FF')
+            help='Choice of parser - Tarski<Default>,FD, FF or FD_SAS' +
+            ' (FD translator output loaded natively), or Tarski_Lifted' +
+            ' for Lifted_Planner')
+        parser.add_argument(
+            '--grounding_cache', action='store',
+            nargs='?', required=False,
+            help='Directory where grounded tasks are cached and reused' +
+            ' across runs on the same domain and problem')
+        parser.add_argument(
+            '--grounding_cache_mb', action='store', type=int,
+            default=1024,
+            help='Size bound of the grounding cache in MB, least' +
+            ' recently used tasks are evicted; **Default = 1024')
         if(debug):
             parser.add_argument(
                 '--wait_debug', action='store_true', help='For' +
@@ -1,5 +1,6 @@
 
 
+from array import array
 from collections import defaultdict
 
 from . import pddl
@@ -12,6 +13,9 @@ import sys
 
 from . import normalize
 from .pddl_parser import pddl_file
+from os import environ
+from os.path import dirname, isfile, join
+import subprocess
 
 
 def get_fluent_facts(task, model):
@@ -238,6 +242,34 @@ def encodeNegatedOnly(lits, atom_table):
     
     return encoded
 
+def pack_actions( nd_actions ) :
+    """Flattens PropositionalDetActions into the arrays taken by
+    STRIPS_Interface.add_actions(): literals are 2*atom+negated, and every
+    list is stored as one array of literals plus an array of offsets.
+    """
+    names = []
+    costs = array('f')
+    pre_offs, pre_lits = array('I', [0]), array('I')
+    eff_offs, eff_lits = array('I', [0]), array('I')
+    ceff_offs, cond_offs, cond_lits = array('I', [0]), array('I', [0]), array('I')
+    ceff_eff_offs, ceff_eff_lits = array('I', [0]), array('I')
+    for (name, action) in nd_actions :
+        names.append( name )
+        costs.append( action.cost )
+        pre_lits.extend( 2*sym + negated for sym, negated in action.precondition )
+        pre_offs.append( len(pre_lits) )
+        for eff in action.effects :
+            eff_lits.extend( 2*sym + negated for sym, negated in eff )
+        eff_offs.append( len(eff_lits) )
+        for cond, eff in action.cond_effs.items() :
+            cond_lits.extend( 2*sym + negated for sym, negated in cond )
+            cond_offs.append( len(cond_lits) )
+            ceff_eff_lits.extend( 2*sym + negated for sym, negated in eff )
+            ceff_eff_offs.append( len(ceff_eff_lits) )
+        ceff_offs.append( len(cond_offs) - 1 )
+    return ( names, costs, pre_offs, pre_lits, eff_offs, eff_lits,
+             ceff_offs, cond_offs, cond_lits, ceff_eff_offs, ceff_eff_lits )
+
 def fodet( domain_file, problem_file, output_task ) :
     parsing_timer = timers.Timer()
         
@@ -361,23 +393,8 @@ def default( domain_file, problem_file, output_task ) :
     
     output_task.create_negated_fluents()
 
-    for (name, _) in nd_actions :
-        output_task.add_action( name.encode('utf-8'), False )
-
-    index = 0
-    for (_,action) in nd_actions :
-        output_task.add_precondition( index, action.precondition )
-        for eff in action.effects :
-            output_task.add_effect( index, eff )
-        #if len(action.cond_effs) != 0 :
-        #   print action.name, len(action.cond_effs), "has conditional effects"
-        for cond, eff in action.cond_effs.items() :
-                        #print( action.name, cond, atom_names[cond[0][0]] )
-
-            output_task.add_cond_effect( index, list(cond), eff )
-                        
-        output_task.set_cost( index, action.cost ) 
-        index += 1
+    with timers.timing("Adding actions", True):
+        output_task.add_actions( *pack_actions( nd_actions ) )
 
         # NIR: Default options assign 0 seconds. Change Options file to 300s to have the same configuration as FD
     # MRJ: Mutex groups processing needs to go after negations are compiled away
@@ -395,4 +412,32 @@ def default( domain_file, problem_file, output_task ) :
     output_task.set_goal( encode( task.goal, atom_table ) )
     output_task.parsing_time = parsing_timer.report()
 
+def sas( domain_file, problem_file, output_task, translator=None, sas_file='output.sas' ) :
+    """Ground with the FD translator and load output.sas in C++.
+
+    The SAS+ task keeps FD's finite-domain variables and mutex groups, and
+    avoids pushing every atom and action through Python. problem_file may
+    also be an existing .sas file, which is then loaded as is.
+    """
+    parsing_timer = timers.Timer()
+    if problem_file.endswith('.sas') :
+        sas_file = problem_file
+    else :
+        if translator is None :
+            translator = environ.get('FD_TRANSLATE', join(dirname(__file__), 'translate.py'))
+        if not isfile(translator) :
+            print("FD translator not found: %s (set FD_TRANSLATE)" % translator)
+            sys.exit(1)
+        with timers.timing("Translating to SAS+", True):
+            rv = subprocess.call([sys.executable, translator, domain_file, problem_file,
+                                  '--sas-file', sas_file])
+        if rv != 0 :
+            print("FD translator failed with exit code %d" % rv)
+            sys.exit(rv)
+
+    with timers.timing("Loading SAS+ task", True):
+        if not output_task.load_sas(sas_file) :
+            sys.exit(1)
+    output_task.parsing_time = parsing_timer.report()
+
 
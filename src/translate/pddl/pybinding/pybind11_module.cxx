@@ -47,6 +47,7 @@ PYBIND11_MODULE(pddl, m)
         .def(py::init<STRIPS_Interface *, py::list &, Formula &,
                       py::list &, py::list &>())
         .def("instantiate_action", &Tarski_Instantiator::instantiate_action)
+        .def("instantiate_actions", &Tarski_Instantiator::instantiate_actions)
         .def("add_fluents", &Tarski_Instantiator::add_fluents)
         .def("add_init", &Tarski_Instantiator::add_init)
         .def("add_goal", &Tarski_Instantiator::add_goal)
@@ -54,7 +55,8 @@ PYBIND11_MODULE(pddl, m)
         .def("add_goal", &Tarski_Instantiator::add_goal)
         .def("set_goal", &Tarski_Instantiator::set_goal)
         .def("add_functions", &Tarski_Instantiator::add_functions)
-        .def("finalize_actions", &Tarski_Instantiator::finalize_actions);
+        .def("finalize_actions", &Tarski_Instantiator::finalize_actions)
+        .def_readwrite("num_threads", &Tarski_Instantiator::m_num_threads);
 
     py::class_<Identifier>(m, "TI_Identifier")
         .def(py::init<char, std::string>());
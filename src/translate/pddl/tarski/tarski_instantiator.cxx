@@ -9,6 +9,9 @@
  *
  */
 #include <tarski_instantiator.hxx>
+#include <thread_pool.hxx>
+
+#include <algorithm>
 
 using namespace tarski;
 
@@ -169,7 +172,7 @@ std::string Atom::instantiate(std::map<Identifier, std::string> &var_map)
 //---- Extract atom's index. Compile away in case of non-fluent atoms
 //==== Arguments ====//
 //---- 1. var_map:  variable to constant mapping
-//---- 2. init:     vector of init atoms(Atom represented by string)
+//---- 2. init:     sorted vector of init atoms(Atom represented by string)
 //---- 3. fluent:   map of fluent-atoms(represented by string) to atom-index
 //----------------------------------------------------------------------------//
 std::pair<int, bool> Atom::compile(std::map<Identifier, std::string> &var_map,
@@ -222,7 +225,7 @@ std::pair<int, bool> Atom::compile(std::map<Identifier, std::string> &var_map,
     }
     else
     {
-        if (std::find(init.begin(), init.end(), atom) != init.end())
+        if (std::binary_search(init.begin(), init.end(), atom))
         {
             return std::make_pair(-1, true);
         }
@@ -315,7 +318,7 @@ std::string Formula::publish()
 //---- 1. var_map:  variable to constant mapping
 //---- 2. init:     vector of init atoms(Atom represented by string)
 //---- 3. fluent:   map of fluent-atoms(represented by string) to atom-index
-//---- 4. out_task: LAPKT planner object
+//---- 4. negated:  atoms appearing under NOT, to be notified to the task
 //==== Return: Encoded precondition and effects (condition and effect atoms
 ///================ Applies to all CONNECTIVE: XXX methods ===================//
 
@@ -323,7 +326,7 @@ std::string Formula::publish()
 std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool>
 Formula::process_not(std::map<Identifier, std::string> &var_map,
                      std::vector<std::string> &init, std::map<std::string, int> &fluent,
-                     STRIPS_Interface *out_task)
+                     std::vector<unsigned> &negated)
 {
     std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool> ret_val;
     // Check with reserve later
@@ -347,9 +350,8 @@ Formula::process_not(std::map<Identifier, std::string> &var_map,
         std::vector<std::pair<int, bool>> temp;
         temp.push_back(std::move(x));
         ret_val.first.push_back(std::move(temp));
-        unsigned index = x.first;
-        // Add a negated atom to STRIPS Problem
-        out_task->notify_negated_atom(index);
+        // Record a negated atom for the STRIPS Problem
+        negated.push_back(x.first);
     }
 
     return ret_val;
@@ -360,7 +362,7 @@ Formula::process_not(std::map<Identifier, std::string> &var_map,
 std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool>
 Formula::process_or(std::map<Identifier, std::string> &var_map,
                     std::vector<std::string> &init, std::map<std::string, int> &fluent,
-                    STRIPS_Interface *out_task)
+                    std::vector<unsigned> &negated)
 {
     /*
     std::cout<< "OR CONNECTIVE DETECTED!!" << std::endl;
@@ -396,7 +398,7 @@ Formula::process_or(std::map<Identifier, std::string> &var_map,
     for (size_t i = 0; i < m_subformula.size(); i++)
     {
         std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool> x(
-            m_subformula[i].instantiate(var_map, init, fluent, out_task));
+            m_subformula[i].instantiate(var_map, init, fluent, negated));
         if (x.first.size() > 0)
         {
             for (size_t j = 0; j < x.first.size(); j++)
@@ -425,7 +427,7 @@ Formula::process_or(std::map<Identifier, std::string> &var_map,
 std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool>
 Formula::process_and(std::map<Identifier, std::string> &var_map,
                      std::vector<std::string> &init, std::map<std::string, int> &fluent,
-                     STRIPS_Interface *out_task)
+                     std::vector<unsigned> &negated)
 {
     std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool> ret_val;
     ret_val.first.push_back(std::vector<std::pair<int, bool>>{});
@@ -453,7 +455,7 @@ Formula::process_and(std::map<Identifier, std::string> &var_map,
     for (size_t i = 0; i < m_subformula.size(); i++)
     {
         std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool> x(
-            m_subformula[i].instantiate(var_map, init, fluent, out_task));
+            m_subformula[i].instantiate(var_map, init, fluent, negated));
         if (x.first.size() > 0)
         {
             size_t n = ret_val.first.size();
@@ -497,7 +499,7 @@ Formula::process_and(std::map<Identifier, std::string> &var_map,
 std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool>
 Formula::process_tautology(std::map<Identifier, std::string> &var_map,
                            std::vector<std::string> &init, std::map<std::string, int> &fluent,
-                           STRIPS_Interface *out_task)
+                           std::vector<unsigned> &negated)
 {
     std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool> ret_val;
 
@@ -511,7 +513,7 @@ std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool>
 Formula::process_contradiction(std::map<Identifier,
                                         std::string> &var_map,
                                std::vector<std::string> &init,
-                               std::map<std::string, int> &fluent, STRIPS_Interface *out_task)
+                               std::map<std::string, int> &fluent, std::vector<unsigned> &negated)
 {
     std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool> ret_val;
 
@@ -525,7 +527,7 @@ Formula::process_contradiction(std::map<Identifier,
 std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool>
 Formula::instantiate(std::map<Identifier, std::string> &var_map,
                      std::vector<std::string> &init,
-                     std::map<std::string, int> &fluent, STRIPS_Interface *out_task)
+                     std::map<std::string, int> &fluent, std::vector<unsigned> &negated)
 {
     std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool> ret_val;
     std::map<std::string, functionpointer>::iterator it;
@@ -533,7 +535,7 @@ Formula::instantiate(std::map<Identifier, std::string> &var_map,
     it = m_connective_map.find(m_symbol);
     if (it != m_connective_map.end())
     {
-        ret_val = (this->*it->second)(var_map, init, fluent, out_task);
+        ret_val = (this->*it->second)(var_map, init, fluent, negated);
     }
     else
     {
@@ -669,54 +671,76 @@ void Action::instantiate(STRIPS_Interface *out_task, py::tuple &params,
                          long &next_action_id, std::map<std::string, int> &fluent,
                          std::vector<std::string> &init, std::map<std::string, float> &fval)
 {
-    std::map<Identifier, std::string> var_map;
-    std::vector<std::pair<int, bool>> effect;
     std::vector<std::string> v_params(py::len(params));
-    float cost;
-    std::vector<std::pair<
-        std::vector<std::pair<int, bool>>,
-        std::vector<std::pair<int, bool>>>>
-        c_effect;
+    for (int i = 0; i < py::len(params); i++)
+    {
+        v_params[i] = params[i].cast<std::string>();
+    }
+    Ground_Action g;
+    ground(v_params, fluent, init, fval, g);
+    g.commit(out_task, next_action_id);
+}
+// ############################################################################//
+
+//---- Ground Action without touching the task, see instantiate()
+//==== Arguments ====//
+//---- 1. params:           constant parameters
+//---- 2. fluent:           Mapping of Fluent atoms <string-to-index>
+//---- 3. init:             sorted init atoms
+//---- 4. fval:             Mapping of functions <string-to-index>
+//---- 5. out:              grounded action, to be commited to the task
+//----------------------------------------------------------------------------//
+void Action::ground(const std::vector<std::string> &params,
+                    std::map<std::string, int> &fluent, std::vector<std::string> &init,
+                    const std::map<std::string, float> &fval, Ground_Action &out)
+{
+    std::map<Identifier, std::string> var_map;
+
+    out.add = false;
+    out.pre_true = false;
+    out.cost = 0;
 
     // create a variable map
-    assert(py::len(params) == m_var.size());
-    for (int i = 0; i < py::len(params); i++)
+    assert(params.size() == m_var.size());
+    for (size_t i = 0; i < params.size(); i++)
     {
-        std::string x((params[i].cast<std::string>()));
-        var_map[m_var[i]] = x;
-        v_params[i] = std::move(x);
+        var_map[m_var[i]] = params[i];
     }
 
     // compute cost
     if (m_cost[0].first.get_symbol() == "")
     {
         // the value is constant and hence function was not passed
-        cost = m_cost[0].second;
+        out.cost = m_cost[0].second;
     }
     else
     {
-        // allocate function value
-        cost = fval[m_cost[0].first.instantiate(var_map)];
+        // allocate function value, unknown values default to 0
+        auto it = fval.find(m_cost[0].first.instantiate(var_map));
+        if (it != fval.end())
+        {
+            out.cost = it->second;
+        }
     }
     // compile preconditions
     std::pair<std::vector<std::vector<std::pair<int, bool>>>, bool> pre(
-        m_pre->instantiate(var_map, init, fluent, out_task));
+        m_pre->instantiate(var_map, init, fluent, out.negated));
     // if pre-condition not-false
     if (((pre.first.size() > 0) && pre.first[0].size() > 0) || (pre.second == true))
     {
-        for (auto e : m_effect)
+        for (auto &e : m_effect)
         {
             // condition - formula
             std::pair<std::vector<std::vector<std::pair<int,
                                                         bool>>>,
                       bool>
                 cond(e.first.instantiate(
-                    var_map, init, fluent, out_task));
+                    var_map, init, fluent, out.negated));
 
             if (cond.first.size() > 0 || cond.second == true)
             {
                 std::vector<std::pair<int, bool>> c_effect_atoms;
-                for (auto a : e.second)
+                for (auto &a : e.second)
                 {
                     int atom_id = -1;
                     // effect - atom
@@ -743,73 +767,87 @@ void Action::instantiate(STRIPS_Interface *out_task, py::tuple &params,
                     }
                     else
                     {
-                        effect.push_back(std::make_pair(atom_id, a.second));
+                        out.effect.push_back(std::make_pair(atom_id, a.second));
                     }
                 }
                 for (auto c : cond.first)
                 {
-                    c_effect.push_back(std::make_pair(c, c_effect_atoms));
+                    out.c_effect.push_back(std::make_pair(c, c_effect_atoms));
                 }
             } // cond.size>0
         }     // loop over m_effect
         // add actions for all precondition(s), more than 1 if OR in prec
-        if (effect.size() > 0 || c_effect.size() > 0)
+        if (out.effect.size() > 0 || out.c_effect.size() > 0)
         {
-            std::string name;
-            // name.reserve(100);
-            name.append("(");
-            name.append(m_name);
-            for (auto p : v_params)
+            out.add = true;
+            out.pre_true = pre.second;
+            out.pre = std::move(pre.first);
+            out.name.append("(");
+            out.name.append(m_name);
+            for (auto &p : params)
             {
-                name.append(" ");
-                name.append(p);
+                out.name.append(" ");
+                out.name.append(p);
             }
-            name.append(")");
-            if (pre.second == true)
+            out.name.append(")");
+        } // effect.size > 0
+    }     // pre exists and is not false
+}
+// ############################################################################//
+
+//---- Push grounded action to the task
+//==== Arguments ====//
+//---- 1. out_task:         LAPKT planner object pointer
+//---- 2. next_action_id :  integer index of action to be set in STRIPS_Problem
+//----------------------------------------------------------------------------//
+void Ground_Action::commit(STRIPS_Interface *out_task, long &next_action_id)
+{
+    for (auto index : negated)
+    {
+        // Add a negated atom to STRIPS Problem
+        out_task->notify_negated_atom(index);
+    }
+    if (!add)
+    {
+        return;
+    }
+    if (pre_true)
+    {
+        out_task->add_action(name, true);
+        if (effect.size() > 0)
+        {
+            out_task->add_effect(next_action_id, effect);
+        }
+        for (auto &c_e : c_effect)
+        {
+            out_task->add_cond_effect(next_action_id, c_e.first,
+                                      c_e.second);
+        }
+        out_task->set_cost(next_action_id, cost);
+        next_action_id++;
+    }
+    else
+    {
+        for (size_t i = 0; i < pre.size(); i++)
+        {
+            // Anu - How to correctly split action with OR precond.?
+            // Anu - Add a "-#" at the end of action signature.
+            //          However, then plan can't be validated
+            out_task->add_action(name, true);
+            out_task->add_precondition(next_action_id, pre[i]);
+            if (effect.size() > 0)
             {
-                out_task->add_action(name, true);
-                if (effect.size() > 0)
-                {
-                    out_task->add_effect(next_action_id, effect);
-                }
-                for (auto c_e : c_effect)
-                {
-                    out_task->add_cond_effect(next_action_id, c_e.first,
-                                              c_e.second);
-                }
-                out_task->set_cost(next_action_id, cost);
-                next_action_id++;
+                out_task->add_effect(next_action_id, effect);
             }
-            else
+            for (auto &c_e : c_effect)
             {
-                for (size_t i = 0; i < pre.first.size(); i++)
-                {
-                    // Anu - How to correctly split action with OR precond.?
-                    // Anu - Add a "-#" at the end of action signature.
-                    //          However, then plan can't be validated
-                    /*
-                    if (i > 0) {
-                        name.append("-");
-                        name.append(std::to_string(i));
-                    }
-                    */
-                    out_task->add_action(name, true);
-                    out_task->add_precondition(next_action_id, pre.first[i]);
-                    if (effect.size() > 0)
-                    {
-                        out_task->add_effect(next_action_id, effect);
-                    }
-                    for (auto c_e : c_effect)
-                    {
-                        out_task->add_cond_effect(next_action_id, c_e.first,
-                                                  c_e.second);
-                    }
-                    out_task->set_cost(next_action_id, cost);
-                    next_action_id++;
-                }
-            } // pre.second == true
-        }     // effect.size > 0
-    }         // pre exists and is not false
+                out_task->add_cond_effect(next_action_id, c_e.first,
+                                          c_e.second);
+            }
+            out_task->set_cost(next_action_id, cost);
+            next_action_id++;
+        }
+    } // pre_true
 }
 // ############################################################################//
 
@@ -817,7 +855,7 @@ void Action::instantiate(STRIPS_Interface *out_task, py::tuple &params,
 
 //---- Constructor
 //----------------------------------------------------------------------------//
-Tarski_Instantiator::Tarski_Instantiator() {}
+Tarski_Instantiator::Tarski_Instantiator() : m_next_action_id(0), m_num_threads(0) {}
 // ############################################################################//
 
 //---- Constructor
@@ -826,6 +864,7 @@ Tarski_Instantiator::Tarski_Instantiator(STRIPS_Interface *strips_problem)
 {
     m_task = strips_problem;
     m_next_action_id = 0;
+    m_num_threads = 0;
 }
 // ############################################################################//
 
@@ -843,6 +882,7 @@ Tarski_Instantiator::Tarski_Instantiator(STRIPS_Interface *task,
 {
     m_task = task;
     m_next_action_id = 0;
+    m_num_threads = 0;
 
     // notify atoms to task
     add_fluents(fluent);
@@ -883,6 +923,8 @@ void Tarski_Instantiator::add_init(py::list &init)
         std::string atom(init[i].cast<std::string>());
         m_init.push_back(atom);
     }
+    m_sorted_init = m_init;
+    std::sort(m_sorted_init.begin(), m_sorted_init.end());
 }
 // ############################################################################//
 
@@ -916,7 +958,12 @@ void Tarski_Instantiator::set_init()
 void Tarski_Instantiator::add_goal(Formula &goal)
 {
     std::map<Identifier, std::string> var_map;
-    m_goal = goal.instantiate(var_map, m_init, m_fluent, m_task);
+    std::vector<unsigned> negated;
+    m_goal = goal.instantiate(var_map, m_sorted_init, m_fluent, negated);
+    for (auto index : negated)
+    {
+        m_task->notify_negated_atom(index);
+    }
 }
 // ############################################################################//
 
@@ -959,7 +1006,80 @@ void Tarski_Instantiator::instantiate_action(tarski::Action &action,
     {
         py::tuple x = reachable_params[i];
         action.instantiate(m_task, x, m_next_action_id,
-                           m_fluent, m_init, m_fval);
+                           m_fluent, m_sorted_init, m_fval);
+    }
+}
+// ############################################################################//
+
+//---- Instantiate several action schemas in parallel and push to STRIPS_Problem
+//==== Arguments ====//
+//---- 1. actions: Python list of Action objects to be instantiated
+//---- 2. reachable_params: Python list, for each action, of its parameters
+//---- NOTE - actions are added to the task in the same order, and with the
+//----        same ids, as calling instantiate_action on each schema in turn
+//----------------------------------------------------------------------------//
+void Tarski_Instantiator::instantiate_actions(py::list &actions,
+                                              py::list &reachable_params)
+{
+    // work items are chunks of parameter tuples of a single schema
+    struct Chunk
+    {
+        size_t schema;
+        size_t begin, end;
+    };
+    const size_t chunk_size = 64;
+
+    assert(py::len(actions) == py::len(reachable_params));
+    std::vector<Action *> schemas(py::len(actions));
+    std::vector<std::vector<std::vector<std::string>>> params(py::len(actions));
+    std::vector<Chunk> chunks;
+    for (size_t i = 0; i < schemas.size(); i++)
+    {
+        schemas[i] = &actions[i].cast<Action &>();
+        py::list p = reachable_params[i];
+        params[i].reserve(py::len(p));
+        for (size_t j = 0; j < py::len(p); j++)
+        {
+            py::tuple x = p[j];
+            std::vector<std::string> v(py::len(x));
+            for (size_t k = 0; k < v.size(); k++)
+            {
+                v[k] = x[k].cast<std::string>();
+            }
+            params[i].push_back(std::move(v));
+        }
+        for (size_t j = 0; j < params[i].size(); j += chunk_size)
+        {
+            chunks.push_back({i, j, std::min(j + chunk_size, params[i].size())});
+        }
+    }
+
+    // ground without the GIL, only reading the fluent/init/function maps
+    std::vector<std::vector<Ground_Action>> grounded(chunks.size());
+    {
+        py::gil_scoped_release release;
+        aptk::Thread_Pool::global().parallel_for(
+            0, chunks.size(),
+            [&](size_t c)
+            {
+                const Chunk &ch = chunks[c];
+                grounded[c].resize(ch.end - ch.begin);
+                for (size_t j = ch.begin; j < ch.end; j++)
+                {
+                    schemas[ch.schema]->ground(params[ch.schema][j], m_fluent, m_sorted_init,
+                                               m_fval, grounded[c][j - ch.begin]);
+                }
+            },
+            1, m_num_threads);
+    }
+
+    // commit in the sequential order
+    for (auto &g : grounded)
+    {
+        for (auto &a : g)
+        {
+            a.commit(m_task, m_next_action_id);
+        }
     }
 }
 // ############################################################################//
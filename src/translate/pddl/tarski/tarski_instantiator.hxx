@@ -78,6 +78,7 @@ namespace tarski
         Atom(std::string symbol, std::vector<Identifier> &subterms);
         std::string instantiate(std::map<Identifier,
                                          std::string> &var_map);
+        // init must be sorted, it is searched with binary search
         std::pair<int, bool> compile(std::map<Identifier,
                                               std::string> &var_map,
                                      std::vector<std::string> &init,
@@ -108,13 +109,13 @@ namespace tarski
                               std::pair<int, bool>>>,
                           bool> (Formula::*functionpointer)(
             std::map<Identifier, std::string> &, std::vector<std::string> &,
-            std::map<std::string, int> &, STRIPS_Interface *);
+            std::map<std::string, int> &, std::vector<unsigned> &);
         // Typedef function for compilation methods
         typedef std::pair<std::vector<std::vector<
                               std::pair<int, bool>>>,
                           bool>(func)(
             std::map<Identifier, std::string> &, std::vector<std::string> &,
-            std::map<std::string, int> &, STRIPS_Interface *);
+            std::map<std::string, int> &, std::vector<unsigned> &);
         // Compilation methods for each fo the connectives
         func process_not;
         func process_and;
@@ -122,7 +123,9 @@ namespace tarski
         func process_tautology;
         func process_contradiction;
 
-        // Anu - Pass task object to notify neg_atoms on the fly
+        // Atoms met under a negation are appended to negated, in order, so
+        // the caller can notify the task. Instantiation itself only reads
+        // shared data and can run on several threads at once
         std::pair<std::vector<std::vector<
                       std::pair<int, bool>>>,
                   bool>
@@ -130,7 +133,7 @@ namespace tarski
             std::map<Identifier, std::string> &var_map,
             std::vector<std::string> &init,
             std::map<std::string, int> &fluent,
-            STRIPS_Interface *out_task);
+            std::vector<unsigned> &negated);
         std::string publish();
         // Anu - TODO - Figure out the root cause of error in this.
         /*
@@ -148,6 +151,25 @@ namespace tarski
         std::vector<Formula> m_subformula;
     };
 
+    // Result of grounding an action schema with one parameter tuple,
+    // waiting to be pushed to the task
+    struct Ground_Action
+    {
+        std::string name;
+        std::vector<unsigned> negated; // atoms to notify as negated, in the order met
+        bool add;                      // false if the precondition is false or there are no effects
+        bool pre_true;
+        std::vector<std::vector<std::pair<int, bool>>> pre; // one action per disjunct
+        std::vector<std::pair<int, bool>> effect;
+        std::vector<std::pair<
+            std::vector<std::pair<int, bool>>,
+            std::vector<std::pair<int, bool>>>>
+            c_effect;
+        float cost;
+
+        void commit(STRIPS_Interface *out_task, long &next_action_id);
+    };
+
     class Action
     {
     public:
@@ -157,6 +179,10 @@ namespace tarski
         // Anu- no need to return anything - send everything to out_task
         void instantiate(STRIPS_Interface *out_task, py::tuple &params, long &next_action_id, std::map<std::string, int> &fluent, std::vector<std::string> &init,
                          std::map<std::string, float> &fval);
+        // Thread-safe part of instantiate(), does not touch the task nor Python objects
+        void ground(const std::vector<std::string> &params, std::map<std::string, int> &fluent,
+                    std::vector<std::string> &init, const std::map<std::string, float> &fval,
+                    Ground_Action &out);
         std::string m_name;
         std::string publish();
 
@@ -175,6 +201,7 @@ namespace tarski
     public:
         // public variables
         long m_next_action_id;
+        unsigned m_num_threads; // for instantiate_actions(), 0 means one per core
         // Constructors
         Tarski_Instantiator();
         Tarski_Instantiator(STRIPS_Interface *strips_problem);
@@ -190,11 +217,14 @@ namespace tarski
         void add_functions(py::list &func);
         void instantiate_action(tarski::Action &action,
                                 py::list &reachable_params);
+        void instantiate_actions(py::list &actions,
+                                 py::list &reachable_params);
         void finalize_actions();
 
     private:
         STRIPS_Interface *m_task;            // STRIPS problem instance
         std::vector<std::string> m_init;     // init state atoms
+        std::vector<std::string> m_sorted_init; // same, sorted for lookups
         std::map<std::string, int> m_fluent; // grounded state vars
         std::map<std::string, float> m_fval; // function vals
         std::pair<std::vector<
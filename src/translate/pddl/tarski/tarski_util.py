@@ -157,7 +157,7 @@ def convert_to_TI_formula( formula) :
 #xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx#
 
 #-----------------------------------------------------------------------------#
-def ground_generate_task( domain_file, problem_file, out_task) :
+def ground_generate_task( domain_file, problem_file, out_task, num_threads=0) :
     """
     Uses Tarski Grounder to generate the output task using pddl
 
@@ -166,6 +166,7 @@ def ground_generate_task( domain_file, problem_file, out_task) :
     domain_file  : domain pddl file location
     problem_file : problem pddl file location
     output_task  : C++ container to store/process domain and problem
+    num_threads  : threads grounding the action schemas, 0 means one per core
 
     Returns
     =======
@@ -203,6 +204,7 @@ def ground_generate_task( domain_file, problem_file, out_task) :
     # A C++ based instantiator for Tarski
     with time_taken("instantiating") :
         instantiator    =   Tarski_Instantiator( out_task)
+        instantiator.num_threads = num_threads
     # Add grounded fluents to out_task
     #with time_taken("adding fluents") :
         fluent_sorted = [str(f) for f in fluents]
@@ -214,6 +216,9 @@ def ground_generate_task( domain_file, problem_file, out_task) :
         instantiator.add_goal(convert_to_TI_formula( problem.goal))
         instantiator.add_functions(problem.fvals)
     #with time_taken('encoding and adding actions') :
+        # Schemas are ground together, in parallel, once all are encoded.
+        # t_pres keeps the precondition formulas alive till then
+        t_actions, t_pres, t_params = [], [], []
         for name, action in problem.actions.items() :
             t_pre   =   convert_to_TI_formula( action.precondition)
             param_list = list( reachable_action_params[action.name])
@@ -253,7 +258,10 @@ def ground_generate_task( domain_file, problem_file, out_task) :
                 if isinstance(p, Variable) else TI_Identifier('c', 
                     term.symbol) for p in action.parameters],
              t_pre, effect_list, cost)
-            instantiator.instantiate_action( t_action, param_list)
+            t_actions.append( t_action)
+            t_pres.append( t_pre)
+            t_params.append( param_list)
+        instantiator.instantiate_actions( t_actions, t_params)
         # finalize_actions Must be called after ALL actions are pushed to task
         # This adds neg_atoms to all Fluent_set(Bit_set) objects in actions
         instantiator.finalize_actions()
@@ -513,3 +521,155 @@ def term_substitution(language, phi, substitution, inplace=False):
     phi = visit(phi, substitution)
     return phi
 #xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx#
+
+#-----------------------------------------------------------------------------#
+def lifted_generate_task( domain_file, problem_file, out_task) :
+    """
+    Loads the action schemas into the output task without grounding them,
+    the lifted planners instantiate actions as search reaches them.
+    Only conjunctive preconditions and goals over (possibly negated) atoms
+    and unconditional effects are supported
+
+    Arguments
+    =========
+    domain_file  : domain pddl file location
+    problem_file : problem pddl file location
+    output_task  : C++ Lifted_Interface container
+
+    Returns
+    =======
+    None
+    """
+
+    parsing_timer   =   time.process_time()
+    with time_taken( "reading and parsing pddl file") :
+        reader = FstripsReader( raise_on_error=True, theories=None)
+        problem = reader.read_problem( domain_file, problem_file)
+
+    with time_taken( "preprocessing tarski problem") :
+        process_problem( problem)
+        out_task.set_domain_name( problem.domain_name)
+        out_task.set_problem_name( problem.name)
+
+    with time_taken( "encoding lifted task") :
+        objects = {}
+        for c in sorted( problem.language.constants(), key=lambda x: str(x.symbol)) :
+            objects[str(c.symbol)] = out_task.add_object( str(c.symbol))
+        # '=' is kept as a static predicate over the objects
+        predicates = { '=' : out_task.add_predicate( '=', 2) }
+        for o in objects.values() :
+            out_task.add_init( predicates['='], [ o, o])
+        for p in problem.language.predicates :
+            if isinstance( p.symbol, BuiltinPredicateSymbol) :
+                continue
+            predicates[str(p.symbol)] = out_task.add_predicate(
+                str(p.symbol), p.arity)
+
+        def encode( atom, params) :
+            terms = []
+            for t in atom.subterms :
+                if isinstance( t, Variable) :
+                    terms.append( -(params[t.symbol]+1))
+                else :
+                    terms.append( objects[str(t.symbol)])
+            return ( predicates[_lifted_predicate( atom)], terms)
+
+        for name, action in problem.actions.items() :
+            params = { p.symbol : i for i, p in enumerate( action.parameters)}
+            domains = [ sorted( objects[str(c.symbol)] for c in p.sort.domain())
+                for p in action.parameters]
+            pre, neg_pre = _lifted_literals( action.precondition)
+            add, dele = [], []
+            for effect in action.effects :
+                if not isinstance( effect.condition, Tautology) :
+                    raise TransformationError( "lifted task", effect,
+                        "Conditional effects are not supported")
+                if isinstance( effect, AddEffect) :
+                    add.append( encode( effect.atom, params))
+                elif isinstance( effect, DelEffect) :
+                    dele.append( encode( effect.atom, params))
+                else :
+                    raise TransformationError( "lifted task", effect,
+                        "Effect type can't be handled!")
+            if isinstance( action.cost, Constant) :
+                cost = float( action.cost.symbol)
+            elif isinstance( action.cost, CompoundTerm) :
+                if not out_task.ignore_action_costs :
+                    raise TransformationError( "lifted task", action.cost,
+                        "Action costs given by functions are not supported")
+                cost = DEFAULTCOST
+            else :
+                cost = float( action.cost)
+            out_task.add_schema( name, [ str(p.symbol) for p in action.parameters],
+                domains, [ encode( a, params) for a in pre],
+                [ encode( a, params) for a in neg_pre],
+                add, dele, cost)
+
+        for atom in problem.init_bk.keys() :
+            pred, terms = encode( atom, {})
+            out_task.add_init( pred, terms)
+        goal, neg_goal = _lifted_literals( problem.goal)
+        if neg_goal :
+            raise TransformationError( "lifted task", problem.goal,
+                "Negated goals are not supported")
+        for atom in goal :
+            pred, terms = encode( atom, {})
+            out_task.add_goal( pred, terms)
+
+    out_task.parsing_time = time.process_time() - parsing_timer
+    return 0
+#xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx#
+
+#-----------------------------------------------------------------------------#
+def _lifted_predicate( atom) :
+    """
+    Name of the predicate of an atom, builtin (in)equality is mapped to '='
+    """
+    if isinstance( atom.symbol.symbol, BuiltinPredicateSymbol) :
+        if atom.symbol.symbol not in ( BuiltinPredicateSymbol.EQ,
+                BuiltinPredicateSymbol.NE) :
+            raise TransformationError( "lifted task", atom,
+                "Builtin predicate '{}' is not supported".format( atom.symbol))
+        return '='
+    return str(atom.symbol.symbol)
+#xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx#
+
+#-----------------------------------------------------------------------------#
+def _lifted_literals( formula) :
+    """
+    Splits a conjunction of literals into its positive and negative atoms
+
+    Arguments
+    =========
+    formula: Atom, Tautology or CompoundFormula
+
+    Returns
+    =======
+    pos: list of atoms
+    neg: list of negated atoms
+    """
+    pos, neg = [], []
+    stack = [ formula]
+    while stack :
+        f = stack.pop()
+        if isinstance( f, Tautology) :
+            continue
+        elif isinstance( f, Atom) :
+            # x != y is the negation of the '=' atom
+            if f.symbol.symbol == BuiltinPredicateSymbol.NE :
+                neg.append( f)
+            else :
+                pos.append( f)
+        elif isinstance( f, CompoundFormula) and f.connective == Connective.And :
+            stack += reversed( f.subformulas)
+        elif isinstance( f, CompoundFormula) and f.connective == Connective.Not \
+                and isinstance( f.subformulas[0], Atom) :
+            if f.subformulas[0].symbol.symbol == BuiltinPredicateSymbol.NE :
+                pos.append( f.subformulas[0])
+            else :
+                neg.append( f.subformulas[0])
+        else :
+            raise TransformationError( "lifted task", f,
+                "Only conjunctions of literals are supported")
+    return pos, neg
+#xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx#
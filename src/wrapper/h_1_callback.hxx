@@ -107,19 +107,18 @@ namespace aptk
 			void fetch_relevant_actions(py::dict &relevant_actions)
 			{
 				const STRIPS_Problem &m_strips_model = H1::m_strips_model;
-				std::vector<
-						std::set<unsigned>> &m_relevant_actions = H1::m_relevant_actions;
+				const Index_Vec &m_relevant_offs = H1::m_relevant_offs;
+				const Index_Vec &m_relevant_actions = H1::m_relevant_actions;
 
 				for (unsigned p = 0; p < m_strips_model.num_fluents(); p++)
 				{
 					relevant_actions[py::handle(
 							py::str(m_strips_model.fluents()[p]->signature()))] = py::list();
-					for (std::set<unsigned>::iterator action_it = m_relevant_actions[p].begin();
-							 action_it != m_relevant_actions[p].end(); ++action_it)
+					for (unsigned k = m_relevant_offs[p]; k < m_relevant_offs[p + 1]; k++)
 					{
 						py::list list = relevant_actions[py::handle(py::str(
 								m_strips_model.fluents()[p]->signature()))];
-						list.append(m_strips_model.actions()[*action_it]->signature());
+						list.append(m_strips_model.actions()[m_relevant_actions[k]]->signature());
 					}
 				}
 			}
@@ -161,8 +160,8 @@ namespace aptk
 			{
 				boost::circular_buffer<int> &m_updated = H1::m_updated;
 				Bit_Set &m_already_updated = H1::m_already_updated;
-				std::vector<
-						std::set<unsigned>> &m_relevant_actions = H1::m_relevant_actions;
+				const Index_Vec &m_relevant_offs = H1::m_relevant_offs;
+				const Index_Vec &m_relevant_actions = H1::m_relevant_actions;
 				const STRIPS_Problem &m_strips_model = H1::m_strips_model;
 				std::vector<float> &m_values = H1::m_values;
 
@@ -178,11 +177,10 @@ namespace aptk
 					// int i = it.first();
 					// std::cout << "First action: " << i << std::endl;
 					// while ( i != -1 ) {
-					for (std::set<unsigned>::iterator action_it = m_relevant_actions[p].begin();
-							 action_it != m_relevant_actions[p].end(); ++action_it)
+					for (unsigned k = m_relevant_offs[p]; k < m_relevant_offs[p + 1]; k++)
 					{
 
-						const Action &a = *(m_strips_model.actions()[*action_it]);
+						const Action &a = *(m_strips_model.actions()[m_relevant_actions[k]]);
 
 						float h_pre = H1::eval_func(
 								a.prec_vec().begin(), a.prec_vec().end());
@@ -191,7 +189,7 @@ namespace aptk
 							continue;
 						// assert( h_pre != infty );
 
-						// std::cout << "Action " << *action_it << ". " << a.signature() << " relevant cost " << a.cost() << std::endl;
+						// std::cout << "Action " << m_relevant_actions[k] << ". " << a.signature() << " relevant cost " << a.cost() << std::endl;
 
 						float v = (cost_opt == H1_Cost_Function::Ignore_Costs ? 1.0f + h_pre : (cost_opt == H1_Cost_Function::Use_Costs ? (float)a.cost() + h_pre : 1.0f + (float)a.cost() + h_pre));
 
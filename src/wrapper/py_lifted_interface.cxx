@@ -0,0 +1,110 @@
+#include <py_lifted_interface.hxx>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+Lifted_Interface::Lifted_Interface()
+{
+	m_parsing_time = 0.0f;
+	m_ignore_action_costs = false;
+	m_problem = new aptk::Lifted_Problem;
+}
+
+Lifted_Interface::Lifted_Interface(std::string domain, std::string instance)
+{
+	m_parsing_time = 0.0f;
+	m_ignore_action_costs = false;
+	m_problem = new aptk::Lifted_Problem(domain, instance);
+}
+
+Lifted_Interface::~Lifted_Interface()
+{
+	delete m_problem;
+}
+
+unsigned Lifted_Interface::add_object(std::string name)
+{
+	return m_problem->add_object(name);
+}
+
+unsigned Lifted_Interface::add_predicate(std::string name, unsigned arity)
+{
+	return m_problem->add_predicate(name, arity);
+}
+
+std::vector<unsigned> Lifted_Interface::object_list(py::list objects)
+{
+	std::vector<unsigned> v;
+	for (size_t i = 0; i < py::len(objects); i++)
+		v.push_back(objects[i].cast<unsigned>());
+	return v;
+}
+
+aptk::Lifted_Atom Lifted_Interface::make_atom(py::tuple t)
+{
+	aptk::Lifted_Atom a;
+	a.predicate = t[0].cast<unsigned>();
+	py::list terms = t[1].cast<py::list>();
+	for (size_t i = 0; i < py::len(terms); i++)
+		a.args.push_back(terms[i].cast<int>());
+	return a;
+}
+
+unsigned Lifted_Interface::add_schema(std::string name, py::list &params, py::list &domains,
+																			py::list &pre, py::list &neg_pre, py::list &add, py::list &del, float cost)
+{
+	aptk::Action_Schema schema;
+	schema.name = name;
+	for (size_t i = 0; i < py::len(params); i++)
+		schema.params.push_back(params[i].cast<std::string>());
+	for (size_t i = 0; i < py::len(domains); i++)
+		schema.domains.push_back(object_list(domains[i].cast<py::list>()));
+	for (size_t i = 0; i < py::len(pre); i++)
+		schema.pre.push_back(make_atom(pre[i]));
+	for (size_t i = 0; i < py::len(neg_pre); i++)
+		schema.neg_pre.push_back(make_atom(neg_pre[i]));
+	for (size_t i = 0; i < py::len(add); i++)
+		schema.add.push_back(make_atom(add[i]));
+	for (size_t i = 0; i < py::len(del); i++)
+		schema.del.push_back(make_atom(del[i]));
+	// same clamping as STRIPS_Interface::set_cost()
+	const float min_action_cost = 1e-3;
+	schema.cost = m_ignore_action_costs ? 1.0f : std::max(cost, min_action_cost);
+	return m_problem->add_schema(schema);
+}
+
+void Lifted_Interface::add_init(unsigned predicate, py::list &args)
+{
+	m_problem->add_init(predicate, object_list(args));
+}
+
+void Lifted_Interface::add_goal(unsigned predicate, py::list &args)
+{
+	m_problem->add_goal(predicate, object_list(args));
+}
+
+void Lifted_Interface::set_domain_name(std::string name)
+{
+	m_problem->set_domain_name(name);
+}
+
+void Lifted_Interface::set_problem_name(std::string name)
+{
+	m_problem->set_problem_name(name);
+}
+
+std::string Lifted_Interface::get_domain_name()
+{
+	return m_problem->domain_name();
+}
+
+std::string Lifted_Interface::get_problem_name()
+{
+	return m_problem->problem_name();
+}
+
+void Lifted_Interface::setup(bool gen_match_tree)
+{
+	if (!m_problem->finalize())
+		throw std::invalid_argument("Lifted task: " + m_problem->error());
+}
@@ -0,0 +1,79 @@
+/**
+ * @file py_lifted_interface.hxx
+ * @brief Python side of Lifted_Problem, for tasks that are not grounded
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files
+  (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so, subject
+  to the following conditions:
+
+  The above copyright notice and this permission notice shall be included
+  in all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __PY_LIFTED_PROBLEM__
+#define __PY_LIFTED_PROBLEM__
+
+#include <lifted_prob.hxx>
+#include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+// Counterpart of STRIPS_Interface for planners searching the lifted task.
+// Atoms are (predicate, [terms]) tuples, where a term is an object index,
+// or -(i+1) for parameter i of the schema
+class PYBIND11_EXPORT Lifted_Interface
+{
+public:
+	Lifted_Interface();
+	Lifted_Interface(std::string, std::string);
+	virtual ~Lifted_Interface();
+
+	aptk::Lifted_Problem *instance() { return m_problem; }
+
+	unsigned add_object(std::string name);
+	unsigned add_predicate(std::string name, unsigned arity);
+	// domains has one list of objects per parameter, empty for any object
+	unsigned add_schema(std::string name, py::list &params, py::list &domains,
+											py::list &pre, py::list &neg_pre, py::list &add, py::list &del, float cost);
+	void add_init(unsigned predicate, py::list &args);
+	void add_goal(unsigned predicate, py::list &args);
+	void set_domain_name(std::string name);
+	void set_problem_name(std::string name);
+	std::string get_domain_name();
+	std::string get_problem_name();
+
+	unsigned n_atoms() { return m_problem->num_fluents(); }
+	unsigned n_actions() { return m_problem->num_actions(); }
+
+	// Checks and indexes the task, call once it is complete
+	virtual void setup(bool gen_match_tree = true);
+
+	float m_parsing_time;
+	bool m_ignore_action_costs;
+
+protected:
+	aptk::Lifted_Atom make_atom(py::tuple atom);
+	std::vector<unsigned> object_list(py::list objects);
+
+	aptk::Lifted_Problem *m_problem;
+};
+
+#endif // py_lifted_interface.hxx
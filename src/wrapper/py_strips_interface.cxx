@@ -1,18 +1,27 @@
 #include <py_strips_interface.hxx>
+#include <strips_image.hxx>
+#include <sas_reader.hxx>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 
 STRIPS_Interface::STRIPS_Interface()
 {
 	m_parsing_time = 0.0f;
 	m_ignore_action_costs = false;
+	m_reduce_task = false;
+	m_packed_states = false;
+	m_adaptive_states = false;
 	m_problem = new aptk::STRIPS_Problem;
 }
 STRIPS_Interface::STRIPS_Interface(std::string domain, std::string instance)
 {
 	m_parsing_time = 0.0f;
 	m_ignore_action_costs = false;
+	m_reduce_task = false;
+	m_packed_states = false;
+	m_adaptive_states = false;
 	m_problem = new aptk::STRIPS_Problem(domain, instance);
 }
 
@@ -79,6 +88,24 @@ void STRIPS_Interface::set_size_negated_fluents(size_t size)
 {
 	m_negated.resize(size, nullptr);
 }
+unsigned STRIPS_Interface::condition_fluent(int fl_idx, bool negated) const
+{
+	if (negated)
+		return m_negated[fl_idx]->index();
+	return fl_idx;
+}
+
+// An effect on an atom with a negated counterpart also sets the complement
+void STRIPS_Interface::split_effect(int fl_idx, bool negated,
+																		aptk::Fluent_Vec &add, aptk::Fluent_Vec &del) const
+{
+	aptk::Fluent_Vec &pos = negated ? del : add;
+	aptk::Fluent_Vec &neg = negated ? add : del;
+	pos.push_back(fl_idx);
+	if ((unsigned)fl_idx < m_negated.size() && m_negated[fl_idx] != nullptr)
+		neg.push_back(m_negated[fl_idx]->index());
+}
+
 // For Py interface
 void STRIPS_Interface::add_precondition(int index, py::list &lits)
 {
@@ -86,11 +113,7 @@ void STRIPS_Interface::add_precondition(int index, py::list &lits)
 	for (int i = 0; i < py::len(lits); i++)
 	{
 		py::tuple li = lits[i];
-		int fl_idx = li[0].cast<int>();
-		bool negated = li[1].cast<bool>();
-
-		if (negated)
-			fl_idx = m_negated[fl_idx]->index();
+		unsigned fl_idx = condition_fluent(li[0].cast<int>(), li[1].cast<bool>());
 		action.prec_vec().push_back(fl_idx);
 		action.prec_set().set(fl_idx);
 		action.prec_varval().push_back(std::make_pair(fl_idx, 0));
@@ -126,42 +149,13 @@ void STRIPS_Interface::add_cond_effect(int index, py::list &cond_lits,
 	for (int i = 0; i < py::len(cond_lits); i++)
 	{
 		py::tuple li = cond_lits[i];
-		int fl_idx = li[0].cast<int>();
-		bool negated = li[1].cast<bool>();
-		if (negated)
-			fl_idx = m_negated[fl_idx]->index();
-
-		cond_fluents.push_back(fl_idx);
+		cond_fluents.push_back(condition_fluent(li[0].cast<int>(), li[1].cast<bool>()));
 	}
 
 	for (int i = 0; i < py::len(eff_lits); i++)
 	{
 		py::tuple li = eff_lits[i];
-
-		int fl_idx = li[0].cast<int>();
-		bool negated = li[1].cast<bool>();
-
-		if (m_negated[fl_idx] == nullptr)
-		{
-			if (negated)
-			{
-				del_fluents.push_back(fl_idx);
-			}
-			else
-			{
-				add_fluents.push_back(fl_idx);
-			}
-			continue;
-		}
-		int neg_fl_idx = m_negated[fl_idx]->index();
-		if (negated)
-		{
-			add_fluents.push_back(neg_fl_idx);
-			del_fluents.push_back(fl_idx);
-			continue;
-		}
-		del_fluents.push_back(neg_fl_idx);
-		add_fluents.push_back(fl_idx);
+		split_effect(li[0].cast<int>(), li[1].cast<bool>(), add_fluents, del_fluents);
 	}
 	aptk::Conditional_Effect *cond_eff =
 			new aptk::Conditional_Effect(*instance());
@@ -228,44 +222,23 @@ void STRIPS_Interface::add_cond_effect(int index,
 void STRIPS_Interface::add_effect(int index, py::list &lits)
 {
 	aptk::Action &action = *(m_problem->actions()[index]);
+	aptk::Fluent_Vec add, del;
 	for (int i = 0; i < py::len(lits); i++)
 	{
 		py::tuple li = lits[i];
-		int fl_idx = li[0].cast<int>();
-		bool negated = li[1].cast<bool>();
-		if (m_negated[fl_idx] == nullptr)
-		{
-			if (negated)
-			{
-				action.del_vec().push_back(fl_idx);
-				action.del_set().set(fl_idx);
-				action.edel_vec().push_back(fl_idx);
-				action.edel_set().set(fl_idx);
-			}
-			else
-			{
-				action.add_vec().push_back(fl_idx);
-				action.add_set().set(fl_idx);
-			}
-			continue;
-		}
-		int neg_fl_idx = m_negated[fl_idx]->index();
-		if (negated)
-		{
-			action.add_vec().push_back(neg_fl_idx);
-			action.add_set().set(neg_fl_idx);
-			action.del_vec().push_back(fl_idx);
-			action.del_set().set(fl_idx);
-			action.edel_vec().push_back(fl_idx);
-			action.edel_set().set(fl_idx);
-			continue;
-		}
-		action.del_vec().push_back(neg_fl_idx);
-		action.del_set().set(neg_fl_idx);
-		action.edel_vec().push_back(neg_fl_idx);
-		action.edel_set().set(neg_fl_idx);
-		action.add_vec().push_back(fl_idx);
-		action.add_set().set(fl_idx);
+		split_effect(li[0].cast<int>(), li[1].cast<bool>(), add, del);
+	}
+	for (auto p : add)
+	{
+		action.add_vec().push_back(p);
+		action.add_set().set(p);
+	}
+	for (auto p : del)
+	{
+		action.del_vec().push_back(p);
+		action.del_set().set(p);
+		action.edel_vec().push_back(p);
+		action.edel_set().set(p);
 	}
 }
 
@@ -382,6 +355,123 @@ void STRIPS_Interface::add_mutex_group(py::list &lits)
 	m_problem->mutexes().add(group);
 }
 
+namespace
+{
+	// Checks a 1-d buffer of 4 byte elements and returns its data
+	template <typename T>
+	const T *buffer_data(const py::buffer_info &info, const char *name, const char *kinds)
+	{
+		if (info.ndim != 1 || info.itemsize != sizeof(T) ||
+				info.format.empty() || std::strchr(kinds, info.format.back()) == nullptr)
+			throw std::invalid_argument(std::string("add_actions: ") + name +
+																	" must be a 1-d array of 4 byte " + kinds);
+		if (info.shape[0] > 0 && info.strides[0] != (py::ssize_t)sizeof(T))
+			throw std::invalid_argument(std::string("add_actions: ") + name + " must be contiguous");
+		return static_cast<const T *>(info.ptr);
+	}
+
+	// Offsets index into lits, one range per row
+	void check_offsets(const uint32_t *offs, size_t n_offs, size_t n_rows, size_t n_lits, const char *name)
+	{
+		if (n_offs != n_rows + 1 || offs[0] != 0 || offs[n_rows] != n_lits)
+			throw std::invalid_argument(std::string("add_actions: bad offsets in ") + name);
+		for (size_t i = 0; i < n_rows; i++)
+			if (offs[i] > offs[i + 1])
+				throw std::invalid_argument(std::string("add_actions: bad offsets in ") + name);
+	}
+}
+
+// Bulk version of add_action() + add_precondition() + add_effect() +
+// add_cond_effect() + set_cost(), the arrays are read in place with the GIL
+// released. Action a has preconditions pre_lits[pre_offs[a]:pre_offs[a+1]],
+// and likewise for effects and the conditional effects ceff_offs[a]..
+// ceff_offs[a+1], each with its own condition and effect literals
+void STRIPS_Interface::add_actions(py::list &names, py::buffer costs,
+																	 py::buffer pre_offs, py::buffer pre_lits,
+																	 py::buffer eff_offs, py::buffer eff_lits,
+																	 py::buffer ceff_offs, py::buffer cond_offs, py::buffer cond_lits,
+																	 py::buffer ceff_eff_offs, py::buffer ceff_eff_lits)
+{
+	size_t n = py::len(names);
+	std::vector<std::string> action_names(n);
+	for (size_t a = 0; a < n; a++)
+		action_names[a] = names[a].cast<std::string>();
+
+	py::buffer_info cost_i = costs.request(), pre_oi = pre_offs.request(), pre_li = pre_lits.request(),
+									eff_oi = eff_offs.request(), eff_li = eff_lits.request(),
+									ceff_oi = ceff_offs.request(), cond_oi = cond_offs.request(),
+									cond_li = cond_lits.request(), ceff_eff_oi = ceff_eff_offs.request(),
+									ceff_eff_li = ceff_eff_lits.request();
+
+	const float *cost = buffer_data<float>(cost_i, "costs", "f");
+	const uint32_t *pre_o = buffer_data<uint32_t>(pre_oi, "pre_offs", "iIlL");
+	const uint32_t *pre_l = buffer_data<uint32_t>(pre_li, "pre_lits", "iIlL");
+	const uint32_t *eff_o = buffer_data<uint32_t>(eff_oi, "eff_offs", "iIlL");
+	const uint32_t *eff_l = buffer_data<uint32_t>(eff_li, "eff_lits", "iIlL");
+	const uint32_t *ceff_o = buffer_data<uint32_t>(ceff_oi, "ceff_offs", "iIlL");
+	const uint32_t *cond_o = buffer_data<uint32_t>(cond_oi, "cond_offs", "iIlL");
+	const uint32_t *cond_l = buffer_data<uint32_t>(cond_li, "cond_lits", "iIlL");
+	const uint32_t *ceff_eff_o = buffer_data<uint32_t>(ceff_eff_oi, "ceff_eff_offs", "iIlL");
+	const uint32_t *ceff_eff_l = buffer_data<uint32_t>(ceff_eff_li, "ceff_eff_lits", "iIlL");
+
+	if ((size_t)cost_i.size != n)
+		throw std::invalid_argument("add_actions: costs must have one entry per action");
+	size_t n_ceffs = cond_oi.size > 0 ? cond_oi.size - 1 : 0;
+	check_offsets(pre_o, pre_oi.size, n, pre_li.size, "pre_offs");
+	check_offsets(eff_o, eff_oi.size, n, eff_li.size, "eff_offs");
+	check_offsets(ceff_o, ceff_oi.size, n, n_ceffs, "ceff_offs");
+	check_offsets(cond_o, cond_oi.size, n_ceffs, cond_li.size, "cond_offs");
+	check_offsets(ceff_eff_o, ceff_eff_oi.size, n_ceffs, ceff_eff_li.size, "ceff_eff_offs");
+
+	// literals must name known atoms, negated ones also a negated fluent
+	size_t n_atoms = m_negated.empty() ? instance()->num_fluents() : m_negated.size();
+	auto check_lits = [&](const uint32_t *lits, size_t count, bool is_condition, const char *name)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			uint32_t fl = lits[i] >> 1;
+			if (fl >= n_atoms || (is_condition && (lits[i] & 1) &&
+												(fl >= m_negated.size() || m_negated[fl] == nullptr)))
+				throw std::invalid_argument(std::string("add_actions: bad literal in ") + name);
+		}
+	};
+	check_lits(pre_l, pre_li.size, true, "pre_lits");
+	check_lits(eff_l, eff_li.size, false, "eff_lits");
+	check_lits(cond_l, cond_li.size, true, "cond_lits");
+	check_lits(ceff_eff_l, ceff_eff_li.size, false, "ceff_eff_lits");
+
+	py::gil_scoped_release release;
+	aptk::Fluent_Vec pre, add, del, cond;
+	for (size_t a = 0; a < n; a++)
+	{
+		pre.clear();
+		add.clear();
+		del.clear();
+		for (uint32_t i = pre_o[a]; i < pre_o[a + 1]; i++)
+			pre.push_back(condition_fluent(pre_l[i] >> 1, pre_l[i] & 1));
+		for (uint32_t i = eff_o[a]; i < eff_o[a + 1]; i++)
+			split_effect(eff_l[i] >> 1, eff_l[i] & 1, add, del);
+
+		aptk::Conditional_Effect_Vec ceffs;
+		for (uint32_t c = ceff_o[a]; c < ceff_o[a + 1]; c++)
+		{
+			aptk::Fluent_Vec c_add, c_del;
+			cond.clear();
+			for (uint32_t i = cond_o[c]; i < cond_o[c + 1]; i++)
+				cond.push_back(condition_fluent(cond_l[i] >> 1, cond_l[i] & 1));
+			for (uint32_t i = ceff_eff_o[c]; i < ceff_eff_o[c + 1]; i++)
+				split_effect(ceff_eff_l[i] >> 1, ceff_eff_l[i] & 1, c_add, c_del);
+			aptk::Conditional_Effect *cond_eff = new aptk::Conditional_Effect(*instance());
+			cond_eff->define(cond, c_add, c_del);
+			ceffs.push_back(cond_eff);
+		}
+
+		unsigned index = aptk::STRIPS_Problem::add_action(*instance(), action_names[a],
+																											pre, add, del, ceffs, 1.0f);
+		set_cost(index, cost[a]);
+	}
+}
+
 void STRIPS_Interface::set_cost(int index, float c)
 {
 	aptk::Action &action = *(m_problem->actions()[index]);
@@ -522,10 +612,61 @@ void STRIPS_Interface::write_ground_pddl(std::string domain, std::string problem
 	*/
 }
 
+bool STRIPS_Interface::write_task_image(std::string path)
+{
+	return aptk::STRIPS_Image::write(*instance(), path);
+}
+
+// Replaces grounding: fills the (empty) task from an image written by
+// write_task_image(). Negated fluents are already part of the image
+bool STRIPS_Interface::load_task_image(std::string path)
+{
+	aptk::STRIPS_Image image;
+	if (!image.open(path))
+		return false;
+	image.load(*instance());
+	m_negated.assign(instance()->num_fluents(), nullptr);
+	return true;
+}
+
+// Fills the (empty) task from the SAS+ file written by the FD translator,
+// without going through Python for every atom and action
+bool STRIPS_Interface::load_sas(std::string path)
+{
+	aptk::SAS_Reader reader;
+	if (!reader.read(path, *instance()))
+	{
+		std::cout << "Error reading " << path << ": " << reader.error() << std::endl;
+		return false;
+	}
+	// same cost handling as actions added one by one
+	for (unsigned a = 0; a < instance()->num_actions(); a++)
+		set_cost(a, instance()->actions()[a]->cost());
+	m_negated.assign(instance()->num_fluents(), nullptr);
+	m_sas_variables = reader.variables();
+	return true;
+}
+
+// Fluents may be removed, so negated fluents of the front end no longer
+// map to anything, as after load_task_image()
+bool STRIPS_Interface::compute_h2_mutexes(float time_budget)
+{
+	if (!instance()->compute_h2_mutexes(time_budget))
+		return false;
+	m_negated.assign(instance()->num_fluents(), nullptr);
+	m_sas_variables.clear();
+	return true;
+}
+
 void STRIPS_Interface::setup(bool gen_match_table)
 {
+	instance()->set_reduce_task(m_reduce_task);
+	instance()->set_packed_states(m_packed_states);
+	instance()->set_adaptive_states(m_adaptive_states);
 	instance()->make_action_tables(gen_match_table);
 	instance()->make_effect_tables();
+	if (m_reduce_task)
+		m_sas_variables.clear();
 }
 
 void STRIPS_Interface::print_fluents()
@@ -34,6 +34,7 @@
 #include <strips_prob.hxx>
 #include <fluent.hxx>
 #include <action.hxx>
+#include <sas_reader.hxx>
 #include <pybind11/pybind11.h>
 #include <string>
 #include <set>
@@ -75,6 +76,14 @@ public:
 	// For FD
 	void add_effect(int index, py::list &list);
 	void set_cost(int index, float v);
+	// Builds many actions in one call, from 1-d buffers (numpy arrays,
+	// array.array, ...). Literals are uint32 2*fluent+negated, offsets are
+	// uint32 CSR offsets and costs float32. Effect literals follow add_effect()
+	void add_actions(py::list &names, py::buffer costs,
+									 py::buffer pre_offs, py::buffer pre_lits,
+									 py::buffer eff_offs, py::buffer eff_lits,
+									 py::buffer ceff_offs, py::buffer cond_offs, py::buffer cond_lits,
+									 py::buffer ceff_eff_offs, py::buffer ceff_eff_lits);
 	void finalize_actions();
 
 	virtual void add_mutex_group(py::list &list);
@@ -113,14 +122,37 @@ public:
 	size_t n_actions() const { return m_problem->num_actions(); }
 
 	void write_ground_pddl(std::string domain, std::string instance);
+	// Binary task images, see STRIPS_Image
+	bool write_task_image(std::string path);
+	bool load_task_image(std::string path);
+	// Fast Downward translator output (output.sas), see SAS_Reader
+	bool load_sas(std::string path);
+	// Finite-domain variables of the task loaded by load_sas(), empty for
+	// other front ends and once fluents are removed
+	const std::vector<aptk::SAS_Reader::Variable> &sas_variables() const { return m_sas_variables; }
+	// h^2 mutex preprocessing of the grounded task, before setup() and
+	// before the task is cached, see STRIPS_Problem::compute_h2_mutexes()
+	bool compute_h2_mutexes(float time_budget);
 
 	float m_parsing_time;
 	bool m_ignore_action_costs;
+	// Drop unreachable and irrelevant fluents and actions in setup()
+	bool m_reduce_task;
+	// Pack the states of closed nodes into finite-domain variables
+	bool m_packed_states;
+	// Pick sparse or dense states from sampled state sizes
+	bool m_adaptive_states;
 
 protected:
+	// Literal handling of the FD interface, negated literals map to the
+	// fluents made by create_negated_fluents()
+	unsigned condition_fluent(int fl_idx, bool negated) const;
+	void split_effect(int fl_idx, bool negated, aptk::Fluent_Vec &add, aptk::Fluent_Vec &del) const;
+
 	aptk::STRIPS_Problem *m_problem;
 	std::set<int> m_negated_conditions;
 	aptk::Fluent_Ptr_Vec m_negated;
+	std::vector<aptk::SAS_Reader::Variable> m_sas_variables;
 };
 
 #endif // py_strips_problem.hxx
@@ -28,6 +28,7 @@
  */
 
 #include <py_strips_interface.hxx>
+#include <py_lifted_interface.hxx>
 #include <h_1.hxx>
 #include <h_1_callback.hxx>
 #include <strips_prob.hxx>
@@ -66,6 +67,7 @@ PYBIND11_MODULE(wrapper, m)
         .def("add_cond_effect",
              static_cast<void (STRIPS_Interface::*)(int, py::list &, py::list &)>(&STRIPS_Interface::add_cond_effect))
         .def("set_cost", &STRIPS_Interface::set_cost)
+        .def("add_actions", &STRIPS_Interface::add_actions)
         .def("notify_negated_conditions", &STRIPS_Interface::notify_negated_conditions)
         .def("create_negated_fluents", &STRIPS_Interface::create_negated_fluents)
         .def("set_init",
@@ -79,12 +81,37 @@ PYBIND11_MODULE(wrapper, m)
         .def("set_domain_name", &STRIPS_Interface::set_domain_name)
         .def("set_problem_name", &STRIPS_Interface::set_problem_name)
         .def("write_ground_pddl", &STRIPS_Interface::write_ground_pddl)
+        .def("write_task_image", &STRIPS_Interface::write_task_image)
+        .def("load_task_image", &STRIPS_Interface::load_task_image)
+        .def("load_sas", &STRIPS_Interface::load_sas)
+        .def("compute_h2_mutexes", &STRIPS_Interface::compute_h2_mutexes)
         .def("print_action", &STRIPS_Interface::print_action)
         .def("print_actions", &STRIPS_Interface::print_actions)
         .def("print_fluents", &STRIPS_Interface::print_fluents)
         .def("finalize_actions", &STRIPS_Interface::finalize_actions)
         .def_readwrite("parsing_time", &STRIPS_Interface::m_parsing_time)
-        .def_readwrite("ignore_action_costs", &STRIPS_Interface::m_ignore_action_costs);
+        .def_readwrite("ignore_action_costs", &STRIPS_Interface::m_ignore_action_costs)
+        .def_readwrite("reduce_task", &STRIPS_Interface::m_reduce_task)
+        .def_readwrite("packed_states", &STRIPS_Interface::m_packed_states)
+        .def_readwrite("adaptive_states", &STRIPS_Interface::m_adaptive_states);
+
+    py::class_<Lifted_Interface>(m, "Lifted_Interface")
+        .def(py::init<>())
+        .def(py::init<std::string, std::string>())
+        .def("add_object", &Lifted_Interface::add_object)
+        .def("add_predicate", &Lifted_Interface::add_predicate)
+        .def("add_schema", &Lifted_Interface::add_schema)
+        .def("add_init", &Lifted_Interface::add_init)
+        .def("add_goal", &Lifted_Interface::add_goal)
+        .def("num_atoms", &Lifted_Interface::n_atoms)
+        .def("num_actions", &Lifted_Interface::n_actions)
+        .def("get_domain_name", &Lifted_Interface::get_domain_name)
+        .def("get_problem_name", &Lifted_Interface::get_problem_name)
+        .def("set_domain_name", &Lifted_Interface::set_domain_name)
+        .def("set_problem_name", &Lifted_Interface::set_problem_name)
+        .def("setup", &Lifted_Interface::setup)
+        .def_readwrite("parsing_time", &Lifted_Interface::m_parsing_time)
+        .def_readwrite("ignore_action_costs", &Lifted_Interface::m_ignore_action_costs);
 
     py::class_<aptk::STRIPS_Problem>(m, "STRIPS_Problem")
         .def(py::init<std::string, std::string>());
@@ -0,0 +1,91 @@
+/**
+ * @file chains.cxx
+ * @brief Chains task shared by the landmark tests
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <chains.hxx>
+#include <action.hxx>
+#include <cond_eff.hxx>
+#include <random>
+#include <sstream>
+#include <vector>
+
+void make_chains_problem( aptk::STRIPS_Problem& prob, unsigned chains, unsigned length, unsigned seed, Chain_Moves moves ) {
+
+	const unsigned C = chains, K = length;
+	std::mt19937 rng( seed );
+	std::vector< std::vector< unsigned > > chain( C );
+	for ( unsigned c = 0; c < C; c++ )
+		for ( unsigned i = 0; i < K; i++ ) {
+			std::stringstream buffer;
+			buffer << "(at c" << c << " " << i << ")";
+			chain[c].push_back( aptk::STRIPS_Problem::add_fluent( prob, buffer.str() ) );
+		}
+
+	aptk::Conditional_Effect_Vec no_ceffs;
+	for ( unsigned c = 0; c < C; c++ )
+		for ( unsigned i = 0; i + 1 < K; i++ ) {
+			std::stringstream step;
+			step << "(step c" << c << " " << i << ")";
+			aptk::Fluent_Vec pre( 1, chain[c][i] );
+			if ( c > 0 && rng() % 3 == 0 )
+				pre.push_back( chain[rng() % c][rng() % K] );
+
+			if ( moves == Chain_Moves::Jumps ) {
+				aptk::STRIPS_Problem::add_action( prob, step.str(), pre, { chain[c][i + 1] }, { chain[c][i] }, no_ceffs );
+				if ( i > 0 && rng() % 4 == 0 ) {
+					std::stringstream jump;
+					jump << "(jump c" << c << " " << i << ")";
+					aptk::STRIPS_Problem::add_action( prob, jump.str(), { chain[c][i - 1] }, { chain[c][i + 1] }, { chain[c][i - 1] }, no_ceffs );
+				}
+				continue;
+			}
+
+			aptk::Conditional_Effect_Vec ceffs;
+			if ( i % 2 == 0 ) {
+				unsigned d = ( c + 1 ) % C;
+				aptk::Fluent_Vec ce_pre( 1, chain[d][K - 1] ), ce_add( 1, chain[d][K - 2] ), ce_del( 1, chain[d][K - 1] );
+				aptk::Conditional_Effect* ce = new aptk::Conditional_Effect( prob );
+				ce->define( ce_pre, ce_add, ce_del );
+				ceffs.push_back( ce );
+			}
+			std::stringstream back;
+			back << "(back c" << c << " " << i + 1 << ")";
+			aptk::STRIPS_Problem::add_action( prob, step.str(), pre, { chain[c][i + 1] }, { chain[c][i] }, ceffs );
+			aptk::STRIPS_Problem::add_action( prob, back.str(), { chain[c][i + 1] }, { chain[c][i] }, { chain[c][i + 1] }, no_ceffs );
+		}
+
+	prob.make_action_tables();
+
+	aptk::Fluent_Vec I, G;
+	for ( unsigned c = 0; c < C; c++ ) {
+		I.push_back( chain[c][0] );
+		G.push_back( chain[c][K - 1] );
+	}
+	aptk::STRIPS_Problem::set_init( prob, I );
+	aptk::STRIPS_Problem::set_goal( prob, G );
+}
@@ -0,0 +1,54 @@
+/**
+ * @file chains.hxx
+ * @brief Chains task shared by the landmark tests
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#ifndef __CHAINS__
+#define __CHAINS__
+
+#include <strips_prob.hxx>
+
+// Actions besides the steps along each chain
+enum class Chain_Moves
+{
+	// Jumps over a step, from the fluent before it
+	Jumps,
+	// Steps taken back, and every other step knocks the next chain back
+	// from its goal through a conditional effect
+	Back_And_Knock
+};
+
+/**
+ * @brief Chains of fluents where each step needs the previous fluent of
+ * its chain and sometimes a random fluent of an earlier chain, the goal
+ * being the last fluent of every chain. Jumps give some fluents several
+ * achievers, steps back and knocks make landmarks be consumed and
+ * unconsumed in many orders.
+ */
+void make_chains_problem( aptk::STRIPS_Problem& prob, unsigned chains, unsigned length, unsigned seed, Chain_Moves moves = Chain_Moves::Jumps );
+
+#endif // chains.hxx
@@ -0,0 +1,99 @@
+/**
+ * @file visit_corners.cxx
+ * @brief Grid task shared by the search engine tests
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <visit_corners.hxx>
+#include <action.hxx>
+#include <cond_eff.hxx>
+#include <sstream>
+#include <vector>
+
+static bool is_corner( unsigned v, unsigned n ) {
+	return ( v % n == 0 || v % n == n - 1 ) && ( v < n || v >= n * n - n );
+}
+
+void make_visit_corners_problem( aptk::STRIPS_Problem& prob, unsigned n, Visit_Marks marks, bool with_lamp ) {
+
+	std::vector< unsigned > at, visited;
+	for ( unsigned v = 0; v < n * n; v++ ) {
+		std::stringstream at_buffer, visited_buffer;
+		at_buffer << "(at c_" << v / n << "_" << v % n << ")";
+		visited_buffer << "(visited c_" << v / n << "_" << v % n << ")";
+		at.push_back( aptk::STRIPS_Problem::add_fluent( prob, at_buffer.str() ) );
+		visited.push_back( aptk::STRIPS_Problem::add_fluent( prob, visited_buffer.str() ) );
+	}
+	unsigned lamp_on = 0, lamp_off = 0;
+	if ( with_lamp ) {
+		lamp_on = aptk::STRIPS_Problem::add_fluent( prob, "(lamp-on)" );
+		lamp_off = aptk::STRIPS_Problem::add_fluent( prob, "(lamp-off)" );
+	}
+
+	for ( unsigned v = 0; v < n * n; v++ ) {
+		std::vector< unsigned > adj;
+		if ( v % n > 0 ) adj.push_back( v - 1 );
+		if ( v % n + 1 < n ) adj.push_back( v + 1 );
+		if ( v >= n ) adj.push_back( v - n );
+		if ( v + n < n * n ) adj.push_back( v + n );
+		for ( auto w : adj ) {
+			aptk::Fluent_Vec pre, add, del;
+			aptk::Conditional_Effect_Vec ceff;
+			std::stringstream buffer;
+			buffer << "(move " << v << " " << w << ")";
+			pre.push_back( at[v] );
+			add.push_back( at[w] );
+			if ( marks == Visit_Marks::All_Cells || is_corner( w, n ) )
+				add.push_back( visited[w] );
+			del.push_back( at[v] );
+			if ( with_lamp && w % 2 == 0 ) {
+				aptk::Fluent_Vec on_pre( 1, lamp_off ), on_add( 1, lamp_on ), on_del( 1, lamp_off );
+				aptk::Fluent_Vec off_pre( 1, lamp_on ), off_add( 1, lamp_off ), off_del( 1, lamp_on );
+				aptk::Conditional_Effect* on = new aptk::Conditional_Effect( prob );
+				on->define( on_pre, on_add, on_del );
+				aptk::Conditional_Effect* off = new aptk::Conditional_Effect( prob );
+				off->define( off_pre, off_add, off_del );
+				ceff.push_back( on );
+				ceff.push_back( off );
+			}
+			aptk::STRIPS_Problem::add_action( prob, buffer.str(), pre, add, del, ceff );
+		}
+	}
+
+	prob.make_action_tables();
+	prob.compute_edeletes();
+
+	aptk::Fluent_Vec I, G;
+	I.push_back( at[0] );
+	I.push_back( visited[0] );
+	if ( with_lamp )
+		I.push_back( lamp_off );
+	G.push_back( visited[n - 1] );
+	G.push_back( visited[n * n - n] );
+	G.push_back( visited[n * n - 1] );
+	aptk::STRIPS_Problem::set_init( prob, I );
+	aptk::STRIPS_Problem::set_goal( prob, G );
+}
@@ -0,0 +1,52 @@
+/**
+ * @file visit_corners.hxx
+ * @brief Grid task shared by the search engine tests
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#ifndef __VISIT_CORNERS__
+#define __VISIT_CORNERS__
+
+#include <strips_prob.hxx>
+
+// Cells whose (visited) fluent is added when the agent moves into them
+enum class Visit_Marks
+{
+	All_Cells,
+	Corners
+};
+
+/**
+ * @brief An agent in a grid of n x n cells has to visit the four corners,
+ * starting from one of them. Each corner is a separate goal, so the task
+ * serializes into several subproblems. Marking only corners keeps the state
+ * space small enough for complete searches to exhaust it. With the lamp,
+ * moving into an even cell also toggles (lamp-on)/(lamp-off) through two
+ * conditional effects, of which only one fires.
+ */
+void make_visit_corners_problem( aptk::STRIPS_Problem& prob, unsigned n, Visit_Marks marks = Visit_Marks::Corners, bool with_lamp = false );
+
+#endif // visit_corners.hxx
@@ -0,0 +1,156 @@
+/**
+ * @file test_Achieved_Fluents.cxx
+ * @brief Checks that the r(n) BFWS derives from the parent of n matches
+ * the count of relevant fluents achieved on the path to the node that owns
+ * the relaxed plan
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <fwd_search_prob.hxx>
+#include <novelty_partition.hxx>
+#include <landmark_graph.hxx>
+#include <landmark_graph_generator.hxx>
+#include <landmark_graph_manager.hxx>
+#include <landmark_count.hxx>
+#include <h_1.hxx>
+#include <rp_heuristic.hxx>
+#include <open_list.hxx>
+#include <new_node_comparer.hxx>
+#include <bfws_2h.hxx>
+#include <relaxed_plan_cache.hxx>
+#include <visit_corners.hxx>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+
+typedef aptk::agnostic::H1_Heuristic< Fwd_Search_Problem, aptk::agnostic::H_Add_Evaluation_Function > H_Add_Fwd;
+typedef aptk::agnostic::Relaxed_Plan_Heuristic< Fwd_Search_Problem, H_Add_Fwd > H_Add_Rp_Fwd;
+typedef aptk::agnostic::Landmarks_Count_Heuristic< Fwd_Search_Problem > H_Lmcount_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Generator< Fwd_Search_Problem > Gen_Lms_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Manager< Fwd_Search_Problem > Land_Graph_Man;
+
+typedef aptk::search::bfws_2h::Node< Fwd_Search_Problem, aptk::State > Search_Node_2h;
+typedef aptk::agnostic::Novelty_Partition< Fwd_Search_Problem, Search_Node_2h > H_Novel_Fwd_2h;
+typedef aptk::search::Open_List< aptk::search::Node_Comparer_2H_gn_unit< Search_Node_2h >, Search_Node_2h > BFS_Open_List_2h;
+typedef aptk::search::bfws_2h::BFWS_2H< Fwd_Search_Problem, H_Novel_Fwd_2h, H_Lmcount_Fwd, H_Add_Rp_Fwd, BFS_Open_List_2h > k_BFWS;
+
+// Checks r(n) of each node as it is expanded, before BFWS computes its
+// relaxed plan, against the count r(n) was taken as before it was cached
+class Checked_BFWS : public k_BFWS {
+public:
+	Checked_BFWS( const Fwd_Search_Problem& search_prob )
+	: k_BFWS( search_prob, false ), m_checked( 0 ), m_mismatches( 0 ), m_max_r( 0 ) {
+	}
+
+	virtual void process( Search_Node_2h* head ) {
+		unsigned r = walk_path( head );
+		if ( r != head->r() )
+			m_mismatches++;
+		m_checked++;
+		m_max_r = std::max( m_max_r, r );
+		k_BFWS::process( head );
+	}
+
+	unsigned checked() const { return m_checked; }
+	unsigned mismatches() const { return m_mismatches; }
+	unsigned max_r() const { return m_max_r; }
+
+protected:
+
+	unsigned walk_path( Search_Node_2h* n ) {
+		Search_Node_2h* n_start = n;
+		while ( !n_start->relevant_fluents() )
+			n_start = n_start->parent();
+
+		const aptk::Fluent_Set& relevant = n_start->relevant_fluents()->set;
+		std::set< unsigned > counted;
+		for ( ; n->action() != aptk::no_op && n != n_start; n = n->parent() ) {
+			const aptk::Action* a = this->problem().task().actions()[ n->action() ];
+			for ( unsigned i = 0; i < a->ceff_vec().size(); i++ )
+				for ( auto p : a->ceff_vec()[i]->add_vec() )
+					if ( relevant.isset( p ) )
+						counted.insert( p );
+			for ( auto p : a->add_vec() )
+				if ( relevant.isset( p ) )
+					counted.insert( p );
+		}
+		return counted.size();
+	}
+
+	unsigned m_checked;
+	unsigned m_mismatches;
+	unsigned m_max_r;
+};
+
+static void run_checked_bfws( const Fwd_Search_Problem& search_prob, Checked_BFWS& engine, aptk::search::Relaxed_Plan_Cache* cache ) {
+
+	Gen_Lms_Fwd gen_lms( search_prob );
+	aptk::agnostic::Landmarks_Graph graph( search_prob.task() );
+	gen_lms.compute_lm_graph_set_additive( graph );
+	Land_Graph_Man lgm( search_prob, &graph );
+
+	float cost = 0;
+	std::vector< aptk::Action_Idx > plan;
+	engine.set_max_novelty( 2 );
+	engine.use_land_graph_manager( &lgm );
+	engine.set_arity( 2, graph.num_landmarks() * 16 );
+	engine.rel_fl_h().ignore_rp_h_value( true );
+	if ( cache != nullptr )
+		engine.set_relplan_cache( cache );
+	engine.start();
+	REQUIRE( engine.find_solution( cost, plan ) );
+}
+
+TEST_CASE("BFWS r(n) matches the count along the path"){
+
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, 6, Visit_Marks::Corners, true );
+	Fwd_Search_Problem search_prob( &prob );
+
+	SECTION("relaxed plans computed per node") {
+		Checked_BFWS engine( search_prob );
+		run_checked_bfws( search_prob, engine, nullptr );
+		CHECK( engine.checked() > 0 );
+		CHECK( engine.max_r() > 0 );
+		CHECK( engine.mismatches() == 0 );
+	}
+
+	SECTION("relaxed plans shared through a cache") {
+		aptk::search::Relaxed_Plan_Cache cache( 1000 );
+		Checked_BFWS warm( search_prob );
+		run_checked_bfws( search_prob, warm, &cache );
+		Checked_BFWS engine( search_prob );
+		run_checked_bfws( search_prob, engine, &cache );
+		CHECK( cache.hits() > 0 );
+		CHECK( engine.checked() > 0 );
+		CHECK( engine.mismatches() == 0 );
+	}
+}
@@ -0,0 +1,135 @@
+/**
+ * @file test_Delta_State_Store.cxx
+ * @brief Checks that BFWS and RP-IW search the same way when closed states
+ * are stored as deltas against their parent
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <fwd_search_prob.hxx>
+#include <novelty_partition.hxx>
+#include <landmark_graph.hxx>
+#include <landmark_graph_generator.hxx>
+#include <landmark_graph_manager.hxx>
+#include <landmark_count.hxx>
+#include <h_1.hxx>
+#include <rp_heuristic.hxx>
+#include <open_list.hxx>
+#include <new_node_comparer.hxx>
+#include <bfws_2h.hxx>
+#include <rp_iw.hxx>
+#include <visit_corners.hxx>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+
+typedef aptk::agnostic::H1_Heuristic< Fwd_Search_Problem, aptk::agnostic::H_Add_Evaluation_Function > H_Add_Fwd;
+typedef aptk::agnostic::Relaxed_Plan_Heuristic< Fwd_Search_Problem, H_Add_Fwd > H_Add_Rp_Fwd;
+typedef aptk::agnostic::Landmarks_Count_Heuristic< Fwd_Search_Problem > H_Lmcount_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Generator< Fwd_Search_Problem > Gen_Lms_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Manager< Fwd_Search_Problem > Land_Graph_Man;
+
+typedef aptk::search::bfws_2h::Node< Fwd_Search_Problem, aptk::State > Search_Node_2h;
+typedef aptk::agnostic::Novelty_Partition< Fwd_Search_Problem, Search_Node_2h > H_Novel_Fwd_2h;
+typedef aptk::search::Open_List< aptk::search::Node_Comparer_2H_gn_unit< Search_Node_2h >, Search_Node_2h > BFS_Open_List_2h;
+typedef aptk::search::bfws_2h::BFWS_2H< Fwd_Search_Problem, H_Novel_Fwd_2h, H_Lmcount_Fwd, H_Add_Rp_Fwd, BFS_Open_List_2h > k_BFWS;
+
+typedef aptk::search::novelty_spaces::Node< aptk::State > IW_Node;
+typedef aptk::agnostic::Novelty_Partition< Fwd_Search_Problem, IW_Node > H_Novel_Fwd;
+typedef aptk::search::novelty_spaces::RP_IW< Fwd_Search_Problem, H_Novel_Fwd, H_Add_Rp_Fwd > RP_IW_Fwd;
+
+static void run_bfws( const Fwd_Search_Problem& search_prob, unsigned snapshot_interval, std::vector< aptk::Action_Idx >& plan, unsigned& expanded ) {
+
+	Gen_Lms_Fwd gen_lms( search_prob );
+	aptk::agnostic::Landmarks_Graph graph( search_prob.task() );
+	gen_lms.compute_lm_graph_set_additive( graph );
+	Land_Graph_Man lgm( search_prob, &graph );
+
+	float cost = 0;
+	k_BFWS engine( search_prob, false );
+	engine.set_max_novelty( 2 );
+	engine.use_land_graph_manager( &lgm );
+	engine.set_arity( 2, graph.num_landmarks() * 16 );
+	engine.rel_fl_h().ignore_rp_h_value( true );
+	if ( snapshot_interval > 0 )
+		engine.set_delta_states( snapshot_interval, 4 );
+	engine.start();
+	REQUIRE( engine.find_solution( cost, plan ) );
+	expanded = engine.expanded();
+}
+
+static void run_rp_iw( const Fwd_Search_Problem& search_prob, unsigned snapshot_interval, std::vector< aptk::Action_Idx >& plan, unsigned& expanded ) {
+
+	float cost = 0;
+	RP_IW_Fwd engine( search_prob );
+	engine.set_verbose( false );
+	engine.set_bound( 2 );
+	if ( snapshot_interval > 0 )
+		engine.set_delta_states( snapshot_interval, 4 );
+	engine.start();
+	REQUIRE( engine.find_solution( cost, plan ) );
+	expanded = engine.expanded();
+}
+
+TEST_CASE("BFWS finds the same plan with delta encoded closed states"){
+
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, 6, Visit_Marks::Corners, true );
+	Fwd_Search_Problem search_prob( &prob );
+
+	std::vector< aptk::Action_Idx > plan;
+	unsigned expanded = 0;
+	run_bfws( search_prob, 0, plan, expanded );
+
+	for ( unsigned k : { 1u, 2u, 5u } ) {
+		std::vector< aptk::Action_Idx > delta_plan;
+		unsigned delta_expanded = 0;
+		run_bfws( search_prob, k, delta_plan, delta_expanded );
+		CHECK( delta_plan == plan );
+		CHECK( delta_expanded == expanded );
+	}
+}
+
+TEST_CASE("RP-IW finds the same plan with delta encoded closed states"){
+
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, 6, Visit_Marks::Corners, true );
+	Fwd_Search_Problem search_prob( &prob );
+
+	std::vector< aptk::Action_Idx > plan;
+	unsigned expanded = 0;
+	run_rp_iw( search_prob, 0, plan, expanded );
+
+	for ( unsigned k : { 1u, 2u, 5u } ) {
+		std::vector< aptk::Action_Idx > delta_plan;
+		unsigned delta_expanded = 0;
+		run_rp_iw( search_prob, k, delta_plan, delta_expanded );
+		CHECK( delta_plan == plan );
+		CHECK( delta_expanded == expanded );
+	}
+}
@@ -0,0 +1,205 @@
+/**
+ * @file test_Lifted_Width.cxx
+ * @brief Checks join-based successor generation on lifted tasks, and that
+ * the width-based engines solve them without grounding
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <lifted_prob.hxx>
+#include <lifted_search_prob.hxx>
+#include <lifted_width.hxx>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using aptk::Action_Schema;
+using aptk::Lifted_Atom;
+using aptk::Lifted_Problem;
+using aptk::lifted_param;
+using aptk::agnostic::Lifted_Search_Problem;
+
+static Lifted_Atom atom( unsigned p, std::vector<aptk::Lifted_Term> args ) {
+	return Lifted_Atom{ p, args };
+}
+
+/**
+ * @brief Blocksworld with 4-operator encoding, n blocks stacked in one tower
+ * b0 on b1 on ... that has to be reversed, or only its bottom block put on
+ * top when single_goal is set
+ */
+static void make_blocksworld( Lifted_Problem& prob, unsigned n, bool single_goal ) {
+	for ( unsigned i = 0; i < n; i++ )
+		prob.add_object( "b" + std::to_string( i ) );
+	unsigned on = prob.add_predicate( "on", 2 );
+	unsigned ontable = prob.add_predicate( "ontable", 1 );
+	unsigned clear = prob.add_predicate( "clear", 1 );
+	unsigned handempty = prob.add_predicate( "handempty", 0 );
+	unsigned holding = prob.add_predicate( "holding", 1 );
+	aptk::Lifted_Term x = lifted_param( 0 ), y = lifted_param( 1 );
+
+	Action_Schema pick{ "pick-up", { "x" } };
+	pick.pre = { atom( clear, { x } ), atom( ontable, { x } ), atom( handempty, {} ) };
+	pick.add = { atom( holding, { x } ) };
+	pick.del = { atom( clear, { x } ), atom( ontable, { x } ), atom( handempty, {} ) };
+	prob.add_schema( pick );
+
+	Action_Schema put{ "put-down", { "x" } };
+	put.pre = { atom( holding, { x } ) };
+	put.add = { atom( clear, { x } ), atom( ontable, { x } ), atom( handempty, {} ) };
+	put.del = { atom( holding, { x } ) };
+	prob.add_schema( put );
+
+	Action_Schema stack{ "stack", { "x", "y" } };
+	stack.pre = { atom( holding, { x } ), atom( clear, { y } ) };
+	stack.add = { atom( on, { x, y } ), atom( clear, { x } ), atom( handempty, {} ) };
+	stack.del = { atom( holding, { x } ), atom( clear, { y } ) };
+	prob.add_schema( stack );
+
+	Action_Schema unstack{ "unstack", { "x", "y" } };
+	unstack.pre = { atom( on, { x, y } ), atom( clear, { x } ), atom( handempty, {} ) };
+	unstack.add = { atom( holding, { x } ), atom( clear, { y } ) };
+	unstack.del = { atom( on, { x, y } ), atom( clear, { x } ), atom( handempty, {} ) };
+	prob.add_schema( unstack );
+
+	prob.add_init( handempty, {} );
+	prob.add_init( clear, { 0 } );
+	prob.add_init( ontable, { n - 1 } );
+	for ( unsigned i = 0; i + 1 < n; i++ ) {
+		prob.add_init( on, { i, i + 1 } );
+		if ( !single_goal )
+			prob.add_goal( on, { i + 1, i } );
+	}
+	if ( single_goal )
+		prob.add_goal( on, { n - 1, 0 } );
+}
+
+/**
+ * @brief Replays plan from the initial state, checking every action
+ */
+static bool valid_plan( Lifted_Problem& prob, const std::vector<aptk::Action_Idx>& plan ) {
+	aptk::Fluent_Vec s = prob.init(), succ;
+	for ( auto a : plan ) {
+		if ( !prob.is_applicable( s, a ) )
+			return false;
+		prob.progress( s, a, succ );
+		s = succ;
+	}
+	return std::includes( s.begin(), s.end(), prob.goal().begin(), prob.goal().end() );
+}
+
+TEST_CASE( "Lifted successor generation joins preconditions with static relations" ) {
+	// a row of cells, moving right only, into cells that are not blocked
+	Lifted_Problem prob;
+	unsigned n = 6;
+	for ( unsigned i = 0; i < n; i++ )
+		prob.add_object( "c" + std::to_string( i ) );
+	unsigned at = prob.add_predicate( "at", 1 );
+	unsigned right = prob.add_predicate( "right", 2 );
+	unsigned blocked = prob.add_predicate( "blocked", 1 );
+	unsigned visited = prob.add_predicate( "visited", 1 );
+	aptk::Lifted_Term x = lifted_param( 0 ), y = lifted_param( 1 );
+
+	Action_Schema move{ "move", { "from", "to" } };
+	move.pre = { atom( right, { x, y } ), atom( at, { x } ) };
+	move.neg_pre = { atom( blocked, { y } ) };
+	move.add = { atom( at, { y } ), atom( visited, { y } ) };
+	move.del = { atom( at, { x } ) };
+	prob.add_schema( move );
+	// a jump of any length, its target only constrained by its domain
+	Action_Schema jump{ "jump", { "from", "to" } };
+	jump.domains = { {}, { 4, 5 } };
+	jump.pre = { atom( at, { x } ) };
+	jump.add = { atom( at, { y } ) };
+	jump.del = { atom( at, { x } ) };
+	prob.add_schema( jump );
+
+	for ( unsigned i = 0; i + 1 < n; i++ )
+		prob.add_init( right, { i, i + 1 } );
+	prob.add_init( blocked, { 2 } );
+	prob.add_init( at, { 1 } );
+	prob.add_goal( at, { 5 } );
+	REQUIRE( prob.finalize() );
+
+	REQUIRE( prob.is_static( right ) );
+	REQUIRE( prob.is_static( blocked ) );
+	REQUIRE_FALSE( prob.is_static( at ) );
+	// only at(c1) and at(c5) have been seen so far
+	REQUIRE( prob.num_fluents() == 2 );
+
+	std::vector<int> app;
+	prob.applicable_actions( prob.init(), app );
+	std::vector<std::string> names;
+	for ( auto a : app )
+		names.push_back( prob.action_signature( a ) );
+	std::sort( names.begin(), names.end() );
+	// move to c2 is blocked
+	REQUIRE( names == std::vector<std::string>{ "(jump c1 c4)", "(jump c1 c5)" } );
+
+	aptk::Fluent_Vec s;
+	prob.progress( prob.init(), app[0], s );
+	app.clear();
+	prob.applicable_actions( s, app );
+	REQUIRE( app.size() == 3 );
+	for ( auto a : app )
+		REQUIRE( prob.is_applicable( s, a ) );
+	// the same ground action keeps its index
+	std::vector<int> again;
+	prob.applicable_actions( s, again );
+	REQUIRE( again == app );
+}
+
+TEST_CASE( "IW and BFWS solve lifted blocksworld" ) {
+	Lifted_Problem prob;
+	bool single_goal = GENERATE( true, false );
+	make_blocksworld( prob, 5, single_goal );
+	REQUIRE( prob.finalize() );
+	Lifted_Search_Problem search_prob( &prob );
+
+	// reversing the whole tower is beyond width 2
+	if ( single_goal ) {
+		aptk::search::lifted::IW< Lifted_Search_Problem > engine( search_prob, 2 );
+		engine.set_verbose( false );
+		engine.start();
+		float cost = 0;
+		std::vector<aptk::Action_Idx> plan;
+		REQUIRE( engine.find_solution( cost, plan ) );
+		REQUIRE( valid_plan( prob, plan ) );
+		REQUIRE( cost == plan.size() );
+	}
+	else {
+		aptk::search::lifted::BFWS< Lifted_Search_Problem > engine( search_prob, 2 );
+		engine.set_verbose( false );
+		engine.start();
+		float cost = 0;
+		std::vector<aptk::Action_Idx> plan;
+		REQUIRE( engine.find_solution( cost, plan ) );
+		REQUIRE( valid_plan( prob, plan ) );
+	}
+	// fluents are only the atoms reached: 5 blocks give 43 ground atoms
+	REQUIRE( prob.num_fluents() <= 43 );
+}
@@ -0,0 +1,145 @@
+/**
+ * @file test_Parallel_IW.cxx
+ * @brief Checks that the layer-synchronous engines return the same plans as
+ * their sequential counterparts, whatever the number of threads
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <strips_prob.hxx>
+#include <fwd_search_prob.hxx>
+#include <brfs.hxx>
+#include <iw.hxx>
+#include <par_brfs.hxx>
+#include <par_iw.hxx>
+#include <novelty.hxx>
+#include <sstream>
+#include <vector>
+#include <toy_graph.hxx>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+
+typedef aptk::agnostic::Novelty< Fwd_Search_Problem, aptk::search::brfs::Node< aptk::State > > H_Novel_Fwd;
+
+/**
+ * @brief A grid of n x n cells, the agent moves between adjacent cells and
+ * has to reach the corner opposite to where it starts. Layers get wide enough
+ * to be split among several threads.
+ */
+static void make_grid_problem( aptk::STRIPS_Problem& prob, unsigned n ) {
+
+	Graph	g;
+	for ( unsigned r = 0; r < n; r++ )
+		for ( unsigned c = 0; c < n; c++ ) {
+			std::stringstream buffer;
+			buffer << "c_" << r << "_" << c;
+			g.add_vertex( buffer.str() );
+		}
+	for ( unsigned r = 0; r < n; r++ )
+		for ( unsigned c = 0; c < n; c++ ) {
+			if ( c + 1 < n ) g.connect( r * n + c, r * n + c + 1 );
+			if ( r + 1 < n ) g.connect( r * n + c, ( r + 1 ) * n + c );
+		}
+
+	for ( unsigned v_k = 0; v_k < g.vertices().size(); v_k++ ) {
+		std::stringstream buffer;
+		buffer << "(at " << g.vertices()[v_k]->label() << ")";
+		g.vertices()[v_k]->set_at_fluent( aptk::STRIPS_Problem::add_fluent( prob, buffer.str() ) );
+	}
+
+	for ( unsigned v_k = 0; v_k < g.vertices().size(); v_k++ )
+		for ( Graph::Vertex_It v_j = g.begin_adj( v_k ); v_j != g.end_adj( v_k ); v_j++ ) {
+			aptk::Fluent_Vec pre, add, del;
+			aptk::Conditional_Effect_Vec ceff;
+			std::stringstream buffer;
+			buffer << "(move " << g.vertices()[v_k]->label() << " " << (*v_j)->label() << ")";
+			pre.push_back( g.vertices()[v_k]->at_fluent() );
+			add.push_back( (*v_j)->at_fluent() );
+			del.push_back( g.vertices()[v_k]->at_fluent() );
+			aptk::STRIPS_Problem::add_action( prob, buffer.str(), pre, add, del, ceff );
+		}
+
+	prob.make_action_tables();
+
+	aptk::Fluent_Vec I, G;
+	I.push_back( g.vertices().front()->at_fluent() );
+	G.push_back( g.vertices().back()->at_fluent() );
+	aptk::STRIPS_Problem::set_init( prob, I );
+	aptk::STRIPS_Problem::set_goal( prob, G );
+}
+
+TEST_CASE("Parallel_BRFS finds the same plan as BRFS"){
+
+	aptk::STRIPS_Problem prob;
+	make_grid_problem( prob, 40 );
+	Fwd_Search_Problem search_prob( &prob );
+
+	float seq_cost = 0;
+	std::vector< aptk::Action_Idx > seq_plan;
+	aptk::search::brfs::BRFS< Fwd_Search_Problem > seq_engine( search_prob );
+	seq_engine.set_verbose( false );
+	seq_engine.start();
+	REQUIRE( seq_engine.find_solution( seq_cost, seq_plan ) );
+	REQUIRE( seq_plan.size() == 78 );
+
+	for ( unsigned threads : { 1u, 2u, 4u, 8u } ) {
+		float cost = 0;
+		std::vector< aptk::Action_Idx > plan;
+		aptk::search::brfs::Parallel_BRFS< Fwd_Search_Problem > engine( search_prob, threads );
+		engine.set_verbose( false );
+		engine.start();
+		REQUIRE( engine.find_solution( cost, plan ) );
+		CHECK( plan == seq_plan );
+		CHECK( cost == seq_cost );
+	}
+}
+
+TEST_CASE("Parallel_IW finds the same plan as IW"){
+
+	aptk::STRIPS_Problem prob;
+	make_grid_problem( prob, 40 );
+	Fwd_Search_Problem search_prob( &prob );
+
+	float seq_cost = 0;
+	std::vector< aptk::Action_Idx > seq_plan;
+	aptk::search::brfs::IW< Fwd_Search_Problem, H_Novel_Fwd > seq_engine( search_prob );
+	seq_engine.set_verbose( false );
+	seq_engine.set_bound( 1 );
+	seq_engine.start();
+	REQUIRE( seq_engine.find_solution( seq_cost, seq_plan ) );
+
+	for ( unsigned threads : { 1u, 2u, 4u, 8u } ) {
+		float cost = 0;
+		std::vector< aptk::Action_Idx > plan;
+		aptk::search::brfs::Parallel_IW< Fwd_Search_Problem > engine( search_prob, threads );
+		engine.set_verbose( false );
+		REQUIRE( engine.set_bound( 1 ) );
+		engine.start();
+		REQUIRE( engine.find_solution( cost, plan ) );
+		CHECK( plan == seq_plan );
+		CHECK( engine.pruned_by_bound() == seq_engine.pruned_by_bound() );
+	}
+}
@@ -0,0 +1,115 @@
+/**
+ * @file test_Relaxed_Plan_Cache.cxx
+ * @brief Checks that BFWS searches the same way when relaxed plans come
+ * from a cache shared across searches
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <fwd_search_prob.hxx>
+#include <novelty_partition.hxx>
+#include <landmark_graph.hxx>
+#include <landmark_graph_generator.hxx>
+#include <landmark_graph_manager.hxx>
+#include <landmark_count.hxx>
+#include <h_1.hxx>
+#include <rp_heuristic.hxx>
+#include <open_list.hxx>
+#include <new_node_comparer.hxx>
+#include <bfws_2h.hxx>
+#include <visit_corners.hxx>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+
+typedef aptk::agnostic::H1_Heuristic< Fwd_Search_Problem, aptk::agnostic::H_Add_Evaluation_Function > H_Add_Fwd;
+typedef aptk::agnostic::Relaxed_Plan_Heuristic< Fwd_Search_Problem, H_Add_Fwd > H_Add_Rp_Fwd;
+typedef aptk::agnostic::Landmarks_Count_Heuristic< Fwd_Search_Problem > H_Lmcount_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Generator< Fwd_Search_Problem > Gen_Lms_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Manager< Fwd_Search_Problem > Land_Graph_Man;
+
+typedef aptk::search::bfws_2h::Node< Fwd_Search_Problem, aptk::State > Search_Node_2h;
+typedef aptk::agnostic::Novelty_Partition< Fwd_Search_Problem, Search_Node_2h > H_Novel_Fwd_2h;
+typedef aptk::search::Open_List< aptk::search::Node_Comparer_2H_gn_unit< Search_Node_2h >, Search_Node_2h > BFS_Open_List_2h;
+typedef aptk::search::bfws_2h::BFWS_2H< Fwd_Search_Problem, H_Novel_Fwd_2h, H_Lmcount_Fwd, H_Add_Rp_Fwd, BFS_Open_List_2h > k_BFWS;
+
+static void run_bfws( const Fwd_Search_Problem& search_prob, std::vector< aptk::Action_Idx >& plan, unsigned& expanded, aptk::search::Relaxed_Plan_Cache* cache = nullptr ) {
+
+	Gen_Lms_Fwd gen_lms( search_prob );
+	aptk::agnostic::Landmarks_Graph graph( search_prob.task() );
+	gen_lms.compute_lm_graph_set_additive( graph );
+	Land_Graph_Man lgm( search_prob, &graph );
+
+	float cost = 0;
+	k_BFWS engine( search_prob, false );
+	engine.set_max_novelty( 2 );
+	engine.use_land_graph_manager( &lgm );
+	engine.set_arity( 2, graph.num_landmarks() * 16 );
+	engine.rel_fl_h().ignore_rp_h_value( true );
+	if ( cache != nullptr )
+		engine.set_relplan_cache( cache );
+	engine.start();
+	REQUIRE( engine.find_solution( cost, plan ) );
+	expanded = engine.expanded();
+}
+
+TEST_CASE("BFWS finds the same plan with relaxed plans from a cache"){
+
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, 6, Visit_Marks::Corners, true );
+	Fwd_Search_Problem search_prob( &prob );
+
+	std::vector< aptk::Action_Idx > plan;
+	unsigned expanded = 0;
+	run_bfws( search_prob, plan, expanded );
+
+	// The second search on the same task finds all its relaxed plans cached
+	aptk::search::Relaxed_Plan_Cache cache( 1000 );
+	for ( unsigned run = 0; run < 2; run++ ) {
+		std::vector< aptk::Action_Idx > cached_plan;
+		unsigned cached_expanded = 0;
+		unsigned misses = cache.misses();
+		run_bfws( search_prob, cached_plan, cached_expanded, &cache );
+		CHECK( cached_plan == plan );
+		CHECK( cached_expanded == expanded );
+		if ( run == 0 )
+			CHECK( cache.misses() > 0 );
+		else
+			CHECK( cache.misses() == misses );
+	}
+	CHECK( cache.hits() > 0 );
+
+	// A cache with room for one relaxed plan still gives the same search
+	aptk::search::Relaxed_Plan_Cache small_cache( 1 );
+	std::vector< aptk::Action_Idx > small_plan;
+	unsigned small_expanded = 0;
+	run_bfws( search_prob, small_plan, small_expanded, &small_cache );
+	CHECK( small_plan == plan );
+	CHECK( small_expanded == expanded );
+	CHECK( small_cache.size() == 1 );
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_Serialized_Search.cxx
+ * @brief Checks the plans found by SIW and SIW+ when goal candidates are
+ * searched speculatively on several threads
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <fwd_search_prob.hxx>
+#include <novelty.hxx>
+#include <novelty_partition.hxx>
+#include <h_1.hxx>
+#include <rp_heuristic.hxx>
+#include <siw.hxx>
+#include <rp_iw.hxx>
+#include <siw_plus.hxx>
+#include <visit_corners.hxx>
+#include <algorithm>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+
+// Applies the plan from the initial state and checks that it reaches the goal
+static bool is_valid_plan( const aptk::STRIPS_Problem& prob, const std::vector< aptk::Action_Idx >& plan ) {
+
+	aptk::State s( prob );
+	s.set( prob.init() );
+	for ( auto a : plan ) {
+		if ( !prob.actions()[a]->can_be_applied_on( s ) )
+			return false;
+		aptk::State* succ = s.progress_through( *( prob.actions()[a] ) );
+		s.set( succ->fluent_vec() );
+		delete succ;
+	}
+	return s.entails( prob.goal() );
+}
+
+TEST_CASE("Speculative SIW finds valid plans"){
+
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, 12, Visit_Marks::All_Cells );
+	Fwd_Search_Problem search_prob( &prob );
+
+	for ( unsigned threads : { 1u, 3u, 8u } ) {
+		float cost = 0;
+		std::vector< aptk::Action_Idx > plan;
+		aptk::search::SIW< Fwd_Search_Problem > engine( search_prob );
+		engine.set_verbose( false );
+		engine.set_num_threads( threads );
+		engine.set_bound( 1 );
+		engine.set_max_bound( 1 );
+		engine.start();
+		REQUIRE( engine.find_solution( cost, plan ) );
+		CHECK( is_valid_plan( prob, plan ) );
+	}
+}
+
+TEST_CASE("Speculative SIW+ finds valid plans"){
+
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, 12, Visit_Marks::All_Cells );
+	Fwd_Search_Problem search_prob( &prob );
+
+	for ( unsigned threads : { 1u, 3u, 8u } ) {
+		float cost = 0;
+		std::vector< aptk::Action_Idx > plan;
+		aptk::search::novelty_spaces::SIW_Plus< Fwd_Search_Problem > engine( search_prob );
+		engine.set_verbose( false );
+		engine.set_num_threads( threads );
+		engine.set_bound( 1 );
+		engine.set_max_bound( 1 );
+		engine.start();
+		REQUIRE( engine.find_solution( cost, plan ) );
+		CHECK( is_valid_plan( prob, plan ) );
+	}
+}
+
+TEST_CASE("Speculative subsearches prune closed goal states"){
+
+	typedef aptk::search::novelty_spaces::SIW_Plus< Fwd_Search_Problem > SIW_Plus_Fwd;
+
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, 12, Visit_Marks::All_Cells );
+	Fwd_Search_Problem search_prob( &prob );
+
+	SIW_Plus_Fwd::Closed_List_Type closed;
+	SIW_Plus_Fwd engine( search_prob );
+	engine.set_verbose( false );
+	engine.set_num_threads( 3 );
+	engine.set_closed_goal_states( &closed );
+	engine.set_bound( 1 );
+
+	// The same subproblem twice: the goal state reached the first time is
+	// closed, so the second search cannot end there again
+	aptk::Fluent_Vec first;
+	for ( unsigned k = 0; k < 2; k++ ) {
+		engine.goals_achieved().clear();
+		engine.goal_candidates() = prob.goal();
+		engine.start();
+		SIW_Plus_Fwd::Search_Node* end = engine.do_search();
+		if ( k == 0 ) {
+			REQUIRE( end != NULL );
+			REQUIRE( closed.size() == 1 );
+			first = end->state()->fluent_vec();
+			std::sort( first.begin(), first.end() );
+			continue;
+		}
+		if ( end == NULL )
+			continue;
+		aptk::Fluent_Vec second = end->state()->fluent_vec();
+		std::sort( second.begin(), second.end() );
+		CHECK_FALSE( second == first );
+	}
+}
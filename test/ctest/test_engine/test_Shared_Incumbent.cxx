@@ -0,0 +1,195 @@
+/**
+ * @file test_Shared_Incumbent.cxx
+ * @brief Checks that anytime engines sharing an incumbent prune against it
+ * and still converge to an optimal plan
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <fwd_search_prob.hxx>
+#include <novelty_partition.hxx>
+#include <landmark_graph.hxx>
+#include <landmark_graph_generator.hxx>
+#include <landmark_graph_manager.hxx>
+#include <landmark_count.hxx>
+#include <h_1.hxx>
+#include <rp_heuristic.hxx>
+#include <open_list.hxx>
+#include <at_gbfs_3h.hxx>
+#include <ipc2014_rwa.hxx>
+#include <shared_incumbent.hxx>
+#include <visit_corners.hxx>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+using aptk::search::Shared_Incumbent;
+
+typedef aptk::agnostic::H1_Heuristic< Fwd_Search_Problem, aptk::agnostic::H_Add_Evaluation_Function > H_Add_Fwd;
+typedef aptk::agnostic::Relaxed_Plan_Heuristic< Fwd_Search_Problem, H_Add_Fwd > H_Add_Rp_Fwd;
+typedef aptk::agnostic::Landmarks_Count_Heuristic< Fwd_Search_Problem > H_Lmcount_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Generator< Fwd_Search_Problem > Gen_Lms_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Manager< Fwd_Search_Problem > Land_Graph_Man;
+
+typedef aptk::search::gbfs_3h::Node< Fwd_Search_Problem, aptk::State > Search_Node;
+typedef aptk::agnostic::Novelty_Partition< Fwd_Search_Problem, Search_Node > H_Novel_Fwd;
+typedef aptk::search::Open_List< aptk::search::Node_Comparer_3H< Search_Node >, Search_Node > BFS_Open_List;
+typedef aptk::search::gbfs_3h::AT_GBFS_3H< Fwd_Search_Problem, H_Novel_Fwd, H_Lmcount_Fwd, H_Add_Rp_Fwd, BFS_Open_List > Anytime_GBFS;
+
+typedef aptk::search::ipc2014::Node< aptk::State > AT_Search_Node;
+typedef aptk::search::bfs_dq_mh::IPC2014_RWA< Fwd_Search_Problem, H_Add_Rp_Fwd, H_Lmcount_Fwd, AT_Search_Node::Open_List > Anytime_RWA;
+
+// Applies the plan from the initial state and checks that it reaches the goal
+static bool is_valid_plan( const aptk::STRIPS_Problem& prob, const std::vector< aptk::Action_Idx >& plan ) {
+
+	aptk::State s( prob );
+	s.set( prob.init() );
+	for ( auto a : plan ) {
+		if ( !prob.actions()[a]->can_be_applied_on( s ) )
+			return false;
+		aptk::State* succ = s.progress_through( *( prob.actions()[a] ) );
+		s.set( succ->fluent_vec() );
+		delete succ;
+	}
+	return s.entails( prob.goal() );
+}
+
+// Runs RWA* until it exhausts its search space, publishing each plan to the incumbent
+static void run_rwa( Anytime_RWA& engine, Shared_Incumbent& incumbent ) {
+
+	float cost = infty;
+	std::vector< aptk::Action_Idx > plan;
+	engine.set_incumbent( &incumbent );
+	engine.start( infty );
+	engine.set_schedule( 1000, 1, 10 );
+	while ( engine.find_solution( cost, plan ) ) {
+		if ( !plan.empty() )
+			incumbent.update( cost, plan );
+		plan.clear();
+	}
+}
+
+TEST_CASE("RWA* with a shared incumbent finds an optimal plan"){
+
+	const unsigned n = 6;
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, n );
+	Fwd_Search_Problem search_prob( &prob );
+
+	Gen_Lms_Fwd gen_lms( search_prob );
+	aptk::agnostic::Landmarks_Graph graph( prob );
+	gen_lms.compute_lm_graph_set_additive( graph );
+	Land_Graph_Man lgm( search_prob, &graph );
+
+	Shared_Incumbent incumbent;
+	Anytime_RWA engine( search_prob, 10.0f, 0.95f );
+	engine.use_land_graph_manager( &lgm );
+	run_rwa( engine, incumbent );
+
+	REQUIRE( incumbent.cost() == 3 * ( n - 1 ) );
+	CHECK( is_valid_plan( prob, incumbent.plan() ) );
+}
+
+TEST_CASE("Anytime engines prune against a plan found elsewhere"){
+
+	const unsigned n = 6;
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, n );
+	Fwd_Search_Problem search_prob( &prob );
+
+	Gen_Lms_Fwd gen_lms( search_prob );
+	aptk::agnostic::Landmarks_Graph graph( prob );
+	gen_lms.compute_lm_graph_set_additive( graph );
+	Land_Graph_Man lgm( search_prob, &graph );
+
+	// Seed the incumbent with an optimal plan, nothing cheaper can be found
+	Shared_Incumbent incumbent;
+	{
+		Anytime_RWA engine( search_prob, 10.0f, 0.95f );
+		engine.use_land_graph_manager( &lgm );
+		run_rwa( engine, incumbent );
+	}
+	REQUIRE( incumbent.cost() == 3 * ( n - 1 ) );
+
+	float cost = infty;
+	std::vector< aptk::Action_Idx > plan;
+	Anytime_RWA engine( search_prob, 10.0f, 0.95f );
+	engine.use_land_graph_manager( &lgm );
+	engine.set_incumbent( &incumbent );
+	engine.start( infty );
+	CHECK_FALSE( engine.find_solution( cost, plan ) );
+	CHECK( engine.pruned_by_bound() > 0 );
+
+	Anytime_GBFS bfs_engine( search_prob );
+	bfs_engine.use_land_graph_manager( &lgm );
+	bfs_engine.set_arity( 2, graph.num_landmarks_and_edges() );
+	bfs_engine.set_verbose( false );
+	bfs_engine.set_incumbent( &incumbent );
+	bfs_engine.start( infty );
+	CHECK_FALSE( bfs_engine.find_solution( cost, plan ) );
+}
+
+TEST_CASE("Concurrent BFS(f) and RWA* agree on the best plan"){
+
+	const unsigned n = 8;
+	aptk::STRIPS_Problem prob;
+	make_visit_corners_problem( prob, n );
+	Fwd_Search_Problem search_prob( &prob );
+
+	// Landmark graphs are consumed during search, so every engine has its own
+	Gen_Lms_Fwd gen_lms( search_prob );
+	aptk::agnostic::Landmarks_Graph bfs_f_graph( prob ), rwa_graph( prob );
+	gen_lms.compute_lm_graph_set_additive( bfs_f_graph );
+	gen_lms.compute_lm_graph_set_additive( rwa_graph );
+	Land_Graph_Man bfs_f_lgm( search_prob, &bfs_f_graph );
+	Land_Graph_Man rwa_lgm( search_prob, &rwa_graph );
+
+	Shared_Incumbent incumbent;
+	Anytime_GBFS bfs_engine( search_prob );
+	bfs_engine.use_land_graph_manager( &bfs_f_lgm );
+	bfs_engine.set_arity( 2, bfs_f_graph.num_landmarks_and_edges() );
+	bfs_engine.set_verbose( false );
+	bfs_engine.set_incumbent( &incumbent );
+
+	std::thread bfs_f( [&]() {
+		float cost = infty;
+		std::vector< aptk::Action_Idx > plan;
+		bfs_engine.start( infty );
+		if ( bfs_engine.find_solution( cost, plan ) )
+			incumbent.update( cost, plan );
+	} );
+
+	Anytime_RWA rwa_engine( search_prob, 10.0f, 0.95f );
+	rwa_engine.use_land_graph_manager( &rwa_lgm );
+	run_rwa( rwa_engine, incumbent );
+	incumbent.close();
+	bfs_f.join();
+
+	REQUIRE( incumbent.cost() == 3 * ( n - 1 ) );
+	CHECK( is_valid_plan( prob, incumbent.plan() ) );
+}
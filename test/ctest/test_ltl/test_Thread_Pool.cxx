@@ -0,0 +1,98 @@
+/**
+ * @file test_Thread_Pool.cxx
+ * @brief Checks the work-stealing thread pool and cancellation tokens
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <thread_pool.hxx>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("parallel_for visits every index once"){
+
+	aptk::Thread_Pool pool( 4 );
+	for ( size_t grain : { 1u, 7u, 1000u } ) {
+		std::vector< std::atomic< unsigned > > visits( 10000 );
+		for ( auto& v : visits ) v = 0;
+		pool.parallel_for( 0, visits.size(), [&]( size_t i ) { visits[i]++; }, grain );
+		for ( auto& v : visits )
+			REQUIRE( v == 1 );
+	}
+}
+
+TEST_CASE("Tasks can wait on tasks they submit"){
+
+	aptk::Thread_Pool pool( 2 );
+	// More nested waits than workers: waiting threads must run the pending tasks
+	std::vector< std::future< long > > outer;
+	for ( long k = 0; k < 8; k++ )
+		outer.push_back( pool.submit( [&pool, k]() {
+			std::vector< std::future< long > > inner;
+			for ( long j = 0; j < 8; j++ )
+				inner.push_back( pool.submit( [k, j]() { return k * j; } ) );
+			long sum = 0;
+			for ( auto& f : inner )
+				sum += pool.wait( f );
+			return sum;
+		} ) );
+
+	long total = 0;
+	for ( auto& f : outer )
+		total += pool.wait( f );
+	CHECK( total == 28 * 28 );
+}
+
+TEST_CASE("Exceptions reach the caller"){
+
+	aptk::Thread_Pool pool( 3 );
+	CHECK_THROWS_AS( pool.parallel_for( 0, 100, []( size_t i ) {
+		if ( i == 42 ) throw std::runtime_error( "boom" );
+	} ), std::runtime_error );
+
+	auto f = pool.submit( []() -> int { throw std::logic_error( "boom" ); } );
+	CHECK_THROWS_AS( pool.wait( f ), std::logic_error );
+}
+
+TEST_CASE("Cancelled loops stop handing out work"){
+
+	aptk::Thread_Pool pool( 4 );
+	aptk::Cancellation_Token token;
+	std::atomic< unsigned > visited( 0 );
+	pool.parallel_for( 0, 100000, [&]( size_t i ) {
+		if ( ++visited == 100 ) token.cancel();
+	}, 1, 0, &token );
+	CHECK( token.cancelled() );
+	CHECK( visited < 100000 );
+
+	aptk::Cancellation_Token timer;
+	CHECK_FALSE( timer.cancelled() );
+	timer.set_deadline( 0.0 );
+	CHECK( timer.cancelled() );
+	CHECK( timer.flag()->load() );
+}
@@ -0,0 +1,127 @@
+/**
+ * @file test_SAS_Reader.cxx
+ * @brief Loading Fast Downward translator output into STRIPS_Problem
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <strips_prob.hxx>
+#include <sas_reader.hxx>
+#include <fluent.hxx>
+#include <action.hxx>
+#include <cond_eff.hxx>
+#include <sstream>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	// A robot moving between three rooms, a binary light variable and
+	// a switch that only works in room c
+	const char *ROOMS_SAS =
+			"begin_version\n3\nend_version\n"
+			"begin_metric\n1\nend_metric\n"
+			"2\n"
+			"begin_variable\nvar0\n-1\n3\nAtom at(a)\nAtom at(b)\nAtom at(c)\nend_variable\n"
+			"begin_variable\nvar1\n-1\n2\nAtom lit()\nNegatedAtom lit()\nend_variable\n"
+			"1\n"
+			"begin_mutex_group\n3\n0 0\n0 1\n0 2\nend_mutex_group\n"
+			"begin_state\n0\n1\nend_state\n"
+			"begin_goal\n1\n1 0\nend_goal\n"
+			"3\n"
+			"begin_operator\nmove a b\n0\n1\n0 0 0 1\n2\nend_operator\n"
+			"begin_operator\nteleport c\n0\n1\n0 0 -1 2\n5\nend_operator\n"
+			"begin_operator\nswitch\n0\n1\n1 0 2 1 -1 0\n1\nend_operator\n"
+			"0\n";
+}
+
+TEST_CASE("A SAS+ task becomes one fluent per variable value"){
+	aptk::STRIPS_Problem prob;
+	aptk::SAS_Reader reader;
+	std::istringstream in(ROOMS_SAS);
+	REQUIRE(reader.read(in, prob));
+
+	REQUIRE(prob.num_fluents() == 5);
+	REQUIRE(reader.variables().size() == 2);
+	REQUIRE(reader.fluent(1, 1) == 4);
+	REQUIRE(prob.fluents()[1]->signature() == "(at b)");
+	REQUIRE(prob.fluents()[3]->signature() == "(lit)");
+	REQUIRE(prob.fluents()[4]->signature() == "(not (lit))");
+	REQUIRE(prob.init() == aptk::Fluent_Vec{0, 4});
+	REQUIRE(prob.goal() == aptk::Fluent_Vec{3});
+	// One group per variable, the translator's group is var0 again
+	REQUIRE(prob.mutexes().num_groups() == 2);
+	REQUIRE(prob.mutexes().are_mutex(0, 2));
+	REQUIRE(prob.mutexes().are_mutex(3, 4));
+	REQUIRE_FALSE(prob.mutexes().are_mutex(0, 3));
+
+	REQUIRE(prob.num_actions() == 3);
+	const aptk::Action *move = prob.actions()[0];
+	REQUIRE(move->signature() == "(move a b)");
+	REQUIRE(move->cost() == 2.0f);
+	REQUIRE(move->prec_vec() == aptk::Fluent_Vec{0});
+	REQUIRE(move->add_vec() == aptk::Fluent_Vec{1});
+	REQUIRE(move->del_vec() == aptk::Fluent_Vec{0});
+
+	// unknown previous value, every other value is deleted
+	const aptk::Action *teleport = prob.actions()[1];
+	REQUIRE(teleport->prec_vec().empty());
+	REQUIRE(teleport->add_vec() == aptk::Fluent_Vec{2});
+	REQUIRE(teleport->del_vec() == aptk::Fluent_Vec{0, 1});
+
+	const aptk::Action *sw = prob.actions()[2];
+	REQUIRE(prob.has_conditional_effects());
+	REQUIRE(sw->ceff_vec().size() == 1);
+	REQUIRE(sw->ceff_vec()[0]->prec_vec() == aptk::Fluent_Vec{2});
+	REQUIRE(sw->ceff_vec()[0]->add_vec() == aptk::Fluent_Vec{3});
+	REQUIRE(sw->ceff_vec()[0]->del_vec() == aptk::Fluent_Vec{4});
+}
+
+TEST_CASE("Unsupported or malformed SAS+ input is reported"){
+	std::string with_axioms(ROOMS_SAS);
+	with_axioms.replace(with_axioms.size() - 2, 2, "1\n");
+	aptk::STRIPS_Problem p1;
+	aptk::SAS_Reader reader;
+	std::istringstream in1(with_axioms);
+	REQUIRE_FALSE(reader.read(in1, p1));
+	REQUIRE(reader.error().find("axioms") != std::string::npos);
+
+	std::string bad_fact(ROOMS_SAS);
+	bad_fact.replace(bad_fact.find("1 0\nend_goal"), 3, "1 7");
+	aptk::STRIPS_Problem p2;
+	std::istringstream in2(bad_fact);
+	REQUIRE_FALSE(reader.read(in2, p2));
+
+	// the operator is cut after its conditional effect was read
+	std::string bad_cost(ROOMS_SAS);
+	bad_cost.replace(bad_cost.find("1\nend_operator\n0\n"), 1, "x");
+	aptk::STRIPS_Problem p3;
+	std::istringstream in3(bad_cost);
+	REQUIRE_FALSE(reader.read(in3, p3));
+	REQUIRE(p3.num_actions() == 2);
+
+	REQUIRE(aptk::SAS_Reader::fluent_signature("Atom on(a, b)", "var3") == "(on a b)");
+	REQUIRE(aptk::SAS_Reader::fluent_signature("<none of those>", "var3") == "(none-of var3)");
+}
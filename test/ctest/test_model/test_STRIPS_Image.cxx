@@ -0,0 +1,144 @@
+/**
+ * @file test_STRIPS_Image.cxx
+ * @brief Round trips of STRIPS_Problem through binary task images
+ * @version 0.1
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files 
+ * (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * 
+ */
+
+#include <strips_prob.hxx>
+#include <strips_image.hxx>
+#include <fluent.hxx>
+#include <action.hxx>
+#include <cond_eff.hxx>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	// Two rooms, a light switch with a conditional effect and a mutex group
+	void make_task(aptk::STRIPS_Problem &prob)
+	{
+		prob.set_domain_name("rooms");
+		prob.set_problem_name("rooms-1");
+		unsigned at_a = aptk::STRIPS_Problem::add_fluent(prob, "(at a)");
+		unsigned at_b = aptk::STRIPS_Problem::add_fluent(prob, "(at b)");
+		unsigned lit = aptk::STRIPS_Problem::add_fluent(prob, "(lit)");
+
+		aptk::Fluent_Vec empty;
+		aptk::Conditional_Effect_Vec no_ceffs;
+		aptk::STRIPS_Problem::add_action(prob, "(move a b)", {at_a}, {at_b}, {at_a}, no_ceffs, 2.0f);
+		aptk::STRIPS_Problem::add_action(prob, "(move b a)", {at_b}, {at_a}, {at_b}, no_ceffs, 3.0f);
+
+		aptk::Fluent_Vec cond{at_b}, add{lit};
+		aptk::Conditional_Effect *ce = new aptk::Conditional_Effect(prob);
+		ce->define(cond, add, empty);
+		aptk::STRIPS_Problem::add_action(prob, "(switch)", empty, empty, empty, {ce}, 1.0f);
+
+		prob.mutexes().add({at_a, at_b});
+		aptk::STRIPS_Problem::set_init(prob, {at_a});
+		aptk::STRIPS_Problem::set_goal(prob, {lit});
+	}
+}
+
+TEST_CASE("A task survives a round trip through an image"){
+	std::string path = "test_strips_image.bin";
+	aptk::STRIPS_Problem orig;
+	make_task(orig);
+	REQUIRE(aptk::STRIPS_Image::write(orig, path));
+
+	aptk::STRIPS_Image image;
+	REQUIRE(image.open(path));
+	REQUIRE(image.num_fluents() == 3);
+	REQUIRE(image.num_actions() == 3);
+	REQUIRE(image.num_cond_effects() == 1);
+	REQUIRE(image.ceff_begin(2) == 0);
+	REQUIRE(image.prec(0)[0] == 0);
+
+	aptk::STRIPS_Problem loaded;
+	image.load(loaded);
+	loaded.make_action_tables();
+
+	REQUIRE(loaded.domain_name() == "rooms");
+	REQUIRE(loaded.problem_name() == "rooms-1");
+	REQUIRE(loaded.num_fluents() == orig.num_fluents());
+	for (unsigned f = 0; f < orig.num_fluents(); f++)
+		REQUIRE(loaded.fluents()[f]->signature() == orig.fluents()[f]->signature());
+	REQUIRE(loaded.num_actions() == orig.num_actions());
+	for (unsigned a = 0; a < orig.num_actions(); a++)
+	{
+		const aptk::Action *x = orig.actions()[a];
+		const aptk::Action *y = loaded.actions()[a];
+		REQUIRE(y->signature() == x->signature());
+		REQUIRE(y->cost() == x->cost());
+		REQUIRE(y->prec_vec() == x->prec_vec());
+		REQUIRE(y->add_vec() == x->add_vec());
+		REQUIRE(y->del_vec() == x->del_vec());
+		REQUIRE(y->ceff_vec().size() == x->ceff_vec().size());
+	}
+	REQUIRE(loaded.actions()[0]->requires(0));
+	REQUIRE(loaded.actions()[2]->ceff_vec()[0]->prec_vec() == aptk::Fluent_Vec{1});
+	REQUIRE(loaded.actions()[2]->ceff_vec()[0]->asserts(2));
+	REQUIRE(loaded.has_conditional_effects());
+	REQUIRE(loaded.mutexes().are_mutex(0, 1));
+	REQUIRE(loaded.init() == orig.init());
+	REQUIRE(loaded.goal() == orig.goal());
+
+	image.close();
+	std::remove(path.c_str());
+}
+
+TEST_CASE("Truncated or foreign images are rejected"){
+	std::string path = "test_strips_image_bad.bin";
+	aptk::STRIPS_Problem orig;
+	make_task(orig);
+	REQUIRE(aptk::STRIPS_Image::write(orig, path));
+
+	// drop the last bytes
+	std::string bytes;
+	{
+		std::ifstream in(path, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), bytes.size() - 4);
+	}
+	aptk::STRIPS_Image image;
+	REQUIRE_FALSE(image.open(path));
+
+	// wrong magic
+	bytes[0] = 'X';
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), bytes.size());
+	}
+	REQUIRE_FALSE(image.open(path));
+	REQUIRE_FALSE(image.is_open());
+	REQUIRE_FALSE(image.open("no_such_image.bin"));
+
+	std::remove(path.c_str());
+}
@@ -32,7 +32,13 @@
 #include <fluent.hxx>
 #include <action.hxx>
 #include <cond_eff.hxx>
+#include <h2_mutexes.hxx>
+#include <strips_state.hxx>
+#include <fwd_search_prob.hxx>
+#include <algorithm>
+#include <random>
 #include <sstream>
+#include <type_traits>
 #include <toy_graph.hxx>
 #include <catch2/catch_test_macros.hpp>
 
@@ -120,3 +126,509 @@ TEST_CASE("Assembling a STRIPS_Problem"){
 	std::cout << "END TEST_CASE(Assembling a STRIPS_Problem)" << std::endl;
 
 }
+
+TEST_CASE("Fluent and action signatures are interned"){
+
+	aptk::STRIPS_Problem prob("signatures", "signatures");
+
+	std::vector<std::string> fluents = {
+		"(on a b)", "Atom on(a, b)", "NegatedAtom clear(b)", "(not (on b a))",
+		"var0=1", "handempty()", "(on  a b)", ""
+	};
+	for ( auto &sig : fluents )
+		aptk::STRIPS_Problem::add_fluent( prob, sig );
+
+	// Rendering gives back exactly what the front end passed
+	for ( unsigned k = 0; k < fluents.size(); k++ ) {
+		REQUIRE( prob.fluents()[k]->signature() == fluents[k] );
+		REQUIRE( prob.get_fluent_index( fluents[k] ) == k );
+	}
+	REQUIRE( prob.get_fluent_index( "(on b a)" ) == no_such_index );
+	REQUIRE( prob.get_fluent_index( "(on a c)" ) == no_such_index );
+
+	// A new combination of known symbols is a new signature
+	unsigned known = prob.fluent_signatures().size();
+	aptk::STRIPS_Problem::add_fluent( prob, "(on b a)" );
+	REQUIRE( prob.fluent_signatures().size() == known + 1 );
+	REQUIRE( prob.get_fluent_index( "(on b a)" ) == fluents.size() );
+
+	aptk::Fluent_Vec pre = { 0 }, add = { 1 }, del;
+	aptk::Conditional_Effect_Vec ceffs;
+	unsigned a = aptk::STRIPS_Problem::add_action( prob, "(unstack a b)", pre, add, del, ceffs );
+	REQUIRE( prob.actions()[a]->signature() == "(unstack a b)" );
+	REQUIRE( prob.actions()[a]->name() == "unstack" );
+	REQUIRE( prob.action_signatures().num_symbols( a ) == 3 );
+	REQUIRE( prob.action_signatures().symbol( a, 2 ) == "b" );
+}
+
+TEST_CASE("Unreachable and irrelevant fluents and actions are removed"){
+
+	aptk::STRIPS_Problem prob("reduce", "reduce");
+	prob.set_verbose(false);
+
+	// at-a, at-b, at-c form a chain; lamp-on is reachable but no goal needs
+	// it and broken is never reached
+	unsigned at_a = aptk::STRIPS_Problem::add_fluent( prob, "(at a)" );
+	unsigned lamp = aptk::STRIPS_Problem::add_fluent( prob, "(lamp-on)" );
+	unsigned broken = aptk::STRIPS_Problem::add_fluent( prob, "(broken)" );
+	unsigned at_b = aptk::STRIPS_Problem::add_fluent( prob, "(at b)" );
+	unsigned at_c = aptk::STRIPS_Problem::add_fluent( prob, "(at c)" );
+
+	aptk::Conditional_Effect_Vec no_ceffs;
+	aptk::STRIPS_Problem::add_action( prob, "(switch-on)", { at_a }, { lamp }, {}, no_ceffs );
+	aptk::STRIPS_Problem::add_action( prob, "(repair)", { broken }, { at_c }, { broken }, no_ceffs );
+	// the conditional effect on broken can never fire
+	aptk::Conditional_Effect *ceff = new aptk::Conditional_Effect( prob );
+	aptk::Fluent_Vec cond = { broken }, adds = { lamp }, dels;
+	ceff->define( cond, adds, dels );
+	aptk::STRIPS_Problem::add_action( prob, "(move a b)", { at_a }, { at_b }, { at_a, lamp }, { ceff } );
+	aptk::STRIPS_Problem::add_action( prob, "(move b c)", { at_b }, { at_c }, { at_b }, no_ceffs );
+
+	aptk::STRIPS_Problem::set_init( prob, { at_a, lamp } );
+	aptk::STRIPS_Problem::set_goal( prob, { at_c } );
+	prob.set_reduce_task( true );
+	prob.make_action_tables( false );
+
+	const aptk::STRIPS_Problem::Task_Reduction &r = prob.reduction();
+	REQUIRE( r.fluents_before == 5 );
+	REQUIRE( r.unreachable_fluents == 1 );
+	REQUIRE( r.irrelevant_fluents == 1 );
+	REQUIRE( r.actions_before == 4 );
+	REQUIRE( r.unreachable_actions == 1 );
+	REQUIRE( r.irrelevant_actions == 1 );
+
+	REQUIRE( prob.num_fluents() == 3 );
+	REQUIRE( prob.num_actions() == 2 );
+	for ( unsigned k = 0; k < prob.num_fluents(); k++ )
+		REQUIRE( prob.fluents()[k]->index() == k );
+	REQUIRE( prob.get_fluent_index( "(lamp-on)" ) == no_such_index );
+	unsigned new_a = prob.get_fluent_index( "(at a)" );
+	unsigned new_b = prob.get_fluent_index( "(at b)" );
+	unsigned new_c = prob.get_fluent_index( "(at c)" );
+	REQUIRE( prob.init() == aptk::Fluent_Vec{ new_a } );
+	REQUIRE( prob.goal() == aptk::Fluent_Vec{ new_c } );
+	REQUIRE( prob.is_in_goal( new_c ) );
+
+	const aptk::Action *move = prob.actions()[0];
+	REQUIRE( move->signature() == "(move a b)" );
+	REQUIRE( move->index() == 0 );
+	REQUIRE( move->ceff_vec().empty() );
+	REQUIRE( move->del_vec() == aptk::Fluent_Vec{ new_a } );
+	REQUIRE( move->asserts( new_b ) );
+	REQUIRE( prob.actions_adding( new_c ).size() == 1 );
+	REQUIRE( prob.actions_adding( new_c )[0]->signature() == "(move b c)" );
+}
+
+TEST_CASE("States are packed into mutex group variables"){
+
+	aptk::STRIPS_Problem prob("pack", "pack");
+	prob.set_verbose(false);
+
+	unsigned at_a = aptk::STRIPS_Problem::add_fluent( prob, "(at a)" );
+	unsigned at_b = aptk::STRIPS_Problem::add_fluent( prob, "(at b)" );
+	unsigned at_c = aptk::STRIPS_Problem::add_fluent( prob, "(at c)" );
+	unsigned lamp = aptk::STRIPS_Problem::add_fluent( prob, "(lamp-on)" );
+	unsigned at_d = aptk::STRIPS_Problem::add_fluent( prob, "(at d)" );
+
+	aptk::Conditional_Effect_Vec no_ceffs;
+	aptk::STRIPS_Problem::add_action( prob, "(move a b)", { at_a }, { at_b }, { at_a }, no_ceffs );
+	aptk::STRIPS_Problem::add_action( prob, "(move b a)", { at_b }, { at_a }, { at_b }, no_ceffs );
+	aptk::STRIPS_Problem::add_action( prob, "(switch-on)", { at_a }, { lamp }, {}, no_ceffs );
+
+	aptk::STRIPS_Problem::set_init( prob, { at_a } );
+	aptk::STRIPS_Problem::set_goal( prob, { at_c } );
+	prob.mutexes().add( { at_a, at_b, at_c, at_d } );
+	prob.set_packed_states( true );
+	prob.make_action_tables( false );
+
+	const aptk::State_Packer *packer = prob.state_packer();
+	REQUIRE( packer != nullptr );
+	REQUIRE( packer->num_vars() == 2 );
+	REQUIRE( packer->num_group_vars() == 1 );
+	REQUIRE( packer->num_bits() == 4 );
+	REQUIRE( packer->num_words() == 1 );
+	REQUIRE( packer->var_of( at_a ) == packer->var_of( at_d ) );
+
+	aptk::State s0( prob );
+	s0.set( prob.init() );
+	s0.update_hash();
+
+	aptk::State *s1 = s0.progress_through( *prob.actions()[0] );
+	aptk::State *s2 = s1->progress_through( *prob.actions()[1] );
+	s1->update_hash();
+	s2->update_hash();
+	REQUIRE_FALSE( *s1 == s0 );
+	REQUIRE( *s2 == s0 );
+	REQUIRE( s2->hash() == s0.hash() );
+	REQUIRE( s1->packed().empty() );
+
+	size_t h0 = s0.hash();
+	s0.pack();
+	REQUIRE( s0.is_packed() );
+	REQUIRE( s0.fluent_vec().empty() );
+	REQUIRE( s0.hash() == h0 );
+	s0.update_hash();
+	REQUIRE( s0.hash() == h0 );
+	REQUIRE( *s2 == s0 );
+	REQUIRE_FALSE( s0 == *s1 );
+
+	aptk::State plain( prob );
+	plain.set( at_a );
+	REQUIRE( plain == s0 );
+
+	aptk::State *s3 = s0.progress_through( *prob.actions()[2] );
+	REQUIRE( s3->entails( at_a ) );
+	REQUIRE( s3->entails( lamp ) );
+
+	s0.unpack();
+	REQUIRE_FALSE( s0.is_packed() );
+	REQUIRE( s0.packed().empty() );
+	REQUIRE( s0.fluent_vec() == aptk::Fluent_Vec{ at_a } );
+	REQUIRE( s0.entails( at_a ) );
+	REQUIRE_FALSE( s0.entails( at_b ) );
+
+	delete s1;
+	delete s2;
+	delete s3;
+}
+
+TEST_CASE("States adapt their representation to the task"){
+
+	aptk::STRIPS_Problem prob("adaptive", "adaptive");
+	prob.set_verbose(false);
+
+	// A line of 64 cells and a light, only the robot cell and the light
+	// can be true at once
+	std::vector<unsigned> at;
+	for ( unsigned k = 0; k < 64; k++ )
+		at.push_back( aptk::STRIPS_Problem::add_fluent( prob, "(at c" + std::to_string(k) + ")" ) );
+	unsigned light = aptk::STRIPS_Problem::add_fluent( prob, "(light)" );
+
+	aptk::Conditional_Effect_Vec no_ceffs;
+	for ( unsigned k = 0; k + 1 < at.size(); k++ ) {
+		aptk::STRIPS_Problem::add_action( prob, "(right c" + std::to_string(k) + ")", { at[k] }, { at[k+1] }, { at[k] }, no_ceffs );
+		aptk::STRIPS_Problem::add_action( prob, "(left c" + std::to_string(k+1) + ")", { at[k+1] }, { at[k] }, { at[k+1] }, no_ceffs );
+	}
+	// Deletes the light and turns it back on
+	aptk::Conditional_Effect *on = new aptk::Conditional_Effect( prob );
+	aptk::Fluent_Vec on_cond, on_adds = { light }, on_dels;
+	on->define( on_cond, on_adds, on_dels );
+	aptk::STRIPS_Problem::add_action( prob, "(relight)", { at[0] }, {}, { light }, { on } );
+
+	aptk::STRIPS_Problem::set_init( prob, { at[0] } );
+	aptk::STRIPS_Problem::set_goal( prob, { at[63] } );
+	prob.set_adaptive_states( true );
+	prob.make_action_tables( false );
+
+	REQUIRE( prob.average_state_size() < 2.0f );
+	REQUIRE( prob.state_representation() == aptk::State_Representation::Sparse );
+
+	const aptk::Action *relight = prob.actions().back();
+	for ( auto r : { aptk::State_Representation::Sparse, aptk::State_Representation::Dense } ) {
+		prob.set_state_representation( r );
+
+		aptk::State s0( prob );
+		s0.set( at[0] );
+		s0.set( light );
+		s0.update_hash();
+		aptk::State s1( prob );
+		s1.set( light );
+		s1.set( at[0] );
+		s1.update_hash();
+		REQUIRE( s0 == s1 );
+		REQUIRE( s0.hash() == s1.hash() );
+
+		aptk::Fluent_Vec added, deleted;
+		aptk::State *s2 = s0.progress_through( *relight, &added, &deleted );
+		s2->update_hash();
+		REQUIRE( s2->entails( at[0] ) );
+		REQUIRE( s2->entails( light ) );
+		REQUIRE( added == aptk::Fluent_Vec{ light } );
+		REQUIRE( deleted == aptk::Fluent_Vec{ light } );
+		REQUIRE( *s2 == s0 );
+
+		aptk::State *s3 = s0.progress_through( *prob.actions()[0] );
+		s3->update_hash();
+		REQUIRE_FALSE( *s3 == s0 );
+		REQUIRE( s3->fluent_vec().size() == 2 );
+		REQUIRE( s3->fluent_set().isset( at[1] ) );
+		REQUIRE_FALSE( s3->fluent_set().isset( at[0] ) );
+		s3->unset( light );
+		REQUIRE( s3->fluent_vec() == aptk::Fluent_Vec{ at[1] } );
+		REQUIRE_FALSE( s3->entails( light ) );
+
+		delete s2;
+		delete s3;
+	}
+}
+
+TEST_CASE("h^2 mutexes are added and mutex actions removed"){
+
+	aptk::STRIPS_Problem prob("h2", "h2");
+	prob.set_verbose(false);
+
+	// The robot moves a -> b -> c and cannot come back, so teleported,
+	// which needs it at a and b at once, is unreachable
+	unsigned at_a = aptk::STRIPS_Problem::add_fluent( prob, "(at a)" );
+	unsigned at_b = aptk::STRIPS_Problem::add_fluent( prob, "(at b)" );
+	unsigned at_c = aptk::STRIPS_Problem::add_fluent( prob, "(at c)" );
+	unsigned tele = aptk::STRIPS_Problem::add_fluent( prob, "(teleported)" );
+	unsigned done = aptk::STRIPS_Problem::add_fluent( prob, "(done)" );
+
+	aptk::Conditional_Effect_Vec no_ceffs;
+	aptk::STRIPS_Problem::add_action( prob, "(move a b)", { at_a }, { at_b }, { at_a }, no_ceffs );
+	aptk::STRIPS_Problem::add_action( prob, "(move b c)", { at_b }, { at_c }, { at_b }, no_ceffs );
+	aptk::STRIPS_Problem::add_action( prob, "(teleport)", { at_a, at_b }, { tele }, {}, no_ceffs );
+	// the conditional effect needs the robot at a while at b
+	aptk::Conditional_Effect *ceff = new aptk::Conditional_Effect( prob );
+	aptk::Fluent_Vec cond = { at_a }, adds = { tele }, dels;
+	ceff->define( cond, adds, dels );
+	aptk::STRIPS_Problem::add_action( prob, "(look)", { at_b }, {}, {}, { ceff } );
+	aptk::STRIPS_Problem::add_action( prob, "(finish)", { at_c }, { done }, {}, no_ceffs );
+
+	aptk::STRIPS_Problem::set_init( prob, { at_a } );
+	aptk::STRIPS_Problem::set_goal( prob, { done } );
+
+	aptk::agnostic::H2_Mutex_Finder finder( prob );
+	REQUIRE( finder.compute() );
+	REQUIRE( finder.reachable( done ) );
+	REQUIRE_FALSE( finder.reachable( tele ) );
+	REQUIRE( finder.are_mutex( at_a, at_b ) );
+	REQUIRE( finder.are_mutex( at_a, done ) );
+	REQUIRE_FALSE( finder.are_mutex( at_c, done ) );
+	REQUIRE( finder.num_mutex_pairs() == 5 );
+
+	REQUIRE( prob.compute_h2_mutexes( 0, 2 ) );
+	REQUIRE( prob.num_fluents() == 4 );
+	REQUIRE( prob.num_actions() == 4 );
+	REQUIRE( prob.get_fluent_index( "(teleported)" ) == no_such_index );
+	for ( unsigned k = 0; k < prob.num_actions(); k++ )
+		REQUIRE( prob.actions()[k]->signature() != "(teleport)" );
+	REQUIRE( prob.actions()[2]->signature() == "(look)" );
+	REQUIRE( prob.actions()[2]->ceff_vec().empty() );
+
+	unsigned new_a = prob.get_fluent_index( "(at a)" );
+	unsigned new_b = prob.get_fluent_index( "(at b)" );
+	unsigned new_c = prob.get_fluent_index( "(at c)" );
+	unsigned new_done = prob.get_fluent_index( "(done)" );
+	const aptk::agnostic::Mutex_Set &mutexes = prob.mutexes();
+	REQUIRE( mutexes.are_mutex( new_a, new_b ) );
+	REQUIRE( mutexes.are_mutex( new_a, new_c ) );
+	REQUIRE( mutexes.are_mutex( new_b, new_c ) );
+	REQUIRE( mutexes.are_mutex( new_b, new_done ) );
+	REQUIRE_FALSE( mutexes.are_mutex( new_c, new_done ) );
+
+	prob.make_action_tables( false );
+	REQUIRE( prob.actions_adding( new_done ).size() == 1 );
+}
+
+TEST_CASE("h^2 mutexes do not depend on the number of threads"){
+
+	const unsigned F = 80, A = 1200;
+	std::mt19937 rng( 7 );
+	auto some_fluents = [&]( unsigned max ) {
+		aptk::Fluent_Vec v;
+		unsigned n = 1 + rng() % max;
+		while ( v.size() < n ) {
+			unsigned p = rng() % F;
+			if ( std::find( v.begin(), v.end(), p ) == v.end() )
+				v.push_back( p );
+		}
+		return v;
+	};
+
+	aptk::STRIPS_Problem prob("h2", "h2");
+	prob.set_verbose(false);
+	for ( unsigned p = 0; p < F; p++ ) {
+		std::stringstream buffer;
+		buffer << "(p" << p << ")";
+		aptk::STRIPS_Problem::add_fluent( prob, buffer.str() );
+	}
+	for ( unsigned i = 0; i < A; i++ ) {
+		std::stringstream buffer;
+		buffer << "(a" << i << ")";
+		aptk::Fluent_Vec pre = some_fluents( 3 ), add = some_fluents( 2 ), del = some_fluents( 3 );
+		aptk::Conditional_Effect_Vec no_ceffs;
+		aptk::STRIPS_Problem::add_action( prob, buffer.str(), pre, add, del, no_ceffs );
+	}
+	aptk::STRIPS_Problem::set_init( prob, some_fluents( 6 ) );
+	aptk::STRIPS_Problem::set_goal( prob, some_fluents( 2 ) );
+
+	aptk::agnostic::H2_Mutex_Finder serial( prob ), parallel( prob );
+	serial.set_num_threads( 1 );
+	parallel.set_num_threads( 4 );
+	REQUIRE( serial.compute() );
+	REQUIRE( parallel.compute() );
+	REQUIRE( parallel.num_mutex_pairs() == serial.num_mutex_pairs() );
+	for ( unsigned p = 0; p < F; p++ )
+		for ( unsigned q = p; q < F; q++ )
+			REQUIRE( parallel.reachable( p, q ) == serial.reachable( p, q ) );
+
+	// Every mutex pair between reachable fluents is in some group
+	std::vector< aptk::Fluent_Vec > groups;
+	serial.mutex_groups( prob.mutexes(), groups );
+	for ( auto &group : groups )
+		prob.mutexes().add( group );
+	for ( unsigned p = 0; p < F; p++ )
+		for ( unsigned q = p + 1; q < F; q++ )
+			if ( serial.reachable( p ) && serial.reachable( q ) )
+				REQUIRE( prob.mutexes().are_mutex( p, q ) == serial.are_mutex( p, q ) );
+}
+
+TEST_CASE("Conditional effects are applied the same way by every state representation"){
+
+	const unsigned F = 80, A = 200;
+	std::mt19937 rng( 3 );
+	auto some_fluents = [&]( unsigned max ) {
+		aptk::Fluent_Vec v;
+		unsigned n = rng() % ( max + 1 );
+		while ( v.size() < n ) {
+			unsigned p = rng() % F;
+			if ( std::find( v.begin(), v.end(), p ) == v.end() )
+				v.push_back( p );
+		}
+		return v;
+	};
+
+	aptk::STRIPS_Problem prob("ceffs", "ceffs");
+	prob.set_verbose(false);
+	for ( unsigned p = 0; p < F; p++ )
+		aptk::STRIPS_Problem::add_fluent( prob, "(p" + std::to_string(p) + ")" );
+	for ( unsigned i = 0; i < A; i++ ) {
+		aptk::Conditional_Effect_Vec ceffs;
+		for ( unsigned k = rng() % 6; k > 0; k-- ) {
+			aptk::Conditional_Effect *ce = new aptk::Conditional_Effect( prob );
+			aptk::Fluent_Vec cond = some_fluents( 4 ), adds = some_fluents( 2 ), dels = some_fluents( 2 );
+			ce->define( cond, adds, dels );
+			ceffs.push_back( ce );
+		}
+		aptk::Fluent_Vec pre = some_fluents( 2 );
+		if ( pre.empty() )
+			pre.push_back( rng() % F );
+		aptk::STRIPS_Problem::add_action( prob, "(a" + std::to_string(i) + ")", pre, some_fluents( 2 ), some_fluents( 2 ), ceffs );
+	}
+	aptk::STRIPS_Problem::set_init( prob, some_fluents( 30 ) );
+	aptk::STRIPS_Problem::set_goal( prob, some_fluents( 2 ) );
+	prob.make_action_tables( false );
+
+	for ( unsigned t = 0; t < 500; t++ ) {
+		std::vector< bool > s( F );
+		for ( unsigned p = 0; p < F; p++ )
+			s[p] = rng() % 3 == 0;
+		const aptk::Action *a = prob.actions()[ rng() % prob.num_actions() ];
+		for ( auto p : a->prec_vec() )
+			s[p] = true;
+
+		// Effects are applied on the state before the action, deletes first
+		std::vector< bool > expected( s );
+		std::vector< const aptk::Conditional_Effect * > fired;
+		for ( auto ce : a->ceff_vec() )
+			if ( std::all_of( ce->prec_vec().begin(), ce->prec_vec().end(), [&]( unsigned p ) { return s[p]; } ) )
+				fired.push_back( ce );
+		for ( auto p : a->del_vec() )
+			expected[p] = false;
+		for ( auto ce : fired )
+			for ( auto p : ce->del_vec() )
+				expected[p] = false;
+		for ( auto p : a->add_vec() )
+			expected[p] = true;
+		for ( auto ce : fired )
+			for ( auto p : ce->add_vec() )
+				expected[p] = true;
+
+		for ( auto r : { aptk::State_Representation::Sparse, aptk::State_Representation::Dual, aptk::State_Representation::Dense } ) {
+			prob.set_state_representation( r );
+			aptk::State s0( prob );
+			for ( unsigned p = 0; p < F; p++ )
+				if ( s[p] )
+					s0.set( p );
+			aptk::State *s1 = s0.progress_through( *a );
+			for ( unsigned p = 0; p < F; p++ )
+				REQUIRE( (bool)s1->entails( p ) == expected[p] );
+			delete s1;
+
+			if ( r != aptk::State_Representation::Dual )
+				continue;
+			aptk::Fluent_Vec added, deleted;
+			s0.progress_lazy_state( a, &added, &deleted );
+			for ( unsigned p = 0; p < F; p++ )
+				REQUIRE( (bool)s0.entails( p ) == expected[p] );
+		}
+	}
+}
+
+TEST_CASE("Search models specialized to STRIPS tasks progress states like the general one"){
+
+	using aptk::agnostic::Costs_Policy;
+	using aptk::agnostic::Effects_Policy;
+	typedef aptk::agnostic::Specialized_Fwd_Search_Problem< Effects_Policy::STRIPS, Costs_Policy::Use_Costs > STRIPS_Search_Problem;
+	typedef aptk::agnostic::Specialized_Fwd_Search_Problem< Effects_Policy::STRIPS, Costs_Policy::Unit_Costs > Unit_STRIPS_Search_Problem;
+
+	const unsigned F = 70, A = 100;
+	std::mt19937 rng( 5 );
+	auto some_fluents = [&]( unsigned max ) {
+		aptk::Fluent_Vec v;
+		unsigned n = 1 + rng() % max;
+		while ( v.size() < n ) {
+			unsigned p = rng() % F;
+			if ( std::find( v.begin(), v.end(), p ) == v.end() )
+				v.push_back( p );
+		}
+		return v;
+	};
+
+	aptk::STRIPS_Problem prob("strips", "strips");
+	prob.set_verbose(false);
+	for ( unsigned p = 0; p < F; p++ )
+		aptk::STRIPS_Problem::add_fluent( prob, "(p" + std::to_string(p) + ")" );
+	aptk::Conditional_Effect_Vec no_ceffs;
+	for ( unsigned i = 0; i < A; i++ )
+		aptk::STRIPS_Problem::add_action( prob, "(a" + std::to_string(i) + ")", some_fluents( 2 ), some_fluents( 3 ), some_fluents( 3 ), no_ceffs, (float)( 1 + rng() % 3 ) );
+	aptk::STRIPS_Problem::set_init( prob, some_fluents( 20 ) );
+	aptk::STRIPS_Problem::set_goal( prob, some_fluents( 2 ) );
+	prob.make_action_tables( false );
+
+	bool dispatched = false;
+	aptk::agnostic::dispatch_search_problem( &prob, [&]( const auto &search_prob ) {
+		dispatched = std::is_same< typename std::decay< decltype( search_prob ) >::type, STRIPS_Search_Problem >::value;
+	} );
+	REQUIRE( dispatched );
+
+	aptk::agnostic::Fwd_Search_Problem general( &prob );
+	STRIPS_Search_Problem strips( &prob );
+	Unit_STRIPS_Search_Problem unit_strips( &prob );
+	for ( auto r : { aptk::State_Representation::Sparse, aptk::State_Representation::Dual, aptk::State_Representation::Dense } ) {
+		prob.set_state_representation( r );
+		for ( unsigned t = 0; t < 200; t++ ) {
+			aptk::State s( prob );
+			for ( unsigned p = 0; p < F; p++ )
+				if ( rng() % 3 == 0 )
+					s.set( p );
+			unsigned a = rng() % A;
+			s.set( prob.actions()[a]->prec_vec() );
+			s.update_hash();
+
+			aptk::State *expected = general.next( s, a );
+			aptk::State *succ = strips.next( s, a );
+			REQUIRE( *succ == *expected );
+			REQUIRE( succ->hash() == expected->hash() );
+			aptk::Fluent_Vec fluents = succ->fluent_vec(), expected_fluents = expected->fluent_vec();
+			std::sort( fluents.begin(), fluents.end() );
+			std::sort( expected_fluents.begin(), expected_fluents.end() );
+			REQUIRE( fluents == expected_fluents );
+			REQUIRE( strips.cost( s, a ) == general.cost( s, a ) );
+			REQUIRE( unit_strips.cost( s, a ) == 1.0f );
+
+			aptk::Fluent_Vec added, deleted, expected_added, expected_deleted;
+			delete succ;
+			delete expected;
+			expected = general.next( s, a, &expected_added, &expected_deleted );
+			succ = strips.next( s, a, &added, &deleted );
+			REQUIRE( *succ == *expected );
+			REQUIRE( added == expected_added );
+			REQUIRE( deleted == expected_deleted );
+			delete succ;
+			delete expected;
+		}
+	}
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_H1_Heuristic.cxx
+ * @brief Checks that h_add and h_max get the same values whether fluents
+ * are swept until a fixpoint, settled in order with a radix heap, or
+ * repaired from the values of the parent state
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <action.hxx>
+#include <cond_eff.hxx>
+#include <fwd_search_prob.hxx>
+#include <h_1.hxx>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+using aptk::agnostic::H1_Cost_Function;
+using aptk::agnostic::H1_Heuristic;
+using aptk::agnostic::H_Add_Evaluation_Function;
+using aptk::agnostic::H_Max_Evaluation_Function;
+
+/**
+ * @brief A random task where actions have between one and three
+ * preconditions, adds and deletes, integral costs, and every fourth action
+ * a conditional effect (half of them unconditioned)
+ */
+static void make_random_problem( aptk::STRIPS_Problem& prob, unsigned seed ) {
+
+	const unsigned F = 40, A = 120;
+	std::mt19937 rng( seed );
+	auto some_fluents = [&]( unsigned max ) {
+		aptk::Fluent_Vec v;
+		unsigned n = 1 + rng() % max;
+		while ( v.size() < n ) {
+			unsigned p = rng() % F;
+			if ( std::find( v.begin(), v.end(), p ) == v.end() )
+				v.push_back( p );
+		}
+		return v;
+	};
+
+	for ( unsigned p = 0; p < F; p++ ) {
+		std::stringstream buffer;
+		buffer << "(p" << p << ")";
+		aptk::STRIPS_Problem::add_fluent( prob, buffer.str() );
+	}
+
+	for ( unsigned i = 0; i < A; i++ ) {
+		std::stringstream buffer;
+		buffer << "(a" << i << ")";
+		aptk::Fluent_Vec pre = some_fluents( 3 ), add = some_fluents( 3 ), del;
+		for ( unsigned p : some_fluents( 3 ) )
+			if ( std::find( add.begin(), add.end(), p ) == add.end() )
+				del.push_back( p );
+		aptk::Conditional_Effect_Vec ceffs;
+		if ( i % 4 == 0 ) {
+			aptk::Fluent_Vec ce_pre = some_fluents( 2 ), ce_add = some_fluents( 2 ), ce_del;
+			for ( unsigned p : some_fluents( 2 ) )
+				if ( std::find( ce_add.begin(), ce_add.end(), p ) == ce_add.end() )
+					ce_del.push_back( p );
+			if ( i % 8 == 0 )
+				ce_pre.clear();
+			aptk::Conditional_Effect* ce = new aptk::Conditional_Effect( prob );
+			ce->define( ce_pre, ce_add, ce_del );
+			ceffs.push_back( ce );
+		}
+		aptk::STRIPS_Problem::add_action( prob, buffer.str(), pre, add, del, ceffs, (float)( 1 + rng() % 5 ) );
+	}
+
+	prob.make_action_tables();
+
+	aptk::Fluent_Vec I = some_fluents( 12 ), G = some_fluents( 3 );
+	aptk::STRIPS_Problem::set_init( prob, I );
+	aptk::STRIPS_Problem::set_goal( prob, G );
+}
+
+template < typename H1 >
+static void check_same_values( const Fwd_Search_Problem& search_prob ) {
+
+	H1 sweep( search_prob ), radix( search_prob );
+	radix.set_radix_heap( true );
+	REQUIRE( radix.uses_radix_heap() );
+
+	aptk::State* s = search_prob.init();
+	float h_sweep = 0, h_radix = 0;
+	sweep.eval( *s, h_sweep );
+	radix.eval( *s, h_radix );
+	CHECK( h_radix == h_sweep );
+	for ( unsigned p = 0; p < search_prob.task().num_fluents(); p++ )
+		CHECK( radix.value( p ) == sweep.value( p ) );
+	delete s;
+}
+
+TEST_CASE("h_add and h_max agree with and without the radix heap"){
+
+	for ( unsigned seed = 0; seed < 20; seed++ ) {
+		aptk::STRIPS_Problem prob;
+		make_random_problem( prob, seed );
+		Fwd_Search_Problem search_prob( &prob );
+
+		check_same_values< H1_Heuristic< Fwd_Search_Problem, H_Add_Evaluation_Function > >( search_prob );
+		check_same_values< H1_Heuristic< Fwd_Search_Problem, H_Max_Evaluation_Function > >( search_prob );
+		check_same_values< H1_Heuristic< Fwd_Search_Problem, H_Add_Evaluation_Function, H1_Cost_Function::Ignore_Costs > >( search_prob );
+		check_same_values< H1_Heuristic< Fwd_Search_Problem, H_Max_Evaluation_Function, H1_Cost_Function::LAMA > >( search_prob );
+	}
+}
+
+template < typename H1 >
+static void check_incremental_values( const Fwd_Search_Problem& search_prob, unsigned seed ) {
+
+	H1 full( search_prob ), incremental( search_prob );
+	incremental.set_incremental( 4 );
+	REQUIRE( incremental.incremental() );
+
+	// Random walks from the initial state, each state evaluated after its parent
+	std::mt19937 rng( seed );
+	const aptk::STRIPS_Problem& prob = search_prob.task();
+	for ( unsigned walk = 0; walk < 5; walk++ ) {
+		aptk::State* s = search_prob.init();
+		float h = 0;
+		incremental.eval( *s, h );
+		for ( unsigned step = 0; step < 10; step++ ) {
+			std::vector< const aptk::Action* > app;
+			for ( const aptk::Action* a : prob.actions() )
+				if ( s->entails( a->prec_vec() ) )
+					app.push_back( a );
+			if ( app.empty() ) break;
+			aptk::State* succ = s->progress_through( *app[ rng() % app.size() ] );
+
+			float h_full = 0, h_incremental = 0;
+			full.eval( *succ, h_full );
+			incremental.set_parent( s );
+			incremental.eval( *succ, h_incremental );
+			CHECK( h_incremental == h_full );
+			for ( unsigned p = 0; p < prob.num_fluents(); p++ )
+				CHECK( incremental.value( p ) == full.value( p ) );
+			delete s;
+			s = succ;
+		}
+		delete s;
+	}
+}
+
+TEST_CASE("Incremental h_add and h_max agree with evaluation from scratch"){
+
+	for ( unsigned seed = 0; seed < 20; seed++ ) {
+		aptk::STRIPS_Problem prob;
+		make_random_problem( prob, seed );
+		Fwd_Search_Problem search_prob( &prob );
+
+		check_incremental_values< H1_Heuristic< Fwd_Search_Problem, H_Add_Evaluation_Function > >( search_prob, seed );
+		check_incremental_values< H1_Heuristic< Fwd_Search_Problem, H_Max_Evaluation_Function > >( search_prob, seed );
+		check_incremental_values< H1_Heuristic< Fwd_Search_Problem, H_Add_Evaluation_Function, H1_Cost_Function::Ignore_Costs > >( search_prob, seed );
+		check_incremental_values< H1_Heuristic< Fwd_Search_Problem, H_Max_Evaluation_Function, H1_Cost_Function::LAMA > >( search_prob, seed );
+	}
+}
@@ -0,0 +1,163 @@
+/**
+ * @file test_H2_Heuristic.cxx
+ * @brief Checks h² values and mutexes on a small task, that fractional costs
+ * round down, and that the pair tables built with several threads give the
+ * same values as with one
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <action.hxx>
+#include <fwd_search_prob.hxx>
+#include <h_2.hxx>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+using aptk::agnostic::H2_Cost_Function;
+using aptk::agnostic::H2_Heuristic;
+
+TEST_CASE("h2 values and mutexes of a small task"){
+
+	// a -(move, 2)-> b -(move, 3)-> c, and d can be added while a holds
+	aptk::STRIPS_Problem prob;
+	unsigned a = aptk::STRIPS_Problem::add_fluent( prob, "(a)" );
+	unsigned b = aptk::STRIPS_Problem::add_fluent( prob, "(b)" );
+	unsigned c = aptk::STRIPS_Problem::add_fluent( prob, "(c)" );
+	unsigned d = aptk::STRIPS_Problem::add_fluent( prob, "(d)" );
+	aptk::Conditional_Effect_Vec no_ceffs;
+	aptk::STRIPS_Problem::add_action( prob, "(ab)", { a }, { b }, { a }, no_ceffs, 2.0f );
+	aptk::STRIPS_Problem::add_action( prob, "(bc)", { b }, { c }, { b }, no_ceffs, 3.0f );
+	aptk::STRIPS_Problem::add_action( prob, "(d)", { a }, { d }, {}, no_ceffs, 1.0f );
+	prob.make_action_tables();
+	aptk::STRIPS_Problem::set_init( prob, { a } );
+	aptk::STRIPS_Problem::set_goal( prob, { c, d } );
+	Fwd_Search_Problem search_prob( &prob );
+
+	H2_Heuristic< Fwd_Search_Problem > h2( search_prob );
+	aptk::State* s = search_prob.init();
+	float h = 0;
+	h2.eval( *s, h );
+	CHECK( h == 6.0f );
+	CHECK( h2.value( a ) == 0.0f );
+	CHECK( h2.value( b ) == 2.0f );
+	CHECK( h2.value( c ) == 5.0f );
+	CHECK( h2.value( d ) == 1.0f );
+	CHECK( h2.value( a, d ) == 1.0f );
+	CHECK( h2.value( b, d ) == 3.0f );
+	CHECK( h2.value( d, c ) == 6.0f );
+	CHECK( h2.is_mutex( a, b ) );
+	CHECK( h2.is_mutex( c, a ) );
+	CHECK( h2.is_mutex( b, c ) );
+	CHECK_FALSE( h2.is_mutex( b, d ) );
+	CHECK( h2.interferes( 0, a ) );
+	CHECK( h2.interferes( 0, b ) );
+	CHECK_FALSE( h2.interferes( 0, d ) );
+
+	H2_Heuristic< Fwd_Search_Problem, H2_Cost_Function::Zero_Costs > mutexes( search_prob );
+	mutexes.compute_mutexes_only( *s );
+	for ( unsigned p = 0; p < prob.num_fluents(); p++ )
+		for ( unsigned q = p; q < prob.num_fluents(); q++ )
+			CHECK( mutexes.is_mutex( p, q ) == h2.is_mutex( p, q ) );
+	delete s;
+}
+
+TEST_CASE("h2 rounds fractional costs down"){
+
+	// Two steps of cost 1.5 cost 3, h2 must not claim more
+	aptk::STRIPS_Problem prob;
+	unsigned a = aptk::STRIPS_Problem::add_fluent( prob, "(a)" );
+	unsigned b = aptk::STRIPS_Problem::add_fluent( prob, "(b)" );
+	unsigned c = aptk::STRIPS_Problem::add_fluent( prob, "(c)" );
+	aptk::Conditional_Effect_Vec no_ceffs;
+	aptk::STRIPS_Problem::add_action( prob, "(ab)", { a }, { b }, { a }, no_ceffs, 1.5f );
+	aptk::STRIPS_Problem::add_action( prob, "(bc)", { b }, { c }, { b }, no_ceffs, 1.5f );
+	prob.make_action_tables();
+	aptk::STRIPS_Problem::set_init( prob, { a } );
+	aptk::STRIPS_Problem::set_goal( prob, { c } );
+	Fwd_Search_Problem search_prob( &prob );
+
+	H2_Heuristic< Fwd_Search_Problem > h2( search_prob );
+	aptk::State* s = search_prob.init();
+	float h = 0;
+	h2.eval( *s, h );
+	CHECK( h <= 3.0f );
+	CHECK( h2.value( b ) == 1.0f );
+	delete s;
+}
+
+TEST_CASE("h2 tables built in parallel give the same values"){
+
+	const unsigned F = 60, A = 400;
+	for ( unsigned seed = 0; seed < 5; seed++ ) {
+		std::mt19937 rng( seed );
+		auto some_fluents = [&]( unsigned max ) {
+			aptk::Fluent_Vec v;
+			unsigned n = 1 + rng() % max;
+			while ( v.size() < n ) {
+				unsigned p = rng() % F;
+				if ( std::find( v.begin(), v.end(), p ) == v.end() )
+					v.push_back( p );
+			}
+			return v;
+		};
+
+		aptk::STRIPS_Problem prob;
+		for ( unsigned p = 0; p < F; p++ ) {
+			std::stringstream buffer;
+			buffer << "(p" << p << ")";
+			aptk::STRIPS_Problem::add_fluent( prob, buffer.str() );
+		}
+		for ( unsigned i = 0; i < A; i++ ) {
+			std::stringstream buffer;
+			buffer << "(a" << i << ")";
+			aptk::Fluent_Vec pre = some_fluents( 3 ), add = some_fluents( 2 ), del;
+			for ( unsigned p : some_fluents( 2 ) )
+				if ( std::find( add.begin(), add.end(), p ) == add.end() )
+					del.push_back( p );
+			aptk::Conditional_Effect_Vec no_ceffs;
+			aptk::STRIPS_Problem::add_action( prob, buffer.str(), pre, add, del, no_ceffs, (float)( 1 + rng() % 5 ) );
+		}
+		prob.make_action_tables();
+		aptk::STRIPS_Problem::set_init( prob, some_fluents( 8 ) );
+		aptk::STRIPS_Problem::set_goal( prob, some_fluents( 3 ) );
+		Fwd_Search_Problem search_prob( &prob );
+
+		H2_Heuristic< Fwd_Search_Problem > serial( search_prob, 1 ), parallel( search_prob, 4 );
+		aptk::State* s = search_prob.init();
+		float h_serial = 0, h_parallel = 0;
+		serial.eval( *s, h_serial );
+		parallel.eval( *s, h_parallel );
+		CHECK( h_parallel == h_serial );
+		for ( unsigned p = 0; p < F; p++ )
+			for ( unsigned q = p; q < F; q++ )
+				CHECK( parallel.value( p, q ) == serial.value( p, q ) );
+		delete s;
+	}
+}
@@ -0,0 +1,253 @@
+/**
+ * @file test_Landmarks_Graph_Generator.cxx
+ * @brief Checks that the landmark graph built with several threads is the
+ * one built with a single thread, that pruning with h_max gives the greedy
+ * necessary orderings of the full recursion over natural orderings, and
+ * that running out of time leaves the goals as the only landmarks
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <strips_prob.hxx>
+#include <action.hxx>
+#include <fwd_search_prob.hxx>
+#include <landmark_graph.hxx>
+#include <landmark_graph_generator.hxx>
+#include <bit_set.hxx>
+#include <chains.hxx>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+using aptk::agnostic::Landmarks_Graph;
+
+typedef aptk::agnostic::Landmarks_Graph_Generator< Fwd_Search_Problem > Gen_Lms_Fwd;
+
+// Every landmark with the landmarks it is ordered after, natural and greedy
+// necessary orderings apart
+static std::vector< std::pair< unsigned, std::vector< unsigned > > > graph_orderings( Landmarks_Graph& graph ) {
+	std::vector< std::pair< unsigned, std::vector< unsigned > > > orderings;
+	for ( auto n : graph.nodes() ) {
+		std::vector< unsigned > before;
+		for ( auto m : n->preceded_by() )
+			before.push_back( m->fluent() );
+		before.push_back( (unsigned)-1 );
+		for ( auto m : n->preceded_by_gn() )
+			before.push_back( m->fluent() );
+		orderings.push_back( std::make_pair( n->fluent(), before ) );
+	}
+	return orderings;
+}
+
+/**
+ * @brief Random actions with costs from 0 to 2, and rings of fluents joined
+ * by zero-cost actions. A ring is entered at its first fluent from a random
+ * fluent, the others are only added by the one before, and the last adds
+ * the first again, so the first has a best supporter whose precondition
+ * follows it. The last fluents of the rings and the fluents they are entered
+ * from are goals.
+ */
+static void make_random_problem( aptk::STRIPS_Problem& prob, unsigned F, unsigned A, unsigned seed ) {
+
+	const unsigned R = 3, L = 3, ring_start = F - R * L;
+	std::mt19937 rng( seed );
+	auto some_fluents = [&]( unsigned max, bool to_add ) {
+		aptk::Fluent_Vec v;
+		unsigned n = 1 + rng() % max;
+		while ( v.size() < n ) {
+			unsigned p = rng() % F;
+			if ( to_add && p >= ring_start )
+				continue;
+			if ( std::find( v.begin(), v.end(), p ) == v.end() )
+				v.push_back( p );
+		}
+		return v;
+	};
+
+	for ( unsigned p = 0; p < F; p++ ) {
+		std::stringstream buffer;
+		buffer << "(p" << p << ")";
+		aptk::STRIPS_Problem::add_fluent( prob, buffer.str() );
+	}
+	aptk::Conditional_Effect_Vec no_ceffs;
+	for ( unsigned i = 0; i < A; i++ ) {
+		std::stringstream buffer;
+		buffer << "(a" << i << ")";
+		aptk::Fluent_Vec pre = some_fluents( 3, false ), add = some_fluents( 2, true ), del;
+		for ( unsigned p : some_fluents( 2, false ) )
+			if ( std::find( add.begin(), add.end(), p ) == add.end() )
+				del.push_back( p );
+		aptk::STRIPS_Problem::add_action( prob, buffer.str(), pre, add, del, no_ceffs, (float)( rng() % 3 ) );
+	}
+	aptk::Fluent_Vec G = some_fluents( 3, false );
+	for ( unsigned r = 0; r < R; r++ ) {
+		std::stringstream enter;
+		enter << "(enter ring" << r << ")";
+		unsigned from = rng() % ring_start;
+		aptk::STRIPS_Problem::add_action( prob, enter.str(), { from }, { ring_start + r * L }, {}, no_ceffs, 0.0f );
+		for ( unsigned j = 0; j < L; j++ ) {
+			std::stringstream buffer;
+			buffer << "(ring" << r << " " << j << ")";
+			unsigned p = ring_start + r * L + j, q = ring_start + r * L + ( j + 1 ) % L;
+			aptk::STRIPS_Problem::add_action( prob, buffer.str(), { p }, { q }, {}, no_ceffs, 0.0f );
+		}
+		for ( unsigned p : { from, ring_start + r * L + L - 1 } )
+			if ( std::find( G.begin(), G.end(), p ) == G.end() )
+				G.push_back( p );
+	}
+	prob.make_action_tables();
+	aptk::STRIPS_Problem::set_init( prob, some_fluents( 4, false ) );
+	aptk::STRIPS_Problem::set_goal( prob, G );
+}
+
+/**
+ * @brief Greedy necessary orderings as they were found before pruning with
+ * h_max: the landmarks of the preconditions of a best supporter of p are
+ * gathered through every natural ordering, and the supporter is no first
+ * achiever of p when p is among them
+ */
+class Reference_Generator : public Gen_Lms_Fwd {
+public:
+	Reference_Generator( const Fwd_Search_Problem& prob )
+		: Gen_Lms_Fwd( prob ) {}
+
+	// The greedy necessary orderings of p, once the graph has been computed
+	std::vector< unsigned > gn_orderings( unsigned p, Landmarks_Graph& graph ) {
+		// Fluent 0 was never looked at
+		if ( p == 0 )
+			return std::vector< unsigned >();
+		unsigned F = m_strips_model.num_fluents();
+		aptk::Bit_Set reach_actions;
+		m_reachability->get_reachable_actions( m_strips_model.init(), m_strips_model.goal(), reach_actions );
+		aptk::Action_Ptr_Const_Vec best_supp;
+		m_h1.get_best_supporters( p, best_supp );
+
+		aptk::Bit_Set lm_set( F );
+		for ( unsigned k = 0; k < best_supp.size(); k++ ) {
+			const aptk::Action* a = best_supp[k];
+			if ( !reach_actions.isset( a->index() ) )
+				continue;
+			aptk::Bit_Set lands_a( F );
+			for ( unsigned q : a->prec_vec() ) {
+				lands_a.set( q );
+				fluent_landmarks( q, lands_a, graph );
+			}
+			if ( lands_a.isset( p ) )
+				continue;
+			if ( k == 0 )
+				lm_set.add( a->prec_set() );
+			else
+				lm_set.set_intersection( a->prec_set() );
+		}
+
+		std::vector< unsigned > gn;
+		for ( unsigned q : lm_set )
+			if ( !m_strips_model.is_in_init( q ) && graph.is_landmark( q ) && !graph.node( p )->is_preceded_by( graph.node( q ) ) )
+				gn.push_back( q );
+		std::sort( gn.begin(), gn.end() );
+		return gn;
+	}
+
+protected:
+	void fluent_landmarks( unsigned p, aptk::Bit_Set& landmarks, Landmarks_Graph& graph ) {
+		if ( !graph.is_landmark( p ) )
+			return;
+		for ( auto n : graph.node( p )->preceded_by() ) {
+			if ( landmarks.isset( n->fluent() ) )
+				continue;
+			landmarks.set( n->fluent() );
+			fluent_landmarks( n->fluent(), landmarks, graph );
+		}
+	}
+};
+
+TEST_CASE("Landmark graph is the same whatever the number of threads"){
+
+	for ( unsigned seed = 0; seed < 5; seed++ ) {
+		aptk::STRIPS_Problem prob;
+		make_chains_problem( prob, 20, 30, seed );
+		Fwd_Search_Problem search_prob( &prob );
+
+		Gen_Lms_Fwd serial_gen( search_prob ), parallel_gen( search_prob );
+		serial_gen.set_num_threads( 1 );
+		parallel_gen.set_num_threads( 4 );
+		Landmarks_Graph serial( prob ), parallel( prob );
+		serial_gen.compute_lm_graph_set_additive( serial );
+		parallel_gen.compute_lm_graph_set_additive( parallel );
+		CHECK_FALSE( serial_gen.timed_out() );
+		CHECK_FALSE( parallel_gen.timed_out() );
+		CHECK( serial.num_landmarks() > prob.goal().size() );
+		CHECK( graph_orderings( parallel ) == graph_orderings( serial ) );
+	}
+}
+
+TEST_CASE("Greedy necessary orderings are those of the full recursion"){
+
+	// Some tasks have no greedy necessary orderings beyond the natural ones
+	unsigned num_gn = 0;
+	for ( unsigned seed = 0; seed < 30; seed++ )
+		for ( unsigned task = 0; task < 3; task++ ) {
+			aptk::STRIPS_Problem prob;
+			if ( task == 0 )
+				make_random_problem( prob, 30, 120, seed );
+			else
+				make_chains_problem( prob, 8, 10, seed, task == 1 ? Chain_Moves::Jumps : Chain_Moves::Back_And_Knock );
+			Fwd_Search_Problem search_prob( &prob );
+
+			Reference_Generator gen_lms( search_prob );
+			gen_lms.set_goal_ordering( false );
+			Landmarks_Graph graph( prob );
+			gen_lms.compute_lm_graph_set_additive( graph );
+			REQUIRE_FALSE( gen_lms.timed_out() );
+
+			for ( auto n : graph.nodes() ) {
+				std::vector< unsigned > gn;
+				for ( auto m : n->preceded_by_gn() )
+					gn.push_back( m->fluent() );
+				std::sort( gn.begin(), gn.end() );
+				CHECK( gn == gen_lms.gn_orderings( n->fluent(), graph ) );
+				num_gn += gn.size();
+			}
+		}
+	CHECK( num_gn > 0 );
+}
+
+TEST_CASE("Landmark graph out of time only has the goals"){
+
+	aptk::STRIPS_Problem prob;
+	make_chains_problem( prob, 20, 30, 0 );
+	Fwd_Search_Problem search_prob( &prob );
+
+	Gen_Lms_Fwd gen_lms( search_prob );
+	gen_lms.set_time_budget( 1e-9 );
+	Landmarks_Graph graph( prob );
+	gen_lms.compute_lm_graph_set_additive( graph );
+	CHECK( gen_lms.timed_out() );
+	CHECK( graph.num_landmarks() == prob.goal().size() );
+}
@@ -0,0 +1,144 @@
+/**
+ * @file test_Landmarks_Graph_Manager.cxx
+ * @brief Checks that moving the landmark graph between the nodes of a search
+ * tree, through their closest common ancestor, leaves the same landmarks
+ * consumed as when each node was generated
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <strips_prob.hxx>
+#include <strips_state.hxx>
+#include <action.hxx>
+#include <fwd_search_prob.hxx>
+#include <landmark_graph.hxx>
+#include <landmark_graph_generator.hxx>
+#include <landmark_graph_manager.hxx>
+#include <chains.hxx>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using aptk::agnostic::Fwd_Search_Problem;
+using aptk::agnostic::Landmark_Delta;
+
+typedef aptk::agnostic::Landmarks_Graph_Generator< Fwd_Search_Problem > Gen_Lms_Fwd;
+typedef aptk::agnostic::Landmarks_Graph_Manager< Fwd_Search_Problem > Land_Graph_Man;
+
+/**
+ * @brief The part of a search node the landmark graph manager relies on
+ */
+class Tree_Node {
+public:
+	Tree_Node( aptk::State* s, Tree_Node* parent )
+		: m_state( s ), m_parent( parent ), m_depth( parent ? parent->m_depth + 1 : 0 ), m_land_delta( NULL ) {}
+	~Tree_Node() { delete m_state; delete m_land_delta; }
+
+	aptk::State* state() { return m_state; }
+	Tree_Node* parent() { return m_parent; }
+	unsigned gn_unit() const { return m_depth; }
+	Landmark_Delta*& land_delta() { return m_land_delta; }
+
+	std::vector< bool > consumed;
+
+private:
+	aptk::State* m_state;
+	Tree_Node* m_parent;
+	unsigned m_depth;
+	Landmark_Delta* m_land_delta;
+};
+
+static std::vector< bool > consumed_landmarks( aptk::agnostic::Landmarks_Graph& graph ) {
+	std::vector< bool > consumed;
+	for ( auto n : graph.nodes() )
+		consumed.push_back( n->is_consumed() );
+	return consumed;
+}
+
+TEST_CASE("Landmark graph moves between nodes through their common ancestor"){
+
+	for ( unsigned seed = 0; seed < 20; seed++ ) {
+		aptk::STRIPS_Problem prob;
+		make_chains_problem( prob, 4, 4, seed, Chain_Moves::Back_And_Knock );
+		Fwd_Search_Problem search_prob( &prob );
+
+		Gen_Lms_Fwd gen_lms( search_prob );
+		aptk::agnostic::Landmarks_Graph graph( prob );
+		gen_lms.compute_lm_graph_set_additive( graph );
+		REQUIRE( graph.num_landmarks() >= 4 );
+		Land_Graph_Man lgm( search_prob, &graph );
+
+		// Grow a random tree, mostly below recent nodes so that it gets deep,
+		// recording the landmarks consumed at each node while the graph is at
+		// the node it was generated from
+		std::mt19937 rng( seed );
+		std::vector< Tree_Node* > tree;
+		Tree_Node* root = new Tree_Node( search_prob.init(), NULL );
+		lgm.reset_graph();
+		lgm.apply_state( root->state()->fluent_vec(), root->land_delta() );
+		lgm.set_node( root );
+		root->consumed = consumed_landmarks( graph );
+		lgm.move_to( root );
+		CHECK( consumed_landmarks( graph ) == root->consumed );
+		lgm.undo_node( root );
+		CHECK( consumed_landmarks( graph ) == std::vector< bool >( graph.num_landmarks(), false ) );
+		tree.push_back( root );
+
+		for ( unsigned i = 0; i < 300; i++ ) {
+			Tree_Node* parent = tree[ tree.size() - 1 - rng() % std::min< size_t >( tree.size(), 4 ) ];
+			std::vector< const aptk::Action* > app;
+			for ( const aptk::Action* a : prob.actions() )
+				if ( parent->state()->entails( a->prec_vec() ) )
+					app.push_back( a );
+			if ( app.empty() ) continue;
+			const aptk::Action* a = app[ rng() % app.size() ];
+
+			lgm.move_to( parent );
+			CHECK( consumed_landmarks( graph ) == parent->consumed );
+			Tree_Node* child = new Tree_Node( parent->state()->progress_through( *a ), parent );
+			lgm.apply_action( parent->state(), a->index(), child->land_delta() );
+			child->consumed = consumed_landmarks( graph );
+			lgm.undo_node( child );
+			CHECK( consumed_landmarks( graph ) == parent->consumed );
+			tree.push_back( child );
+		}
+
+		// Visit them in a random order, and once after forgetting where the
+		// graph was, which replays the whole path
+		std::vector< Tree_Node* > order( tree );
+		std::shuffle( order.begin(), order.end(), rng );
+		for ( Tree_Node* n : order ) {
+			lgm.move_to( n );
+			CHECK( consumed_landmarks( graph ) == n->consumed );
+		}
+		lgm.apply_state( prob.init() );
+		lgm.move_to( order.front() );
+		CHECK( consumed_landmarks( graph ) == order.front()->consumed );
+
+		for ( Tree_Node* n : tree )
+			delete n;
+	}
+}
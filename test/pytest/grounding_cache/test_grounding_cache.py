@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+
+# The grounding cache only needs the task image calls of a task, a small
+# stand-in task keeps these tests independent of the grounders.
+
+import os
+
+import pytest
+
+from lapkt.grounding_cache import GroundingCache
+
+MB = 1024 * 1024
+
+
+class ImageTask:
+    """Stands in for STRIPS_Interface, its task image is a blob of bytes"""
+
+    def __init__(self, image: bytes = b''):
+        self.image = image
+
+    def write_task_image(self, path: str) -> bool:
+        with open(path, 'wb') as out_f:
+            out_f.write(self.image)
+        return True
+
+    def load_task_image(self, path: str) -> bool:
+        with open(path, 'rb') as in_f:
+            self.image = in_f.read()
+        return True
+
+
+@pytest.fixture
+def pddl(tmp_path):
+    domain = tmp_path / 'domain.pddl'
+    problem = tmp_path / 'problem.pddl'
+    domain.write_text('(define (domain d))')
+    problem.write_text('(define (problem p) (:domain d))')
+    return str(domain), str(problem)
+
+
+def test_key_stability(pddl, tmp_path):
+    domain, problem = pddl
+    options = {'grounder': 'Tarski', 'ignore_action_costs': False}
+    key = GroundingCache.key(domain, problem, options)
+    # same inputs, option order does not matter
+    assert GroundingCache.key(domain, problem, options) == key
+    assert GroundingCache.key(domain, problem,
+                              dict(reversed(list(options.items())))) == key
+    # the key depends on the file contents, not on their paths
+    copy = tmp_path / 'copy.pddl'
+    copy.write_text(open(domain).read())
+    assert GroundingCache.key(str(copy), problem, options) == key
+    # any change of an input changes the key
+    assert GroundingCache.key(problem, domain, options) != key
+    assert GroundingCache.key(domain, problem,
+                              dict(options, grounder='FD')) != key
+    assert GroundingCache.key(domain, problem,
+                              dict(options, h2_mutexes=10)) != key
+    with open(problem, 'a') as out_f:
+        out_f.write(' ')
+    assert GroundingCache.key(domain, problem, options) != key
+
+
+def test_hit_and_miss(pddl, tmp_path):
+    domain, problem = pddl
+    cache = GroundingCache(str(tmp_path / 'cache'), 1024 * MB)
+    key = GroundingCache.key(domain, problem, {'grounder': 'Tarski'})
+
+    task = ImageTask()
+    assert not cache.load(key, task)
+    assert task.image == b''
+
+    assert cache.store(key, ImageTask(b'grounded task'))
+    assert os.listdir(str(tmp_path / 'cache')) == [key + '.lapkt']
+    assert cache.load(key, task)
+    assert task.image == b'grounded task'
+
+    other = GroundingCache.key(domain, problem, {'grounder': 'FD'})
+    assert not cache.load(other, ImageTask())
+
+
+def test_lru_eviction(tmp_path):
+    cache_dir = tmp_path / 'cache'
+    # as set up by the planner for --grounding_cache_mb 1
+    cache = GroundingCache(str(cache_dir), 1 * MB)
+    image = ImageTask(b'x' * (400 * 1024))
+
+    def age(key, mtime):
+        os.utime(cache.path(key), (mtime, mtime))
+
+    assert cache.store('a', image)
+    age('a', 1000)
+    assert cache.store('b', image)
+    age('b', 2000)
+    # a hit makes 'a' the most recently used entry
+    assert cache.load('a', ImageTask())
+    assert os.stat(cache.path('a')).st_mtime > 2000
+
+    # a third image does not fit, the least recently used 'b' goes
+    assert cache.store('c', image)
+    assert sorted(os.listdir(str(cache_dir))) == ['a.lapkt', 'c.lapkt']
+
+    # the entry just stored is kept even when it alone exceeds the bound
+    assert cache.store('big', ImageTask(b'x' * (2 * MB)))
+    assert os.listdir(str(cache_dir)) == ['big.lapkt']
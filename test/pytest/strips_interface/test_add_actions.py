@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+
+# STRIPS_Interface.add_actions() must build the same actions as the
+# add_action(), add_precondition(), add_effect(), add_cond_effect() and
+# set_cost() calls it replaces, and reject malformed arrays up front.
+
+from array import array
+
+import pytest
+
+from lapkt.core.lib.wrapper import STRIPS_Interface
+
+
+def make_task():
+    """Atoms (p0)..(p3), (p1) also appears negated in conditions"""
+    task = STRIPS_Interface("domain.pddl", "problem.pddl")
+    for i in range(4):
+        task.add_atom("(p%d)" % i)
+    task.notify_negated_conditions([1])
+    task.create_negated_fluents()
+    return task
+
+
+def lit(atom, negated=False):
+    return 2 * atom + int(negated)
+
+
+# (name, cost, pre, eff, [(cond, eff)]) with (atom, negated) literals
+ACTIONS = [
+    ("(a)", 2.0, [(0, False), (1, True)], [(2, False), (1, False)],
+     [([(1, True)], [(3, False), (0, True)])]),
+    ("(b)", 1.0, [(2, False)], [(1, True)], []),
+    ("(c)", 3.0, [(3, False)], [],
+     [([(0, False)], [(2, True)]), ([(1, True), (2, False)], [(1, False)])]),
+]
+
+
+def pack(actions):
+    names, costs = [], array('f')
+    pre_offs, pre_lits = array('I', [0]), array('I')
+    eff_offs, eff_lits = array('I', [0]), array('I')
+    ceff_offs, cond_offs, cond_lits = array('I', [0]), array('I', [0]), array('I')
+    ceff_eff_offs, ceff_eff_lits = array('I', [0]), array('I')
+    for name, cost, pre, eff, ceffs in actions:
+        names.append(name)
+        costs.append(cost)
+        pre_lits.extend(lit(*l) for l in pre)
+        pre_offs.append(len(pre_lits))
+        eff_lits.extend(lit(*l) for l in eff)
+        eff_offs.append(len(eff_lits))
+        for cond, c_eff in ceffs:
+            cond_lits.extend(lit(*l) for l in cond)
+            cond_offs.append(len(cond_lits))
+            ceff_eff_lits.extend(lit(*l) for l in c_eff)
+            ceff_eff_offs.append(len(ceff_eff_lits))
+        ceff_offs.append(len(cond_offs) - 1)
+    return [names, costs, pre_offs, pre_lits, eff_offs, eff_lits,
+            ceff_offs, cond_offs, cond_lits, ceff_eff_offs, ceff_eff_lits]
+
+
+def printed_actions(task):
+    task.print_actions()
+    with open("actions.list") as in_f:
+        return in_f.read()
+
+
+def test_add_actions_matches_single_calls(tmp_path, monkeypatch):
+    monkeypatch.chdir(tmp_path)
+    bulk = make_task()
+    bulk.add_actions(*pack(ACTIONS))
+
+    single = make_task()
+    for index, (name, cost, pre, eff, ceffs) in enumerate(ACTIONS):
+        single.add_action(name, False)
+        single.add_precondition(index, pre)
+        single.add_effect(index, eff)
+        for cond, c_eff in ceffs:
+            single.add_cond_effect(index, cond, c_eff)
+        single.set_cost(index, cost)
+
+    assert bulk.num_actions() == len(ACTIONS)
+    assert bulk.num_atoms() == 5
+    actions = printed_actions(bulk)
+    assert actions == printed_actions(single)
+    # negated (p1) is read through its negated fluent
+    assert "(not (p1))" in actions
+
+
+@pytest.mark.parametrize("field, value", [
+    # offsets: wrong length, not starting at 0, decreasing, not ending at
+    # the number of literals
+    (2, array('I', [0, 2, 3])),
+    (2, array('I', [1, 2, 3, 4])),
+    (4, array('I', [0, 2, 1, 3])),
+    (9, array('I', [0, 2, 3, 3])),
+    # literals: unknown atom, negated condition without a negated fluent
+    (3, array('I', [lit(0), lit(1, True), lit(9), lit(3)])),
+    (8, array('I', [lit(1, True), lit(0, True), lit(1, True), lit(2)])),
+    # wrong element types
+    (1, array('d', [2.0, 1.0, 3.0])),
+    (5, array('H', [lit(2), lit(1), lit(1, True)])),
+    # one cost per action
+    (1, array('f', [2.0, 1.0])),
+])
+def test_add_actions_rejects_malformed_input(field, value):
+    task = make_task()
+    args = pack(ACTIONS)
+    args[field] = value
+    with pytest.raises(ValueError):
+        task.add_actions(*args)
+    # nothing is added before the input has been checked
+    assert task.num_actions() == 0
+    task.add_actions(*pack(ACTIONS))
+    assert task.num_actions() == len(ACTIONS)
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+
+# Grounding the action schemas in parallel must give the same task as the
+# sequential path: same actions, same ids, same order.
+
+import pytest
+
+from lapkt.core.lib.wrapper import STRIPS_Interface
+from lapkt.pddl.tarski import ground_generate_task
+
+
+blocks_domain = """
+(define (domain BLOCKS)
+  (:requirements :strips :conditional-effects)
+  (:predicates (on ?x ?y) (ontable ?x) (clear ?x) (handempty) (holding ?x)
+               (tower ?x))
+  (:action pick-up
+     :parameters (?x)
+     :precondition (and (clear ?x) (ontable ?x) (handempty))
+     :effect (and (not (ontable ?x)) (not (clear ?x)) (not (handempty))
+                  (holding ?x)))
+  (:action put-down
+     :parameters (?x)
+     :precondition (holding ?x)
+     :effect (and (not (holding ?x)) (clear ?x) (handempty) (ontable ?x)))
+  (:action stack
+     :parameters (?x ?y)
+     :precondition (and (holding ?x) (clear ?y))
+     :effect (and (not (holding ?x)) (not (clear ?y)) (clear ?x) (handempty)
+                  (on ?x ?y)
+                  (when (ontable ?y) (tower ?x))))
+  (:action unstack
+     :parameters (?x ?y)
+     :precondition (and (on ?x ?y) (clear ?x) (handempty))
+     :effect (and (holding ?x) (clear ?y) (not (clear ?x)) (not (handempty))
+                  (not (on ?x ?y)) (not (tower ?x)))))
+"""
+
+# Enough blocks for stack and unstack to span several grounding chunks
+blocks = ["B%d" % i for i in range(12)]
+
+blocks_problem = """
+(define (problem BLOCKS-12)
+  (:domain BLOCKS)
+  (:objects %s)
+  (:init (handempty) %s)
+  (:goal (and %s)))
+""" % (" ".join(blocks),
+       " ".join("(ontable %s) (clear %s)" % (b, b) for b in blocks),
+       " ".join("(on %s %s)" % (x, y) for x, y in zip(blocks, blocks[1:])))
+
+
+def ground(num_threads):
+    task = STRIPS_Interface("blocks_domain.pddl", "blocks_problem.pddl")
+    ground_generate_task("blocks_domain.pddl", "blocks_problem.pddl", task,
+                         num_threads)
+    task.print_actions()
+    task.print_fluents()
+    with open("actions.list") as file:
+        actions = file.read()
+    with open("fluents.list") as file:
+        fluents = file.read()
+    return task.num_actions(), task.num_atoms(), actions, fluents
+
+
+def test_parallel_grounding_matches_sequential(tmp_path, monkeypatch):
+    monkeypatch.chdir(tmp_path)
+    with open("blocks_domain.pddl", 'w') as file:
+        file.write(blocks_domain)
+    with open("blocks_problem.pddl", 'w') as file:
+        file.write(blocks_problem)
+
+    sequential = ground(1)
+    # stack and unstack have 132 groundings each, 64 per chunk
+    assert sequential[0] > 2 * 64
+    for num_threads in (2, 4, 0):
+        assert ground(num_threads) == sequential